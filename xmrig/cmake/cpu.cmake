@@ -26,6 +26,7 @@ if (XMRIG_64_BIT AND CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64)$")
 else()
     set(WITH_SSE4_1 OFF)
     set(WITH_VAES OFF)
+    set(WITH_VPAES OFF)
 endif()
 
 if (NOT ARM_TARGET)
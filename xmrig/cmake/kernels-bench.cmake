@@ -0,0 +1,14 @@
+if (WITH_KERNELS_BENCH)
+    set(KERNELS_BENCH_SOURCES "${SOURCES}")
+    list(REMOVE_ITEM KERNELS_BENCH_SOURCES src/xmrig.cpp)
+
+    list(APPEND KERNELS_BENCH_SOURCES
+        src/crypto/bench/KernelsBench.h
+        src/crypto/bench/KernelsBench.cpp
+        src/crypto/bench/kernels_bench.cpp
+        )
+
+    # Not built by default, use "cmake --build . --target xmrig-kernels-bench".
+    add_executable(xmrig-kernels-bench EXCLUDE_FROM_ALL ${HEADERS} ${KERNELS_BENCH_SOURCES} ${SOURCES_OS} ${HEADERS_CRYPTO} ${SOURCES_CRYPTO} ${SOURCES_SYSLOG} ${TLS_SOURCES} ${XMRIG_ASM_SOURCES})
+    target_link_libraries(xmrig-kernels-bench ${XMRIG_ASM_LIBRARY} ${OPENSSL_LIBRARIES} ${UV_LIBRARIES} ${EXTRA_LIBS} ${CPUID_LIB} ${ARGON2_LIBRARY} ${ETHASH_LIBRARY} ${GHOSTRIDER_LIBRARY})
+endif()
@@ -9,6 +9,7 @@ if (WITH_RANDOMX)
         src/crypto/rx/RxCache.h
         src/crypto/rx/RxConfig.h
         src/crypto/rx/RxDataset.h
+        src/crypto/rx/RxDiskCache.h
         src/crypto/rx/RxQueue.h
         src/crypto/rx/RxSeed.h
         src/crypto/rx/RxVm.h
@@ -38,6 +39,7 @@ if (WITH_RANDOMX)
         src/crypto/rx/RxCache.cpp
         src/crypto/rx/RxConfig.cpp
         src/crypto/rx/RxDataset.cpp
+        src/crypto/rx/RxDiskCache.cpp
         src/crypto/rx/RxQueue.cpp
         src/crypto/rx/RxVm.cpp
     )
@@ -80,6 +82,14 @@ if (WITH_RANDOMX)
         endif()
     endif()
 
+    if (WITH_VPAES)
+        list(APPEND SOURCES_CRYPTO src/crypto/randomx/aes_hash_vpaes.cpp)
+
+        if (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
+            set_source_files_properties(src/crypto/randomx/aes_hash_vpaes.cpp PROPERTIES COMPILE_FLAGS -mssse3)
+        endif()
+    endif()
+
     if (CMAKE_CXX_COMPILER_ID MATCHES Clang)
         set_source_files_properties(src/crypto/randomx/jit_compiler_x86.cpp PROPERTIES COMPILE_FLAGS -Wno-unused-const-variable)
     endif()
@@ -0,0 +1,80 @@
+#!/bin/bash
+
+# Runs offline benchmark for every algo/threads/size combination and compares results with a baseline.
+#
+# Create or extend a baseline (several runs per combination are recommended to estimate noise):
+#   ./bench_regression.sh -o baseline.json -n 5
+#
+# Check a new build against it, exit code is 1 if any combination regressed:
+#   ./bench_regression.sh -x ./build/xmrig -b baseline.json -o current.json
+
+XMRIG=./xmrig
+ALGOS="rx/0 rx/wow"
+THREADS="$(nproc 2>/dev/null || sysctl -n hw.logicalcpu)"
+SIZES="1M"
+RUNS=1
+BASELINE=
+REPORT=bench_report.json
+THRESHOLD=
+
+usage() {
+	echo "Usage: $0 [-x XMRIG] [-a ALGOS] [-t THREADS] [-s SIZES] [-n RUNS] [-b BASELINE] [-o REPORT] [-p THRESHOLD] [-- XMRIG_OPTIONS]"
+	echo
+	echo "  -x XMRIG      path to xmrig binary (default: $XMRIG)"
+	echo "  -a ALGOS      space separated list of algorithms (default: \"$ALGOS\")"
+	echo "  -t THREADS    space separated list of threads count (default: \"$THREADS\")"
+	echo "  -s SIZES      space separated list of benchmark sizes (default: \"$SIZES\")"
+	echo "  -n RUNS       number of runs for every combination (default: $RUNS)"
+	echo "  -b BASELINE   baseline file to compare with"
+	echo "  -o REPORT     report file to append results to (default: $REPORT)"
+	echo "  -p THRESHOLD  allowed regression in percent (default: 5)"
+}
+
+while getopts "x:a:t:s:n:b:o:p:h" opt; do
+	case $opt in
+		x) XMRIG=$OPTARG ;;
+		a) ALGOS=$OPTARG ;;
+		t) THREADS=$OPTARG ;;
+		s) SIZES=$OPTARG ;;
+		n) RUNS=$OPTARG ;;
+		b) BASELINE=$OPTARG ;;
+		o) REPORT=$OPTARG ;;
+		p) THRESHOLD=$OPTARG ;;
+		h) usage; exit 0 ;;
+		*) usage; exit 2 ;;
+	esac
+done
+
+shift $((OPTIND - 1))
+
+FAILED=0
+
+for size in $SIZES; do
+	for algo in $ALGOS; do
+		for threads in $THREADS; do
+			i=0
+			while [ $i -lt "$RUNS" ]; do
+				i=$((i + 1))
+				echo "=== $algo threads=$threads size=$size run $i/$RUNS"
+
+				args=(--bench="$size" -a "$algo" -t "$threads" --bench-report="$REPORT")
+				if [ -n "$BASELINE" ]; then
+					args+=(--bench-baseline="$BASELINE")
+				fi
+				if [ -n "$THRESHOLD" ]; then
+					args+=(--bench-threshold="$THRESHOLD")
+				fi
+
+				"$XMRIG" "${args[@]}" "$@"
+				rc=$?
+
+				if [ $rc -ne 0 ]; then
+					echo "=== $algo threads=$threads size=$size FAILED (exit code $rc)"
+					FAILED=1
+				fi
+			done
+		done
+	done
+done
+
+exit $FAILED
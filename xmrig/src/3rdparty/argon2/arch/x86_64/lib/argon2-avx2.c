@@ -324,12 +324,21 @@ void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_posit
 }
 
 
+#define ARGON2_MULTI_STATE __m256i
+#include "argon2-template-multi.h"
+
+void xmrig_ar2_fill_segment_multi_avx2(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position)
+{
+    fill_segment_multi(instances, count, position);
+}
+
 extern int cpu_flags_has_avx2(void);
 int xmrig_ar2_check_avx2(void) { return cpu_flags_has_avx2(); }
 
 #else
 
 void xmrig_ar2_fill_segment_avx2(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_multi_avx2(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position) {}
 int xmrig_ar2_check_avx2(void) { return 0; }
 
 #endif
@@ -165,3 +165,6 @@ static void fill_segment_128(const argon2_instance_t *instance,
         }
     }
 }
+
+#define ARGON2_MULTI_STATE __m128i
+#include "argon2-template-multi.h"
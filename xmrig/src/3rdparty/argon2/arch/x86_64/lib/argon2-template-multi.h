@@ -0,0 +1,144 @@
+/*
+ * Lockstep filling of several independent single lane instances with the same
+ * parameters. Block i of every instance is computed before block i + 1 of any
+ * instance and reference blocks of all instances are prefetched before the
+ * compressions, so memory latency of one instance is hidden behind the work
+ * on the others. Addresses for the data-independent part (Argon2i and first
+ * half of the first pass of Argon2id) depend only on parameters and position
+ * and are computed once for all instances.
+ *
+ * Expects ARGON2_MULTI_STATE (SIMD register type), fill_block() and
+ * next_addresses() to be defined by the including file.
+ */
+
+#include <string.h>
+
+#ifdef __GNUC__
+#   include <x86intrin.h>
+#else
+#   include <intrin.h>
+#endif
+
+#include "core.h"
+
+#define ARGON2_MULTI_STATE_WORDS (ARGON2_BLOCK_SIZE / sizeof(ARGON2_MULTI_STATE))
+
+static void prefetch_block(const block *b)
+{
+    unsigned int i;
+
+    for (i = 0; i < ARGON2_BLOCK_SIZE; i += 64) {
+        _mm_prefetch((const char *)b->v + i, _MM_HINT_T0);
+    }
+}
+
+static void fill_segment_multi(const argon2_instance_t *const *instances,
+                               uint32_t count, argon2_position_t position)
+{
+    const argon2_instance_t *instance = instances[0];
+    const block *ref_blocks[ARGON2_MAX_MULTI];
+    block address_block, input_block;
+    uint64_t pseudo_rand, ref_index, ref_lane;
+    uint32_t prev_offset, curr_offset;
+    uint32_t starting_index, i, j;
+    ARGON2_MULTI_STATE state[ARGON2_MAX_MULTI][ARGON2_MULTI_STATE_WORDS];
+    int data_independent_addressing, with_xor;
+
+    if (instance == NULL || count == 0 || count > ARGON2_MAX_MULTI) {
+        return;
+    }
+
+    data_independent_addressing = (instance->type == Argon2_i) ||
+            (instance->type == Argon2_id && (position.pass == 0) &&
+             (position.slice < ARGON2_SYNC_POINTS / 2));
+
+    /* version 1.2.1 and earlier: overwrite, not XOR */
+    with_xor = !(0 == position.pass || ARGON2_VERSION_10 == instance->version);
+
+    if (data_independent_addressing) {
+        init_block_value(&input_block, 0);
+
+        input_block.v[0] = position.pass;
+        input_block.v[1] = position.lane;
+        input_block.v[2] = position.slice;
+        input_block.v[3] = instance->memory_blocks;
+        input_block.v[4] = instance->passes;
+        input_block.v[5] = instance->type;
+    }
+
+    starting_index = 0;
+
+    if ((0 == position.pass) && (0 == position.slice)) {
+        starting_index = 2; /* we have already generated the first two blocks */
+
+        /* Don't forget to generate the first block of addresses: */
+        if (data_independent_addressing) {
+            next_addresses(&address_block, &input_block);
+        }
+    }
+
+    /* Offset of the current block */
+    curr_offset = position.lane * instance->lane_length +
+                  position.slice * instance->segment_length + starting_index;
+
+    if (0 == curr_offset % instance->lane_length) {
+        /* Last block in this lane */
+        prev_offset = curr_offset + instance->lane_length - 1;
+    } else {
+        /* Previous block */
+        prev_offset = curr_offset - 1;
+    }
+
+    for (j = 0; j < count; ++j) {
+        memcpy(state[j], ((instances[j]->memory + prev_offset)->v), ARGON2_BLOCK_SIZE);
+    }
+
+    for (i = starting_index; i < instance->segment_length;
+         ++i, ++curr_offset, ++prev_offset) {
+        /*1.1 Rotating prev_offset if needed */
+        if (curr_offset % instance->lane_length == 1) {
+            prev_offset = curr_offset - 1;
+        }
+
+        position.index = i;
+
+        /* 1.2 Computing the index of the reference block for every instance */
+        if (data_independent_addressing) {
+            if (i % ARGON2_ADDRESSES_IN_BLOCK == 0) {
+                next_addresses(&address_block, &input_block);
+            }
+            pseudo_rand = address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK];
+
+            ref_lane = ((pseudo_rand >> 32)) % instance->lanes;
+            if ((position.pass == 0) && (position.slice == 0)) {
+                ref_lane = position.lane;
+            }
+
+            ref_index = xmrig_ar2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF, ref_lane == position.lane);
+
+            for (j = 0; j < count; ++j) {
+                ref_blocks[j] = instances[j]->memory + instance->lane_length * ref_lane + ref_index;
+                prefetch_block(ref_blocks[j]);
+            }
+        } else {
+            for (j = 0; j < count; ++j) {
+                pseudo_rand = instances[j]->memory[prev_offset].v[0];
+
+                ref_lane = ((pseudo_rand >> 32)) % instance->lanes;
+                if ((position.pass == 0) && (position.slice == 0)) {
+                    ref_lane = position.lane;
+                }
+
+                ref_index = xmrig_ar2_index_alpha(instance, &position, pseudo_rand & 0xFFFFFFFF, ref_lane == position.lane);
+
+                ref_blocks[j] = instances[j]->memory + instance->lane_length * ref_lane + ref_index;
+                prefetch_block(ref_blocks[j]);
+            }
+        }
+
+        /* 2 Creating new blocks */
+        for (j = 0; j < count; ++j) {
+            fill_block(state[j], ref_blocks[j], instances[j]->memory + curr_offset, with_xor);
+        }
+    }
+}
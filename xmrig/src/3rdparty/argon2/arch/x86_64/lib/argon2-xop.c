@@ -105,12 +105,18 @@ void xmrig_ar2_fill_segment_xop(const argon2_instance_t *instance, argon2_positi
     fill_segment_128(instance, position);
 }
 
+void xmrig_ar2_fill_segment_multi_xop(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position)
+{
+    fill_segment_multi(instances, count, position);
+}
+
 extern int cpu_flags_has_xop(void);
 int xmrig_ar2_check_xop(void) { return cpu_flags_has_xop(); }
 
 #else
 
 void xmrig_ar2_fill_segment_xop(const argon2_instance_t *instance, argon2_position_t position) {}
+void xmrig_ar2_fill_segment_multi_xop(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position) {}
 int xmrig_ar2_check_xop(void) { return 0; }
 
 #endif
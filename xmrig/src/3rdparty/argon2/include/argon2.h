@@ -29,6 +29,9 @@ extern "C" {
  * Argon2 input parameter restrictions
  */
 
+/* Maximum number of independent hashes computed in lockstep by argon2id_hash_raw_multi */
+#define ARGON2_MAX_MULTI UINT32_C(8)
+
 /* Minimum and maximum number of lanes (degree of parallelism) */
 #define ARGON2_MIN_LANES UINT32_C(1)
 #define ARGON2_MAX_LANES UINT32_C(0xFFFFFF)
@@ -316,6 +319,22 @@ ARGON2_PUBLIC int argon2id_hash_raw_ex(const uint32_t t_cost,
                                        const size_t hashlen,
                                        void *memory);
 
+/**
+ * Hashes count (up to ARGON2_MAX_MULTI) independent inputs with the same
+ * parameters and a single lane, block compressions of all instances are
+ * interleaved to hide memory latency. Every instance needs own memory.
+ */
+ARGON2_PUBLIC int argon2id_hash_raw_multi(const uint32_t t_cost,
+                                          const uint32_t m_cost,
+                                          const void *const *pwd,
+                                          const size_t pwdlen,
+                                          const void *const *salt,
+                                          const size_t saltlen,
+                                          void *const *hash,
+                                          const size_t hashlen,
+                                          void *const *memory,
+                                          const uint32_t count);
+
 /* generic function underlying the above ones */
 ARGON2_PUBLIC int argon2_hash(const uint32_t t_cost, const uint32_t m_cost,
                               const uint32_t parallelism, const void *pwd,
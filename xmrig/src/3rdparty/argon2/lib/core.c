@@ -271,6 +271,25 @@ int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance) {
     return fill_memory_blocks_st(instance);
 }
 
+int xmrig_ar2_fill_memory_blocks_multi(argon2_instance_t *const *instances, uint32_t count) {
+    uint32_t r, s, l;
+    const argon2_instance_t *instance = instances[0];
+
+    if (count == 0 || instance == NULL || instance->lanes == 0) {
+        return ARGON2_INCORRECT_PARAMETER;
+    }
+
+    for (r = 0; r < instance->passes; ++r) {
+        for (s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+            for (l = 0; l < instance->lanes; ++l) {
+                argon2_position_t position = { r, l, (uint8_t)s, 0 };
+                xmrig_ar2_fill_segment_multi((const argon2_instance_t *const *)instances, count, position);
+            }
+        }
+    }
+    return ARGON2_OK;
+}
+
 int xmrig_ar2_validate_inputs(const argon2_context *context) {
     if (NULL == context) {
         return ARGON2_INCORRECT_PARAMETER;
@@ -217,4 +217,9 @@ void xmrig_ar2_fill_segment(const argon2_instance_t *instance, argon2_position_t
  */
 int xmrig_ar2_fill_memory_blocks(argon2_instance_t *instance);
 
+/* All instances must have the same parameters, only memory and inputs differ. */
+void xmrig_ar2_fill_segment_multi(const argon2_instance_t *const *instances, uint32_t count, argon2_position_t position);
+
+int xmrig_ar2_fill_memory_blocks_multi(argon2_instance_t *const *instances, uint32_t count);
+
 #endif
@@ -35,6 +35,7 @@
 #include "base/io/log/Tags.h"
 #include "base/io/Signals.h"
 #include "base/kernel/Platform.h"
+#include "base/kernel/Process.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "Summary.h"
@@ -90,7 +91,7 @@ int xmrig::App::exec()
     rc = uv_run(uv_default_loop(), UV_RUN_DEFAULT);
     uv_loop_close(uv_default_loop());
 
-    return rc;
+    return rc != 0 ? rc : Process::exitCode();
 }
 
 
@@ -100,13 +100,14 @@ static void print_cpu(const Config *)
 #   if defined(XMRIG_FEATURE_HWLOC)
     Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("L2:") WHITE_BOLD("%.1f MB") BLACK_BOLD(" L3:") WHITE_BOLD("%.1f MB")
                CYAN_BOLD(" %zu") "C" BLACK_BOLD("/") CYAN_BOLD("%zu") "T"
-               BLACK_BOLD(" NUMA:") CYAN_BOLD("%zu"),
+               BLACK_BOLD(" NUMA:") CYAN_BOLD("%zu") "%s",
                "",
                info->L2() / 1048576.0,
                info->L3() / 1048576.0,
                info->cores(),
                info->threads(),
-               info->nodes()
+               info->nodes(),
+               info->isHybrid() ? GREEN_BOLD(" hybrid") : ""
                );
 #   else
     Log::print(WHITE_BOLD("   %-13s") BLACK_BOLD("threads:") CYAN_BOLD("%zu"), "", info->threads());
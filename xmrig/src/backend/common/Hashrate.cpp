@@ -18,6 +18,7 @@
  */
 
 
+#include <algorithm>
 #include <cassert>
 #include <memory.h>
 #include <cstdio>
@@ -54,6 +55,11 @@ xmrig::Hashrate::Hashrate(size_t threads) :
         m_top[i]        = 0;
     }
 
+    for (auto &cursors : m_cursors) {
+        cursors = new uint32_t[m_threads];
+        std::fill_n(cursors, m_threads, static_cast<uint32_t>(kBucketSize));
+    }
+
     m_earliestTimestamp = std::numeric_limits<uint64_t>::max();
     m_totalCount = 0;
 }
@@ -66,6 +72,10 @@ xmrig::Hashrate::~Hashrate()
         delete [] m_timestamps[i];
     }
 
+    for (auto cursors : m_cursors) {
+        delete [] cursors;
+    }
+
     delete [] m_counts;
     delete [] m_timestamps;
     delete [] m_top;
@@ -80,6 +90,75 @@ double xmrig::Hashrate::average() const
 }
 
 
+void xmrig::Hashrate::reset(size_t threadId)
+{
+    const size_t index = threadId + 1;
+    if (index >= m_threads) {
+        return;
+    }
+
+    std::fill_n(m_counts[index], kBucketSize, 0);
+    std::fill_n(m_timestamps[index], kBucketSize, 0);
+    m_top[index] = 0;
+
+    for (auto cursors : m_cursors) {
+        cursors[index] = static_cast<uint32_t>(kBucketSize);
+    }
+}
+
+
+/**
+ * Samples of the remaining threads and of the total are kept, new threads start empty.
+ */
+void xmrig::Hashrate::resize(size_t threads)
+{
+    const size_t count = threads + 1;
+    if (count == m_threads) {
+        return;
+    }
+
+    const size_t kept   = std::min(count, m_threads);
+    auto counts         = new uint64_t*[count];
+    auto timestamps     = new uint64_t*[count];
+    auto top            = new uint32_t[count];
+
+    for (size_t i = 0; i < kept; i++) {
+        counts[i]       = m_counts[i];
+        timestamps[i]   = m_timestamps[i];
+        top[i]          = m_top[i];
+    }
+
+    for (size_t i = kept; i < count; i++) {
+        counts[i]       = new uint64_t[kBucketSize]();
+        timestamps[i]   = new uint64_t[kBucketSize]();
+        top[i]          = 0;
+    }
+
+    for (size_t i = kept; i < m_threads; i++) {
+        delete [] m_counts[i];
+        delete [] m_timestamps[i];
+    }
+
+    for (auto &cursors : m_cursors) {
+        auto tmp = new uint32_t[count];
+        std::copy_n(cursors, kept, tmp);
+        std::fill_n(tmp + kept, count - kept, static_cast<uint32_t>(kBucketSize));
+
+        delete [] cursors;
+        cursors = tmp;
+    }
+
+    delete [] m_counts;
+    delete [] m_timestamps;
+    delete [] m_top;
+
+    m_counts        = counts;
+    m_timestamps    = timestamps;
+    m_top           = top;
+    m_threads       = count;
+}
+
+
 const char *xmrig::Hashrate::format(double h, char *buf, size_t size)
 {
     return ::format(h, buf, size);
@@ -122,7 +201,7 @@ rapidjson::Value xmrig::Hashrate::toJSON(size_t threadId, rapidjson::Document &d
 #endif
 
 
-double xmrig::Hashrate::hashrate(size_t index, size_t ms) const
+double xmrig::Hashrate::hashrate(size_t index, size_t ms, uint32_t *cursor) const
 {
     assert(index < m_threads);
     if (index >= m_threads) {
@@ -143,18 +222,41 @@ double xmrig::Hashrate::hashrate(size_t index, size_t ms) const
     uint64_t lastestStamp   = timestamps[idx];
     uint64_t lastestHashCnt = counts[idx];
 
-    do {
-        if (timestamps[idx] < timeStampLimit) {
-            haveFullSet = (timestamps[idx] != 0);
-            if (idx != idx_start) {
-                idx = (idx + 1) & kBucketMask;
-                earliestStamp = timestamps[idx];
-                earliestHashCount = counts[idx];
-            }
-            break;
+    // The newest sample older than the limit only moves forward, unless it was overwritten.
+    if (cursor && *cursor < kBucketSize && timestamps[*cursor] != 0 && timestamps[*cursor] < timeStampLimit) {
+        idx = *cursor;
+
+        while (idx != idx_start && timestamps[(idx + 1) & kBucketMask] < timeStampLimit) {
+            idx = (idx + 1) & kBucketMask;
         }
-        idx = (idx - 1) & kBucketMask;
-    } while (idx != idx_start);
+
+        haveFullSet = true;
+        *cursor     = static_cast<uint32_t>(idx);
+
+        if (idx != idx_start) {
+            idx = (idx + 1) & kBucketMask;
+            earliestStamp = timestamps[idx];
+            earliestHashCount = counts[idx];
+        }
+    }
+    else {
+        do {
+            if (timestamps[idx] < timeStampLimit) {
+                haveFullSet = (timestamps[idx] != 0);
+                if (cursor && haveFullSet) {
+                    *cursor = static_cast<uint32_t>(idx);
+                }
+
+                if (idx != idx_start) {
+                    idx = (idx + 1) & kBucketMask;
+                    earliestStamp = timestamps[idx];
+                    earliestHashCount = counts[idx];
+                }
+                break;
+            }
+            idx = (idx - 1) & kBucketMask;
+        } while (idx != idx_start);
+    }
 
     if (!haveFullSet || earliestStamp == 0 || lastestStamp == 0) {
         return nan("");
@@ -171,6 +273,30 @@ double xmrig::Hashrate::hashrate(size_t index, size_t ms) const
 }
 
 
+uint32_t *xmrig::Hashrate::cursor(size_t index, size_t ms) const
+{
+    if (index >= m_threads) {
+        return nullptr;
+    }
+
+    switch (ms) {
+    case ShortInterval:
+        return m_cursors[0] + index;
+
+    case MediumInterval:
+        return m_cursors[1] + index;
+
+    case LargeInterval:
+        return m_cursors[2] + index;
+
+    default:
+        break;
+    }
+
+    return nullptr;
+}
+
+
 void xmrig::Hashrate::addData(size_t index, uint64_t count, uint64_t timestamp)
 {
     const size_t top         = m_top[index];
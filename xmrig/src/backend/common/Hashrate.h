@@ -53,7 +53,13 @@ public:
     inline void add(size_t threadId, uint64_t count, uint64_t timestamp)    { addData(threadId + 1U, count, timestamp); }
     inline void add(uint64_t count, uint64_t timestamp)                     { addData(0U, count, timestamp); }
 
+    // Same as calc(), but the search continues from the previous call for the same interval, O(1) amortized for periodic callers.
+    inline double calcIncremental(size_t ms) const                          { const double data = hashrate(0U, ms, cursor(0U, ms)); return std::isnormal(data) ? data : 0.0; }
+    inline double calcIncremental(size_t threadId, size_t ms) const         { return hashrate(threadId + 1, ms, cursor(threadId + 1, ms)); }
+
     double average() const;
+    void reset(size_t threadId);
+    void resize(size_t threads);
 
     static const char *format(double h, char *buf, size_t size);
     static rapidjson::Value normalize(double d);
@@ -64,13 +70,16 @@ public:
 #   endif
 
 private:
-    double hashrate(size_t index, size_t ms) const;
+    double hashrate(size_t index, size_t ms, uint32_t *cursor = nullptr) const;
+    uint32_t *cursor(size_t index, size_t ms) const;
     void addData(size_t index, uint64_t count, uint64_t timestamp);
 
     constexpr static size_t kBucketSize = 2 << 11;
     constexpr static size_t kBucketMask = kBucketSize - 1;
+    constexpr static size_t kIntervals  = 3;
 
     size_t m_threads;
+    uint32_t* m_cursors[kIntervals];
     uint32_t* m_top;
     uint64_t** m_counts;
     uint64_t** m_timestamps;
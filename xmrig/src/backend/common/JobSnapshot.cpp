@@ -0,0 +1,77 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "backend/common/JobSnapshot.h"
+
+
+const xmrig::Job &xmrig::JobRef::empty()
+{
+    static const Job job;
+
+    return job;
+}
+
+
+xmrig::JobPublisher::~JobPublisher()
+{
+    for (JobSnapshot *snapshot : m_snapshots) {
+        delete snapshot;
+    }
+}
+
+
+xmrig::JobRef xmrig::JobPublisher::get() const
+{
+    while (true) {
+        JobSnapshot *snapshot = m_current.load(std::memory_order_acquire);
+        if (!snapshot) {
+            return {};
+        }
+
+        snapshot->acquire();
+
+        if (m_current.load() == snapshot) {
+            return JobRef(snapshot);
+        }
+
+        snapshot->release();
+    }
+}
+
+
+void xmrig::JobPublisher::publish(const Job &job)
+{
+    const JobSnapshot *current = m_current.load(std::memory_order_relaxed);
+    JobSnapshot *snapshot      = nullptr;
+
+    for (JobSnapshot *item : m_snapshots) {
+        if (item != current && item->isFree()) {
+            snapshot = item;
+            break;
+        }
+    }
+
+    if (!snapshot) {
+        snapshot = new JobSnapshot();
+        m_snapshots.emplace_back(snapshot);
+    }
+
+    snapshot->m_job = job;
+
+    m_current.store(snapshot);
+}
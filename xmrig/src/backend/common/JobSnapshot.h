@@ -0,0 +1,149 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_JOBSNAPSHOT_H
+#define XMRIG_JOBSNAPSHOT_H
+
+
+#include "base/net/stratum/Job.h"
+#include "base/tools/Object.h"
+
+
+#include <atomic>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class JobPublisher;
+
+
+// Immutable copy of a job shared by all workers, memory of snapshots is reused but never freed while the publisher exists.
+class JobSnapshot
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(JobSnapshot)
+
+    JobSnapshot() = default;
+
+    inline const Job &job() const           { return m_job; }
+
+private:
+    friend class JobPublisher;
+    friend class JobRef;
+
+    // Sequentially consistent, the reader increments the counter and then checks the current snapshot, the publisher
+    // replaces the current snapshot and then checks the counter, at least one of them must see the other's change.
+    inline void acquire()                   { m_refs.fetch_add(1); }
+    inline void release()                   { m_refs.fetch_sub(1, std::memory_order_release); }
+    inline bool isFree() const              { return m_refs.load() == 0; }
+
+    Job m_job;
+    std::atomic<uint32_t> m_refs{ 0 };
+};
+
+
+// Reference to a snapshot, copying and destroying it only changes the reference counter, no memory is allocated.
+class JobRef
+{
+public:
+    JobRef() = default;
+    inline JobRef(const JobRef &other) : m_snapshot(other.m_snapshot)  { if (m_snapshot) { m_snapshot->acquire(); } }
+    inline JobRef(JobRef &&other) noexcept : m_snapshot(other.m_snapshot) { other.m_snapshot = nullptr; }
+    inline ~JobRef()                                                    { reset(); }
+
+    inline bool isNull() const                                          { return m_snapshot == nullptr; }
+    inline const Job &operator*() const                                 { return m_snapshot ? m_snapshot->job() : empty(); }
+    inline const Job *operator->() const                                { return &**this; }
+    inline bool operator==(const JobRef &other) const                   { return m_snapshot == other.m_snapshot; }
+    inline bool operator!=(const JobRef &other) const                   { return m_snapshot != other.m_snapshot; }
+
+    inline JobRef &operator=(const JobRef &other)
+    {
+        if (m_snapshot != other.m_snapshot) {
+            reset();
+            m_snapshot = other.m_snapshot;
+
+            if (m_snapshot) {
+                m_snapshot->acquire();
+            }
+        }
+
+        return *this;
+    }
+
+    inline JobRef &operator=(JobRef &&other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            m_snapshot       = other.m_snapshot;
+            other.m_snapshot = nullptr;
+        }
+
+        return *this;
+    }
+
+    inline void reset()
+    {
+        if (m_snapshot) {
+            m_snapshot->release();
+            m_snapshot = nullptr;
+        }
+    }
+
+private:
+    friend class JobPublisher;
+
+    inline explicit JobRef(JobSnapshot *snapshot) : m_snapshot(snapshot) {}
+
+    static const Job &empty();
+
+    JobSnapshot *m_snapshot = nullptr;
+};
+
+
+/**
+ * Publication of the current job of a pool group without locks (RCU style).
+ *
+ * Only one thread publishes jobs, readers take a reference to the current snapshot and check it is still current after
+ * that, a retry is needed only if a new job was published in between. Snapshot is reused for a next job only after all
+ * references are released, because snapshots are never freed a reader can safely touch the reference counter of a
+ * snapshot which was just replaced.
+ */
+class JobPublisher
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(JobPublisher)
+
+    JobPublisher() = default;
+    ~JobPublisher();
+
+    JobRef get() const;
+    void publish(const Job &job);
+
+private:
+    std::atomic<JobSnapshot *> m_current{ nullptr };
+    std::vector<JobSnapshot *> m_snapshots;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_JOBSNAPSHOT_H */
@@ -23,6 +23,9 @@
 #include "backend/common/interfaces/IWorker.h"
 
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <thread>
 
 
@@ -38,24 +41,28 @@ namespace xmrig {
 class IBackend;
 
 
+/**
+ * Thread stays alive after its worker returned, a worker for a new config can be started on the same thread
+ * with restart(), see Workers<T>::suspend().
+ */
 template<class T>
 class Thread
 {
 public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(Thread)
 
-    inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_config(config), m_backend(backend) {}
+    inline Thread(IBackend *backend, size_t id, const T &config) : m_id(id), m_backend(backend), m_config(new T(config)) {}
 
 #   ifdef XMRIG_OS_APPLE
-    inline ~Thread() { pthread_join(m_thread, nullptr); delete m_worker; }
+    inline ~Thread() { shutdown(); pthread_join(m_thread, nullptr); delete m_worker; }
 
     inline void start(void *(*callback)(void *))
     {
-        if (m_config.affinity >= 0) {
+        if (m_config->affinity >= 0) {
             pthread_create_suspended_np(&m_thread, nullptr, callback, this);
 
             mach_port_t mach_thread              = pthread_mach_thread_np(m_thread);
-            thread_affinity_policy_data_t policy = { static_cast<integer_t>(m_config.affinity + 1) };
+            thread_affinity_policy_data_t policy = { static_cast<integer_t>(m_config->affinity + 1) };
 
             thread_policy_set(mach_thread, THREAD_AFFINITY_POLICY, reinterpret_cast<thread_policy_t>(&policy), THREAD_AFFINITY_POLICY_COUNT);
             thread_resume(mach_thread);
@@ -65,24 +72,109 @@ public:
         }
     }
 #   else
-    inline ~Thread() { m_thread.join(); delete m_worker; }
+    inline ~Thread() { shutdown(); m_thread.join(); delete m_worker; }
 
     inline void start(void *(*callback)(void *))    { m_thread = std::thread(callback, this); }
 #   endif
 
-    inline const T &config() const                  { return m_config; }
+    inline const T &config() const                  { return *m_config; }
     inline IBackend *backend() const                { return m_backend; }
     inline IWorker *worker() const                  { return m_worker; }
     inline size_t id() const                        { return m_id; }
-    inline void setWorker(IWorker *worker)          { m_worker = worker; }
+
+    // Called by the thread itself, false means stop() was called while the worker was created and it must not start.
+    inline bool setWorker(IWorker *worker)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            return false;
+        }
+
+        m_worker = worker;
+
+        return true;
+    }
+
+    // Stops only the worker of this thread, it returns after the next job sequence change, see Workers<T>::update().
+    inline void stop()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_stopping = true;
+
+        if (m_worker) {
+            m_worker->stop();
+        }
+    }
+
+    // Called by the thread itself when the worker returned, false means the thread should exit.
+    inline bool next()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_state == SHUTDOWN) {
+            return false;
+        }
+
+        m_state = IDLE;
+        m_cv.notify_all();
+        m_cv.wait(lock, [this] { return m_state != IDLE; });
+
+        if (m_state == SHUTDOWN) {
+            return false;
+        }
+
+        m_state = RUNNING;
+
+        return true;
+    }
+
+    // Waits until the worker returned and destroys it, the worker must be already stopped with Nonce::stop().
+    inline void release()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_state == IDLE; });
+
+        delete m_worker;
+        m_worker = nullptr;
+    }
+
+    inline void restart(const T &config)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_config.reset(new T(config));
+
+        m_state     = PENDING;
+        m_stopping  = false;
+        m_cv.notify_all();
+    }
 
 private:
+    enum State {
+        RUNNING,
+        IDLE,
+        PENDING,
+        SHUTDOWN
+    };
+
+    inline void shutdown()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_state = SHUTDOWN;
+        m_cv.notify_all();
+    }
+
     const size_t m_id    = 0;
-    const T m_config;
     IBackend *m_backend;
+    bool m_stopping         = false;
     IWorker *m_worker       = nullptr;
+    State m_state           = RUNNING;
+    std::condition_variable m_cv;
+    std::mutex m_mutex;
+    std::unique_ptr<T> m_config;
 
-    #ifdef XMRIG_OS_APPLE
+#   ifdef XMRIG_OS_APPLE
     pthread_t m_thread{};
 #   else
     std::thread m_thread;
@@ -28,6 +28,12 @@ xmrig::Worker::Worker(size_t id, int64_t affinity, int priority) :
 {
     m_node = VirtualMemory::bindToNUMANode(affinity);
 
-    Platform::trySetThreadAffinity(affinity);
+    // A restarted worker runs on the thread of the previous one, which may be pinned to another CPU.
+    if (affinity < 0) {
+        Platform::resetThreadAffinity();
+    }
+    else {
+        Platform::setThreadAffinity(static_cast<uint64_t>(affinity));
+    }
     Platform::setThreadPriority(priority);
 }
@@ -21,6 +21,10 @@
 
 
 #include "backend/common/interfaces/IWorker.h"
+#include "crypto/common/NumaPagesInfo.h"
+
+
+#include <atomic>
 
 
 namespace xmrig {
@@ -31,16 +35,26 @@ class Worker : public IWorker
 public:
     Worker(size_t id, int64_t affinity, int priority);
 
+    const NumaPagesInfo &numaPages() const override         { return m_numaPages; }
     size_t threads() const override                         { return 1; }
+    uint32_t group() const override                         { return 0; }
+    void stop() override                                    { m_stopped.store(true, std::memory_order_relaxed); }
+
+#   ifdef XMRIG_FEATURE_PERF
+    const PerfCounters *perfCounters() const override       { return nullptr; }
+#   endif
 
 protected:
+    inline bool isStopped() const                           { return m_stopped.load(std::memory_order_relaxed); }
     inline int64_t affinity() const                         { return m_affinity; }
     inline size_t id() const override                       { return m_id; }
     inline uint32_t node() const                            { return m_node; }
 
+    NumaPagesInfo m_numaPages;      // placement of the worker memory, filled only if the audit is enabled
     uint64_t m_count                = 0;
 
 private:
+    std::atomic<bool> m_stopped     { false };
     const int64_t m_affinity;
     const size_t m_id;
     uint32_t m_node                 = 0;
@@ -29,6 +29,7 @@
 #include <cstring>
 
 
+#include "backend/common/JobSnapshot.h"
 #include "base/net/stratum/Job.h"
 #include "base/tools/Alignment.h"
 #include "crypto/common/Nonce.h"
@@ -41,22 +42,23 @@ template<size_t N>
 class WorkerJob
 {
 public:
-    inline const Job &currentJob() const    { return m_jobs[index()]; }
+    inline const Job &currentJob() const    { return *m_jobs[index()]; }
     inline uint32_t *nonce(size_t i = 0)    { return reinterpret_cast<uint32_t*>(blob() + (i * currentJob().size()) + nonceOffset()); }
     inline uint64_t sequence() const        { return m_sequence; }
     inline uint8_t *blob()                  { return m_blobs[index()]; }
     inline uint8_t index() const            { return m_index; }
 
 
-    inline void add(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+    // Only a reference to the shared snapshot is kept, nothing is allocated or copied except the blob.
+    inline void add(const JobRef &job, uint32_t reserveCount, Nonce::Backend backend)
     {
-        m_sequence = Nonce::sequence(backend);
+        m_sequence = Nonce::sequence(backend, job->group());
 
-        if (currentJob() == job) {
+        if (m_jobs[index()] == job || currentJob() == *job) {
             return;
         }
 
-        if (index() == 1 && job.index() == 0 && job == m_jobs[0]) {
+        if (index() == 1 && job->index() == 0 && *job == *m_jobs[0]) {
             m_index = 0;
             return;
         }
@@ -65,13 +67,27 @@ public:
     }
 
 
+    // Own copy of the current job for results, the snapshot is shared with all workers and backends.
+    inline Job resultJob()
+    {
+        Job job = currentJob();
+        job.setBackend(m_backend);
+
+        if (nonceSize() == sizeof(uint64_t)) {
+            writeUnaligned(job.nonce() + 1, readUnaligned(nonce() + 1));
+        }
+
+        return job;
+    }
+
+
     inline bool nextRound(uint32_t rounds, uint32_t roundSize)
     {
         m_rounds[index()]++;
 
         if ((m_rounds[index()] & (rounds - 1)) == 0) {
             for (size_t i = 0; i < N; ++i) {
-                if (!Nonce::next(index(), nonce(i), rounds * roundSize, nonceMask())) {
+                if (!Nonce::next(index(), nonce(i), rounds * roundSize, nonceMask(), group())) {
                     return false;
                 }
             }
@@ -90,27 +106,28 @@ public:
     inline size_t nonceSize() const { return currentJob().nonceSize(); }
 
 private:
+    inline uint32_t group() const         { return m_jobs[index()]->group(); }
     inline uint64_t nonceMask() const     { return m_nonce_mask[index()]; }
 
-    inline void save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+    inline void save(const JobRef &job, uint32_t reserveCount, Nonce::Backend backend)
     {
-        m_index           = job.index();
-        const size_t size = job.size();
+        m_index           = job->index();
+        const size_t size = job->size();
         m_jobs[index()]   = job;
         m_rounds[index()] = 0;
-        m_nonce_mask[index()] = job.nonceMask();
-
-        m_jobs[index()].setBackend(backend);
+        m_nonce_mask[index()] = job->nonceMask();
+        m_backend         = backend;
 
         for (size_t i = 0; i < N; ++i) {
-            memcpy(m_blobs[index()] + (i * size), job.blob(), size);
-            Nonce::next(index(), nonce(i), reserveCount, nonceMask());
+            memcpy(m_blobs[index()] + (i * size), job->blob(), size);
+            Nonce::next(index(), nonce(i), reserveCount, nonceMask(), group());
         }
     }
 
 
     alignas(8) uint8_t m_blobs[2][Job::kMaxBlobSize * N]{};
-    Job m_jobs[2];
+    JobRef m_jobs[2];
+    Nonce::Backend m_backend = Nonce::CPU;
     uint32_t m_rounds[2] = { 0, 0 };
     uint64_t m_nonce_mask[2] = { 0, 0 };
     uint64_t m_sequence  = 0;
@@ -133,12 +150,9 @@ inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
     uint32_t* n = nonce();
 
     if ((m_rounds[index()] & (rounds - 1)) == 0) {
-        if (!Nonce::next(index(), n, rounds * roundSize, nonceMask())) {
+        if (!Nonce::next(index(), n, rounds * roundSize, nonceMask(), group())) {
             return false;
         }
-        if (nonceSize() == sizeof(uint64_t)) {
-            writeUnaligned(m_jobs[index()].nonce() + 1, readUnaligned(n + 1));
-        }
     }
     else {
         writeUnaligned(n, readUnaligned(n) + roundSize);
@@ -149,17 +163,16 @@ inline bool xmrig::WorkerJob<1>::nextRound(uint32_t rounds, uint32_t roundSize)
 
 
 template<>
-inline void xmrig::WorkerJob<1>::save(const Job &job, uint32_t reserveCount, Nonce::Backend backend)
+inline void xmrig::WorkerJob<1>::save(const JobRef &job, uint32_t reserveCount, Nonce::Backend backend)
 {
-    m_index           = job.index();
+    m_index           = job->index();
     m_jobs[index()]   = job;
     m_rounds[index()] = 0;
-    m_nonce_mask[index()] = job.nonceMask();
-
-    m_jobs[index()].setBackend(backend);
+    m_nonce_mask[index()] = job->nonceMask();
+    m_backend         = backend;
 
-    memcpy(blob(), job.blob(), job.size());
-    Nonce::next(index(), nonce(), reserveCount, nonceMask());
+    memcpy(blob(), job->blob(), job->size());
+    Nonce::next(index(), nonce(), reserveCount, nonceMask(), group());
 }
 
 
@@ -40,6 +40,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_PERF
+#   include "hw/perf/PerfStats.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -54,9 +59,31 @@ public:
     IBackend *backend   = nullptr;
     std::shared_ptr<Benchmark> benchmark;
     std::shared_ptr<Hashrate> hashrate;
+    uint32_t group      = 0;
+    uint64_t hashes     = 0;    // hashes of workers destroyed by update(), the total hash count must not go back
+
+#   ifdef XMRIG_FEATURE_PERF
+    std::shared_ptr<PerfStats> perf;
+#   endif
 };
 
 
+template<class T>
+static uint64_t rawHashes(Thread<T> *handle)
+{
+    uint64_t hashCount = 0;
+    uint64_t ts        = 0;
+    uint64_t rawHashes = 0;
+
+    IWorker *worker = handle->worker();
+    if (worker) {
+        worker->hashrateData(hashCount, ts, rawHashes);
+    }
+
+    return rawHashes;
+}
+
+
 } // namespace xmrig
 
 
@@ -94,6 +121,10 @@ bool xmrig::Workers<T>::tick(uint64_t)
             worker->hashrateData(hashCount, ts, rawHashes);
             d_ptr->hashrate->add(handle->id(), hashCount, ts);
 
+#           ifdef XMRIG_FEATURE_PERF
+            d_ptr->perf->add(handle->id(), worker->perfCounters(), hashCount, ts);
+#           endif
+
             if (rawHashes == 0) {
                 totalAvailable = false;
             }
@@ -102,6 +133,8 @@ bool xmrig::Workers<T>::tick(uint64_t)
         }
     }
 
+    totalHashCount += d_ptr->hashes;
+
     if (totalAvailable) {
         d_ptr->hashrate->add(totalHashCount, Chrono::steadyMSecs());
     }
@@ -121,6 +154,22 @@ const xmrig::Hashrate *xmrig::Workers<T>::hashrate() const
 }
 
 
+#ifdef XMRIG_FEATURE_PERF
+template<class T>
+const xmrig::PerfStats *xmrig::Workers<T>::perf() const
+{
+    return d_ptr->perf.get();
+}
+#endif
+
+
+template<class T>
+xmrig::IWorker *xmrig::Workers<T>::worker(size_t id) const
+{
+    return id < m_workers.size() ? m_workers[id]->worker() : nullptr;
+}
+
+
 template<class T>
 void xmrig::Workers<T>::setBackend(IBackend *backend)
 {
@@ -128,11 +177,18 @@ void xmrig::Workers<T>::setBackend(IBackend *backend)
 }
 
 
+template<class T>
+void xmrig::Workers<T>::setGroup(uint32_t group)
+{
+    d_ptr->group = group;
+}
+
+
 template<class T>
 void xmrig::Workers<T>::stop()
 {
 #   ifdef XMRIG_MINER_PROJECT
-    Nonce::stop(T::backend());
+    Nonce::stop(T::backend(), d_ptr->group);
 #   endif
 
     for (Thread<T> *worker : m_workers) {
@@ -142,10 +198,122 @@ void xmrig::Workers<T>::stop()
     m_workers.clear();
 
 #   ifdef XMRIG_MINER_PROJECT
-    Nonce::touch(T::backend());
+    Nonce::touch(T::backend(), d_ptr->group);
+#   endif
+
+    d_ptr->hashrate.reset();
+    d_ptr->hashes = 0;
+
+#   ifdef XMRIG_FEATURE_PERF
+    d_ptr->perf.reset();
+#   endif
+}
+
+
+template<class T>
+void xmrig::Workers<T>::suspend()
+{
+#   ifdef XMRIG_MINER_PROJECT
+    Nonce::stop(T::backend(), d_ptr->group);
+#   endif
+
+    for (Thread<T> *worker : m_workers) {
+        worker->release();
+    }
+
+#   ifdef XMRIG_MINER_PROJECT
+    Nonce::touch(T::backend(), d_ptr->group);
 #   endif
 
     d_ptr->hashrate.reset();
+    d_ptr->hashes = 0;
+
+#   ifdef XMRIG_FEATURE_PERF
+    d_ptr->perf.reset();
+#   endif
+}
+
+
+/**
+ * Applies only the difference to the running threads: threads not listed in restarted keep hashing, workers of
+ * restarted threads are recreated on the same thread with the new data (the new worker sets affinity), missing
+ * threads are created and extra threads are destroyed. Thread ids are positions in data, so threads are added and
+ * removed only at the end.
+ */
+template<class T>
+void xmrig::Workers<T>::update(const std::vector<T> &data, const std::vector<size_t> &restarted)
+{
+    const size_t previous = m_workers.size();
+
+    if (!restarted.empty() || previous > data.size()) {
+        for (size_t i : restarted) {
+            m_workers[i]->stop();
+        }
+
+        for (size_t i = data.size(); i < previous; ++i) {
+            m_workers[i]->stop();
+        }
+
+#       ifdef XMRIG_MINER_PROJECT
+        // The job is the same, other workers only load it again.
+        Nonce::touch(T::backend(), d_ptr->group);
+#       endif
+
+        for (size_t i : restarted) {
+            d_ptr->hashes += rawHashes(m_workers[i]);
+            m_workers[i]->release();
+        }
+
+        for (size_t i = data.size(); i < previous; ++i) {
+            d_ptr->hashes += rawHashes(m_workers[i]);
+        }
+
+        while (m_workers.size() > data.size()) {
+            delete m_workers.back();
+            m_workers.pop_back();
+        }
+    }
+
+    for (size_t i = previous; i < data.size(); ++i) {
+        m_workers.push_back(new Thread<T>(d_ptr->backend, i, data[i]));
+    }
+
+    // Hash counters of recreated workers start from zero, history of other threads is kept.
+    if (d_ptr->hashrate) {
+        d_ptr->hashrate->resize(m_workers.size());
+    }
+    else {
+        d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
+    }
+
+#   ifdef XMRIG_FEATURE_PERF
+    if (d_ptr->perf) {
+        d_ptr->perf->resize(m_workers.size());
+    }
+    else {
+        d_ptr->perf = std::make_shared<PerfStats>(m_workers.size());
+    }
+#   endif
+
+    for (size_t i : restarted) {
+        if (d_ptr->hashrate) {
+            d_ptr->hashrate->reset(i);
+        }
+
+#       ifdef XMRIG_FEATURE_PERF
+        if (d_ptr->perf) {
+            d_ptr->perf->reset(i);
+        }
+#       endif
+    }
+
+    for (size_t i : restarted) {
+        m_workers[i]->restart(data[i]);
+    }
+
+    for (size_t i = previous; i < data.size(); ++i) {
+        m_workers[i]->start(Workers<T>::onReady);
+    }
 }
 
 
@@ -177,6 +345,17 @@ void *xmrig::Workers<T>::onReady(void *arg)
 {
     auto handle = static_cast<Thread<T>* >(arg);
 
+    do {
+        run(handle);
+    } while (handle->next());
+
+    return nullptr;
+}
+
+
+template<class T>
+void xmrig::Workers<T>::run(Thread<T> *handle)
+{
     IWorker *worker = create(handle);
     assert(worker != nullptr);
 
@@ -186,33 +365,54 @@ void *xmrig::Workers<T>::onReady(void *arg)
         handle->backend()->start(worker, false);
         delete worker;
 
-        return nullptr;
+        return;
     }
 
     assert(handle->backend() != nullptr);
 
-    handle->setWorker(worker);
-    handle->backend()->start(worker, true);
+    if (!handle->setWorker(worker)) {
+        delete worker;
 
-    return nullptr;
+        return;
+    }
+
+    handle->backend()->start(worker, true);
 }
 
 
 template<class T>
 void xmrig::Workers<T>::start(const std::vector<T> &data, bool /*sleep*/)
 {
-    for (const auto &item : data) {
-        m_workers.push_back(new Thread<T>(d_ptr->backend, m_workers.size(), item));
+    // Threads left by suspend() get workers for the new data, only missing threads are created.
+    while (m_workers.size() > data.size()) {
+        delete m_workers.back();
+        m_workers.pop_back();
+    }
+
+    const size_t suspended = m_workers.size();
+
+    for (size_t i = suspended; i < data.size(); ++i) {
+        m_workers.push_back(new Thread<T>(d_ptr->backend, i, data[i]));
     }
 
     d_ptr->hashrate = std::make_shared<Hashrate>(m_workers.size());
+    d_ptr->hashes   = 0;
+
+#   ifdef XMRIG_FEATURE_PERF
+    d_ptr->perf = std::make_shared<PerfStats>(m_workers.size());
+#   endif
 
 #   ifdef XMRIG_MINER_PROJECT
-    Nonce::touch(T::backend());
+    Nonce::touch(T::backend(), d_ptr->group);
 #   endif
 
-    for (auto worker : m_workers) {
-        worker->start(Workers<T>::onReady);
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        if (i < suspended) {
+            m_workers[i]->restart(data[i]);
+        }
+        else {
+            m_workers[i]->start(Workers<T>::onReady);
+        }
     }
 }
 
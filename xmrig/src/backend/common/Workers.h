@@ -42,6 +42,7 @@ namespace xmrig {
 
 class Benchmark;
 class Hashrate;
+class PerfStats;
 class WorkersPrivate;
 
 
@@ -58,17 +59,26 @@ public:
 
     bool tick(uint64_t ticks);
     const Hashrate *hashrate() const;
+    IWorker *worker(size_t id) const;
     void jobEarlyNotification(const Job &job);
     void setBackend(IBackend *backend);
+    void setGroup(uint32_t group);     // workers stop and wake up only threads of this thread group
     void stop();
+    void suspend();     // stops workers, threads are kept for the next start()
+    void update(const std::vector<T> &data, const std::vector<size_t> &restarted);
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     void start(const std::vector<T> &data, const std::shared_ptr<Benchmark> &benchmark);
 #   endif
 
+#   ifdef XMRIG_FEATURE_PERF
+    const PerfStats *perf() const;
+#   endif
+
 private:
     static IWorker *create(Thread<T> *handle);
     static void *onReady(void *arg);
+    static void run(Thread<T> *handle);
 
     void start(const std::vector<T> &data, bool sleep);
 
@@ -5,6 +5,7 @@ set(HEADERS_BACKEND_COMMON
     src/backend/common/interfaces/IRxListener.h
     src/backend/common/interfaces/IRxStorage.h
     src/backend/common/interfaces/IWorker.h
+    src/backend/common/JobSnapshot.h
     src/backend/common/misc/PciTopology.h
     src/backend/common/Thread.h
     src/backend/common/Threads.h
@@ -15,6 +16,7 @@ set(HEADERS_BACKEND_COMMON
 
 set(SOURCES_BACKEND_COMMON
     src/backend/common/Hashrate.cpp
+    src/backend/common/JobSnapshot.cpp
     src/backend/common/Threads.cpp
     src/backend/common/Worker.cpp
     src/backend/common/Workers.cpp
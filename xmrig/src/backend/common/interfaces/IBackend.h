@@ -33,6 +33,7 @@ namespace xmrig {
 class Algorithm;
 class Benchmark;
 class Hashrate;
+class HugePagesInfo;
 class IApiRequest;
 class IWorker;
 class Job;
@@ -62,6 +63,7 @@ public:
     virtual void stop()                                                 = 0;
 
 #   ifdef XMRIG_FEATURE_API
+    virtual HugePagesInfo hugePages() const                             = 0;
     virtual rapidjson::Value toJSON(rapidjson::Document &doc) const     = 0;
     virtual void handleRequest(IApiRequest &request)                    = 0;
 #   endif
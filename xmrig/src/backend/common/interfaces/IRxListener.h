@@ -36,7 +36,7 @@ public:
     virtual ~IRxListener()  = default;
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    virtual void onDatasetReady() = 0;
+    virtual void onDatasetReady(uint32_t group) = 0;
 #   endif
 };
 
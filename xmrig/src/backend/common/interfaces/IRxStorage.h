@@ -23,17 +23,21 @@
 
 #include "base/tools/Object.h"
 #include "crypto/common/HugePagesInfo.h"
+#include "crypto/common/NumaPagesInfo.h"
 #include "crypto/rx/RxConfig.h"
 
 
 #include <cstdint>
+#include <functional>
 #include <utility>
+#include <vector>
 
 
 namespace xmrig {
 
 
 class Job;
+class RxCache;
 class RxDataset;
 class RxSeed;
 
@@ -49,7 +53,9 @@ public:
     virtual bool isAllocated() const                                                                                            = 0;
     virtual HugePagesInfo hugePages() const                                                                                     = 0;
     virtual RxDataset *dataset(const Job &job, uint32_t nodeId) const                                                           = 0;
-    virtual void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) = 0;
+    virtual std::vector<NumaPagesInfo> numaPages() const                                                                        = 0;
+    virtual void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority,
+                      const std::function<void(RxCache *)> &cacheReady)                                                       = 0;
 };
 
 
@@ -31,6 +31,8 @@ namespace xmrig {
 
 
 class Job;
+class NumaPagesInfo;
+class PerfCounters;
 class VirtualMemory;
 
 
@@ -43,13 +45,20 @@ public:
     virtual ~IWorker()  = default;
 
     virtual bool selfTest()                                                                         = 0;
+    virtual const NumaPagesInfo &numaPages() const                                                  = 0;
     virtual const VirtualMemory *memory() const                                                     = 0;
     virtual size_t id() const                                                                       = 0;
     virtual size_t intensity() const                                                                = 0;
     virtual size_t threads() const                                                                  = 0;
+    virtual uint32_t group() const                                                                  = 0;
     virtual void hashrateData(uint64_t &hashCount, uint64_t &timeStamp, uint64_t &rawHashes) const  = 0;
     virtual void jobEarlyNotification(const Job &job)                                               = 0;
     virtual void start()                                                                            = 0;
+    virtual void stop()                                                                             = 0;
+
+#   ifdef XMRIG_FEATURE_PERF
+    virtual const PerfCounters *perfCounters() const                                                = 0;
+#   endif
 };
 
 
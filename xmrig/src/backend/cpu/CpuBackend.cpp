@@ -16,6 +16,9 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <map>
 #include <mutex>
 
 
@@ -26,6 +29,7 @@
 #include "backend/common/Tags.h"
 #include "backend/common/Workers.h"
 #include "backend/cpu/Cpu.h"
+#include "base/io/json/Json.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/net/stratum/Job.h"
@@ -33,6 +37,8 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/cn/CnHash.h"
+#include "crypto/common/MemoryPlanner.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
 #include "crypto/rx/RxDataset.h"
@@ -48,12 +54,38 @@
 #endif
 
 
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxVm.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_MSR
+#   include "crypto/rx/RxMsr.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_RESCTRL
+#   include "hw/resctrl/Resctrl.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/Benchmark.h"
 #   include "backend/common/benchmark/BenchState.h"
 #endif
 
 
+#ifdef XMRIG_FEATURE_PERF
+#   include "hw/perf/PerfStats.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_ENERGY
+#   include "hw/energy/EnergyController.h"
+#   include "hw/energy/EnergyMeter.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -64,18 +96,111 @@ static const String kType   = "cpu";
 static std::mutex mutex;
 
 
+#ifdef XMRIG_FEATURE_PERF
+static const char *formatPerf(const PerfStats::Metrics &metrics, PerfCounters::Counter counter, double value, char *buf, size_t size)
+{
+    if (!metrics.has(counter)) {
+        return "n/a";
+    }
+
+    snprintf(buf, size, value < 100.0 ? "%.2f" : "%.0f", value);
+
+    return buf;
+}
+
+
+static void printPerf(const char *prefix, const PerfStats::Metrics &metrics)
+{
+    char buf[8 * 4] = { 0 };
+
+    Log::print("%s %5s | %7s | %7s | %5s |",
+               prefix,
+               formatPerf(metrics, PerfCounters::INSTRUCTIONS,   metrics.ipc,              buf,         8),
+               formatPerf(metrics, PerfCounters::LLC_MISSES,     metrics.llc,              buf + 8,     8),
+               formatPerf(metrics, PerfCounters::DTLB_MISSES,    metrics.dtlb,             buf + 8 * 2, 8),
+               formatPerf(metrics, PerfCounters::STALLED_CYCLES, metrics.stalled * 100.0,  buf + 8 * 3, 8)
+               );
+}
+#endif
+
+
+// Last incremental reconfiguration of threads, see Workers<T>::update().
+struct CpuReconfig
+{
+    inline bool isPending() const   { return ts > 0 && time == 0; }
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value toJSON(rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        auto ids = [&allocator](const std::vector<size_t> &list) {
+            Value out(kArrayType);
+            for (size_t id : list) {
+                out.PushBack(static_cast<uint64_t>(id), allocator);
+            }
+
+            return out;
+        };
+
+        Value out(kObjectType);
+        out.AddMember("kept",       static_cast<uint64_t>(kept), allocator);
+        out.AddMember("restarted",  ids(restarted), allocator);
+        out.AddMember("started",    ids(started), allocator);
+        out.AddMember("stopped",    ids(stopped), allocator);
+
+        Value list(kArrayType);
+        for (const auto &kv : downtime) {
+            Value item(kArrayType);
+            item.PushBack(static_cast<uint64_t>(kv.first), allocator);
+            item.PushBack(kv.second, allocator);
+
+            list.PushBack(item, allocator);
+        }
+
+        out.AddMember("downtime",   list, allocator);
+        out.AddMember("time",       time, allocator);
+
+        return out;
+    }
+#   endif
+
+    std::map<size_t, uint64_t> downtime;    // ms from the reconfiguration until the restarted or new worker was ready
+    std::vector<size_t> restarted;          // changed launch data, the worker was recreated on the same thread
+    std::vector<size_t> started;
+    std::vector<size_t> stopped;
+    size_t kept     = 0;
+    uint64_t time   = 0;                    // ms until all restarted and new workers were ready
+    uint64_t ts     = 0;
+};
+
+
 struct CpuLaunchStatus
 {
 public:
     inline const HugePagesInfo &hugePages() const   { return m_hugePages; }
+    inline const NumaPagesInfo &numaPages() const   { return m_numaPages; }
     inline size_t memory() const                    { return m_ways * m_memory; }
+    inline const CpuReconfig &reconfig() const      { return m_reconfig; }
     inline size_t threads() const                   { return m_threads; }
     inline size_t ways() const                      { return m_ways; }
+    inline uint64_t switchTime() const              { return m_switchTime; }
 
-    inline void start(const std::vector<CpuLaunchData> &threads, size_t memory)
+    inline const NumaPagesInfo &numaPages(size_t id) const
+    {
+        static const NumaPagesInfo empty;
+
+        return id < m_threadsNumaPages.size() ? m_threadsNumaPages[id] : empty;
+    }
+
+    inline void start(const std::vector<CpuLaunchData> &threads, size_t memory, uint64_t switchTs)
     {
         m_workersMemory.clear();
+        m_group        = threads.empty() ? 0 : threads.front().group;
         m_hugePages.reset();
+        m_numaPages.reset();
+        m_threadsNumaPages.assign(threads.size(), {});
         m_memory       = memory;
         m_started      = 0;
         m_totalStarted = 0;
@@ -83,6 +208,29 @@ public:
         m_threads      = threads.size();
         m_ways         = 0;
         m_ts           = Chrono::steadyMSecs();
+        m_switchTs     = switchTs;
+        m_reconfig     = {};
+    }
+
+    // Only restarted and new workers report start, kept workers are counted right away, returns true if there is nothing to wait for.
+    inline bool update(const std::vector<CpuLaunchData> &threads, size_t memory, CpuReconfig &&reconfig, const Workers<CpuLaunchData> &workers)
+    {
+        start(threads, memory, 0);
+
+        const size_t common = reconfig.kept + reconfig.restarted.size();
+        bool ready          = false;
+
+        for (size_t i = 0; i < common; ++i) {
+            if (std::find(reconfig.restarted.begin(), reconfig.restarted.end(), i) == reconfig.restarted.end()) {
+                IWorker *worker = workers.worker(i);
+                ready           = started(worker, worker != nullptr);
+            }
+        }
+
+        m_reconfig    = std::move(reconfig);
+        m_reconfig.ts = m_ts;
+
+        return ready;
     }
 
     inline bool started(IWorker *worker, bool ready)
@@ -93,8 +241,17 @@ public:
 
             if (m_workersMemory.insert(worker->memory()).second) {
                 m_hugePages += worker->memory()->hugePages();
+                m_numaPages += worker->numaPages();
+            }
+
+            if (worker->id() < m_threadsNumaPages.size()) {
+                m_threadsNumaPages[worker->id()] = worker->numaPages();
             }
             m_ways += worker->intensity();
+
+            if (m_reconfig.isPending()) {
+                m_reconfig.downtime[worker->id()] = Chrono::steadyMSecs() - m_reconfig.ts;
+            }
         }
         else {
             m_errors++;
@@ -103,46 +260,93 @@ public:
         return (m_started + m_errors) == m_threads;
     }
 
-    inline void print() const
+    inline void print()
     {
+        char group[24] = {};
+        if (m_group) {
+            snprintf(group, sizeof(group), " group %u", m_group);
+        }
+
         if (m_started == 0) {
-            LOG_ERR("%s " RED_BOLD("disabled") YELLOW(" (failed to start threads)"), Tags::cpu());
+            LOG_ERR("%s" RED_BOLD("%s disabled") YELLOW(" (failed to start threads)"), Tags::cpu(), group);
 
             return;
         }
 
-        LOG_INFO("%s" GREEN_BOLD(" READY") " threads %s%zu/%zu (%zu)" CLEAR " huge pages %s%1.0f%% %zu/%zu" CLEAR " memory " CYAN_BOLD("%zu KB") BLACK_BOLD(" (%" PRIu64 " ms)"),
+        char numa[64] = {};
+        if (m_numaPages.isValid()) {
+            int size = snprintf(numa, sizeof(numa), " NUMA local %s%1.0f%%" CLEAR,
+                                m_numaPages.isFullyLocal() ? GREEN_BOLD_S : (m_numaPages.local == 0 ? RED_BOLD_S : YELLOW_BOLD_S), m_numaPages.percent());
+
+            if (m_numaPages.migrated && size > 0) {
+                snprintf(numa + size, sizeof(numa) - size, BLACK_BOLD(" (%zu migrated)"), m_numaPages.migrated);
+            }
+        }
+
+        LOG_INFO("%s" GREEN_BOLD("%s READY") " threads %s%zu/%zu (%zu)" CLEAR " huge pages %s%1.0f%% %zu/%zu" CLEAR "%s memory " CYAN_BOLD("%zu KB") BLACK_BOLD(" (%" PRIu64 " ms)"),
                  Tags::cpu(),
+                 group,
                  m_errors == 0 ? CYAN_BOLD_S : YELLOW_BOLD_S,
                  m_totalStarted, std::max(m_totalStarted, m_threads), m_ways,
                  (m_hugePages.isFullyAllocated() ? GREEN_BOLD_S : (m_hugePages.allocated == 0 ? RED_BOLD_S : YELLOW_BOLD_S)),
                  m_hugePages.percent(),
                  m_hugePages.allocated, m_hugePages.total,
+                 numa,
                  memory() / 1024,
                  Chrono::steadyMSecs() - m_ts
                  );
+
+        if (m_switchTs) {
+            m_switchTime = Chrono::steadyMSecs() - m_switchTs;
+
+            LOG_INFO("%s" GREEN_BOLD(" switched") " to new profile in " CYAN_BOLD("%" PRIu64 " ms") BLACK_BOLD(" (threads kept)"), Tags::cpu(), m_switchTime);
+        }
+
+        if (m_reconfig.isPending()) {
+            m_reconfig.time = std::max<uint64_t>(Chrono::steadyMSecs() - m_reconfig.ts, 1);
+
+            LOG_INFO("%s" GREEN_BOLD(" reconfigured") " threads in " CYAN_BOLD("%" PRIu64 " ms") BLACK_BOLD(" (%zu kept, %zu restarted, %zu started, %zu stopped)"),
+                     Tags::cpu(), m_reconfig.time, m_reconfig.kept, m_reconfig.restarted.size(), m_reconfig.started.size(), m_reconfig.stopped.size());
+        }
     }
 
 private:
     std::set<const VirtualMemory*> m_workersMemory;
+    std::vector<NumaPagesInfo> m_threadsNumaPages;
     HugePagesInfo m_hugePages;
+    NumaPagesInfo m_numaPages;
     size_t m_errors       = 0;
     size_t m_memory       = 0;
     size_t m_started      = 0;
     size_t m_totalStarted = 0;
     size_t m_threads      = 0;
     size_t m_ways         = 0;
+    CpuReconfig m_reconfig;
+    uint64_t m_switchTime = 0;
+    uint32_t m_group      = 0;
+    uint64_t m_switchTs   = 0;
     uint64_t m_ts         = 0;
 };
 
 
+// Threads of a thread group > 0 (CpuConfig::kGroups) and the job of the pools of this group, group 0 uses fields of CpuBackendPrivate.
+struct CpuGroup
+{
+    Algorithm algo;
+    CpuLaunchStatus status;
+    std::vector<CpuLaunchData> threads;
+    String profileName;
+    Workers<CpuLaunchData> workers;
+};
+
+
 class CpuBackendPrivate
 {
 public:
     inline explicit CpuBackendPrivate(Controller *controller) : controller(controller)   {}
 
 
-    inline void start()
+    inline void start(uint64_t switchTs = 0)
     {
         LOG_INFO("%s use profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" thread%s)") " scratchpad " CYAN_BOLD("%zu KB"),
                  Tags::cpu(),
@@ -152,7 +356,11 @@ public:
                  algo.l3() / 1024
                  );
 
-        status.start(threads, algo.l3());
+        status.start(threads, algo.l3(), switchTs);
+
+#       ifdef XMRIG_FEATURE_ENERGY
+        resetEnergy();
+#       endif
 
 #       ifdef XMRIG_FEATURE_BENCHMARK
         workers.start(threads, benchmark);
@@ -162,6 +370,180 @@ public:
     }
 
 
+    /**
+     * Threads with equal launch data keep mining, only changed, new and removed threads are touched. Returns false
+     * if a full restart is required: no thread can be kept, benchmark, or the total count of threads is a part of
+     * the worker setup (GhostRider helper threads, shared cn-heavy memory on Zen3) and it changed.
+     */
+    bool update(Workers<CpuLaunchData> &workers, CpuLaunchStatus &status, std::vector<CpuLaunchData> &current, std::vector<CpuLaunchData> &threads, const Algorithm &algorithm)
+    {
+#       ifdef XMRIG_FEATURE_BENCHMARK
+        if (BenchState::size()) {
+            return false;
+        }
+#       endif
+
+        const auto family = algorithm.family();
+        if (current.empty() || (current.size() != threads.size() && (family == Algorithm::GHOSTRIDER || family == Algorithm::CN_HEAVY))) {
+            return false;
+        }
+
+        CpuReconfig reconfig;
+        const size_t common = std::min(current.size(), threads.size());
+
+        for (size_t i = 0; i < common; ++i) {
+            if (current[i] != threads[i]) {
+                reconfig.restarted.push_back(i);
+            }
+            else {
+                ++reconfig.kept;
+            }
+        }
+
+        if (reconfig.kept == 0) {
+            return false;
+        }
+
+        for (size_t i = common; i < threads.size(); ++i) {
+            reconfig.started.push_back(i);
+        }
+
+        for (size_t i = common; i < current.size(); ++i) {
+            reconfig.stopped.push_back(i);
+        }
+
+        const size_t arena = controller->config()->cpu().arenaSize(controller->miner());
+        for (auto &thread : threads) {
+            thread.arena = arena;
+        }
+
+        const std::vector<size_t> restarted = reconfig.restarted;
+
+        mutex.lock();
+        const bool ready = status.update(threads, algorithm.l3(), std::move(reconfig), workers);
+        mutex.unlock();
+
+        current = std::move(threads);
+        workers.update(current, restarted);
+
+        // Only removed threads, no worker reports start.
+        if (ready) {
+            std::lock_guard<std::mutex> lock(mutex);
+            status.print();
+        }
+
+        return true;
+    }
+
+
+    void setGroupJob(IBackend *backend, const Job &job)
+    {
+        const auto &cpu   = controller->config()->cpu();
+        const uint32_t id = job.group();
+        auto threads      = job.isValid() ? cpu.get(controller->miner(), job.algorithm(), id) : std::vector<CpuLaunchData>();
+        auto &group       = groups[id];
+
+        if (threads.empty()) {
+            if (group) {
+                group->workers.stop();
+                group.reset();
+
+                LOG_INFO("%s" YELLOW(" group %u stopped"), Tags::cpu(), id);
+            }
+            else if (job.isValid()) {
+                LOG_WARN("%s " RED_BOLD("group %u disabled") YELLOW(" (no threads on CPUs of the group)"), Tags::cpu(), id);
+            }
+
+            return;
+        }
+
+        if (group && group->threads.size() == threads.size() && std::equal(group->threads.begin(), group->threads.end(), threads.begin())) {
+            return;
+        }
+
+        uint64_t ts = 0;
+
+        if (group && update(group->workers, group->status, group->threads, threads, job.algorithm())) {
+            group->algo         = job.algorithm();
+            group->profileName  = cpu.threads().profileName(job.algorithm());
+
+            return;
+        }
+
+        if (group) {
+            ts = Chrono::steadyMSecs();
+
+            group->workers.suspend();
+
+            const size_t arena = cpu.arenaSize(controller->miner());
+            for (auto &thread : threads) {
+                thread.arena = arena;
+            }
+        }
+        else {
+            group = std::make_shared<CpuGroup>();
+            group->workers.setBackend(backend);
+            group->workers.setGroup(id);
+        }
+
+        group->algo         = job.algorithm();
+        group->profileName  = cpu.threads().profileName(job.algorithm());
+        group->threads      = std::move(threads);
+
+        LOG_INFO("%s " WHITE_BOLD("group %u") " use profile " BLUE_BG(WHITE_BOLD_S " %s ") WHITE_BOLD_S " (" CYAN_BOLD("%zu") WHITE_BOLD(" thread%s)") " scratchpad " CYAN_BOLD("%zu KB"),
+                 Tags::cpu(),
+                 id,
+                 group->profileName.data(),
+                 group->threads.size(),
+                 group->threads.size() > 1 ? "s" : "",
+                 group->algo.l3() / 1024
+                 );
+
+        group->status.start(group->threads, group->algo.l3(), ts);
+        group->workers.start(group->threads);
+    }
+
+
+    // Stops threads of group 0, threads of other groups keep mining their jobs.
+    void stop()
+    {
+        if (threads.empty()) {
+            return;
+        }
+
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        workers.stop();
+        threads.clear();
+
+#       ifdef XMRIG_FEATURE_ENERGY
+        resetEnergy();
+#       endif
+
+        LOG_INFO("%s" YELLOW(" stopped") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::cpu(), Chrono::steadyMSecs() - ts);
+    }
+
+
+    void stopGroups()
+    {
+        for (auto &kv : groups) {
+            if (kv.second) {
+                kv.second->workers.stop();
+            }
+        }
+
+        groups.clear();
+    }
+
+
+    inline CpuLaunchStatus &launchStatus(uint32_t group)
+    {
+        const auto it = groups.find(group);
+
+        return (it != groups.end() && it->second) ? it->second->status : status;
+    }
+
+
     size_t ways() const
     {
         std::lock_guard<std::mutex> lock(mutex);
@@ -170,7 +552,25 @@ public:
     }
 
 
-    rapidjson::Value hugePages(int version, rapidjson::Document &doc) const
+    uint64_t switchTime() const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        return status.switchTime();
+    }
+
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value reconfig(rapidjson::Document &doc) const
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        return status.reconfig().ts ? status.reconfig().toJSON(doc) : rapidjson::Value(rapidjson::kNullType);
+    }
+#   endif
+
+
+    HugePagesInfo hugePages() const
     {
         HugePagesInfo pages;
 
@@ -186,6 +586,14 @@ public:
 
         mutex.unlock();
 
+        return pages;
+    }
+
+
+    rapidjson::Value hugePages(int version, rapidjson::Document &doc) const
+    {
+        const HugePagesInfo pages = hugePages();
+
         rapidjson::Value hugepages;
 
         if (version > 1) {
@@ -201,9 +609,221 @@ public:
     }
 
 
+#   ifdef XMRIG_FEATURE_API
+    // Threads count and total hashrate for each type of cores on hybrid CPUs.
+    rapidjson::Value coreTypes(rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        constexpr size_t intervals[] = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+        const Hashrate *hashrate     = workers.hashrate();
+
+        Value out(kArrayType);
+
+        for (uint32_t type = 0; type < ICpuInfo::CORE_MAX; ++type) {
+            double total[3]  = { 0.0, 0.0, 0.0 };
+            bool valid[3]    = { false, false, false };
+            uint32_t count   = 0;
+
+            for (size_t i = 0; i < threads.size(); ++i) {
+                if (threads[i].coreType != type) {
+                    continue;
+                }
+
+                ++count;
+
+                for (size_t j = 0; j < 3; ++j) {
+                    const double value = hashrate ? hashrate->calc(i, intervals[j]) : 0.0;
+                    if (std::isnormal(value)) {
+                        total[j] += value;
+                        valid[j]  = true;
+                    }
+                }
+            }
+
+            if (count == 0) {
+                continue;
+            }
+
+            Value rate(kArrayType);
+            for (size_t j = 0; j < 3; ++j) {
+                rate.PushBack(valid[j] ? Json::normalize(total[j], false) : Value(kNullType), allocator);
+            }
+
+            Value obj(kObjectType);
+            obj.AddMember("type",       StringRef(CpuCoreTypes::name(static_cast<ICpuInfo::CoreType>(type))), allocator);
+            obj.AddMember("threads",    count, allocator);
+            obj.AddMember("hashrate",   rate, allocator);
+
+            out.PushBack(obj, allocator);
+        }
+
+        return out;
+    }
+
+
+    // Algorithm, profile and hashrate of each thread group > 0, threads of these groups are not included to the main lists.
+    rapidjson::Value groupsToJSON(rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        Value out(kArrayType);
+
+        for (const auto &kv : groups) {
+            if (!kv.second) {
+                continue;
+            }
+
+            const Hashrate *hr = kv.second->workers.hashrate();
+
+            Value threads(kArrayType);
+            for (size_t i = 0; i < kv.second->threads.size(); ++i) {
+                const auto &data = kv.second->threads[i];
+
+                Value thread(kObjectType);
+                thread.AddMember("intensity",   data.intensity, allocator);
+                thread.AddMember("affinity",    data.affinity, allocator);
+                thread.AddMember("av",          data.av(), allocator);
+                thread.AddMember("hashrate",    hr ? hr->toJSON(i, doc) : Value(kNullType), allocator);
+
+#               ifdef XMRIG_FEATURE_HWLOC
+                thread.AddMember("numa-pages",  kv.second->status.numaPages(i).toJSON(doc), allocator);
+#               endif
+
+                threads.PushBack(thread, allocator);
+            }
+
+            Value obj(kObjectType);
+            obj.AddMember("group",      kv.first, allocator);
+            obj.AddMember("algo",       kv.second->algo.toJSON(), allocator);
+            obj.AddMember("profile",    kv.second->profileName.toJSON(), allocator);
+            obj.AddMember("hashrate",   hr ? hr->toJSON(doc) : Value(kNullType), allocator);
+            obj.AddMember("threads",    threads, allocator);
+
+            out.PushBack(obj, allocator);
+        }
+
+        return out;
+    }
+#   endif
+
+
+#   ifdef XMRIG_FEATURE_ENERGY
+    // Threads are parked from the end of the list, so the first threads (usually one per physical core) keep working.
+    void updateEnergy(uint64_t now)
+    {
+        const auto &config = controller->config()->cpu().energy();
+
+        if (!config.isEnabled()) {
+            if (meter) {
+                meter.reset();
+                resetEnergy();
+            }
+
+            return;
+        }
+
+        if (!meter || meter->path() != config.path()) {
+            meter = std::make_shared<EnergyMeter>(config.path());
+            resetEnergy();
+
+            if (meter->isAvailable()) {
+                LOG_INFO("%s " WHITE_BOLD("energy") " RAPL zones " CYAN_BOLD("%zu") BLACK_BOLD(" (%s)"), Tags::cpu(), meter->zones(), config.path());
+            }
+            else {
+                LOG_WARN("%s " YELLOW_BOLD("energy") YELLOW(" RAPL counters are not available at \"%s\""), Tags::cpu(), config.path());
+            }
+        }
+
+        if (!meter->isAvailable()) {
+            return;
+        }
+
+        meter->update(now);
+
+        if (threads.empty() || !workers.hashrate()) {
+            return;
+        }
+
+        if (!energyController || !energyController->isEqual(config, threads.size())) {
+            resetEnergy();
+            energyController = std::make_shared<EnergyController>(config, threads.size(), now);
+        }
+
+        const double power    = meter->power();
+        const double hashrate = workers.hashrate()->calc(Hashrate::ShortInterval);
+
+        if (!energyController->update(now, power, hashrate)) {
+            return;
+        }
+
+        Nonce::park(Nonce::CPU, energyController->active());
+        Nonce::touch(Nonce::CPU);
+
+        LOG_INFO("%s " WHITE_BOLD("energy") " controller " MAGENTA_BOLD("%s") " active threads " CYAN_BOLD("%zu/%zu") BLACK_BOLD(" (%.1f W, %.1f H/J)"),
+                 Tags::cpu(),
+                 EnergyConfig::modeName(energyController->mode()),
+                 energyController->active(),
+                 energyController->threads(),
+                 power,
+                 std::isnormal(hashrate) ? hashrate / power : 0.0
+                 );
+    }
+
+
+    void resetEnergy()
+    {
+        energyController.reset();
+        Nonce::park(Nonce::CPU, SIZE_MAX);
+    }
+
+
+    double hashesPerJoule() const
+    {
+        const double power = meter ? meter->power() : 0.0;
+        if (!std::isnormal(power) || !workers.hashrate()) {
+            return 0.0;
+        }
+
+        const double hashrate = workers.hashrate()->calc(Hashrate::ShortInterval);
+
+        return std::isnormal(hashrate) ? hashrate / power : 0.0;
+    }
+
+
+#   ifdef XMRIG_FEATURE_API
+    rapidjson::Value energy(rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        if (!meter || !meter->isAvailable()) {
+            return Value(kNullType);
+        }
+
+        Value out(kObjectType);
+        out.AddMember("power",              Json::normalize(meter->power(), false), allocator);
+        out.AddMember("energy",             Json::normalize(meter->energy(), false), allocator);
+        out.AddMember("hashes-per-joule",   Json::normalize(hashesPerJoule(), false), allocator);
+        out.AddMember("controller",         StringRef(EnergyConfig::modeName(energyController ? energyController->mode() : EnergyConfig::ModeOff)), allocator);
+        out.AddMember("active-threads",     static_cast<uint64_t>(energyController ? energyController->active() : threads.size()), allocator);
+
+        return out;
+    }
+#   endif
+
+
+    std::shared_ptr<EnergyController> energyController;
+    std::shared_ptr<EnergyMeter> meter;
+#   endif
+
+
     Algorithm algo;
     Controller *controller;
     CpuLaunchStatus status;
+    std::map<uint32_t, std::shared_ptr<CpuGroup> > groups;
     std::vector<CpuLaunchData> threads;
     String profileName;
     Workers<CpuLaunchData> workers;
@@ -268,6 +888,16 @@ bool xmrig::CpuBackend::isEnabled(const Algorithm &algorithm) const
 
 bool xmrig::CpuBackend::tick(uint64_t ticks)
 {
+#   ifdef XMRIG_FEATURE_ENERGY
+    d_ptr->updateEnergy(Chrono::steadyMSecs());
+#   endif
+
+    for (auto &kv : d_ptr->groups) {
+        if (kv.second) {
+            kv.second->workers.tick(ticks);
+        }
+    }
+
     return d_ptr->workers.tick(ticks);
 }
 
@@ -292,6 +922,13 @@ const xmrig::String &xmrig::CpuBackend::type() const
 
 void xmrig::CpuBackend::prepare(const Job &nextJob)
 {
+    // Memory of the first job is planned before the RandomX dataset and threads allocate it.
+    if (isEnabled() && !MemoryPlanner::isInitialized()) {
+        MemoryPlanner::init(*d_ptr->controller->config(), nextJob.algorithm());
+    }
+
+    CnHash::setSoftAes(d_ptr->controller->config()->cpu().softAes());
+
 #   ifdef XMRIG_ALGO_ARGON2
     const auto f = nextJob.algorithm().family();
     if ((f == Algorithm::ARGON2) || (f == Algorithm::RANDOM_X)) {
@@ -309,11 +946,35 @@ void xmrig::CpuBackend::prepare(const Job &nextJob)
 
 void xmrig::CpuBackend::printHashrate(bool details)
 {
+    char num[8 * 3] = { 0 };
+
+    for (const auto &kv : d_ptr->groups) {
+        const Hashrate *hr = kv.second ? kv.second->workers.hashrate() : nullptr;
+        if (!hr) {
+            continue;
+        }
+
+        LOG_INFO("%s " WHITE_BOLD("group %u") " algo " WHITE_BOLD("%s") " speed 10s/60s/15m " CYAN_BOLD("%s") CYAN(" %s %s ") CYAN_BOLD("H/s") " threads " CYAN_BOLD("%zu"),
+                 Tags::cpu(),
+                 kv.first,
+                 kv.second->algo.name(),
+                 Hashrate::format(hr->calc(Hashrate::ShortInterval),  num,         sizeof num / 3),
+                 Hashrate::format(hr->calc(Hashrate::MediumInterval), num + 8,     sizeof num / 3),
+                 Hashrate::format(hr->calc(Hashrate::LargeInterval),  num + 8 * 2, sizeof num / 3),
+                 kv.second->threads.size()
+                 );
+    }
+
     if (!details || !hashrate()) {
         return;
     }
 
-    char num[8 * 3] = { 0 };
+#   ifdef XMRIG_FEATURE_PERF
+    const PerfStats *perf = d_ptr->workers.perf();
+    if (perf && !perf->isAvailable()) {
+        perf = nullptr;
+    }
+#   endif
 
     Log::print(WHITE_BOLD_S "|    CPU # | AFFINITY | 10s H/s | 60s H/s | 15m H/s |");
 
@@ -335,6 +996,41 @@ void xmrig::CpuBackend::printHashrate(bool details)
                Hashrate::format(hashrate()->calc(Hashrate::MediumInterval), num + 8,     sizeof num / 3),
                Hashrate::format(hashrate()->calc(Hashrate::LargeInterval),  num + 8 * 2, sizeof num / 3)
                );
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    const double hitRate = RxVm::hitRate();
+    if (std::isnormal(hitRate)) {
+        Log::print(WHITE_BOLD_S "RandomX hybrid mode dataset hit rate " CYAN_BOLD_S "%.2f%%", hitRate);
+    }
+#   endif
+
+#   ifdef XMRIG_FEATURE_ENERGY
+    if (d_ptr->meter && d_ptr->meter->isAvailable() && std::isnormal(d_ptr->meter->power())) {
+        Log::print(WHITE_BOLD_S "energy " CYAN_BOLD_S "%.1f W" WHITE_BOLD_S " efficiency " CYAN_BOLD_S "%.1f H/J" WHITE_BOLD_S " active threads " CYAN_BOLD_S "%zu/%zu",
+                   d_ptr->meter->power(),
+                   d_ptr->hashesPerJoule(),
+                   d_ptr->energyController ? d_ptr->energyController->active() : d_ptr->threads.size(),
+                   d_ptr->threads.size()
+                   );
+    }
+#   endif
+
+#   ifdef XMRIG_FEATURE_PERF
+    if (!perf) {
+        return;
+    }
+
+    Log::print(WHITE_BOLD_S "|    CPU # |   IPC |   LLC/H |   TLB/H | STL % |");
+
+    for (i = 0; i < d_ptr->threads.size(); ++i) {
+        char prefix[32] = { 0 };
+        snprintf(prefix, sizeof prefix, "| %8zu |", i);
+
+        printPerf(prefix, perf->get(i));
+    }
+
+    printPerf(WHITE_BOLD_S "|        - |", perf->total());
+#   endif
 }
 
 
@@ -349,6 +1045,15 @@ void xmrig::CpuBackend::setJob(const Job &job)
         return stop();
     }
 
+    if (job.group() > 0) {
+        return d_ptr->setGroupJob(this, job);
+    }
+
+    // Invalid job stops only threads of group 0, the same as for other groups.
+    if (!job.isValid()) {
+        return d_ptr->stop();
+    }
+
     const auto &cpu = d_ptr->controller->config()->cpu();
 
     auto threads = cpu.get(d_ptr->controller->miner(), job.algorithm());
@@ -362,10 +1067,31 @@ void xmrig::CpuBackend::setJob(const Job &job)
     if (d_ptr->profileName.isNull() || threads.empty()) {
         LOG_WARN("%s " RED_BOLD("disabled") YELLOW(" (no suitable configuration found)"), Tags::cpu());
 
-        return stop();
+        return d_ptr->stop();
+    }
+
+    if (d_ptr->update(d_ptr->workers, d_ptr->status, d_ptr->threads, threads, job.algorithm())) {
+#       ifdef XMRIG_FEATURE_ENERGY
+        d_ptr->resetEnergy();
+#       endif
+
+        return;
     }
 
-    stop();
+    // Threads and their scratchpad memory are kept, on the first switch memory grows to fit any enabled algorithm.
+    uint64_t ts = 0;
+
+    if (!d_ptr->threads.empty()) {
+        ts = Chrono::steadyMSecs();
+
+        d_ptr->workers.suspend();
+        d_ptr->threads.clear();
+
+        const size_t arena = cpu.arenaSize(d_ptr->controller->miner());
+        for (auto &thread : threads) {
+            thread.arena = arena;
+        }
+    }
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
     if (BenchState::size()) {
@@ -374,7 +1100,7 @@ void xmrig::CpuBackend::setJob(const Job &job)
 #   endif
 
     d_ptr->threads = std::move(threads);
-    d_ptr->start();
+    d_ptr->start(ts);
 }
 
 
@@ -382,8 +1108,11 @@ void xmrig::CpuBackend::start(IWorker *worker, bool ready)
 {
     mutex.lock();
 
-    if (d_ptr->status.started(worker, ready)) {
-        d_ptr->status.print();
+    auto &status = d_ptr->launchStatus(worker ? worker->group() : 0);
+    if (status.started(worker, ready)) {
+        status.print();
+
+        MemoryPlanner::mark(MemoryPlanner::THREADS);
     }
 
     mutex.unlock();
@@ -396,20 +1125,18 @@ void xmrig::CpuBackend::start(IWorker *worker, bool ready)
 
 void xmrig::CpuBackend::stop()
 {
-    if (d_ptr->threads.empty()) {
-        return;
-    }
-
-    const uint64_t ts = Chrono::steadyMSecs();
+    d_ptr->stopGroups();
+    d_ptr->stop();
+}
 
-    d_ptr->workers.stop();
-    d_ptr->threads.clear();
 
-    LOG_INFO("%s" YELLOW(" stopped") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::cpu(), Chrono::steadyMSecs() - ts);
+#ifdef XMRIG_FEATURE_API
+xmrig::HugePagesInfo xmrig::CpuBackend::hugePages() const
+{
+    return d_ptr->hugePages();
 }
 
 
-#ifdef XMRIG_FEATURE_API
 rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 {
     using namespace rapidjson;
@@ -425,6 +1152,14 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
     out.AddMember("priority",   cpu.priority(), allocator);
     out.AddMember("msr",        Rx::isMSR(), allocator);
 
+#   ifdef XMRIG_FEATURE_MSR
+    out.AddMember("msr-watchdog", RxMsr::toJSON(doc), allocator);
+#   endif
+
+#   ifdef XMRIG_FEATURE_RESCTRL
+    out.AddMember("resctrl", Resctrl::toJSON(doc), allocator);
+#   endif
+
 #   ifdef XMRIG_FEATURE_ASM
     const Assembly assembly = Cpu::assembly(cpu.assembly());
     out.AddMember("asm", assembly.toJSON(), allocator);
@@ -438,6 +1173,34 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
     out.AddMember("hugepages", d_ptr->hugePages(2, doc), allocator);
     out.AddMember("memory",    static_cast<uint64_t>(d_ptr->algo.isValid() ? (d_ptr->ways() * d_ptr->algo.l3()) : 0), allocator);
+    out.AddMember("switch-time", d_ptr->switchTime(), allocator);
+    out.AddMember("reconfig",    d_ptr->reconfig(doc), allocator);
+    out.AddMember("memory-plan", MemoryPlanner::toJSON(doc), allocator);
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    out.AddMember("dataset-hit-rate", Json::normalize(RxVm::hitRate(), false), allocator);
+#   endif
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    out.AddMember("numa-pages", d_ptr->status.numaPages().toJSON(doc), allocator);
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    Value datasets(kArrayType);
+    for (const auto &pages : Rx::numaPages()) {
+        datasets.PushBack(pages.toJSON(doc), allocator);
+    }
+
+    out.AddMember("dataset-numa-pages", datasets, allocator);
+#   endif
+#   endif
+
+#   ifdef XMRIG_FEATURE_ENERGY
+    out.AddMember("energy", d_ptr->energy(doc), allocator);
+#   endif
+
+    if (!d_ptr->groups.empty()) {
+        out.AddMember("groups", d_ptr->groupsToJSON(doc), allocator);
+    }
 
     if (d_ptr->threads.empty() || !hashrate()) {
         return out;
@@ -445,6 +1208,12 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
 
     out.AddMember("hashrate", hashrate()->toJSON(doc), allocator);
 
+#   ifdef XMRIG_FEATURE_PERF
+    const PerfStats *perf = d_ptr->workers.perf();
+    out.AddMember("perf", perf ? PerfStats::toJSON(perf->total(), doc) : Value(kNullType), allocator);
+#   endif
+
+    const bool hybrid = Cpu::info()->isHybrid();
     Value threads(kArrayType);
 
     size_t i = 0;
@@ -455,12 +1224,28 @@ rapidjson::Value xmrig::CpuBackend::toJSON(rapidjson::Document &doc) const
         thread.AddMember("av",          data.av(), allocator);
         thread.AddMember("hashrate",    hashrate()->toJSON(i, doc), allocator);
 
+        if (hybrid) {
+            thread.AddMember("core-type", StringRef(CpuCoreTypes::name(data.coreType)), allocator);
+        }
+
+#       ifdef XMRIG_FEATURE_PERF
+        thread.AddMember("perf",        perf ? PerfStats::toJSON(perf->get(i), doc) : Value(kNullType), allocator);
+#       endif
+
+#       ifdef XMRIG_FEATURE_HWLOC
+        thread.AddMember("numa-pages",  d_ptr->status.numaPages(i).toJSON(doc), allocator);
+#       endif
+
         i++;
         threads.PushBack(thread, allocator);
     }
 
     out.AddMember("threads", threads, allocator);
 
+    if (hybrid) {
+        out.AddMember(StringRef(CpuCoreTypes::kField), d_ptr->coreTypes(doc), allocator);
+    }
+
     return out;
 }
 
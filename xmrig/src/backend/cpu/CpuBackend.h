@@ -60,6 +60,7 @@ protected:
     void stop() override;
 
 #   ifdef XMRIG_FEATURE_API
+    HugePagesInfo hugePages() const override;
     rapidjson::Value toJSON(rapidjson::Document &doc) const override;
     void handleRequest(IApiRequest &request) override;
 #   endif
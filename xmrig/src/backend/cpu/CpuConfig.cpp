@@ -21,14 +21,19 @@
 #include "backend/cpu/CpuConfig_gen.h"
 #include "backend/cpu/Cpu.h"
 #include "base/io/json/Json.h"
+#include "core/Miner.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 
 namespace xmrig {
 
 const char *CpuConfig::kEnabled             = "enabled";
 const char *CpuConfig::kField               = "cpu";
+const char *CpuConfig::kGroups              = "groups";
 const char *CpuConfig::kHugePages           = "huge-pages";
 const char *CpuConfig::kHugePagesJit        = "huge-pages-jit";
 const char *CpuConfig::kHwAes               = "hw-aes";
@@ -45,6 +50,20 @@ const char *CpuConfig::kAsm                 = "asm";
 const char *CpuConfig::kArgon2Impl          = "argon2-impl";
 #endif
 
+#ifdef XMRIG_FEATURE_PERF
+const char *CpuConfig::kPerfCounters        = "perf-counters";
+#endif
+
+#ifdef XMRIG_FEATURE_HWLOC
+const char *CpuConfig::kNumaAudit           = "numa-audit";
+static const char *kMigrate                 = "migrate";
+#endif
+
+#ifdef XMRIG_VPAES
+const char *CpuConfig::kSoftAes             = "soft-aes";
+static const char *softAesNames[]           = { "auto", "table", "vpaes" };
+#endif
+
 
 extern template class Threads<CpuThreads>;
 
@@ -76,6 +95,10 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
         obj.AddMember(StringRef(kMaxThreadsHint), m_limit, allocator);
     }
 
+    if (Cpu::info()->isHybrid() || !m_coreTypes.isDefault()) {
+        obj.AddMember(StringRef(CpuCoreTypes::kField), m_coreTypes.toJSON(doc), allocator);
+    }
+
 #   ifdef XMRIG_FEATURE_ASM
     obj.AddMember(StringRef(kAsm), m_assembly.toJSON(), allocator);
 #   endif
@@ -84,19 +107,71 @@ rapidjson::Value xmrig::CpuConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kArgon2Impl), m_argon2Impl.toJSON(), allocator);
 #   endif
 
+#   ifdef XMRIG_FEATURE_PERF
+    obj.AddMember(StringRef(kPerfCounters), m_perfCounters, allocator);
+#   endif
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    if (m_numaAudit == NumaPagesInfo::MODE_MIGRATE) {
+        obj.AddMember(StringRef(kNumaAudit), StringRef(kMigrate), allocator);
+    }
+    else {
+        obj.AddMember(StringRef(kNumaAudit), m_numaAudit == NumaPagesInfo::MODE_REPORT, allocator);
+    }
+#   endif
+
+#   ifdef XMRIG_VPAES
+    obj.AddMember(StringRef(kSoftAes), StringRef(softAesNames[m_softAes]), allocator);
+#   endif
+
+#   ifdef XMRIG_FEATURE_ENERGY
+    obj.AddMember(StringRef(EnergyConfig::kField), m_energy.toJSON(doc), allocator);
+#   endif
+
+    if (!m_groups.empty()) {
+        Value groups(kObjectType);
+
+        for (const auto &kv : m_groups) {
+            Value cpus(kArrayType);
+            for (const int64_t cpu : kv.second) {
+                cpus.PushBack(cpu, allocator);
+            }
+
+            groups.AddMember(Value(std::to_string(kv.first).c_str(), allocator), cpus, allocator);
+        }
+
+        obj.AddMember(StringRef(kGroups), groups, allocator);
+    }
+
     m_threads.toJSON(obj, doc);
 
     return obj;
 }
 
 
+// Largest scratchpad memory of a single thread across all algorithms enabled for mining.
+size_t xmrig::CpuConfig::arenaSize(const Miner *miner) const
+{
+    size_t size = 0;
+
+    for (const auto &algorithm : miner->algorithms()) {
+        for (const auto &thread : m_threads.get(algorithm).data()) {
+            size = std::max(size, algorithm.l3() * thread.intensity());
+        }
+    }
+
+    return size;
+}
+
+
 size_t xmrig::CpuConfig::memPoolSize() const
 {
     return m_memoryPool < 0 ? std::max(Cpu::info()->threads(), Cpu::info()->L3() >> 21) : m_memoryPool;
 }
 
 
-std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm) const
+// Threads of the group are threads of the algorithm profile pinned to CPUs of the group, group 0 gets all other threads.
+std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, const Algorithm &algorithm, uint32_t group) const
 {
     if (algorithm.family() == Algorithm::KAWPOW) {
         return {};
@@ -109,18 +184,28 @@ std::vector<xmrig::CpuLaunchData> xmrig::CpuConfig::get(const Miner *miner, cons
         return out;
     }
 
-    const size_t count = threads.count();
+    std::vector<CpuThread> data;
+    data.reserve(threads.count());
+
+    for (const auto &thread : threads.data()) {
+        if (this->group(thread.affinity()) == group) {
+            data.emplace_back(thread);
+        }
+    }
+
+    const size_t count = data.size();
     out.reserve(count);
 
     std::vector<int64_t> affinities;
     affinities.reserve(count);
 
-    for (const auto& thread : threads.data()) {
+    for (const auto& thread : data) {
         affinities.emplace_back(thread.affinity());
     }
 
-    for (const auto &thread : threads.data()) {
+    for (const auto &thread : data) {
         out.emplace_back(miner, algorithm, *this, thread, count, affinities);
+        out.back().group = group;
     }
 
     return out;
@@ -148,6 +233,24 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
         m_argon2Impl = Json::getString(value, kArgon2Impl);
 #       endif
 
+#       ifdef XMRIG_FEATURE_PERF
+        m_perfCounters = Json::getBool(value, kPerfCounters, m_perfCounters);
+#       endif
+
+#       ifdef XMRIG_FEATURE_HWLOC
+        setNumaAudit(Json::getValue(value, kNumaAudit));
+#       endif
+
+#       ifdef XMRIG_VPAES
+        setSoftAes(Json::getValue(value, kSoftAes));
+#       endif
+
+#       ifdef XMRIG_FEATURE_ENERGY
+        m_energy.read(Json::getValue(value, EnergyConfig::kField));
+#       endif
+
+        m_coreTypes.read(Json::getValue(value, CpuCoreTypes::kField));
+        setGroups(Json::getValue(value, kGroups));
         m_threads.read(value);
 
         generate();
@@ -163,6 +266,22 @@ void xmrig::CpuConfig::read(const rapidjson::Value &value)
 }
 
 
+uint32_t xmrig::CpuConfig::group(int64_t affinity) const
+{
+    if (affinity < 0) {
+        return 0;
+    }
+
+    for (const auto &kv : m_groups) {
+        if (kv.second.count(affinity)) {
+            return kv.first;
+        }
+    }
+
+    return 0;
+}
+
+
 void xmrig::CpuConfig::generate()
 {
     if (!isEnabled() || m_threads.has("*")) {
@@ -171,14 +290,14 @@ void xmrig::CpuConfig::generate()
 
     size_t count = 0;
 
-    count += xmrig::generate<Algorithm::CN>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_LITE>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_HEAVY>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_PICO>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::CN_FEMTO>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::RANDOM_X>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::ARGON2>(m_threads, m_limit);
-    count += xmrig::generate<Algorithm::GHOSTRIDER>(m_threads, m_limit);
+    count += xmrig::generate<Algorithm::CN>(m_threads, m_limit, m_coreTypes);
+    count += xmrig::generate<Algorithm::CN_LITE>(m_threads, m_limit, m_coreTypes);
+    count += xmrig::generate<Algorithm::CN_HEAVY>(m_threads, m_limit, m_coreTypes);
+    count += xmrig::generate<Algorithm::CN_PICO>(m_threads, m_limit, m_coreTypes);
+    count += xmrig::generate<Algorithm::CN_FEMTO>(m_threads, m_limit, m_coreTypes);
+    count += xmrig::generate<Algorithm::RANDOM_X>(m_threads, m_limit, m_coreTypes);
+    count += xmrig::generate<Algorithm::ARGON2>(m_threads, m_limit, m_coreTypes);
+    count += xmrig::generate<Algorithm::GHOSTRIDER>(m_threads, m_limit, m_coreTypes);
 
     m_shouldSave |= count > 0;
 }
@@ -195,6 +314,30 @@ void xmrig::CpuConfig::setAesMode(const rapidjson::Value &value)
 }
 
 
+// Object with group number keys and arrays of logical CPUs as values, for example {"1": [6, 7]}.
+void xmrig::CpuConfig::setGroups(const rapidjson::Value &value)
+{
+    m_groups.clear();
+
+    if (!value.IsObject()) {
+        return;
+    }
+
+    for (const auto &member : value.GetObject()) {
+        const auto group = static_cast<uint32_t>(strtoul(member.name.GetString(), nullptr, 10));
+        if (group == 0 || group >= Nonce::kMaxGroups || !member.value.IsArray()) {
+            continue;
+        }
+
+        for (const auto &cpu : member.value.GetArray()) {
+            if (cpu.IsInt64() && cpu.GetInt64() >= 0 && this->group(cpu.GetInt64()) == 0) {
+                m_groups[group].insert(cpu.GetInt64());
+            }
+        }
+    }
+}
+
+
 void xmrig::CpuConfig::setHugePages(const rapidjson::Value &value)
 {
     if (value.IsBool()) {
@@ -217,3 +360,39 @@ void xmrig::CpuConfig::setMemoryPool(const rapidjson::Value &value)
         m_memoryPool = value.GetInt();
     }
 }
+
+
+#ifdef XMRIG_FEATURE_HWLOC
+void xmrig::CpuConfig::setNumaAudit(const rapidjson::Value &value)
+{
+    if (value.IsBool()) {
+        m_numaAudit = value.GetBool() ? NumaPagesInfo::MODE_REPORT : NumaPagesInfo::MODE_OFF;
+    }
+    else if (value.IsString() && strcmp(value.GetString(), kMigrate) == 0) {
+        m_numaAudit = NumaPagesInfo::MODE_MIGRATE;
+    }
+    else {
+        m_numaAudit = NumaPagesInfo::MODE_OFF;
+    }
+}
+#endif
+
+
+#ifdef XMRIG_VPAES
+void xmrig::CpuConfig::setSoftAes(const rapidjson::Value &value)
+{
+    m_softAes = SOFT_AES_AUTO;
+
+    if (!value.IsString()) {
+        return;
+    }
+
+    for (size_t i = 0; i < sizeof(softAesNames) / sizeof(softAesNames[0]); ++i) {
+        if (strcmp(value.GetString(), softAesNames[i]) == 0) {
+            m_softAes = static_cast<SoftAesImpl>(i);
+
+            return;
+        }
+    }
+}
+#endif
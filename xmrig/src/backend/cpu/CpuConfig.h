@@ -21,9 +21,21 @@
 
 
 #include "backend/common/Threads.h"
+#include "backend/cpu/CpuCoreTypes.h"
 #include "backend/cpu/CpuLaunchData.h"
 #include "backend/cpu/CpuThreads.h"
 #include "crypto/common/Assembly.h"
+#include "crypto/common/NumaPagesInfo.h"
+#include "crypto/common/SoftAes.h"
+
+
+#include <map>
+#include <set>
+
+
+#ifdef XMRIG_FEATURE_ENERGY
+#   include "hw/energy/EnergyConfig.h"
+#endif
 
 
 namespace xmrig {
@@ -40,6 +52,7 @@ public:
 
     static const char *kEnabled;
     static const char *kField;
+    static const char *kGroups;
     static const char *kHugePages;
     static const char *kHugePagesJit;
     static const char *kHwAes;
@@ -56,49 +69,90 @@ public:
     static const char *kArgon2Impl;
 #   endif
 
+#   ifdef XMRIG_FEATURE_PERF
+    static const char *kPerfCounters;
+#   endif
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    static const char *kNumaAudit;
+#   endif
+
+#   ifdef XMRIG_VPAES
+    static const char *kSoftAes;
+#   endif
+
     CpuConfig() = default;
 
     bool isHwAES() const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    size_t arenaSize(const Miner *miner) const;
     size_t memPoolSize() const;
-    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm) const;
+    std::vector<CpuLaunchData> get(const Miner *miner, const Algorithm &algorithm, uint32_t group = 0) const;
     void read(const rapidjson::Value &value);
 
     inline bool isEnabled() const                       { return m_enabled; }
     inline bool isHugePages() const                     { return m_hugePageSize > 0; }
     inline bool isHugePagesJit() const                  { return m_hugePagesJit; }
+    inline bool isPerfCounters() const                  { return m_perfCounters; }
     inline bool isShouldSave() const                    { return m_shouldSave; }
     inline bool isYield() const                         { return m_yield; }
     inline const Assembly &assembly() const             { return m_assembly; }
+    inline const CpuCoreTypes &coreTypes() const        { return m_coreTypes; }
+    inline const std::map<uint32_t, std::set<int64_t> > &groups() const { return m_groups; }
     inline const String &argon2Impl() const             { return m_argon2Impl; }
     inline const Threads<CpuThreads> &threads() const   { return m_threads; }
     inline int priority() const                         { return m_priority; }
+    inline NumaPagesInfo::Mode numaAudit() const        { return m_numaAudit; }
     inline size_t hugePageSize() const                  { return m_hugePageSize * 1024U; }
+    inline SoftAesImpl softAes() const                  { return m_softAes; }
     inline uint32_t limit() const                       { return m_limit; }
 
+#   ifdef XMRIG_FEATURE_ENERGY
+    inline const EnergyConfig &energy() const           { return m_energy; }
+#   endif
+
 private:
     constexpr static size_t kDefaultHugePageSizeKb  = 2048U;
     constexpr static size_t kOneGbPageSizeKb        = 1048576U;
 
+    uint32_t group(int64_t affinity) const;
     void generate();
+    void setGroups(const rapidjson::Value &value);
     void setAesMode(const rapidjson::Value &value);
     void setHugePages(const rapidjson::Value &value);
     void setMemoryPool(const rapidjson::Value &value);
 
+#   ifdef XMRIG_FEATURE_HWLOC
+    void setNumaAudit(const rapidjson::Value &value);
+#   endif
+
+#   ifdef XMRIG_VPAES
+    void setSoftAes(const rapidjson::Value &value);
+#   endif
+
     inline void setPriority(int priority)   { m_priority = (priority >= -1 && priority <= 5) ? priority : -1; }
 
     AesMode m_aes           = AES_AUTO;
     Assembly m_assembly;
+    CpuCoreTypes m_coreTypes;
     bool m_enabled          = true;
     bool m_hugePagesJit     = false;
+    bool m_perfCounters     = false;
     bool m_shouldSave       = false;
     bool m_yield            = true;
     int m_memoryPool        = 0;
     int m_priority          = -1;
+    NumaPagesInfo::Mode m_numaAudit = NumaPagesInfo::MODE_OFF;
     size_t m_hugePageSize   = kDefaultHugePageSizeKb;
+    SoftAesImpl m_softAes   = SOFT_AES_AUTO;
+    std::map<uint32_t, std::set<int64_t> > m_groups;   // logical CPUs reserved for the threads of each pool group
     String m_argon2Impl;
     Threads<CpuThreads> m_threads;
     uint32_t m_limit        = 100;
+
+#   ifdef XMRIG_FEATURE_ENERGY
+    EnergyConfig m_energy;
+#   endif
 };
 
 
@@ -22,32 +22,33 @@
 
 #include "backend/common/Threads.h"
 #include "backend/cpu/Cpu.h"
+#include "backend/cpu/CpuCoreTypes.h"
 #include "backend/cpu/CpuThreads.h"
 
 
 namespace xmrig {
 
 
-static inline size_t generate(const char *key, Threads<CpuThreads> &threads, const Algorithm &algorithm, uint32_t limit)
+static inline size_t generate(const char *key, Threads<CpuThreads> &threads, const Algorithm &algorithm, uint32_t limit, const CpuCoreTypes &types)
 {
     if (threads.isExist(algorithm) || threads.has(key)) {
         return 0;
     }
 
-    return threads.move(key, Cpu::info()->threads(algorithm, limit));
+    return threads.move(key, Cpu::info()->threads(algorithm, limit, types));
 }
 
 
 template<Algorithm::Family FAMILY>
-static inline size_t generate(Threads<CpuThreads> &, uint32_t) { return 0; }
+static inline size_t generate(Threads<CpuThreads> &, uint32_t, const CpuCoreTypes &) { return 0; }
 
 
 template<>
-size_t inline generate<Algorithm::CN>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::CN>(Threads<CpuThreads> &threads, uint32_t limit, const CpuCoreTypes &types)
 {
     size_t count = 0;
 
-    count += generate(Algorithm::kCN, threads, Algorithm::CN_1, limit);
+    count += generate(Algorithm::kCN, threads, Algorithm::CN_1, limit, types);
 
     if (!threads.isExist(Algorithm::CN_0)) {
         threads.disable(Algorithm::CN_0);
@@ -60,11 +61,11 @@ size_t inline generate<Algorithm::CN>(Threads<CpuThreads> &threads, uint32_t lim
 
 #ifdef XMRIG_ALGO_CN_LITE
 template<>
-size_t inline generate<Algorithm::CN_LITE>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::CN_LITE>(Threads<CpuThreads> &threads, uint32_t limit, const CpuCoreTypes &types)
 {
     size_t count = 0;
 
-    count += generate(Algorithm::kCN_LITE, threads, Algorithm::CN_LITE_1, limit);
+    count += generate(Algorithm::kCN_LITE, threads, Algorithm::CN_LITE_1, limit, types);
 
     if (!threads.isExist(Algorithm::CN_LITE_0)) {
         threads.disable(Algorithm::CN_LITE_0);
@@ -78,41 +79,41 @@ size_t inline generate<Algorithm::CN_LITE>(Threads<CpuThreads> &threads, uint32_
 
 #ifdef XMRIG_ALGO_CN_HEAVY
 template<>
-size_t inline generate<Algorithm::CN_HEAVY>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::CN_HEAVY>(Threads<CpuThreads> &threads, uint32_t limit, const CpuCoreTypes &types)
 {
-    return generate(Algorithm::kCN_HEAVY, threads, Algorithm::CN_HEAVY_0, limit);
+    return generate(Algorithm::kCN_HEAVY, threads, Algorithm::CN_HEAVY_0, limit, types);
 }
 #endif
 
 
 #ifdef XMRIG_ALGO_CN_PICO
 template<>
-size_t inline generate<Algorithm::CN_PICO>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::CN_PICO>(Threads<CpuThreads> &threads, uint32_t limit, const CpuCoreTypes &types)
 {
-    return generate(Algorithm::kCN_PICO, threads, Algorithm::CN_PICO_0, limit);
+    return generate(Algorithm::kCN_PICO, threads, Algorithm::CN_PICO_0, limit, types);
 }
 #endif
 
 
 #ifdef XMRIG_ALGO_CN_FEMTO
 template<>
-size_t inline generate<Algorithm::CN_FEMTO>(Threads<CpuThreads>& threads, uint32_t limit)
+size_t inline generate<Algorithm::CN_FEMTO>(Threads<CpuThreads>& threads, uint32_t limit, const CpuCoreTypes &types)
 {
-    return generate(Algorithm::kCN_UPX2, threads, Algorithm::CN_UPX2, limit);
+    return generate(Algorithm::kCN_UPX2, threads, Algorithm::CN_UPX2, limit, types);
 }
 #endif
 
 
 #ifdef XMRIG_ALGO_RANDOMX
 template<>
-size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32_t limit, const CpuCoreTypes &types)
 {
     size_t count = 0;
     auto cpuInfo = Cpu::info();
-    auto wow     = cpuInfo->threads(Algorithm::RX_WOW, limit);
+    auto wow     = cpuInfo->threads(Algorithm::RX_WOW, limit, types);
 
     if (!threads.isExist(Algorithm::RX_ARQ)) {
-        auto arq = cpuInfo->threads(Algorithm::RX_ARQ, limit);
+        auto arq = cpuInfo->threads(Algorithm::RX_ARQ, limit, types);
         if (arq == wow) {
             threads.setAlias(Algorithm::RX_ARQ, Algorithm::kRX_WOW);
             ++count;
@@ -123,7 +124,7 @@ size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32
     }
 
     if (!threads.isExist(Algorithm::RX_KEVA)) {
-        auto keva = cpuInfo->threads(Algorithm::RX_KEVA, limit);
+        auto keva = cpuInfo->threads(Algorithm::RX_KEVA, limit, types);
         if (keva == wow) {
             threads.setAlias(Algorithm::RX_KEVA, Algorithm::kRX_WOW);
             ++count;
@@ -137,7 +138,7 @@ size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32
         count += threads.move(Algorithm::kRX_WOW, std::move(wow));
     }
 
-    count += generate(Algorithm::kRX, threads, Algorithm::RX_0, limit);
+    count += generate(Algorithm::kRX, threads, Algorithm::RX_0, limit, types);
 
     return count;
 }
@@ -146,18 +147,18 @@ size_t inline generate<Algorithm::RANDOM_X>(Threads<CpuThreads> &threads, uint32
 
 #ifdef XMRIG_ALGO_ARGON2
 template<>
-size_t inline generate<Algorithm::ARGON2>(Threads<CpuThreads> &threads, uint32_t limit)
+size_t inline generate<Algorithm::ARGON2>(Threads<CpuThreads> &threads, uint32_t limit, const CpuCoreTypes &types)
 {
-    return generate(Algorithm::kAR2, threads, Algorithm::AR2_CHUKWA_V2, limit);
+    return generate(Algorithm::kAR2, threads, Algorithm::AR2_CHUKWA_V2, limit, types);
 }
 #endif
 
 
 #ifdef XMRIG_ALGO_GHOSTRIDER
 template<>
-size_t inline generate<Algorithm::GHOSTRIDER>(Threads<CpuThreads>& threads, uint32_t limit)
+size_t inline generate<Algorithm::GHOSTRIDER>(Threads<CpuThreads>& threads, uint32_t limit, const CpuCoreTypes &types)
 {
-    return generate(Algorithm::kGHOSTRIDER, threads, Algorithm::GHOSTRIDER_RTM, limit);
+    return generate(Algorithm::kGHOSTRIDER, threads, Algorithm::GHOSTRIDER_RTM, limit, types);
 }
 #endif
 
@@ -0,0 +1,120 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "backend/cpu/CpuCoreTypes.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+namespace xmrig {
+
+
+const char *CpuCoreTypes::kField                    = "core-types";
+const char *CpuCoreTypes::kIntensity                = "intensity";
+const char *CpuCoreTypes::kSMT                      = "smt";
+const char *CpuCoreTypes::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
+
+
+static const char *kCoreTypeNames[ICpuInfo::CORE_MAX] = { "performance", "efficiency" };
+
+
+// Efficiency cores usually share L2 cache by clusters of 4, so more than one hash per core only thrashes it.
+static CpuCoreTypes::Profile defaultProfile(ICpuInfo::CoreType type)
+{
+    CpuCoreTypes::Profile profile;
+
+    if (type == ICpuInfo::CORE_EFFICIENCY) {
+        profile.intensity = 1;
+    }
+
+    return profile;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::CpuCoreTypes::CpuCoreTypes()
+{
+    for (uint32_t i = 0; i < ICpuInfo::CORE_MAX; ++i) {
+        m_profiles[i] = defaultProfile(static_cast<ICpuInfo::CoreType>(i));
+    }
+}
+
+
+const char *xmrig::CpuCoreTypes::name(ICpuInfo::CoreType type)
+{
+    return type < ICpuInfo::CORE_MAX ? kCoreTypeNames[type] : kCoreTypeNames[ICpuInfo::CORE_PERFORMANCE];
+}
+
+
+bool xmrig::CpuCoreTypes::isDefault() const
+{
+    for (uint32_t i = 0; i < ICpuInfo::CORE_MAX; ++i) {
+        if (m_profiles[i] != defaultProfile(static_cast<ICpuInfo::CoreType>(i))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+rapidjson::Value xmrig::CpuCoreTypes::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+
+    for (uint32_t i = 0; i < ICpuInfo::CORE_MAX; ++i) {
+        const auto &profile = m_profiles[i];
+
+        Value obj(kObjectType);
+        obj.AddMember(StringRef(kIntensity),                profile.intensity, allocator);
+        obj.AddMember(StringRef(kSMT),                      profile.smt, allocator);
+        obj.AddMember(StringRef(kScratchpadPrefetchMode),   profile.prefetch, allocator);
+
+        out.AddMember(StringRef(kCoreTypeNames[i]), obj, allocator);
+    }
+
+    return out;
+}
+
+
+void xmrig::CpuCoreTypes::read(const rapidjson::Value &value)
+{
+    if (!value.IsObject()) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < ICpuInfo::CORE_MAX; ++i) {
+        const auto &obj = Json::getObject(value, kCoreTypeNames[i]);
+        if (!obj.IsObject()) {
+            continue;
+        }
+
+        auto &profile     = m_profiles[i];
+        profile.intensity = Json::getUint(obj, kIntensity, profile.intensity);
+        profile.smt       = Json::getBool(obj, kSMT, profile.smt);
+
+        const int prefetch = Json::getInt(obj, kScratchpadPrefetchMode, profile.prefetch);
+        profile.prefetch   = (prefetch >= 0 && prefetch <= 3) ? prefetch : -1;
+    }
+}
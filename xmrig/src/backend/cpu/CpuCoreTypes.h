@@ -0,0 +1,71 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CPUCORETYPES_H
+#define XMRIG_CPUCORETYPES_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "backend/cpu/interfaces/ICpuInfo.h"
+
+
+namespace xmrig {
+
+
+/**
+ * Thread profiles for each kind of cores on hybrid CPUs (P-cores and E-cores), ignored if all cores are the same.
+ *
+ * Intensity and SMT siblings usage are applied when threads are generated for an algorithm, scratchpad prefetch mode
+ * overrides the global RandomX option for threads running on this kind of cores.
+ */
+class CpuCoreTypes
+{
+public:
+    struct Profile
+    {
+        bool smt            = true;
+        int prefetch        = -1;   // RandomX scratchpad prefetch mode, -1 means global "scratchpad_prefetch_mode"
+        uint32_t intensity  = 0;    // 0 means auto
+
+        inline bool operator!=(const Profile &other) const { return smt != other.smt || prefetch != other.prefetch || intensity != other.intensity; }
+    };
+
+    static const char *kField;
+    static const char *kIntensity;
+    static const char *kSMT;
+    static const char *kScratchpadPrefetchMode;
+
+    CpuCoreTypes();
+
+    inline const Profile &get(ICpuInfo::CoreType type) const { return m_profiles[type < ICpuInfo::CORE_MAX ? type : ICpuInfo::CORE_PERFORMANCE]; }
+
+    static const char *name(ICpuInfo::CoreType type);
+
+    bool isDefault() const;
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    void read(const rapidjson::Value &value);
+
+private:
+    Profile m_profiles[ICpuInfo::CORE_MAX];
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CPUCORETYPES_H */
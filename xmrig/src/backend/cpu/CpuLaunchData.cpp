@@ -26,6 +26,7 @@
 
 #include "backend/cpu/CpuLaunchData.h"
 #include "backend/common/Tags.h"
+#include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuConfig.h"
 
 
@@ -35,12 +36,16 @@
 xmrig::CpuLaunchData::CpuLaunchData(const Miner *miner, const Algorithm &algorithm, const CpuConfig &config, const CpuThread &thread, size_t threads, const std::vector<int64_t>& affinities) :
     algorithm(algorithm),
     assembly(config.assembly()),
+    coreType(Cpu::info()->coreType(thread.affinity())),
     hugePages(config.isHugePages()),
     hwAES(config.isHwAES()),
+    perfCounters(config.isPerfCounters()),
     yield(config.isYield()),
+    prefetch(Cpu::info()->isHybrid() ? config.coreTypes().get(coreType).prefetch : -1),
     priority(config.priority()),
     affinity(thread.affinity()),
     miner(miner),
+    numaAudit(config.numaAudit()),
     threads(threads),
     intensity(std::max<uint32_t>(std::min<uint32_t>(thread.intensity(), algorithm.maxIntensity()), algorithm.minIntensity())),
     affinities(affinities)
@@ -54,9 +59,13 @@ bool xmrig::CpuLaunchData::isEqual(const CpuLaunchData &other) const
             && assembly         == other.assembly
             && hugePages        == other.hugePages
             && hwAES            == other.hwAES
+            && perfCounters     == other.perfCounters
+            && numaAudit        == other.numaAudit
             && intensity        == other.intensity
+            && prefetch         == other.prefetch
             && priority         == other.priority
             && affinity         == other.affinity
+            && group            == other.group
             );
 }
 
@@ -27,10 +27,12 @@
 #define XMRIG_CPULAUNCHDATA_H
 
 
+#include "backend/cpu/interfaces/ICpuInfo.h"
 #include "base/crypto/Algorithm.h"
 #include "crypto/cn/CnHash.h"
 #include "crypto/common/Assembly.h"
 #include "crypto/common/Nonce.h"
+#include "crypto/common/NumaPagesInfo.h"
 
 
 namespace xmrig {
@@ -58,15 +60,22 @@ public:
 
     const Algorithm algorithm;
     const Assembly assembly;
+    const ICpuInfo::CoreType coreType;
     const bool hugePages;
     const bool hwAES;
+    const bool perfCounters;
     const bool yield;
+    const int prefetch;         // RandomX scratchpad prefetch mode of this type of cores, -1 if not overridden
     const int priority;
     const int64_t affinity;
     const Miner *miner;
+    const NumaPagesInfo::Mode numaAudit;
     const size_t threads;
     const uint32_t intensity;
     const std::vector<int64_t> affinities;
+
+    size_t arena = 0;   // minimal scratchpad memory of the thread, largest need of all enabled algorithms, not a part of the profile
+    uint32_t group = 0; // thread group (CpuConfig::kGroups), the thread mines only jobs of the pools of this group
 };
 
 
@@ -16,7 +16,9 @@
  *   along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cassert>
+#include <memory>
 #include <thread>
 #include <mutex>
 
@@ -25,6 +27,7 @@
 #include "backend/cpu/CpuWorker.h"
 #include "base/tools/Alignment.h"
 #include "base/tools/Chrono.h"
+#include "base/tools/cryptonote/SignatureEngine.h"
 #include "core/config/Config.h"
 #include "core/Miner.h"
 #include "crypto/cn/CnCtx.h"
@@ -33,6 +36,7 @@
 #include "crypto/common/Nonce.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/rx/Rx.h"
+#include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxVm.h"
 #include "crypto/ghostrider/ghostrider.h"
@@ -44,11 +48,21 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
 #ifdef XMRIG_FEATURE_BENCHMARK
 #   include "backend/common/benchmark/BenchState.h"
 #endif
 
 
+#ifdef XMRIG_FEATURE_PERF
+#   include "hw/perf/PerfCounters.h"
+#endif
+
+
 namespace xmrig {
 
 static constexpr uint32_t kReserveCount = 32768;
@@ -59,6 +73,27 @@ static std::mutex cn_heavyZen3MemoryMutex;
 VirtualMemory* cn_heavyZen3Memory = nullptr;
 #endif
 
+
+// Scratchpad memory of a CPU thread, it survives workers so a new thread profile on the same thread doesn't allocate it again.
+static thread_local struct {
+    bool hugePages  = false;
+    uint32_t node   = 0;
+    std::unique_ptr<VirtualMemory> memory;
+} arena;
+
+
+static VirtualMemory *arenaMemory(size_t size, bool hugePages, uint32_t node)
+{
+    if (!arena.memory || arena.memory->size() < size || arena.hugePages != hugePages || arena.node != node) {
+        arena.memory.reset();
+        arena.memory.reset(new VirtualMemory(size, hugePages, false, true, node));
+        arena.hugePages = hugePages;
+        arena.node      = node;
+    }
+
+    return arena.memory.get();
+}
+
 } // namespace xmrig
 
 
@@ -71,8 +106,10 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     m_hwAES(data.hwAES),
     m_yield(data.yield),
     m_av(data.av()),
+    m_prefetch(data.prefetch),
     m_miner(data.miner),
     m_threads(data.threads),
+    m_group(data.group),
     m_ctx()
 {
 #   ifdef XMRIG_ALGO_CN_HEAVY
@@ -90,12 +127,29 @@ xmrig::CpuWorker<N>::CpuWorker(size_t id, const CpuLaunchData &data) :
     else
 #   endif
     {
-        m_memory = new VirtualMemory(m_algorithm.l3() * N, data.hugePages, false, true, node());
+        m_memory = arenaMemory(std::max(m_algorithm.l3() * N, data.arena), data.hugePages, node());
+    }
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    if (data.numaAudit != NumaPagesInfo::MODE_OFF && affinity() >= 0) {
+        bool populate = true;
+#       ifdef XMRIG_ALGO_CN_HEAVY
+        populate = m_memory != cn_heavyZen3Memory;   // shared memory, other threads may already use it
+#       endif
+
+        m_numaPages = m_memory->numaPages(node(), data.numaAudit == NumaPagesInfo::MODE_MIGRATE, populate);
     }
+#   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     m_ghHelper = ghostrider::create_helper_thread(affinity(), data.priority, data.affinities);
 #   endif
+
+#   ifdef XMRIG_FEATURE_PERF
+    if (data.perfCounters) {
+        m_perf = new PerfCounters();
+    }
+#   endif
 }
 
 
@@ -103,21 +157,20 @@ template<size_t N>
 xmrig::CpuWorker<N>::~CpuWorker()
 {
 #   ifdef XMRIG_ALGO_RANDOMX
+    releaseLight();
     RxVm::destroy(m_vm);
+    delete m_signer;
 #   endif
 
     CnCtx::release(m_ctx, N);
 
-#   ifdef XMRIG_ALGO_CN_HEAVY
-    if (m_memory != cn_heavyZen3Memory)
-#   endif
-    {
-        delete m_memory;
-    }
-
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     ghostrider::destroy_helper_thread(m_ghHelper);
 #   endif
+
+#   ifdef XMRIG_FEATURE_PERF
+    delete m_perf;
+#   endif
 }
 
 
@@ -128,21 +181,72 @@ void xmrig::CpuWorker<N>::allocateRandomX_VM()
     RxDataset *dataset = Rx::dataset(m_job.currentJob(), node());
 
     while (dataset == nullptr) {
+        if (m_light && Rx::isLightReady(m_job.currentJob())) {
+            return;
+        }
+
+        auto light = Rx::lightDataset(m_job.currentJob(), static_cast<uint32_t>(id()));
+        if (light) {
+            releaseLight();
+            RxVm::destroy(m_vm);
+
+            m_light      = std::move(light);
+            m_lightCount = m_count;
+            m_vm         = RxVm::create(m_light.get(), m_memory->scratchpad(), !m_hwAES, m_assembly, node(), m_job.currentJob().algorithm());
+
+            if (m_prefetch >= 0) {
+                randomx_vm_set_scratchpad_prefetch_mode(m_vm, m_prefetch);
+            }
+
+            return;
+        }
+
         std::this_thread::sleep_for(std::chrono::milliseconds(20));
 
-        if (Nonce::sequence(Nonce::CPU) == 0) {
+        // Workers<T>::update() waits for a stopped worker on the main loop, don't keep it waiting for the dataset.
+        if (Nonce::sequence(Nonce::CPU, m_group) == 0 || isStopped()) {
             return;
         }
 
         dataset = Rx::dataset(m_job.currentJob(), node());
     }
 
+    // Dataset is ready, switch from light mode without waiting for the next pause.
+    if (m_light) {
+        releaseLight();
+    }
+
+    // Every VM is bound to the configuration of its RandomX variant.
+    if (m_vm && randomx_vm_get_config(m_vm) != RxAlgo::base(m_job.currentJob().algorithm())) {
+        RxVm::destroy(m_vm);
+        m_vm = nullptr;
+    }
+
     if (!m_vm) {
         // Try to allocate scratchpad from dataset's 1 GB huge pages, if normal huge pages are not available
         uint8_t* scratchpad = m_memory->isHugePages() ? m_memory->scratchpad() : dataset->tryAllocateScrathpad();
-        m_vm = RxVm::create(dataset, scratchpad ? scratchpad : m_memory->scratchpad(), !m_hwAES, m_assembly, node());
+        m_vm = RxVm::create(dataset, scratchpad ? scratchpad : m_memory->scratchpad(), !m_hwAES, m_assembly, node(), m_job.currentJob().algorithm());
+
+        if (m_prefetch >= 0) {
+            randomx_vm_set_scratchpad_prefetch_mode(m_vm, m_prefetch);
+        }
     }
 }
+
+
+template<size_t N>
+void xmrig::CpuWorker<N>::releaseLight()
+{
+    if (!m_light) {
+        return;
+    }
+
+    RxVm::destroy(m_vm);
+    m_vm = nullptr;
+
+    Rx::addLightHashes(m_group, m_count - m_lightCount);
+    m_light.reset();
+}
 #endif
 
 
@@ -210,9 +314,14 @@ bool xmrig::CpuWorker<N>::selfTest()
 
 #   ifdef XMRIG_ALGO_ARGON2
     if (m_algorithm.family() == Algorithm::ARGON2) {
-        return verify(Algorithm::AR2_CHUKWA, argon2_chukwa_test_out) &&
-               verify(Algorithm::AR2_CHUKWA_V2, argon2_chukwa_v2_test_out) &&
-               verify(Algorithm::AR2_WRKZ, argon2_wrkz_test_out);
+        // Multi-lane hashes place every lane at l3() offset, algorithms which need more memory per lane can't be checked.
+        auto verifyArgon2 = [this](Algorithm::Id id, const uint8_t *referenceValue) {
+            return (N > 1 && Algorithm::l3(id) > m_algorithm.l3()) || verify(id, referenceValue);
+        };
+
+        return verifyArgon2(Algorithm::AR2_CHUKWA, argon2_chukwa_test_out) &&
+               verifyArgon2(Algorithm::AR2_CHUKWA_V2, argon2_chukwa_v2_test_out) &&
+               verifyArgon2(Algorithm::AR2_WRKZ, argon2_wrkz_test_out);
     }
 #   endif
 
@@ -231,18 +340,27 @@ void xmrig::CpuWorker<N>::hashrateData(uint64_t &hashCount, uint64_t &, uint64_t
 template<size_t N>
 void xmrig::CpuWorker<N>::start()
 {
-    while (Nonce::sequence(Nonce::CPU) > 0) {
-        if (Nonce::isPaused()) {
+    // stop() of this worker alone is noticed here, the job sequence is bumped to get out of the hashing loop.
+    while (Nonce::sequence(Nonce::CPU, m_group) > 0 && !isStopped()) {
+        if (Nonce::isPaused(m_group) || Nonce::isParked(Nonce::CPU, id(), m_group)) {
+#           ifdef XMRIG_ALGO_RANDOMX
+            releaseLight();
+#           endif
+
             do {
                 std::this_thread::sleep_for(std::chrono::milliseconds(20));
             }
-            while (Nonce::isPaused() && Nonce::sequence(Nonce::CPU) > 0);
+            while ((Nonce::isPaused(m_group) || Nonce::isParked(Nonce::CPU, id(), m_group)) && Nonce::sequence(Nonce::CPU, m_group) > 0 && !isStopped());
 
-            if (Nonce::sequence(Nonce::CPU) == 0) {
+            if (Nonce::sequence(Nonce::CPU, m_group) == 0 || isStopped()) {
                 break;
             }
 
             consumeJob();
+
+            if (isStopped()) {
+                break;
+            }
         }
 
 #       ifdef XMRIG_ALGO_RANDOMX
@@ -250,7 +368,7 @@ void xmrig::CpuWorker<N>::start()
         alignas(16) uint64_t tempHash[8] = {};
 #       endif
 
-        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence())) {
+        while (!Nonce::isOutdated(Nonce::CPU, m_job.sequence(), m_group)) {
             const Job &job = m_job.currentJob();
 
             if (job.algorithm().l3() != m_algorithm.l3()) {
@@ -285,7 +403,7 @@ void xmrig::CpuWorker<N>::start()
                 if (first) {
                     first = false;
                     if (job.hasMinerSignature()) {
-                        job.generateMinerSignature(m_job.blob(), job.size(), miner_signature_ptr);
+                        m_signer->sign(m_job.blob(), job.size());
                     }
                     randomx_calculate_hash_first(m_vm, tempHash, m_job.blob(), job.size());
                 }
@@ -296,7 +414,7 @@ void xmrig::CpuWorker<N>::start()
 
                 if (job.hasMinerSignature()) {
                     memcpy(miner_signature_saved, miner_signature_ptr, sizeof(miner_signature_saved));
-                    job.generateMinerSignature(m_job.blob(), job.size(), miner_signature_ptr);
+                    m_signer->sign(m_job.blob(), job.size());
                 }
                 randomx_calculate_hash_next(m_vm, tempHash, m_job.blob(), job.size(), m_hash);
             }
@@ -317,6 +435,17 @@ void xmrig::CpuWorker<N>::start()
 #               endif
 
                 default:
+#                   ifdef XMRIG_FEATURE_ASM
+                    if (job.algorithm() == Algorithm::CN_R && job.height() != m_heightR) {
+                        const double ts = Chrono::highResolutionMSecs();
+                        fn(job.algorithm())(m_job.blob(), job.size(), m_hash, m_ctx, job.height());
+                        CnRCache::firstHash(job.height(), Chrono::highResolutionMSecs() - ts);
+
+                        m_heightR = job.height();
+                        break;
+                    }
+#                   endif
+
                     fn(job.algorithm())(m_job.blob(), job.size(), m_hash, m_ctx, job.height());
                     break;
                 }
@@ -490,14 +619,14 @@ void xmrig::CpuWorker<N>::allocateCnCtx()
 template<size_t N>
 void xmrig::CpuWorker<N>::consumeJob()
 {
-    if (Nonce::sequence(Nonce::CPU) == 0) {
+    if (Nonce::sequence(Nonce::CPU, m_group) == 0) {
         return;
     }
 
-    auto job = m_miner->job();
+    const JobRef job = m_miner->jobSnapshot(m_group);
 
 #   ifdef XMRIG_FEATURE_BENCHMARK
-    m_benchSize          = job.benchSize();
+    m_benchSize          = job->benchSize();
     const uint32_t count = m_benchSize ? 1U : kReserveCount;
 #   else
     constexpr uint32_t count = kReserveCount;
@@ -508,6 +637,19 @@ void xmrig::CpuWorker<N>::consumeJob()
 #   ifdef XMRIG_ALGO_RANDOMX
     if (m_job.currentJob().algorithm().family() == Algorithm::RANDOM_X) {
         allocateRandomX_VM();
+
+        // The VM is not created if the worker was stopped while it waited for the dataset.
+        if (isStopped()) {
+            return;
+        }
+
+        if (m_job.currentJob().hasMinerSignature()) {
+            if (!m_signer) {
+                m_signer = new SignatureEngine(Cpu::info()->hasAVX2());
+            }
+
+            m_signer->setJob(m_job.currentJob());
+        }
     }
     else
 #   endif
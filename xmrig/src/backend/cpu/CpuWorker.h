@@ -27,6 +27,10 @@
 #include "net/JobResult.h"
 
 
+#include <limits>
+#include <memory>
+
+
 #ifdef XMRIG_ALGO_RANDOMX
 class randomx_vm;
 #endif
@@ -35,7 +39,9 @@ class randomx_vm;
 namespace xmrig {
 
 
+class RxDataset;
 class RxVm;
+class SignatureEngine;
 
 
 #ifdef XMRIG_ALGO_GHOSTRIDER
@@ -68,13 +74,19 @@ protected:
 
     inline const VirtualMemory *memory() const override     { return m_memory; }
     inline size_t intensity() const override                { return N; }
+    inline uint32_t group() const override                  { return m_group; }
     inline void jobEarlyNotification(const Job&) override   {}
 
+#   ifdef XMRIG_FEATURE_PERF
+    inline const PerfCounters *perfCounters() const override { return m_perf; }
+#   endif
+
 private:
     inline cn_hash_fun fn(const Algorithm &algorithm) const { return CnHash::fn(algorithm, m_av, m_assembly); }
 
 #   ifdef XMRIG_ALGO_RANDOMX
     void allocateRandomX_VM();
+    void releaseLight();
 #   endif
 
     bool nextRound();
@@ -89,23 +101,36 @@ private:
     const bool m_hwAES;
     const bool m_yield;
     const CnHash::AlgoVariant m_av;
+    const int m_prefetch;
     const Miner *m_miner;
     const size_t m_threads;
+    const uint32_t m_group;
     cryptonight_ctx *m_ctx[N];
     VirtualMemory *m_memory = nullptr;
     WorkerJob<N> m_job;
 
 #   ifdef XMRIG_ALGO_RANDOMX
     randomx_vm *m_vm        = nullptr;
+    SignatureEngine *m_signer = nullptr;
+    std::shared_ptr<RxDataset> m_light;     // cache used in light mode while the dataset is initialized
+    uint64_t m_lightCount   = 0;
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     ghostrider::HelperThread* m_ghHelper = nullptr;
 #   endif
 
+#   ifdef XMRIG_FEATURE_ASM
+    uint64_t m_heightR      = std::numeric_limits<uint64_t>::max();   // last CN-R height, for first hash latency
+#   endif
+
 #   ifdef XMRIG_FEATURE_BENCHMARK
     uint32_t m_benchSize    = 0;
 #   endif
+
+#   ifdef XMRIG_FEATURE_PERF
+    PerfCounters *m_perf    = nullptr;
+#   endif
 };
 
 
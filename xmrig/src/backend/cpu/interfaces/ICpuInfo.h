@@ -29,6 +29,9 @@
 namespace xmrig {
 
 
+class CpuCoreTypes;
+
+
 class ICpuInfo
 {
 public:
@@ -59,6 +62,12 @@ public:
 
 #   define MSR_NAMES_LIST "none", "ryzen_17h", "ryzen_19h", "intel", "custom"
 
+    enum CoreType : uint32_t {
+        CORE_PERFORMANCE,
+        CORE_EFFICIENCY,
+        CORE_MAX
+    };
+
     enum Flag : uint32_t {
         FLAG_AES,
         FLAG_VAES,
@@ -98,12 +107,14 @@ public:
     virtual bool hasCatL3() const                                                   = 0;
     virtual bool hasOneGbPages() const                                              = 0;
     virtual bool hasXOP() const                                                     = 0;
+    virtual bool isHybrid() const                                                   = 0;
     virtual bool isVM() const                                                       = 0;
     virtual bool jccErratum() const                                                 = 0;
     virtual const char *backend() const                                             = 0;
     virtual const char *brand() const                                               = 0;
     virtual const std::vector<int32_t> &units() const                               = 0;
-    virtual CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const    = 0;
+    virtual CoreType coreType(int64_t affinity) const                               = 0;
+    virtual CpuThreads threads(const Algorithm &algorithm, uint32_t limit, const CpuCoreTypes &types) const = 0;
     virtual MsrMod msrMod() const                                                   = 0;
     virtual rapidjson::Value toJSON(rapidjson::Document &doc) const                 = 0;
     virtual size_t cores() const                                                    = 0;
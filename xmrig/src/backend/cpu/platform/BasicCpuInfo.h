@@ -37,7 +37,7 @@ public:
 
 protected:
     const char *backend() const override;
-    CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const override;
+    CpuThreads threads(const Algorithm &algorithm, uint32_t limit, const CpuCoreTypes &types) const override;
     rapidjson::Value toJSON(rapidjson::Document &doc) const override;
 
     inline Arch arch() const override                           { return m_arch; }
@@ -51,10 +51,12 @@ protected:
     inline bool hasCatL3() const override                       { return has(FLAG_CAT_L3); }
     inline bool hasOneGbPages() const override                  { return has(FLAG_PDPE1GB); }
     inline bool hasXOP() const override                         { return has(FLAG_XOP); }
+    inline bool isHybrid() const override                       { return false; }
     inline bool isVM() const override                           { return has(FLAG_VM); }
     inline bool jccErratum() const override                     { return m_jccErratum; }
     inline const char *brand() const override                   { return m_brand; }
     inline const std::vector<int32_t> &units() const override   { return m_units; }
+    inline CoreType coreType(int64_t) const override            { return CORE_PERFORMANCE; }
     inline MsrMod msrMod() const override                       { return m_msrMod; }
     inline size_t cores() const override                        { return 0; }
     inline size_t L2() const override                           { return 0; }
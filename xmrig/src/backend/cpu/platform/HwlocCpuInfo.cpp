@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <hwloc.h>
 
 
@@ -33,6 +34,7 @@
 
 
 #include "backend/cpu/platform/HwlocCpuInfo.h"
+#include "backend/cpu/CpuCoreTypes.h"
 #include "base/io/log/Log.h"
 
 
@@ -119,6 +121,16 @@ static inline bool isCacheExclusive(hwloc_obj_t obj)
 #endif
 
 
+static inline uint32_t profileIntensity(const CpuCoreTypes::Profile &profile, const Algorithm &algorithm, uint32_t intensity)
+{
+    if (profile.intensity == 0 || algorithm.maxIntensity() == 1) {
+        return intensity;
+    }
+
+    return std::max(std::min(profile.intensity, algorithm.maxIntensity()), algorithm.minIntensity());
+}
+
+
 } // namespace xmrig
 
 
@@ -168,6 +180,7 @@ xmrig::HwlocCpuInfo::HwlocCpuInfo()
     findCache(root, 2, 3, [this](hwloc_obj_t found) { this->m_cache[found->attr->cache.depth] += found->attr->cache.size; });
 
     setThreads(countByType(m_topology, HWLOC_OBJ_PU));
+    setCoreTypes();
 
     m_cores     = countByType(m_topology, HWLOC_OBJ_CORE);
     m_nodes     = std::max(hwloc_bitmap_weight(hwloc_topology_get_complete_nodeset(m_topology)), 1);
@@ -214,11 +227,37 @@ bool xmrig::HwlocCpuInfo::membind(hwloc_const_bitmap_t nodeset)
 }
 
 
-xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint32_t limit) const
+bool xmrig::HwlocCpuInfo::unbind()
+{
+    if (!hwloc_topology_get_support(m_topology)->membind->set_thisthread_membind) {
+        return false;
+    }
+
+    hwloc_const_bitmap_t nodeset = hwloc_topology_get_topology_nodeset(m_topology);
+
+#   if HWLOC_API_VERSION >= 0x20000
+    return hwloc_set_membind(m_topology, nodeset, HWLOC_MEMBIND_DEFAULT, HWLOC_MEMBIND_THREAD | HWLOC_MEMBIND_BYNODESET) >= 0;
+#   else
+    return hwloc_set_membind_nodeset(m_topology, nodeset, HWLOC_MEMBIND_DEFAULT, HWLOC_MEMBIND_THREAD) >= 0;
+#   endif
+}
+
+
+xmrig::ICpuInfo::CoreType xmrig::HwlocCpuInfo::coreType(int64_t affinity) const
+{
+    if (affinity < 0 || static_cast<size_t>(affinity) >= m_coreTypes.size()) {
+        return CORE_PERFORMANCE;
+    }
+
+    return m_coreTypes[static_cast<size_t>(affinity)];
+}
+
+
+xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint32_t limit, const CpuCoreTypes &types) const
 {
 #   ifndef XMRIG_ARM
     if (L2() == 0 && L3() == 0) {
-        return BasicCpuInfo::threads(algorithm, limit);
+        return BasicCpuInfo::threads(algorithm, limit, types);
     }
 
     const unsigned depth = L3() > 0 ? 3 : 2;
@@ -237,7 +276,7 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint3
         int remaining                = std::max(static_cast<int>(maxTotalThreads), 1);
 
         for (hwloc_obj_t cache : caches) {
-            processTopLevelCache(cache, algorithm, threads, std::min(maxPerCache, remaining));
+            processTopLevelCache(cache, algorithm, threads, std::min(maxPerCache, remaining), types);
 
             remaining -= maxPerCache;
             if (remaining <= 0) {
@@ -247,24 +286,24 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::threads(const Algorithm &algorithm, uint3
     }
     else {
         for (hwloc_obj_t cache : caches) {
-            processTopLevelCache(cache, algorithm, threads, 0);
+            processTopLevelCache(cache, algorithm, threads, 0, types);
         }
     }
 
     if (threads.isEmpty()) {
         LOG_WARN("hwloc auto configuration for algorithm \"%s\" failed.", algorithm.name());
 
-        return BasicCpuInfo::threads(algorithm, limit);
+        return BasicCpuInfo::threads(algorithm, limit, types);
     }
 
     return threads;
 #   else
-    return allThreads(algorithm, limit);
+    return allThreads(algorithm, limit, types);
 #   endif
 }
 
 
-xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, uint32_t limit) const
+xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, uint32_t limit, const CpuCoreTypes &types) const
 {
     CpuThreads threads;
     threads.reserve(m_threads);
@@ -272,11 +311,11 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, ui
     const uint32_t intensity = (algorithm.family() == Algorithm::GHOSTRIDER) ? 8 : 0;
 
     for (const int32_t pu : m_units) {
-        threads.add(pu, intensity);
+        threads.add(pu, (m_hybrid && intensity == 0) ? profileIntensity(types.get(coreType(pu)), algorithm, intensity) : intensity);
     }
 
     if (threads.isEmpty()) {
-        return BasicCpuInfo::threads(algorithm, limit);
+        return BasicCpuInfo::threads(algorithm, limit, types);
     }
 
     return threads;
@@ -284,7 +323,7 @@ xmrig::CpuThreads xmrig::HwlocCpuInfo::allThreads(const Algorithm &algorithm, ui
 
 
 
-void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const
+void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit, const CpuCoreTypes &types) const
 {
 #   ifndef XMRIG_ARM
     constexpr size_t oneMiB = 1024U * 1024U;
@@ -301,7 +340,9 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 #   ifdef XMRIG_ALGO_GHOSTRIDER
     if ((algorithm == Algorithm::GHOSTRIDER_RTM) && (PUs > cores.size()) && (PUs < cores.size() * 2)) {
         // Don't use E-cores on Alder Lake
-        cores.erase(std::remove_if(cores.begin(), cores.end(), [](hwloc_obj_t c) { return hwloc_bitmap_weight(c->cpuset) == 1; }), cores.end());
+        cores.erase(std::remove_if(cores.begin(), cores.end(), [this](hwloc_obj_t c) {
+            return m_hybrid ? (coreType(hwloc_bitmap_first(c->cpuset)) == CORE_EFFICIENCY) : (hwloc_bitmap_weight(c->cpuset) == 1);
+        }), cores.end());
 
         // This shouldn't happen, but check it anyway
         if (cores.empty()) {
@@ -310,6 +351,23 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
     }
 #   endif
 
+    // SMT siblings of a core are not used if disabled for this type of cores
+    auto coreUnits = [this, &types](hwloc_obj_t core) {
+        std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
+        if (m_hybrid && units.size() > 1 && !types.get(coreType(units.front()->os_index)).smt) {
+            units.resize(1);
+        }
+
+        return units;
+    };
+
+    if (m_hybrid) {
+        PUs = 0;
+        for (hwloc_obj_t core : cores) {
+            PUs += coreUnits(core).size();
+        }
+    }
+
     size_t L3               = cache->attr->cache.size;
     const bool L3_exclusive = isCacheExclusive(cache);
     size_t L2               = 0;
@@ -367,11 +425,15 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
     }
 #   endif
 
+    auto puIntensity = [this, &types, &algorithm, &intensity](uint32_t pu) {
+        return (m_hybrid && algorithm.family() != Algorithm::GHOSTRIDER) ? profileIntensity(types.get(coreType(pu)), algorithm, intensity) : intensity;
+    };
+
     if (cacheHashes >= PUs) {
         for (hwloc_obj_t core : cores) {
-            const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
+            const std::vector<hwloc_obj_t> units = coreUnits(core);
             for (hwloc_obj_t pu : units) {
-                threads.add(pu->os_index, intensity);
+                threads.add(pu->os_index, puIntensity(pu->os_index));
             }
         }
 
@@ -387,7 +449,7 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 
         threads_data.clear();
         for (hwloc_obj_t core : cores) {
-            const std::vector<hwloc_obj_t> units = findByType(core, HWLOC_OBJ_PU);
+            const std::vector<hwloc_obj_t> units = coreUnits(core);
             if (units.size() <= pu_id) {
                 continue;
             }
@@ -396,7 +458,7 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
             PUs--;
 
             allocated_pu = true;
-            threads_data.emplace_back(units[pu_id]->os_index, intensity);
+            threads_data.emplace_back(units[pu_id]->os_index, puIntensity(units[pu_id]->os_index));
 
             if (cacheHashes == 0) {
                 break;
@@ -426,6 +488,59 @@ void xmrig::HwlocCpuInfo::processTopLevelCache(hwloc_obj_t cache, const Algorith
 }
 
 
+void xmrig::HwlocCpuInfo::setCoreTypes()
+{
+#   if HWLOC_API_VERSION >= 0x00020400
+    const int count = hwloc_cpukinds_get_nr(m_topology, 0);
+    if (count < 2) {
+        return;
+    }
+
+    // Kinds are ordered by efficiency, the most powerful is the last one. If the OS doesn't report efficiency and hwloc
+    // can't rank kinds, it is unknown (-1) for all of them and only Intel core type can be trusted.
+    hwloc_bitmap_t cpuset = hwloc_bitmap_alloc();
+    size_t efficiency     = 0;
+
+    for (int i = 0; i < count; ++i) {
+        int rank                = -1;
+        unsigned infosCount     = 0;
+        hwloc_info_s *infos     = nullptr;
+
+        if (hwloc_cpukinds_get_info(m_topology, static_cast<unsigned>(i), cpuset, &rank, &infosCount, &infos, 0) < 0) {
+            continue;
+        }
+
+        CoreType type = (i == count - 1) ? CORE_PERFORMANCE : CORE_EFFICIENCY;
+
+        if (rank < 0) {
+            for (unsigned j = 0; j < infosCount; ++j) {
+                if (strcmp(infos[j].name, "CoreType") == 0) {
+                    type = strcmp(infos[j].value, "IntelAtom") == 0 ? CORE_EFFICIENCY : CORE_PERFORMANCE;
+                }
+            }
+        }
+
+        unsigned pu = 0;
+        hwloc_bitmap_foreach_begin(pu, cpuset)
+            if (m_coreTypes.size() <= pu) {
+                m_coreTypes.resize(pu + 1, CORE_PERFORMANCE);
+            }
+
+            m_coreTypes[pu] = type;
+            efficiency += type == CORE_EFFICIENCY;
+        hwloc_bitmap_foreach_end();
+    }
+
+    hwloc_bitmap_free(cpuset);
+
+    m_hybrid = efficiency > 0 && efficiency < m_threads;
+    if (!m_hybrid) {
+        m_coreTypes.clear();
+    }
+#   endif
+}
+
+
 void xmrig::HwlocCpuInfo::setThreads(size_t threads)
 {
     if (!threads) {
@@ -52,10 +52,13 @@ public:
     inline hwloc_topology_t topology() const                    { return m_topology; }
 
     bool membind(hwloc_const_bitmap_t nodeset);
+    bool unbind();
 
 protected:
-    CpuThreads threads(const Algorithm &algorithm, uint32_t limit) const override;
+    CoreType coreType(int64_t affinity) const override;
+    CpuThreads threads(const Algorithm &algorithm, uint32_t limit, const CpuCoreTypes &types) const override;
 
+    inline bool isHybrid() const override           { return m_hybrid; }
     inline const char *backend() const override     { return m_backend; }
     inline size_t cores() const override            { return m_cores; }
     inline size_t L2() const override               { return m_cache[2]; }
@@ -64,18 +67,21 @@ protected:
     inline size_t packages() const override         { return m_packages; }
 
 private:
-    CpuThreads allThreads(const Algorithm &algorithm, uint32_t limit) const;
-    void processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit) const;
+    CpuThreads allThreads(const Algorithm &algorithm, uint32_t limit, const CpuCoreTypes &types) const;
+    void processTopLevelCache(hwloc_obj_t cache, const Algorithm &algorithm, CpuThreads &threads, size_t limit, const CpuCoreTypes &types) const;
+    void setCoreTypes();
     void setThreads(size_t threads);
 
     static uint32_t m_features;
 
+    bool m_hybrid               = false;
     char m_backend[20]          = { 0 };
     hwloc_topology_t m_topology = nullptr;
     size_t m_cache[5]           = { 0 };
     size_t m_cores              = 0;
     size_t m_nodes              = 0;
     size_t m_packages           = 0;
+    std::vector<CoreType> m_coreTypes;     // indexed by PU os_index, empty if all cores are the same
     std::vector<uint32_t> m_nodeset;
 };
 
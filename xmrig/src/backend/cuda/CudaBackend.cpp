@@ -38,6 +38,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/HugePagesInfo.h"
 
 
 #ifdef XMRIG_ALGO_KAWPOW
@@ -490,6 +491,12 @@ bool xmrig::CudaBackend::tick(uint64_t ticks)
 
 
 #ifdef XMRIG_FEATURE_API
+xmrig::HugePagesInfo xmrig::CudaBackend::hugePages() const
+{
+    return {};
+}
+
+
 rapidjson::Value xmrig::CudaBackend::toJSON(rapidjson::Document &doc) const
 {
     using namespace rapidjson;
@@ -147,11 +147,11 @@ void xmrig::CudaWorker::start()
             }
 
             if (foundCount) {
-                JobResults::submit(m_job.currentJob(), foundNonce, foundCount, m_deviceIndex);
+                JobResults::submit(m_job.resultJob(), foundNonce, foundCount, m_deviceIndex);
             }
 
             if (!Nonce::isOutdated(Nonce::CUDA, m_job.sequence()) && !m_job.nextRound(1, intensity())) {
-                JobResults::done(m_job.currentJob());
+                JobResults::done(m_job.resultJob());
             }
 
             storeStats();
@@ -171,7 +171,7 @@ bool xmrig::CudaWorker::consumeJob()
         return false;
     }
 
-    m_job.add(m_miner->job(), intensity(), Nonce::CUDA);
+    m_job.add(m_miner->jobSnapshot(), intensity(), Nonce::CUDA);
 
     return m_runner->set(m_job.currentJob(), m_job.blob());
 }
@@ -39,6 +39,7 @@
 #include "base/tools/String.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "crypto/common/HugePagesInfo.h"
 
 
 #ifdef XMRIG_ALGO_KAWPOW
@@ -478,6 +479,12 @@ bool xmrig::OclBackend::tick(uint64_t ticks)
 
 
 #ifdef XMRIG_FEATURE_API
+xmrig::HugePagesInfo xmrig::OclBackend::hugePages() const
+{
+    return {};
+}
+
+
 rapidjson::Value xmrig::OclBackend::toJSON(rapidjson::Document &doc) const
 {
     using namespace rapidjson;
@@ -179,11 +179,11 @@ void xmrig::OclWorker::start()
             }
 
             if (results[0xFF] > 0) {
-                JobResults::submit(m_job.currentJob(), results, results[0xFF], m_deviceIndex);
+                JobResults::submit(m_job.resultJob(), results, results[0xFF], m_deviceIndex);
             }
 
             if (!Nonce::isOutdated(Nonce::OPENCL, m_job.sequence()) && !m_job.nextRound(1, intensity())) {
-                JobResults::done(m_job.currentJob());
+                JobResults::done(m_job.resultJob());
             }
 
             storeStats(t);
@@ -203,7 +203,7 @@ bool xmrig::OclWorker::consumeJob()
         return false;
     }
 
-    m_job.add(m_miner->job(), intensity(), Nonce::OPENCL);
+    m_job.add(m_miner->jobSnapshot(), intensity(), Nonce::OPENCL);
 
     try {
         m_runner->set(m_job.currentJob(), m_job.blob());
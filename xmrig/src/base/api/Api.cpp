@@ -20,12 +20,15 @@
 
 
 #include "base/api/Api.h"
+#include "3rdparty/llhttp/llhttp.h"
 #include "base/api/interfaces/IApiListener.h"
 #include "base/api/requests/HttpApiRequest.h"
 #include "base/crypto/keccak.h"
 #include "base/io/Env.h"
 #include "base/io/json/Json.h"
 #include "base/kernel/Base.h"
+#include "base/net/http/HttpData.h"
+#include "base/net/http/HttpResponse.h"
 #include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "core/config/Config.h"
@@ -98,12 +101,23 @@ xmrig::Api::~Api()
 
 void xmrig::Api::request(const HttpData &req)
 {
+    if (metrics(req)) {
+        return;
+    }
+
     HttpApiRequest request(req, m_base->config()->http().isRestricted());
 
     exec(request);
 }
 
 
+void xmrig::Api::setMetrics(std::string &text, std::string &json)
+{
+    m_metrics.swap(text);
+    m_metricsJson.swap(json);
+}
+
+
 void xmrig::Api::start()
 {
     genWorkerId(m_base->config()->apiWorkerId());
@@ -135,6 +149,43 @@ void xmrig::Api::onConfigChanged(Config *config, Config *previousConfig)
 }
 
 
+// Metrics snapshot is serialized by the miner once per tick, requests only copy it to the socket.
+bool xmrig::Api::metrics(const HttpData &req) const
+{
+    if (req.method != HTTP_GET) {
+        return false;
+    }
+
+    const std::string *body = nullptr;
+    const char *contentType = nullptr;
+
+    if (req.url == "/metrics") {
+        body        = &m_metrics;
+        contentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+    }
+    else if (req.url == "/2/metrics") {
+        body        = &m_metricsJson;
+        contentType = "application/json";
+    }
+    else {
+        return false;
+    }
+
+    HttpResponse res(req.id(), body->empty() ? 404 : 200);
+
+    if (body->empty()) {
+        res.end();
+
+        return true;
+    }
+
+    res.setHeader(HttpData::kContentType, contentType);
+    res.end(body->data(), body->size());
+
+    return true;
+}
+
+
 void xmrig::Api::exec(IApiRequest &request)
 {
     using namespace rapidjson;
@@ -20,8 +20,9 @@
 #define XMRIG_API_H
 
 
-#include <vector>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 
 #include "base/kernel/interfaces/IBaseListener.h"
@@ -52,6 +53,7 @@ public:
     inline void addListener(IApiListener *listener) { m_listeners.push_back(listener); }
 
     void request(const HttpData &req);
+    void setMetrics(std::string &text, std::string &json);
     void start();
     void stop();
 
@@ -59,6 +61,7 @@ protected:
     void onConfigChanged(Config *config, Config *previousConfig) override;
 
 private:
+    bool metrics(const HttpData &req) const;
     void exec(IApiRequest &request);
     void genId(const String &id);
     void genWorkerId(const String &id);
@@ -68,6 +71,8 @@ private:
     String m_workerId;
     const uint64_t m_timestamp;
     Httpd *m_httpd = nullptr;
+    std::string m_metrics;          // OpenMetrics text
+    std::string m_metricsJson;
     std::vector<IApiListener *> m_listeners;
 };
 
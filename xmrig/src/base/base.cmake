@@ -4,6 +4,7 @@ set(HEADERS_BASE
     src/base/crypto/Algorithm.h
     src/base/crypto/Coin.h
     src/base/crypto/keccak.h
+    src/base/crypto/keccak_lanes.h
     src/base/crypto/sha3.h
     src/base/io/Async.h
     src/base/io/Console.h
@@ -77,6 +78,7 @@ set(HEADERS_BASE
     src/base/tools/cryptonote/BlobReader.h
     src/base/tools/cryptonote/BlockTemplate.h
     src/base/tools/cryptonote/crypto-ops.h
+    src/base/tools/cryptonote/SignatureEngine.h
     src/base/tools/cryptonote/Signatures.h
     src/base/tools/cryptonote/umul128.h
     src/base/tools/cryptonote/WalletAddress.h
@@ -137,6 +139,7 @@ set(SOURCES_BASE
     src/base/tools/cryptonote/BlockTemplate.cpp
     src/base/tools/cryptonote/crypto-ops-data.c
     src/base/tools/cryptonote/crypto-ops.c
+    src/base/tools/cryptonote/SignatureEngine.cpp
     src/base/tools/cryptonote/Signatures.cpp
     src/base/tools/cryptonote/WalletAddress.cpp
     src/base/tools/Cvt.cpp
@@ -173,6 +176,23 @@ if (WITH_HWLOC)
 endif()
 
 
+if (XMRIG_64_BIT AND CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64)$")
+    add_definitions(/DXMRIG_FEATURE_SIGNATURES_AVX2)
+    list(APPEND SOURCES_BASE src/base/tools/cryptonote/crypto-ops-avx2.c)
+
+    if (CMAKE_C_COMPILER_ID MATCHES GNU OR CMAKE_C_COMPILER_ID MATCHES Clang)
+        set_source_files_properties(src/base/tools/cryptonote/crypto-ops-avx2.c PROPERTIES COMPILE_FLAGS -mavx2)
+    endif()
+
+    add_definitions(/DXMRIG_FEATURE_KECCAK_AVX2)
+    list(APPEND SOURCES_BASE src/base/crypto/keccak-avx2.cpp)
+
+    if (CMAKE_CXX_COMPILER_ID MATCHES GNU OR CMAKE_CXX_COMPILER_ID MATCHES Clang)
+        set_source_files_properties(src/base/crypto/keccak-avx2.cpp PROPERTIES COMPILE_FLAGS -mavx2)
+    endif()
+endif()
+
+
 if (NOT WIN32)
     CHECK_INCLUDE_FILE (syslog.h HAVE_SYSLOG_H)
     if (HAVE_SYSLOG_H)
@@ -265,11 +285,13 @@ if (WITH_RANDOMX AND WITH_BENCHMARK)
     list(APPEND HEADERS_BASE
         src/base/net/stratum/benchmark/BenchClient.h
         src/base/net/stratum/benchmark/BenchConfig.h
+        src/base/net/stratum/benchmark/BenchReport.h
         )
 
     list(APPEND SOURCES_BASE
         src/base/net/stratum/benchmark/BenchClient.cpp
         src/base/net/stratum/benchmark/BenchConfig.cpp
+        src/base/net/stratum/benchmark/BenchReport.cpp
         )
 else()
     remove_definitions(/DXMRIG_FEATURE_BENCHMARK)
@@ -0,0 +1,89 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "base/crypto/keccak_lanes.h"
+
+
+#include <immintrin.h>
+
+
+namespace xmrig {
+
+
+struct KeccakLanesAVX2
+{
+    using V = __m256i;
+
+    static inline V xor_(V a, V b)      { return _mm256_xor_si256(a, b); }
+    static inline V andnot(V a, V b)    { return _mm256_andnot_si256(a, b); }
+    static inline V set1(uint64_t x)    { return _mm256_set1_epi64x(static_cast<int64_t>(x)); }
+
+    template<int n>
+    static inline V rotl(V a)           { return _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - n)); }
+};
+
+
+void keccakf_x4_avx2(uint64_t *const *st, int rounds, const uint64_t *rndc)
+{
+    __m256i s[25];
+
+    // 4x4 transpose of 64-bit lanes, state i of the group goes to element i of every vector.
+    for (int i = 0; i < 24; i += 4) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(st[0] + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(st[1] + i));
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(st[2] + i));
+        const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(st[3] + i));
+
+        const __m256i ab0 = _mm256_unpacklo_epi64(a, b);
+        const __m256i ab1 = _mm256_unpackhi_epi64(a, b);
+        const __m256i cd0 = _mm256_unpacklo_epi64(c, d);
+        const __m256i cd1 = _mm256_unpackhi_epi64(c, d);
+
+        s[i]     = _mm256_permute2x128_si256(ab0, cd0, 0x20);
+        s[i + 1] = _mm256_permute2x128_si256(ab1, cd1, 0x20);
+        s[i + 2] = _mm256_permute2x128_si256(ab0, cd0, 0x31);
+        s[i + 3] = _mm256_permute2x128_si256(ab1, cd1, 0x31);
+    }
+
+    s[24] = _mm256_set_epi64x(static_cast<int64_t>(st[3][24]), static_cast<int64_t>(st[2][24]), static_cast<int64_t>(st[1][24]), static_cast<int64_t>(st[0][24]));
+
+    keccakf_lanes<KeccakLanesAVX2>(s, rounds, rndc);
+
+    for (int i = 0; i < 24; i += 4) {
+        const __m256i ab0 = _mm256_unpacklo_epi64(s[i], s[i + 1]);
+        const __m256i ab1 = _mm256_unpackhi_epi64(s[i], s[i + 1]);
+        const __m256i cd0 = _mm256_unpacklo_epi64(s[i + 2], s[i + 3]);
+        const __m256i cd1 = _mm256_unpackhi_epi64(s[i + 2], s[i + 3]);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(st[0] + i), _mm256_permute2x128_si256(ab0, cd0, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(st[1] + i), _mm256_permute2x128_si256(ab1, cd1, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(st[2] + i), _mm256_permute2x128_si256(ab0, cd0, 0x31));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(st[3] + i), _mm256_permute2x128_si256(ab1, cd1, 0x31));
+    }
+
+    alignas(32) uint64_t last[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(last), s[24]);
+
+    for (int i = 0; i < 4; ++i) {
+        st[i][24] = last[i];
+    }
+}
+
+
+} // namespace xmrig
@@ -28,6 +28,24 @@
 
 
 #include "base/crypto/keccak.h"
+#include "base/crypto/keccak_lanes.h"
+
+
+#if defined(_M_X64) || defined(__x86_64__)
+#   include <emmintrin.h>
+#endif
+
+
+#ifdef XMRIG_FEATURE_KECCAK_AVX2
+#   include "backend/cpu/Cpu.h"
+
+
+namespace xmrig {
+
+void keccakf_x4_avx2(uint64_t *const *st, int rounds, const uint64_t *rndc);
+
+} // namespace xmrig
+#endif
 
 
 #define HASH_DATA_AREA 136
@@ -200,3 +218,156 @@ void xmrig::keccak(const uint8_t *in, int inlen, uint8_t *md, int mdlen)
 
     memcpy(md, st, mdlen);
 }
+
+
+#if defined(_M_X64) || defined(__x86_64__)
+namespace xmrig {
+
+
+struct KeccakLanesSSE2
+{
+    using V = __m128i;
+
+    static inline V xor_(V a, V b)      { return _mm_xor_si128(a, b); }
+    static inline V andnot(V a, V b)    { return _mm_andnot_si128(a, b); }
+    static inline V set1(uint64_t x)    { return _mm_set1_epi64x(static_cast<int64_t>(x)); }
+
+    template<int n>
+    static inline V rotl(V a)           { return _mm_or_si128(_mm_slli_epi64(a, n), _mm_srli_epi64(a, 64 - n)); }
+};
+
+
+} // namespace xmrig
+#endif
+
+
+bool xmrig::keccakf_x2(uint64_t *const *st, int rounds)
+{
+#   if defined(_M_X64) || defined(__x86_64__)
+    uint64_t *a = st[0];
+    uint64_t *b = st[1];
+    __m128i s[25];
+
+    for (int i = 0; i < 24; i += 2) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+
+        s[i]     = _mm_unpacklo_epi64(x, y);
+        s[i + 1] = _mm_unpackhi_epi64(x, y);
+    }
+
+    s[24] = _mm_set_epi64x(static_cast<int64_t>(b[24]), static_cast<int64_t>(a[24]));
+
+    keccakf_lanes<KeccakLanesSSE2>(s, rounds, keccakf_rndc);
+
+    for (int i = 0; i < 24; i += 2) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(a + i), _mm_unpacklo_epi64(s[i], s[i + 1]));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(b + i), _mm_unpackhi_epi64(s[i], s[i + 1]));
+    }
+
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(a + 24), s[24]);
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(b + 24), _mm_unpackhi_epi64(s[24], s[24]));
+
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+
+bool xmrig::keccakf_x4(uint64_t *const *st, int rounds)
+{
+#   ifdef XMRIG_FEATURE_KECCAK_AVX2
+    static const bool avx2 = Cpu::info()->hasAVX2();
+
+    if (avx2) {
+        keccakf_x4_avx2(st, rounds, keccakf_rndc);
+
+        return true;
+    }
+#   endif
+
+    return false;
+}
+
+
+void xmrig::keccakf(uint64_t *const *st, size_t count, int rounds)
+{
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        if (!keccakf_x4(st + i, rounds)) {
+            break;
+        }
+    }
+
+    for (; i + 2 <= count; i += 2) {
+        if (!keccakf_x2(st + i, rounds)) {
+            break;
+        }
+    }
+
+    for (; i < count; ++i) {
+        keccakf(st[i], rounds);
+    }
+}
+
+
+void xmrig::keccak(const uint8_t *in, size_t inlen, uint8_t *const *md, size_t count)
+{
+    if (count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            keccak(in + inlen * i, inlen, md[i]);
+        }
+
+        return;
+    }
+
+    constexpr size_t kMaxLanes = 8;
+
+    if (count > kMaxLanes) {
+        keccak(in, inlen, md, kMaxLanes);
+        keccak(in + inlen * kMaxLanes, inlen, md + kMaxLanes, count - kMaxLanes);
+
+        return;
+    }
+
+    constexpr size_t rsizw = HASH_DATA_AREA / 8;
+    alignas(8) uint8_t temp[HASH_DATA_AREA];
+    uint64_t *st[kMaxLanes];
+
+    for (size_t i = 0; i < count; ++i) {
+        st[i] = reinterpret_cast<uint64_t *>(md[i]);
+        memset(st[i], 0, sizeof(state_t));
+    }
+
+    size_t offset = 0;
+
+    for (; inlen - offset >= HASH_DATA_AREA; offset += HASH_DATA_AREA) {
+        for (size_t i = 0; i < count; ++i) {
+            memcpy(temp, in + inlen * i + offset, HASH_DATA_AREA);
+
+            for (size_t j = 0; j < rsizw; ++j) {
+                st[i][j] ^= reinterpret_cast<const uint64_t *>(temp)[j];
+            }
+        }
+
+        keccakf(st, count, KECCAK_ROUNDS);
+    }
+
+    // last block and padding
+    const size_t rest = inlen - offset;
+
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(temp, in + inlen * i + offset, rest);
+        temp[rest] = 1;
+        memset(temp + rest + 1, 0, HASH_DATA_AREA - rest - 1);
+        temp[HASH_DATA_AREA - 1] |= 0x80;
+
+        for (size_t j = 0; j < rsizw; ++j) {
+            st[i][j] ^= reinterpret_cast<const uint64_t *>(temp)[j];
+        }
+    }
+
+    keccakf(st, count, KECCAK_ROUNDS);
+}
@@ -27,6 +27,7 @@
 #ifndef XMRIG_KECCAK_H
 #define XMRIG_KECCAK_H
 
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 
@@ -51,6 +52,16 @@ inline void keccak(const char *in, size_t inlen, uint8_t *md)
 // update the state
 void keccakf(uint64_t st[25], int norounds);
 
+// update count independent states, 4 or 2 of them are permuted at once with SIMD if possible
+void keccakf(uint64_t *const *st, size_t count, int norounds);
+
+// compute keccak states (200 bytes, 8 byte aligned) of count inputs of the same length stored one after another
+void keccak(const uint8_t *in, size_t inlen, uint8_t *const *md, size_t count);
+
+// SIMD permutation of exactly 2 or 4 states, returns false if the CPU or the build doesn't support it
+bool keccakf_x2(uint64_t *const *st, int norounds);
+bool keccakf_x4(uint64_t *const *st, int norounds);
+
 } /* namespace xmrig */
 
 #endif /* XMRIG_KECCAK_H */
@@ -0,0 +1,105 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_KECCAK_LANES_H
+#define XMRIG_KECCAK_LANES_H
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+/**
+ * Keccak-f[1600] permutation of several independent states, one 64-bit lane of every state per SIMD element.
+ *
+ * L provides the vector type V and xor_(), andnot() (~a & b), rotl<n>() and set1() for it, the round
+ * structure is exactly the same as the scalar keccakf().
+ */
+template<typename L>
+static inline void keccakf_lanes(typename L::V st[25], int rounds, const uint64_t *rndc)
+{
+    using V = typename L::V;
+
+    for (int round = 0; round < rounds; ++round) {
+        V bc[5];
+
+        // Theta
+        for (int i = 0; i < 5; ++i) {
+            bc[i] = L::xor_(L::xor_(L::xor_(st[i], st[i + 5]), L::xor_(st[i + 10], st[i + 15])), st[i + 20]);
+        }
+
+        for (int i = 0; i < 5; ++i) {
+            const V t = L::xor_(bc[(i + 4) % 5], L::template rotl<1>(bc[(i + 1) % 5]));
+
+            st[i     ] = L::xor_(st[i     ], t);
+            st[i +  5] = L::xor_(st[i +  5], t);
+            st[i + 10] = L::xor_(st[i + 10], t);
+            st[i + 15] = L::xor_(st[i + 15], t);
+            st[i + 20] = L::xor_(st[i + 20], t);
+        }
+
+        // Rho Pi
+        const V t = st[1];
+        st[ 1] = L::template rotl<44>(st[ 6]);
+        st[ 6] = L::template rotl<20>(st[ 9]);
+        st[ 9] = L::template rotl<61>(st[22]);
+        st[22] = L::template rotl<39>(st[14]);
+        st[14] = L::template rotl<18>(st[20]);
+        st[20] = L::template rotl<62>(st[ 2]);
+        st[ 2] = L::template rotl<43>(st[12]);
+        st[12] = L::template rotl<25>(st[13]);
+        st[13] = L::template rotl< 8>(st[19]);
+        st[19] = L::template rotl<56>(st[23]);
+        st[23] = L::template rotl<41>(st[15]);
+        st[15] = L::template rotl<27>(st[ 4]);
+        st[ 4] = L::template rotl<14>(st[24]);
+        st[24] = L::template rotl< 2>(st[21]);
+        st[21] = L::template rotl<55>(st[ 8]);
+        st[ 8] = L::template rotl<45>(st[16]);
+        st[16] = L::template rotl<36>(st[ 5]);
+        st[ 5] = L::template rotl<28>(st[ 3]);
+        st[ 3] = L::template rotl<21>(st[18]);
+        st[18] = L::template rotl<15>(st[17]);
+        st[17] = L::template rotl<10>(st[11]);
+        st[11] = L::template rotl< 6>(st[ 7]);
+        st[ 7] = L::template rotl< 3>(st[10]);
+        st[10] = L::template rotl< 1>(t);
+
+        // Chi
+        for (int j = 0; j < 25; j += 5) {
+            for (int i = 0; i < 5; ++i) {
+                bc[i] = st[j + i];
+            }
+
+            for (int i = 0; i < 5; ++i) {
+                st[j + i] = L::xor_(bc[i], L::andnot(bc[(i + 1) % 5], bc[(i + 2) % 5]));
+            }
+        }
+
+        // Iota
+        st[0] = L::xor_(st[0], L::set1(rndc[round]));
+    }
+}
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_KECCAK_LANES_H */
@@ -21,9 +21,13 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/io/Signals.h"
+#include "base/kernel/Process.h"
 #include "base/tools/Handle.h"
 
 
+#include <cstdint>
+
+
 #ifdef SIGUSR1
 static const int signums[xmrig::Signals::kSignalsCount] = { SIGHUP, SIGINT, SIGTERM, SIGUSR1 };
 #else
@@ -31,9 +35,20 @@ static const int signums[xmrig::Signals::kSignalsCount] = { SIGHUP, SIGINT, SIGT
 #endif
 
 
+namespace xmrig {
+
+
+static Signals *instance = nullptr;
+
+
+} // namespace xmrig
+
+
 xmrig::Signals::Signals(ISignalListener *listener)
     : m_listener(listener)
 {
+    instance = this;
+
 #   ifndef XMRIG_OS_WIN
     signal(SIGPIPE, SIG_IGN);
 #   endif
@@ -52,13 +67,40 @@ xmrig::Signals::Signals(ISignalListener *listener)
 
 xmrig::Signals::~Signals()
 {
+    if (instance == this) {
+        instance = nullptr;
+    }
+
     for (auto signal : m_signals) {
         Handle::close(signal);
     }
 }
 
 
-void xmrig::Signals::onSignal(uv_signal_t *handle, int signum)
+// uv_kill() terminates the process on Windows without shutdown, there the signal is delivered from the event loop.
+void xmrig::Signals::raise(int signum)
+{
+#   ifdef XMRIG_OS_WIN
+    auto timer  = new uv_timer_t;
+    timer->data = reinterpret_cast<void *>(static_cast<intptr_t>(signum));
+
+    uv_timer_init(uv_default_loop(), timer);
+    uv_timer_start(timer, [](uv_timer_t *handle) {
+        const int signum = static_cast<int>(reinterpret_cast<intptr_t>(handle->data));
+
+        Handle::close(handle);
+
+        if (instance) {
+            instance->dispatch(signum);
+        }
+    }, 0, 0);
+#   else
+    uv_kill(Process::pid(), signum);
+#   endif
+}
+
+
+void xmrig::Signals::dispatch(int signum)
 {
     switch (signum)
     {
@@ -84,5 +126,11 @@ void xmrig::Signals::onSignal(uv_signal_t *handle, int signum)
         break;
     }
 
-    static_cast<Signals *>(handle->data)->m_listener->onSignal(signum);
+    m_listener->onSignal(signum);
+}
+
+
+void xmrig::Signals::onSignal(uv_signal_t *handle, int signum)
+{
+    static_cast<Signals *>(handle->data)->dispatch(signum);
 }
@@ -50,8 +50,11 @@ public:
     Signals(ISignalListener *listener);
     ~Signals();
 
+    static void raise(int signum);
+
 private:
     void close(int signum);
+    void dispatch(int signum);
 
     static void onSignal(uv_signal_t *handle, int signum);
 
@@ -41,6 +41,7 @@ public:
         return setThreadAffinity(static_cast<uint64_t>(cpu_id));
     }
 
+    static bool resetThreadAffinity();
     static bool setThreadAffinity(uint64_t cpu_id);
     static void init(const char *userAgent);
     static void setProcessPriority(int priority);
@@ -27,6 +27,21 @@
 
 
 #ifndef XMRIG_OS_APPLE
+bool xmrig::Platform::resetThreadAffinity()
+{
+    auto cpu            = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_bitmap_t set  = hwloc_bitmap_alloc();
+
+    // Binding of the process includes CPUs of all its threads, so it is the mask the process was started with.
+    const bool result = hwloc_get_cpubind(cpu->topology(), set, HWLOC_CPUBIND_PROCESS) >= 0 &&
+                        hwloc_set_cpubind(cpu->topology(), set, HWLOC_CPUBIND_THREAD) >= 0;
+
+    hwloc_bitmap_free(set);
+
+    return result;
+}
+
+
 bool xmrig::Platform::setThreadAffinity(uint64_t cpu_id)
 {
     auto cpu       = static_cast<HwlocCpuInfo *>(Cpu::info());
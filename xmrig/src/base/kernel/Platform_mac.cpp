@@ -55,6 +55,12 @@ char *xmrig::Platform::createUserAgent()
 }
 
 
+bool xmrig::Platform::resetThreadAffinity()
+{
+    return true;
+}
+
+
 bool xmrig::Platform::setThreadAffinity(uint64_t cpu_id)
 {
     return true;
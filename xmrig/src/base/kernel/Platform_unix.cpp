@@ -74,6 +74,32 @@ char *xmrig::Platform::createUserAgent()
 
 
 #ifndef XMRIG_FEATURE_HWLOC
+bool xmrig::Platform::resetThreadAffinity()
+{
+    cpu_set_t mn;
+    CPU_ZERO(&mn);
+
+    // Mask of the process (the main thread is never pinned), so CPUs excluded by taskset or cpuset stay excluded.
+#   ifdef __FreeBSD__
+    if (cpuset_getaffinity(CPU_LEVEL_CPUSET, CPU_WHICH_PID, -1, sizeof(cpu_set_t), &mn) != 0) {
+        return false;
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &mn) == 0;
+#   else
+    if (sched_getaffinity(getpid(), sizeof(cpu_set_t), &mn) != 0) {
+        return false;
+    }
+
+#   ifndef __ANDROID__
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &mn) == 0;
+#   else
+    return sched_setaffinity(gettid(), sizeof(cpu_set_t), &mn) == 0;
+#   endif
+#   endif
+}
+
+
 bool xmrig::Platform::setThreadAffinity(uint64_t cpu_id)
 {
     cpu_set_t mn;
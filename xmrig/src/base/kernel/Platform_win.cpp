@@ -71,6 +71,19 @@ char *xmrig::Platform::createUserAgent()
 
 
 #ifndef XMRIG_FEATURE_HWLOC
+bool xmrig::Platform::resetThreadAffinity()
+{
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask  = 0;
+
+    if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+        return false;
+    }
+
+    return SetThreadAffinityMask(GetCurrentThread(), processMask) != 0;
+}
+
+
 bool xmrig::Platform::setThreadAffinity(uint64_t cpu_id)
 {
     const bool result = (SetThreadAffinityMask(GetCurrentThread(), 1ULL << cpu_id) != 0);
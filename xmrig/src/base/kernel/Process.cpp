@@ -43,6 +43,7 @@ namespace xmrig {
 
 
 static char pathBuf[520];
+static int processExitCode = 0;
 static std::string dataDir;
 
 
@@ -138,6 +139,12 @@ xmrig::Process::Process(int argc, char **argv) :
 }
 
 
+int xmrig::Process::exitCode()
+{
+    return processExitCode;
+}
+
+
 int xmrig::Process::ppid()
 {
 #   if UV_VERSION_HEX >= 0x011000
@@ -165,3 +172,9 @@ xmrig::String xmrig::Process::location(Location location, const char *fileName)
 
     return fmt::format("{}" XMRIG_DIR_SEPARATOR "{}", path, fileName).c_str();
 }
+
+
+void xmrig::Process::setExitCode(int code)
+{
+    processExitCode = code;
+}
@@ -46,10 +46,12 @@ public:
 
     Process(int argc, char **argv);
 
+    static int exitCode();
     static int pid();
     static int ppid();
     static String exepath();
     static String location(Location location, const char *fileName = nullptr);
+    static void setExitCode(int code);
 
     inline const Arguments &arguments() const { return m_arguments; }
 
@@ -61,6 +61,7 @@ public:
     virtual bool hasExtension(Extension extension) const noexcept           = 0;
     virtual bool isEnabled() const                                          = 0;
     virtual bool isTLS() const                                              = 0;
+    virtual bool isTLSResumed() const                                       = 0;
     virtual const char *mode() const                                        = 0;
     virtual const char *tag() const                                         = 0;
     virtual const char *tlsFingerprint() const                              = 0;
@@ -73,6 +74,7 @@ public:
     virtual int64_t send(const rapidjson::Value &obj)                       = 0;
     virtual int64_t sequence() const                                        = 0;
     virtual int64_t submit(const JobResult &result)                         = 0;
+    virtual uint64_t tlsHandshakeTime() const                               = 0;
     virtual void connect()                                                  = 0;
     virtual void connect(const Pool &pool)                                  = 0;
     virtual void deleteLater()                                              = 0;
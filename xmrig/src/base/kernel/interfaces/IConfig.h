@@ -88,6 +88,9 @@ public:
         DaemonZMQPortKey     = 1056,
         HugePagesJitKey      = 1057,
         RotationKey          = 1058,
+        BenchReportKey       = 1059,
+        BenchBaselineKey     = 1060,
+        BenchThresholdKey    = 1061,
 
         // xmrig common
         CPUPriorityKey       = 1021,
@@ -113,6 +116,7 @@ public:
         YieldKey             = 1030,
         Argon2ImplKey        = 1039,
         RandomXCacheQoSKey   = 1040,
+        RandomXHybridMemKey  = 1062,
 
         // xmrig amd
         OclPlatformKey       = 1400,
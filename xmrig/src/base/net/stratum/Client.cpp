@@ -113,6 +113,16 @@ bool xmrig::Client::isTLS() const
 }
 
 
+bool xmrig::Client::isTLSResumed() const
+{
+#   ifdef XMRIG_FEATURE_TLS
+    return isTLS() && m_tls->isResumed();
+#   else
+    return false;
+#   endif
+}
+
+
 const char *xmrig::Client::tlsFingerprint() const
 {
 #   ifdef XMRIG_FEATURE_TLS
@@ -137,6 +147,18 @@ const char *xmrig::Client::tlsVersion() const
 }
 
 
+uint64_t xmrig::Client::tlsHandshakeTime() const
+{
+#   ifdef XMRIG_FEATURE_TLS
+    if (isTLS()) {
+        return m_tls->handshakeTime();
+    }
+#   endif
+
+    return 0;
+}
+
+
 int64_t xmrig::Client::send(const rapidjson::Value &obj, Callback callback)
 {
     assert(obj["id"] == sequence());
@@ -64,11 +64,13 @@ public:
 protected:
     bool disconnect() override;
     bool isTLS() const override;
+    bool isTLSResumed() const override;
     const char *tlsFingerprint() const override;
     const char *tlsVersion() const override;
     int64_t send(const rapidjson::Value &obj, Callback callback) override;
     int64_t send(const rapidjson::Value &obj) override;
     int64_t submit(const JobResult &result) override;
+    uint64_t tlsHandshakeTime() const override;
     void connect() override;
     void connect(const Pool &pool) override;
     void deleteLater() override;
@@ -73,11 +73,13 @@ protected:
     void onResolved(const DnsRecords &records, int status, const char* error) override;
 
     inline bool hasExtension(Extension) const noexcept override         { return false; }
+    inline bool isTLSResumed() const override                           { return false; }
     inline const char *mode() const override                            { return "daemon"; }
     inline const char *tlsFingerprint() const override                  { return m_tlsFingerprint; }
     inline const char *tlsVersion() const override                      { return m_tlsVersion; }
     inline int64_t send(const rapidjson::Value &, Callback) override    { return -1; }
     inline int64_t send(const rapidjson::Value &) override              { return -1; }
+    inline uint64_t tlsHandshakeTime() const override                   { return 0; }
     void deleteLater() override;
     inline void tick(uint64_t) override                                 {}
 
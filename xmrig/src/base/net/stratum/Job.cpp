@@ -205,6 +205,7 @@ void xmrig::Job::copy(const Job &other)
     m_clientId   = other.m_clientId;
     m_id         = other.m_id;
     m_backend    = other.m_backend;
+    m_group      = other.m_group;
     m_diff       = other.m_diff;
     m_height     = other.m_height;
     m_target     = other.m_target;
@@ -255,6 +256,7 @@ void xmrig::Job::move(Job &&other)
     m_clientId   = std::move(other.m_clientId);
     m_id         = std::move(other.m_id);
     m_backend    = other.m_backend;
+    m_group      = other.m_group;
     m_diff       = other.m_diff;
     m_height     = other.m_height;
     m_target     = other.m_target;
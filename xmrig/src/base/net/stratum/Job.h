@@ -81,6 +81,7 @@ public:
     inline size_t size() const                          { return m_size; }
     inline uint32_t *nonce()                            { return reinterpret_cast<uint32_t*>(m_blob + nonceOffset()); }
     inline uint32_t backend() const                     { return m_backend; }
+    inline uint32_t group() const                       { return m_group; }
     inline uint64_t diff() const                        { return m_diff; }
     inline uint64_t height() const                      { return m_height; }
     inline uint64_t nonceMask() const                   { return isNicehash() ? 0xFFFFFFULL : (nonceSize() == sizeof(uint64_t) ? (static_cast<uint64_t>(-1LL) >> (extraNonce().size() * 4)) : 0xFFFFFFFFULL); }
@@ -94,6 +95,7 @@ public:
     inline void setBackend(uint32_t backend)            { m_backend = backend; }
     inline void setClientId(const String &id)           { m_clientId = id; }
     inline void setExtraNonce(const String &extraNonce) { m_extraNonce = extraNonce; }
+    inline void setGroup(uint32_t group)                { m_group = group; }
     inline void setHeight(uint64_t height)              { m_height = height; }
     inline void setIndex(uint8_t index)                 { m_index = index; }
     inline void setPoolWallet(const String &poolWallet) { m_poolWallet = poolWallet; }
@@ -125,6 +127,7 @@ public:
     void generateSignatureData(String& signatureData) const;
     void generateHashingBlob(String& blob) const;
 #   else
+    inline const uint8_t* ephPublicKey() const { return m_hasMinerSignature ? m_ephPublicKey : nullptr; }
     inline const uint8_t* ephSecretKey() const { return m_hasMinerSignature ? m_ephSecretKey : nullptr; }
 
     inline void setEphemeralKeys(const uint8_t *pub_key, const uint8_t *sec_key)
@@ -154,6 +157,7 @@ private:
     String m_id;
     String m_poolWallet;
     uint32_t m_backend  = 0;
+    uint32_t m_group    = 0;
     uint64_t m_diff     = 0;
     uint64_t m_height   = 0;
     uint64_t m_target   = 0;
@@ -128,6 +128,8 @@ rapidjson::Value xmrig::NetworkState::getConnection(rapidjson::Document &doc, in
     connection.AddMember("failures",        m_failures, allocator);
     connection.AddMember("tls",             m_tls.toJSON(), allocator);
     connection.AddMember("tls-fingerprint", m_fingerprint.toJSON(), allocator);
+    connection.AddMember("tls-handshake",   m_tls.isNull() ? Value(kNullType) : Value(m_tlsHandshake), allocator);
+    connection.AddMember("tls-resumed",     m_tlsResumed, allocator);
 
     connection.AddMember("algo",            m_algorithm.toJSON(), allocator);
     connection.AddMember("diff",            m_diff, allocator);
@@ -189,6 +191,10 @@ void xmrig::NetworkState::printConnection() const
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CYAN_BOLD("%s ") BLACK_BOLD("(%s) ") GREEN_BOLD("%s"),
                "pool address", m_pool, m_ip.data(), m_tls.isNull() ? "" : m_tls.data());
 
+    if (!m_tls.isNull()) {
+        Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") CYAN_BOLD("%" PRIu64 " ms") BLACK_BOLD(" (%s)"), "TLS handshake", m_tlsHandshake, m_tlsResumed ? "resumed" : "full");
+    }
+
     Log::print(GREEN_BOLD(" * ") WHITE_BOLD("%-17s") WHITE_BOLD("%s"), "algorithm", m_algorithm.name());
     printDiff(m_diff);
     printLatency(latency());
@@ -262,6 +268,8 @@ void xmrig::NetworkState::onActive(IStrategy *strategy, IClient *client)
     m_ip             = client->ip();
     m_tls            = client->tlsVersion();
     m_fingerprint    = client->tlsFingerprint();
+    m_tlsHandshake   = client->tlsHandshakeTime();
+    m_tlsResumed     = client->isTLSResumed();
     m_active         = true;
     m_connectionTime = Chrono::steadyMSecs();
 
@@ -343,6 +351,7 @@ void xmrig::NetworkState::add(const SubmitResult &result, const char *error)
     }
 
     m_latency.push_back(result.elapsed > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(result.elapsed));
+    m_latencySum += result.elapsed;
 }
 
 
@@ -353,6 +362,7 @@ void xmrig::NetworkState::stop()
     m_ip          = nullptr;
     m_tls         = nullptr;
     m_fingerprint = nullptr;
+    m_tlsResumed  = false;
 
     m_failures++;
     m_latency.clear();
@@ -40,6 +40,10 @@ public:
 
     inline const Algorithm &algorithm() const   { return m_algorithm; }
     inline uint64_t accepted() const            { return m_accepted; }
+    inline uint64_t diff() const                { return m_diff; }
+    inline uint64_t failures() const            { return m_failures; }
+    inline uint64_t hashes() const              { return m_hashes; }
+    inline uint64_t latencySum() const          { return m_latencySum; }
     inline uint64_t rejected() const            { return m_rejected; }
 
 #   ifdef XMRIG_FEATURE_API
@@ -68,6 +72,7 @@ private:
 
     Algorithm m_algorithm;
     bool m_active               = false;
+    bool m_tlsResumed           = false;
     char m_pool[256]{};
     std::array<uint64_t, 10> m_topDiff { { } };
     std::vector<uint16_t> m_latency;
@@ -79,7 +84,9 @@ private:
     uint64_t m_diff             = 0;
     uint64_t m_failures         = 0;
     uint64_t m_hashes           = 0;
+    uint64_t m_latencySum       = 0;    // ms, of all accepted results, unlike m_latency never cleared
     uint64_t m_rejected         = 0;
+    uint64_t m_tlsHandshake     = 0;    // ms
 };
 
 
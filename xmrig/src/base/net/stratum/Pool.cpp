@@ -68,6 +68,7 @@ const char *Pool::kDaemonPollInterval     = "daemon-poll-interval";
 const char *Pool::kDaemonZMQPort          = "daemon-zmq-port";
 const char *Pool::kEnabled                = "enabled";
 const char *Pool::kFingerprint            = "tls-fingerprint";
+const char *Pool::kGroup                  = "group";
 const char *Pool::kKeepalive              = "keepalive";
 const char *Pool::kNicehash               = "nicehash";
 const char *Pool::kPass                   = "pass";
@@ -128,6 +129,7 @@ xmrig::Pool::Pool(const rapidjson::Value &object) :
     m_daemon         = Json::getString(object, kSelfSelect);
     m_proxy          = Json::getValue(object, kSOCKS5);
     m_zmqPort        = Json::getInt(object, kDaemonZMQPort, m_zmqPort);
+    m_group          = Json::getUint(object, kGroup);
 
     m_flags.set(FLAG_ENABLED,  Json::getBool(object, kEnabled, true));
     m_flags.set(FLAG_NICEHASH, Json::getBool(object, kNicehash) || m_url.host().contains(kNicehashHost));
@@ -209,6 +211,7 @@ bool xmrig::Pool::isEqual(const Pool &other) const
             && m_pollInterval == other.m_pollInterval
             && m_daemon       == other.m_daemon
             && m_proxy        == other.m_proxy
+            && m_group        == other.m_group
             );
 }
 
@@ -297,6 +300,10 @@ rapidjson::Value xmrig::Pool::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kDaemon),       m_mode == MODE_DAEMON, allocator);
     obj.AddMember(StringRef(kSOCKS5),       m_proxy.toJSON(doc), allocator);
 
+#   ifdef XMRIG_MINER_PROJECT
+    obj.AddMember(StringRef(kGroup),        m_group, allocator);
+#   endif
+
     if (m_mode == MODE_DAEMON) {
         obj.AddMember(StringRef(kDaemonPollInterval), m_pollInterval, allocator);
         obj.AddMember(StringRef(kDaemonZMQPort), m_zmqPort, allocator);
@@ -321,6 +328,10 @@ std::string xmrig::Pool::printableName() const
         out += std::string(" algo ") + WHITE_BOLD_S + (m_algorithm.isValid() ? m_algorithm.name() : "auto") + CLEAR;
     }
 
+    if (m_group > 0) {
+        out += std::string(" group ") + WHITE_BOLD_S + std::to_string(m_group) + CLEAR;
+    }
+
     if (m_mode == MODE_SELF_SELECT) {
         out += std::string(" self-select ") + CSI "1;" + std::to_string(m_daemon.isTLS() ? 32 : 36) + "m" + m_daemon.url().data() + WHITE_BOLD_S + (m_submitToOrigin ? " submit-to-origin" : "") + CLEAR;
     }
@@ -61,6 +61,7 @@ public:
     static const char *kDaemonPollInterval;
     static const char *kEnabled;
     static const char *kFingerprint;
+    static const char *kGroup;
     static const char *kKeepalive;
     static const char *kNicehash;
     static const char *kPass;
@@ -109,6 +110,7 @@ public:
     inline Mode mode() const                            { return m_mode; }
     inline uint16_t port() const                        { return m_url.port(); }
     inline int zmq_port() const                         { return m_zmqPort; }
+    inline uint32_t group() const                       { return m_group; }
     inline uint64_t pollInterval() const                { return m_pollInterval; }
     inline void setAlgo(const Algorithm &algorithm)     { m_algorithm = algorithm; }
     inline void setUrl(const char *url)                 { m_url = Url(url); }
@@ -155,6 +157,7 @@ private:
     String m_rigId;
     String m_user;
     String m_spendSecretKey;
+    uint32_t m_group                = 0;
     uint64_t m_pollInterval         = kDefaultPollInterval;
     Url m_daemon;
     Url m_url;
@@ -37,6 +37,9 @@
 #endif
 
 
+#include <algorithm>
+
+
 namespace xmrig {
 
 
@@ -80,11 +83,12 @@ int xmrig::Pools::donateLevel() const
 }
 
 
-xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) const
+// Pools of each group are independent failover lists, group 0 is the main one.
+xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener, uint32_t group) const
 {
-    if (active() == 1) {
+    if (active(group) == 1) {
         for (const Pool &pool : m_data) {
-            if (pool.isEnabled()) {
+            if (pool.isEnabled() && pool.group() == group) {
                 return new SinglePoolStrategy(pool, retryPause(), retries(), listener);
             }
         }
@@ -92,7 +96,7 @@ xmrig::IStrategy *xmrig::Pools::createStrategy(IStrategyListener *listener) cons
 
     auto strategy = new FailoverStrategy(retryPause(), retries(), listener);
     for (const Pool &pool : m_data) {
-        if (pool.isEnabled()) {
+        if (pool.isEnabled() && pool.group() == group) {
             strategy->add(pool);
         }
     }
@@ -116,11 +120,11 @@ rapidjson::Value xmrig::Pools::toJSON(rapidjson::Document &doc) const
 }
 
 
-size_t xmrig::Pools::active() const
+size_t xmrig::Pools::active(uint32_t group) const
 {
     size_t count = 0;
     for (const Pool &pool : m_data) {
-        if (pool.isEnabled()) {
+        if (pool.isEnabled() && pool.group() == group) {
             count++;
         }
     }
@@ -129,6 +133,21 @@ size_t xmrig::Pools::active() const
 }
 
 
+std::vector<uint32_t> xmrig::Pools::groups() const
+{
+    std::vector<uint32_t> out;
+    for (const Pool &pool : m_data) {
+        if (pool.isEnabled() && pool.group() > 0 && std::find(out.begin(), out.end(), pool.group()) == out.end()) {
+            out.push_back(pool.group());
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+
+    return out;
+}
+
+
 void xmrig::Pools::load(const IJsonReader &reader)
 {
     m_data.clear();
@@ -73,9 +73,10 @@ public:
 
     bool isEqual(const Pools &other) const;
     int donateLevel() const;
-    IStrategy *createStrategy(IStrategyListener *listener) const;
+    IStrategy *createStrategy(IStrategyListener *listener, uint32_t group = 0) const;
     rapidjson::Value toJSON(rapidjson::Document &doc) const;
-    size_t active() const;
+    size_t active(uint32_t group = 0) const;
+    std::vector<uint32_t> groups() const;
     uint32_t benchSize() const;
     void load(const IJsonReader &reader);
     void print() const;
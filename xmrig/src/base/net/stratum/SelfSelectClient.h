@@ -49,6 +49,7 @@ protected:
     inline bool hasExtension(Extension extension) const noexcept override           { return m_client->hasExtension(extension); }
     inline bool isEnabled() const override                                          { return m_client->isEnabled(); }
     inline bool isTLS() const override                                              { return m_client->isTLS(); }
+    inline bool isTLSResumed() const override                                       { return m_client->isTLSResumed(); }
     inline const char *mode() const override                                        { return m_client->mode(); }
     inline const char *tag() const override                                         { return m_client->tag(); }
     inline const char *tlsFingerprint() const override                              { return m_client->tlsFingerprint(); }
@@ -60,6 +61,7 @@ protected:
     inline int64_t send(const rapidjson::Value &obj, Callback callback) override    { return m_client->send(obj, callback); }
     inline int64_t send(const rapidjson::Value &obj) override                       { return m_client->send(obj); }
     inline int64_t sequence() const override                                        { return m_client->sequence(); }
+    inline uint64_t tlsHandshakeTime() const override                               { return m_client->tlsHandshakeTime(); }
     inline void connect() override                                                  { m_client->connect(); }
     inline void connect(const Pool &pool) override                                  { m_client->connect(pool); }
     inline void deleteLater() override                                              { m_client->deleteLater(); }
@@ -20,6 +20,7 @@
 #include "base/net/stratum/Tls.h"
 #include "base/io/log/Log.h"
 #include "base/net/stratum/Client.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 
 
@@ -29,11 +30,48 @@
 
 
 #include <cassert>
+#include <map>
 #include <openssl/ssl.h>
 
 
+#if OPENSSL_VERSION_NUMBER >= 0x1010100fL && !defined(LIBRESSL_VERSION_NUMBER)
+#   define XMRIG_TLS_V13
+#endif
+
+
+namespace xmrig {
+
+
+// Last session (TLS 1.2 session id or TLS 1.3 ticket) for each pool, shared by all clients and kept across reconnects.
+static std::map<std::string, SSL_SESSION *> sessions;
+
+
+static void setSession(const std::string &key, SSL_SESSION *session)
+{
+    auto it = sessions.find(key);
+    if (it != sessions.end()) {
+        SSL_SESSION_free(it->second);
+
+        if (!session) {
+            sessions.erase(it);
+
+            return;
+        }
+
+        it->second = session;
+    }
+    else if (session) {
+        sessions.emplace(key, session);
+    }
+}
+
+
+} // namespace xmrig
+
+
 xmrig::Client::Tls::Tls(Client *client) :
-    m_client(client)
+    m_client(client),
+    m_key(std::string(client->m_pool.host().data()) + ":" + std::to_string(client->m_pool.port()))
 {
     m_ctx = SSL_CTX_new(SSLv23_method());
     assert(m_ctx != nullptr);
@@ -45,6 +83,8 @@ xmrig::Client::Tls::Tls(Client *client) :
     m_write = BIO_new(BIO_s_mem());
     m_read  = BIO_new(BIO_s_mem());
     SSL_CTX_set_options(m_ctx, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+    SSL_CTX_set_session_cache_mode(m_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(m_ctx, onNewSession);
 }
 
 
@@ -55,6 +95,11 @@ xmrig::Client::Tls::~Tls()
     }
 
     if (m_ssl) {
+        // Pool connections are closed without TLS shutdown, otherwise OpenSSL would mark the cached session as not resumable.
+        if (m_ready) {
+            SSL_set_shutdown(m_ssl, SSL_SENT_SHUTDOWN | SSL_RECEIVED_SHUTDOWN);
+        }
+
         SSL_free(m_ssl);
     }
 }
@@ -69,16 +114,53 @@ bool xmrig::Client::Tls::handshake()
         return false;
     }
 
+    SSL_set_app_data(m_ssl, this);
     SSL_set_connect_state(m_ssl);
     SSL_set_bio(m_ssl, m_read, m_write);
+
+    m_ts = Chrono::steadyMSecs();
+
+    auto it = sessions.find(m_key);
+    if (it != sessions.end() && SSL_set_session(m_ssl, it->second) == 1) {
+#       ifdef XMRIG_TLS_V13
+        m_earlyData = SSL_SESSION_get_max_early_data(it->second) > 0;
+#       endif
+    }
+
+    // Login request goes in the first flight together with ClientHello, if the pool doesn't accept it, it is sent again after the handshake.
+    if (m_earlyData) {
+        m_client->login();
+
+        return true;
+    }
+
     SSL_do_handshake(m_ssl);
 
     return send();
 }
 
 
+bool xmrig::Client::Tls::isResumed() const
+{
+    return m_ready && SSL_session_reused(m_ssl) == 1;
+}
+
+
 bool xmrig::Client::Tls::send(const char *data, size_t size)
 {
+#   ifdef XMRIG_TLS_V13
+    if (m_earlyData && !SSL_is_init_finished(m_ssl)) {
+        size_t written = 0;
+
+        if (SSL_write_early_data(m_ssl, data, size, &written) != 1) {
+            m_earlyData = false;
+            SSL_do_handshake(m_ssl);
+        }
+
+        return send();
+    }
+#   endif
+
     SSL_write(m_ssl, data, size);
 
     return send();
@@ -106,23 +188,39 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
 
         if (rc < 0 && SSL_get_error(m_ssl, rc) == SSL_ERROR_WANT_READ) {
             send();
-        } else if (rc == 1) {
-            X509 *cert = SSL_get_peer_certificate(m_ssl);
-            if (!verify(cert)) {
-                X509_free(cert);
-                m_client->close();
 
-                return;
-            }
+            return;
+        }
+
+        if (rc != 1) {
+            // Cached session could be the reason, next connection makes a full handshake.
+            setSession(m_key, nullptr);
 
+            return;
+        }
+
+        X509 *cert = SSL_get_peer_certificate(m_ssl);
+        if (!verify(cert)) {
             X509_free(cert);
-            m_ready = true;
-            m_client->login();
-      }
+            setSession(m_key, nullptr);
+            m_client->close();
+
+            return;
+        }
+
+        X509_free(cert);
+        m_handshakeTime = Chrono::steadyMSecs() - m_ts;
+        m_ready         = true;
 
-      return;
+        if (isEarlyDataAccepted()) {
+            send();
+        }
+        else {
+            m_client->login();
+        }
     }
 
+    // Application data (pool response to the early data login) may arrive together with the last handshake message.
     static char buf[16384]{};
     int bytes_read = 0;
 
@@ -132,6 +230,35 @@ void xmrig::Client::Tls::read(const char *data, size_t size)
 }
 
 
+int xmrig::Client::Tls::onNewSession(SSL *ssl, SSL_SESSION *session)
+{
+    const auto tls = static_cast<const Tls *>(SSL_get_app_data(ssl));
+    if (!tls) {
+        return 0;
+    }
+
+#   ifdef XMRIG_TLS_V13
+    if (!SSL_SESSION_is_resumable(session)) {
+        return 0;
+    }
+#   endif
+
+    setSession(tls->m_key, session);
+
+    return 1;
+}
+
+
+bool xmrig::Client::Tls::isEarlyDataAccepted() const
+{
+#   ifdef XMRIG_TLS_V13
+    return m_earlyData && SSL_get_early_data_status(m_ssl) == SSL_EARLY_DATA_ACCEPTED;
+#   else
+    return false;
+#   endif
+}
+
+
 bool xmrig::Client::Tls::send()
 {
     return m_client->send(m_write);
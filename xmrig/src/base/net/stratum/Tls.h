@@ -21,16 +21,20 @@
 #define XMRIG_CLIENT_TLS_H
 
 
-using BIO       = struct bio_st;
-using SSL       = struct ssl_st;
-using SSL_CTX   = struct ssl_ctx_st;
-using X509      = struct x509_st;
+using BIO           = struct bio_st;
+using SSL           = struct ssl_st;
+using SSL_CTX       = struct ssl_ctx_st;
+using SSL_SESSION   = struct ssl_session_st;
+using X509          = struct x509_st;
 
 
 #include "base/net/stratum/Client.h"
 #include "base/tools/Object.h"
 
 
+#include <string>
+
+
 namespace xmrig {
 
 
@@ -42,24 +46,34 @@ public:
     Tls(Client *client);
     ~Tls();
 
+    inline uint64_t handshakeTime() const   { return m_ready ? m_handshakeTime : 0; }
+
     bool handshake();
+    bool isResumed() const;
     bool send(const char *data, size_t size);
     const char *fingerprint() const;
     const char *version() const;
     void read(const char *data, size_t size);
 
 private:
+    static int onNewSession(SSL *ssl, SSL_SESSION *session);
+
+    bool isEarlyDataAccepted() const;
     bool send();
     bool verify(X509 *cert);
     bool verifyFingerprint(X509 *cert);
 
-    BIO *m_read     = nullptr;
-    BIO *m_write    = nullptr;
-    bool m_ready    = false;
+    BIO *m_read                 = nullptr;
+    BIO *m_write                = nullptr;
+    bool m_earlyData            = false;    // login request was sent as TLS 1.3 early data
+    bool m_ready                = false;
     char m_fingerprint[32 * 2 + 8]{};
     Client *m_client;
-    SSL *m_ssl      = nullptr;
+    SSL *m_ssl                  = nullptr;
     SSL_CTX *m_ctx;
+    std::string m_key;                      // pool host:port, key in the sessions cache
+    uint64_t m_handshakeTime    = 0;
+    uint64_t m_ts               = 0;
 };
 
 
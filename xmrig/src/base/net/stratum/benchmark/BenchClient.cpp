@@ -23,8 +23,10 @@
 #include "backend/common/interfaces/IBackend.h"
 #include "backend/cpu/Cpu.h"
 #include "base/io/json/Json.h"
+#include "base/io/Signals.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/kernel/Process.h"
 #include "base/kernel/interfaces/IClientListener.h"
 #include "base/net/dns/Dns.h"
 #include "base/net/dns/DnsRecords.h"
@@ -32,13 +34,23 @@
 #include "base/net/http/HttpData.h"
 #include "base/net/http/HttpListener.h"
 #include "base/net/stratum/benchmark/BenchConfig.h"
+#include "base/net/stratum/benchmark/BenchReport.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
 #include "version.h"
 
+
+#include <csignal>
+#include <uv.h>
+
 #ifdef XMRIG_FEATURE_DMI
 #   include "hw/dmi/DmiReader.h"
 #endif
 
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/Rx.h"
+#endif
+
 
 xmrig::BenchClient::BenchClient(const std::shared_ptr<BenchConfig> &benchmark, IClientListener* listener) :
     m_listener(listener),
@@ -170,6 +182,10 @@ void xmrig::BenchClient::onBenchDone(uint64_t result, uint64_t diff, uint64_t ts
     LOG_NOTICE("%s " WHITE_BOLD("benchmark finished in ") CYAN_BOLD("%.3f seconds (%.1f h/s)") WHITE_BOLD_S " hash sum = " CLEAR "%s%016" PRIX64 CLEAR, tag(), dt, BenchState::size() / dt, color, result);
 
     if (m_token.isEmpty()) {
+        if (m_benchmark->isRegression()) {
+            return report(BenchState::size() / dt);
+        }
+
         printExit();
     }
 }
@@ -289,8 +305,58 @@ void xmrig::BenchClient::printExit() const
 }
 
 
+void xmrig::BenchClient::report(double hashrate)
+{
+    BenchReport::Result result;
+    result.algorithm = m_job.algorithm();
+    result.hashrate  = hashrate;
+    result.size      = BenchState::size();
+    result.threads   = m_threads;
+    result.hash      = m_result;
+    result.ready     = m_readyTime - m_jobTime;
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    if (result.algorithm.family() == Algorithm::RANDOM_X) {
+        result.dataset = Rx::initTime();
+    }
+#   endif
+
+    if (m_backend) {
+        rapidjson::Document doc(rapidjson::kObjectType);
+        const rapidjson::Value backend = m_backend->toJSON(doc);
+        const rapidjson::Value &pages  = Json::getArray(backend, "hugepages");
+
+        if (pages.Size() == 2 && pages[1].GetUint64() > 0) {
+            result.hugePages = static_cast<double>(pages[0].GetUint64()) * 100.0 / static_cast<double>(pages[1].GetUint64());
+        }
+    }
+
+    const uint64_t ref = referenceHash();
+    bool regression    = ref && ref != m_result;
+
+    if (!m_benchmark->baseline().isEmpty()) {
+        regression |= BenchReport::compare(m_benchmark->baseline(), result, m_benchmark->threshold());
+    }
+
+    // Runs with wrong hash sum are not a valid baseline.
+    if (!m_benchmark->report().isEmpty() && (!ref || ref == m_result) && !BenchReport::save(m_benchmark->report(), result)) {
+        regression = true;
+    }
+
+    if (regression) {
+        LOG_ERR("%s " RED_BOLD("performance regression detected"), tag());
+    }
+
+    Process::setExitCode(regression ? 1 : 0);
+
+    Signals::raise(SIGTERM);
+}
+
+
 void xmrig::BenchClient::start()
 {
+    m_jobTime = Chrono::steadyMSecs();
+
     const uint32_t size = BenchState::size();
 
     LOG_NOTICE("%s " MAGENTA_BOLD("start benchmark ") "hashes " CYAN_BOLD("%u%s") " algo " WHITE_BOLD("%s"),
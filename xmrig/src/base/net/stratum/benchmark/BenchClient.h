@@ -41,6 +41,7 @@ public:
     inline bool hasExtension(Extension) const noexcept override                     { return false; }
     inline bool isEnabled() const override                                          { return true; }
     inline bool isTLS() const override                                              { return false; }
+    inline bool isTLSResumed() const override                                       { return false; }
     inline const char *mode() const override                                        { return "benchmark"; }
     inline const char *tlsFingerprint() const override                              { return nullptr; }
     inline const char *tlsVersion() const override                                  { return nullptr; }
@@ -52,6 +53,7 @@ public:
     inline int64_t send(const rapidjson::Value &) override                          { return 0; }
     inline int64_t sequence() const override                                        { return 0; }
     inline int64_t submit(const JobResult &) override                               { return 0; }
+    inline uint64_t tlsHandshakeTime() const override                               { return 0; }
     inline void connect(const Pool &pool) override                                  { setPool(pool); }
     inline void deleteLater() override                                              { delete this; }
     inline void setAlgo(const Algorithm &algo) override                             {}
@@ -91,6 +93,7 @@ private:
     bool setSeed(const char *seed);
     uint64_t referenceHash() const;
     void printExit() const;
+    void report(double hashrate);
     void start();
 
 #   ifdef XMRIG_FEATURE_HTTP
@@ -118,6 +121,7 @@ private:
     uint64_t m_diff             = 0;
     uint64_t m_doneTime         = 0;
     uint64_t m_hash             = 0;
+    uint64_t m_jobTime          = 0;
     uint64_t m_readyTime        = 0;
     uint64_t m_result           = 0;
     uint64_t m_startTime        = 0;
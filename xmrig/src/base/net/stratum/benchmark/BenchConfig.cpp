@@ -34,13 +34,16 @@ namespace xmrig {
 
 
 const char *BenchConfig::kAlgo      = "algo";
+const char *BenchConfig::kBaseline  = "baseline";
 const char *BenchConfig::kBenchmark = "benchmark";
 const char *BenchConfig::kHash      = "hash";
 const char *BenchConfig::kId        = "id";
+const char *BenchConfig::kReport    = "report";
 const char *BenchConfig::kSeed      = "seed";
 const char *BenchConfig::kSize      = "size";
 const char *BenchConfig::kRotation  = "rotation";
 const char *BenchConfig::kSubmit    = "submit";
+const char *BenchConfig::kThreshold = "threshold";
 const char *BenchConfig::kToken     = "token";
 const char *BenchConfig::kUser      = "user";
 const char *BenchConfig::kVerify    = "verify";
@@ -58,7 +61,10 @@ xmrig::BenchConfig::BenchConfig(uint32_t size, const String &id, const rapidjson
     m_algorithm(Json::getString(object, kAlgo)),
     m_dmi(dmi),
     m_submit(Json::getBool(object, kSubmit)),
+    m_threshold(Json::getDouble(object, kThreshold, kDefaultThreshold)),
+    m_baseline(Json::getString(object, kBaseline)),
     m_id(id),
+    m_report(Json::getString(object, kReport)),
     m_seed(Json::getString(object, kSeed)),
     m_token(Json::getString(object, kToken)),
     m_user(Json::getString(object, kUser)),
@@ -78,6 +84,10 @@ xmrig::BenchConfig::BenchConfig(uint32_t size, const String &id, const rapidjson
     if (hash) {
         m_hash = strtoull(hash, nullptr, 16);
     }
+
+    if (m_threshold < 0.0) {
+        m_threshold = kDefaultThreshold;
+    }
 }
 
 
@@ -123,6 +133,9 @@ rapidjson::Value xmrig::BenchConfig::toJSON(rapidjson::Document &doc) const
     out.AddMember(StringRef(kToken),    m_token.toJSON(), allocator);
     out.AddMember(StringRef(kSeed),     m_seed.toJSON(), allocator);
     out.AddMember(StringRef(kUser),     m_user.toJSON(), allocator);
+    out.AddMember(StringRef(kBaseline), m_baseline.toJSON(), allocator);
+    out.AddMember(StringRef(kReport),   m_report.toJSON(), allocator);
+    out.AddMember(StringRef(kThreshold), m_threshold, allocator);
 
     if (m_hash) {
         out.AddMember(StringRef(kHash), Value(fmt::format("{:016X}", m_hash).c_str(), allocator), allocator);
@@ -32,13 +32,16 @@ class BenchConfig
 public:
     static const char *kAlgo;
     static const char *kApiHost;
+    static const char *kBaseline;
     static const char *kBenchmark;
     static const char *kHash;
     static const char *kId;
+    static const char *kReport;
     static const char *kSeed;
     static const char *kSize;
     static const char* kRotation;
     static const char *kSubmit;
+    static const char *kThreshold;
     static const char *kToken;
     static const char *kUser;
     static const char *kVerify;
@@ -51,18 +54,24 @@ public:
     static constexpr const uint16_t kApiPort    = 18805;
 #   endif
 
+    static constexpr double kDefaultThreshold   = 5.0;
+
     BenchConfig(uint32_t size, const String &id, const rapidjson::Value &object, bool dmi, uint32_t rotation);
 
     static BenchConfig *create(const rapidjson::Value &object, bool dmi);
 
     inline bool isDMI() const                   { return m_dmi; }
+    inline bool isRegression() const            { return !m_baseline.isEmpty() || !m_report.isEmpty(); }
     inline bool isSubmit() const                { return m_submit; }
     inline const Algorithm &algorithm() const   { return m_algorithm; }
+    inline const String &baseline() const       { return m_baseline; }
     inline const String &id() const             { return m_id; }
+    inline const String &report() const         { return m_report; }
     inline const String &seed() const           { return m_seed; }
     inline const String &token() const          { return m_token; }
     inline const String &user() const           { return m_user; }
     inline uint32_t size() const                { return m_size; }
+    inline double threshold() const             { return m_threshold; }
     inline uint64_t hash() const                { return m_hash; }
     inline uint32_t rotation() const            { return m_rotation; }
 
@@ -74,7 +83,10 @@ private:
     Algorithm m_algorithm;
     bool m_dmi;
     bool m_submit;
+    double m_threshold;
+    String m_baseline;
     String m_id;
+    String m_report;
     String m_seed;
     String m_token;
     String m_user;
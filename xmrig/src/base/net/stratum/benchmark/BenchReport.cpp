@@ -0,0 +1,260 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/net/stratum/benchmark/BenchReport.h"
+#include "3rdparty/fmt/core.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+
+
+namespace xmrig {
+
+
+static const char *kAlgo        = "algo";
+static const char *kDataset     = "dataset";
+static const char *kHash        = "hash";
+static const char *kHashrate    = "hashrate";
+static const char *kHugePages   = "hugepages";
+static const char *kReady       = "ready";
+static const char *kResults     = "results";
+static const char *kSize        = "size";
+static const char *kThreads     = "threads";
+static const char *kVersion     = "version";
+
+
+struct Baseline
+{
+    inline Baseline(const rapidjson::Value &value)
+    {
+        if (!value.IsArray()) {
+            return;
+        }
+
+        min = value.Empty() ? 0.0 : HUGE_VAL;
+
+        for (const auto &v : value.GetArray()) {
+            if (!v.IsNumber()) {
+                continue;
+            }
+
+            const double d = v.GetDouble();
+            mean += d;
+            min   = std::min(min, d);
+            ++count;
+        }
+
+        if (count == 0) {
+            min = 0.0;
+
+            return;
+        }
+
+        mean /= count;
+
+        for (const auto &v : value.GetArray()) {
+            if (v.IsNumber()) {
+                stddev += (v.GetDouble() - mean) * (v.GetDouble() - mean);
+            }
+        }
+
+        stddev = count > 1 ? std::sqrt(stddev / (count - 1)) : 0.0;
+    }
+
+    inline double diff(double value) const { return mean > 0.0 ? (value - mean) / mean * 100.0 : 0.0; }
+
+    double mean     = 0.0;
+    double min      = 0.0;
+    double stddev   = 0.0;
+    size_t count    = 0;
+};
+
+
+static void print(const char *name, const char *unit, double value, const Baseline &baseline, bool regression)
+{
+    if (regression) {
+        LOG_ERR("%s " WHITE_BOLD("%-10s") RED_BOLD("%.1f %s") " baseline " WHITE_BOLD("%.1f") BLACK_BOLD(" \xC2\xB1%.1f") " (%+.2f%%) " RED_BOLD("REGRESSION"),
+                Tags::bench(), name, value, unit, baseline.mean, baseline.stddev, baseline.diff(value));
+    }
+    else {
+        LOG_NOTICE("%s " WHITE_BOLD("%-10s") CYAN_BOLD("%.1f %s") " baseline " WHITE_BOLD("%.1f") BLACK_BOLD(" \xC2\xB1%.1f") " (%+.2f%%) " GREEN_BOLD("OK"),
+                   Tags::bench(), name, value, unit, baseline.mean, baseline.stddev, baseline.diff(value));
+    }
+}
+
+
+static void push(rapidjson::Value &entry, const char *key, double value, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    if (!entry.HasMember(key) || !entry[key].IsArray()) {
+        entry.RemoveMember(key);
+        entry.AddMember(StringRef(key), Value(kArrayType), doc.GetAllocator());
+    }
+
+    auto &array = entry[key];
+    array.PushBack(Json::normalize(value, true), doc.GetAllocator());
+
+    while (array.Size() > BenchReport::kMaxSamples) {
+        array.Erase(array.Begin());
+    }
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::BenchReport::compare(const char *fileName, const Result &result, double threshold)
+{
+    using namespace rapidjson;
+
+    Document doc;
+    if (!Json::get(fileName, doc) || !doc.IsObject()) {
+        LOG_WARN("%s " YELLOW_BOLD("baseline \"%s\" not found or invalid, skip comparison"), Tags::bench(), fileName);
+
+        return false;
+    }
+
+    const auto results = doc.FindMember(kResults);
+    const Value *entry = results != doc.MemberEnd() ? find(results->value, result) : nullptr;
+    if (!entry) {
+        LOG_WARN("%s " YELLOW_BOLD("no baseline for ") WHITE_BOLD("%s") YELLOW_BOLD(" threads ") WHITE_BOLD("%u") YELLOW_BOLD(" size ") WHITE_BOLD("%u"),
+                 Tags::bench(), result.algorithm.name(), result.threads, result.size);
+
+        return false;
+    }
+
+    bool failed = false;
+    const double ratio = threshold / 100.0;
+
+    // Lower hashrate is a regression only if it falls out of both relative threshold and run-to-run noise of the baseline.
+    const Baseline hashrate(Json::getValue(*entry, kHashrate));
+    if (hashrate.count) {
+        const bool regression = result.hashrate < hashrate.mean - std::max(hashrate.mean * ratio, hashrate.stddev * 3.0);
+        print(kHashrate, "h/s", result.hashrate, hashrate, regression);
+        failed |= regression;
+    }
+
+    const Baseline ready(Json::getValue(*entry, kReady));
+    if (ready.count) {
+        const bool regression = result.ready > ready.mean + std::max({ ready.mean * ratio, ready.stddev * 3.0, static_cast<double>(kMinTimeDiff) });
+        print(kReady, "ms", static_cast<double>(result.ready), ready, regression);
+        failed |= regression;
+    }
+
+    const Baseline dataset(Json::getValue(*entry, kDataset));
+    if (dataset.count && (dataset.mean > 0.0 || result.dataset)) {
+        const bool regression = result.dataset > dataset.mean + std::max({ dataset.mean * ratio, dataset.stddev * 3.0, static_cast<double>(kMinTimeDiff) });
+        print(kDataset, "ms", static_cast<double>(result.dataset), dataset, regression);
+        failed |= regression;
+    }
+
+    const Baseline hugePages(Json::getValue(*entry, kHugePages));
+    if (hugePages.count) {
+        const bool regression = result.hugePages < hugePages.min - kHugePagesDiff;
+        print(kHugePages, "%", result.hugePages, hugePages, regression);
+        failed |= regression;
+    }
+
+    const char *hash = Json::getString(*entry, kHash);
+    if (hash && strtoull(hash, nullptr, 16) != result.hash) {
+        LOG_ERR("%s " WHITE_BOLD("%-10s") RED_BOLD("%016" PRIX64) " baseline " WHITE_BOLD("%s ") RED_BOLD("MISMATCH"), Tags::bench(), kHash, result.hash, hash);
+        failed = true;
+    }
+
+    return failed;
+}
+
+
+bool xmrig::BenchReport::save(const char *fileName, const Result &result)
+{
+    using namespace rapidjson;
+
+    Document doc;
+    if (!Json::get(fileName, doc) || !doc.IsObject()) {
+        doc.SetObject();
+    }
+
+    auto &allocator = doc.GetAllocator();
+
+    if (!doc.HasMember(kResults) || !doc[kResults].IsArray()) {
+        doc.RemoveMember(kResults);
+        doc.AddMember(StringRef(kResults), Value(kArrayType), allocator);
+    }
+
+    if (doc.HasMember(kVersion)) {
+        doc[kVersion] = kFormatVersion;
+    }
+    else {
+        doc.AddMember(StringRef(kVersion), kFormatVersion, allocator);
+    }
+
+    Value *entry = find(doc[kResults], result);
+    if (!entry) {
+        Value value(kObjectType);
+        value.AddMember(StringRef(kAlgo),       result.algorithm.toJSON(), allocator);
+        value.AddMember(StringRef(kThreads),    result.threads, allocator);
+        value.AddMember(StringRef(kSize),       result.size, allocator);
+
+        doc[kResults].PushBack(value, allocator);
+        entry = &doc[kResults][doc[kResults].Size() - 1];
+    }
+
+    const std::string hash = fmt::format("{:016X}", result.hash);
+    entry->RemoveMember(kHash);
+    entry->AddMember(StringRef(kHash), Value(hash.c_str(), allocator), allocator);
+
+    push(*entry, kHashrate,  result.hashrate, doc);
+    push(*entry, kReady,     static_cast<double>(result.ready), doc);
+    push(*entry, kDataset,   static_cast<double>(result.dataset), doc);
+    push(*entry, kHugePages, result.hugePages, doc);
+
+    if (!Json::save(fileName, doc)) {
+        LOG_ERR("%s " RED("failed to save benchmark report \"%s\""), Tags::bench(), fileName);
+
+        return false;
+    }
+
+    LOG_NOTICE("%s " WHITE_BOLD("benchmark report saved to ") CYAN_BOLD("\"%s\""), Tags::bench(), fileName);
+
+    return true;
+}
+
+
+rapidjson::Value *xmrig::BenchReport::find(rapidjson::Value &results, const Result &result)
+{
+    if (!results.IsArray()) {
+        return nullptr;
+    }
+
+    for (auto &entry : results.GetArray()) {
+        if (Algorithm(Json::getString(entry, kAlgo)) == result.algorithm &&
+            Json::getUint(entry, kThreads) == result.threads &&
+            Json::getUint(entry, kSize) == result.size) {
+            return &entry;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,65 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_BENCHREPORT_H
+#define XMRIG_BENCHREPORT_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/crypto/Algorithm.h"
+
+
+namespace xmrig {
+
+
+/**
+ * Offline benchmark results stored in a JSON file, one entry per algo/threads/size combination,
+ * every entry keeps last kMaxSamples runs and used as a baseline for regression checks.
+ */
+class BenchReport
+{
+public:
+    static constexpr const double kHugePagesDiff    = 0.5;  // %
+    static constexpr const size_t kMaxSamples       = 10;
+    static constexpr const uint32_t kFormatVersion  = 1;
+    static constexpr const uint64_t kMinTimeDiff    = 250;  // ms, timer noise for time-to-ready and dataset init time
+
+    struct Result
+    {
+        Algorithm algorithm;
+        double hashrate     = 0.0;
+        double hugePages    = 0.0;  // % of memory backed by huge pages
+        uint32_t size       = 0;
+        uint32_t threads    = 0;
+        uint64_t dataset    = 0;    // ms
+        uint64_t hash       = 0;
+        uint64_t ready      = 0;    // ms
+    };
+
+    static bool compare(const char *fileName, const Result &result, double threshold);
+    static bool save(const char *fileName, const Result &result);
+
+private:
+    static rapidjson::Value *find(rapidjson::Value &results, const Result &result);
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_BENCHREPORT_H */
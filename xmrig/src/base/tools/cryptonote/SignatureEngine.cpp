@@ -0,0 +1,254 @@
+/* XMRig
+ * Copyright (c) 2012-2013 The Cryptonote developers
+ * Copyright (c) 2014-2021 The Monero Project
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "base/tools/cryptonote/SignatureEngine.h"
+#include "base/crypto/keccak.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/net/stratum/Job.h"
+#include "base/tools/cryptonote/BlockTemplate.h"
+#include "base/tools/cryptonote/Signatures.h"
+#include "base/tools/Cvt.h"
+
+
+extern "C" {
+
+#include "base/tools/cryptonote/crypto-ops.h"
+
+}
+
+
+#include <cstring>
+
+
+namespace xmrig {
+
+
+static_assert(SignatureEngine::kBatchSize % 4 == 0 && SignatureEngine::kBatchSize <= GE_P3_TOBYTES_BATCH_MAX, "Invalid signatures batch size");
+
+
+static void commitments(SignatureEngine::Mode mode, const uint8_t (*k)[SignatureEngine::kKeySize], uint8_t (*R)[SignatureEngine::kKeySize])
+{
+    if (mode == SignatureEngine::MODE_AVX2) {
+#       ifdef XMRIG_FEATURE_SIGNATURES_AVX2
+        for (size_t i = 0; i < SignatureEngine::kBatchSize; i += 4) {
+            ge_scalarmult_base_tobytes_x4(R[i], k[i]);
+        }
+
+        return;
+#       endif
+    }
+
+    ge_p3 points[SignatureEngine::kBatchSize];
+    for (size_t i = 0; i < SignatureEngine::kBatchSize; ++i) {
+        ge_scalarmult_base(&points[i], k[i]);
+    }
+
+    ge_p3_tobytes_batch(R[0], points, static_cast<int>(SignatureEngine::kBatchSize));
+}
+
+
+// Same as generate_signature() with already known k and R, comm is prefix hash, public key and R.
+static bool signature(const uint8_t *comm, const uint8_t *sec, const uint8_t *k, uint8_t *sig)
+{
+    keccak(comm, static_cast<int>(SignatureEngine::kKeySize * 3), sig, static_cast<int>(SignatureEngine::kKeySize));
+    sc_reduce32(sig);
+
+    if (!sc_isnonzero(sig)) {
+        return false;
+    }
+
+    sc_mulsub(sig + SignatureEngine::kKeySize, sig, sec, k);
+
+    return sc_isnonzero(sig + SignatureEngine::kKeySize) != 0;
+}
+
+
+static bool check(SignatureEngine::Mode mode)
+{
+    constexpr size_t kKeySize = SignatureEngine::kKeySize;
+
+    uint8_t k[SignatureEngine::kBatchSize][kKeySize];
+    uint8_t R[SignatureEngine::kBatchSize][kKeySize];
+
+    Cvt::randomBytes(k, sizeof(k));
+    for (auto &scalar : k) {
+        sc_reduce32(scalar);
+    }
+
+    // Edge cases: 1 and l - 1
+    uint8_t zero[kKeySize]{};
+    memset(k[0], 0, kKeySize);
+    k[0][0] = 1;
+    sc_sub(k[1], zero, k[0]);
+
+    commitments(mode, k, R);
+
+    bool valid = true;
+    ge_p3 point;
+    uint8_t expected[kKeySize];
+
+    for (size_t i = 0; i < SignatureEngine::kBatchSize; ++i) {
+        ge_scalarmult_base(&point, k[i]);
+        ge_p3_tobytes(expected, &point);
+
+        valid &= memcmp(expected, R[i], kKeySize) == 0;
+    }
+
+    uint8_t comm[kKeySize * 3];
+    uint8_t sec[kKeySize];
+    uint8_t sig[BlockTemplate::kSignatureSize];
+
+    generate_keys(comm + kKeySize, sec);
+    Cvt::randomBytes(comm, kKeySize);
+
+    for (size_t i = 2; i < SignatureEngine::kBatchSize && valid; ++i) {
+        memcpy(comm + kKeySize * 2, R[i], kKeySize);
+
+        valid = signature(comm, sec, k[i], sig) && check_signature(comm, comm + kKeySize, sig);
+    }
+
+    if (!valid) {
+        LOG_ERR("%s " RED("miner signatures self-test failed for ") RED_BOLD("\"%s\"") RED(" implementation"), Tags::cpu(), SignatureEngine::modeName(mode));
+    }
+
+    return valid;
+}
+
+
+static bool isValid(SignatureEngine::Mode mode)
+{
+    if (mode == SignatureEngine::MODE_AVX2) {
+        static const bool valid = check(mode);
+
+        return valid;
+    }
+
+    static const bool valid = check(mode);
+
+    return valid;
+}
+
+
+static SignatureEngine::Mode selectMode(bool avx2)
+{
+#   ifdef XMRIG_FEATURE_SIGNATURES_AVX2
+    if (avx2 && isValid(SignatureEngine::MODE_AVX2)) {
+        return SignatureEngine::MODE_AVX2;
+    }
+#   endif
+
+    return isValid(SignatureEngine::MODE_BATCH) ? SignatureEngine::MODE_BATCH : SignatureEngine::MODE_REFERENCE;
+}
+
+
+} // namespace xmrig
+
+
+xmrig::SignatureEngine::SignatureEngine(bool avx2) :
+    m_mode(selectMode(avx2))
+{
+}
+
+
+xmrig::SignatureEngine::~SignatureEngine()
+{
+    memset(m_k, 0, sizeof(m_k));
+    memset(m_secretKey, 0, sizeof(m_secretKey));
+}
+
+
+bool xmrig::SignatureEngine::verify(Mode mode)
+{
+    return mode == MODE_REFERENCE || check(mode);
+}
+
+
+const char *xmrig::SignatureEngine::modeName(Mode mode)
+{
+    switch (mode) {
+    case MODE_BATCH:
+        return "batch";
+
+    case MODE_AVX2:
+        return "avx2";
+
+    default:
+        break;
+    }
+
+    return "reference";
+}
+
+
+void xmrig::SignatureEngine::setJob(const Job &job)
+{
+    m_signatureOffset = job.nonceOffset() + job.nonceSize();
+
+    memcpy(m_comm + kKeySize, job.ephPublicKey(), kKeySize);
+    memcpy(m_secretKey, job.ephSecretKey(), kKeySize);
+}
+
+
+void xmrig::SignatureEngine::sign(uint8_t *blob, size_t size)
+{
+    uint8_t *sig = blob + m_signatureOffset;
+
+    // Signature is hashed as zeros
+    memset(sig, 0, BlockTemplate::kSignatureSize);
+    keccak(blob, static_cast<int>(size), m_comm, static_cast<int>(kKeySize));
+
+    if (m_mode == MODE_REFERENCE) {
+        generate_signature(m_comm, m_comm + kKeySize, m_secretKey, sig);
+
+        return;
+    }
+
+    bool valid = false;
+
+    do {
+        if (m_next == kBatchSize) {
+            fill();
+        }
+
+        uint8_t *k = m_k[m_next];
+        memcpy(m_comm + kKeySize * 2, m_R[m_next], kKeySize);
+        ++m_next;
+
+        valid = signature(m_comm, m_secretKey, k, sig);
+
+        memset(k, 0, kKeySize);
+    } while (!valid);
+}
+
+
+void xmrig::SignatureEngine::fill()
+{
+    // Don't care about bias or possible 0 after reduce, see random_scalar() in Signatures.cpp.
+    Cvt::randomBytes(m_k, sizeof(m_k));
+
+    for (auto &k : m_k) {
+        sc_reduce32(k);
+    }
+
+    commitments(m_mode, m_k, m_R);
+
+    m_next = 0;
+}
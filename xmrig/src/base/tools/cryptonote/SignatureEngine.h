@@ -0,0 +1,87 @@
+/* XMRig
+ * Copyright (c) 2012-2013 The Cryptonote developers
+ * Copyright (c) 2014-2021 The Monero Project
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_SIGNATUREENGINE_H
+#define XMRIG_SIGNATUREENGINE_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class Job;
+
+
+/**
+ * Per worker miner signatures generator, produces the same signatures as Job::generateMinerSignature().
+ *
+ * Random nonce k and commitment R = k*G of a signature don't depend on the job or the hashing blob, they are
+ * generated kBatchSize at once ahead of time (4 lanes at once with AVX2, a single field inversion for the whole batch
+ * otherwise), so only keccak of the blob and a few scalar operations are left for every hash.
+ * Every (k, R) pair is used only once.
+ */
+class SignatureEngine
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(SignatureEngine)
+
+    enum Mode {
+        MODE_REFERENCE,
+        MODE_BATCH,
+        MODE_AVX2
+    };
+
+    static constexpr size_t kBatchSize  = 8;
+    static constexpr size_t kKeySize    = 32;
+
+    SignatureEngine(bool avx2);
+    ~SignatureEngine();
+
+    inline Mode mode() const { return m_mode; }
+
+    static bool verify(Mode mode);
+    static const char *modeName(Mode mode);
+
+    void setJob(const Job &job);
+    void sign(uint8_t *blob, size_t size);
+
+private:
+    void fill();
+
+    uint8_t m_k[kBatchSize][kKeySize]{};
+    uint8_t m_R[kBatchSize][kKeySize]{};
+    Mode m_mode;
+    size_t m_next               = kBatchSize;
+    size_t m_signatureOffset    = 0;
+    uint8_t m_comm[kKeySize * 3]{};     // prefix hash, public key, R
+    uint8_t m_secretKey[kKeySize]{};
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_SIGNATUREENGINE_H */
@@ -0,0 +1,528 @@
+// Copyright (c) 2014-2020, The Monero Project
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are
+// permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this list of
+//    conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice, this list
+//    of conditions and the following disclaimer in the documentation and/or other
+//    materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its contributors may be
+//    used to endorse or promote products derived from this software without specific
+//    prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+// EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+// MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+// THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+// SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+// THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Parts of this file are originally copyright (c) 2012-2013 The Cryptonote developers
+
+/*
+4-way ge_scalarmult_base() + ge_p3_tobytes() with AVX2, used to precompute commitments
+for miner signatures.
+
+This is the ref10 code from crypto-ops.c with every int32 limb widened to a 64-bit lane,
+lane i computes the result for the i-th scalar. Limb bounds, the order of operations and
+the carry chains are the same as in ref10, so every lane goes through exactly the same
+values as the scalar code. 32x32->64 signed multiplication is _mm256_mul_epi32(), there
+is no 64-bit arithmetic shift in AVX2, so carries are computed with a 2^63 bias and a
+logical shift. Table lookups are constant time, like in ref10.
+*/
+
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "crypto-ops.h"
+
+typedef __m256i fe4[10];
+
+typedef struct {
+  fe4 X;
+  fe4 Y;
+  fe4 Z;
+} ge4_p2;
+
+typedef struct {
+  fe4 X;
+  fe4 Y;
+  fe4 Z;
+  fe4 T;
+} ge4_p3;
+
+typedef struct {
+  fe4 X;
+  fe4 Y;
+  fe4 Z;
+  fe4 T;
+} ge4_p1p1;
+
+typedef struct {
+  fe4 yplusx;
+  fe4 yminusx;
+  fe4 xy2d;
+} ge4_precomp;
+
+#define MUL(a, b) _mm256_mul_epi32(a, b)
+#define MAC(h, a, b) h = _mm256_add_epi64(h, _mm256_mul_epi32(a, b))
+
+static void fe4_0(fe4 h) {
+  int i;
+  for (i = 0; i < 10; ++i) {
+    h[i] = _mm256_setzero_si256();
+  }
+}
+
+static void fe4_1(fe4 h) {
+  fe4_0(h);
+  h[0] = _mm256_set1_epi64x(1);
+}
+
+static void fe4_copy(fe4 h, const fe4 f) {
+  int i;
+  for (i = 0; i < 10; ++i) {
+    h[i] = f[i];
+  }
+}
+
+static void fe4_add(fe4 h, const fe4 f, const fe4 g) {
+  int i;
+  for (i = 0; i < 10; ++i) {
+    h[i] = _mm256_add_epi64(f[i], g[i]);
+  }
+}
+
+static void fe4_sub(fe4 h, const fe4 f, const fe4 g) {
+  int i;
+  for (i = 0; i < 10; ++i) {
+    h[i] = _mm256_sub_epi64(f[i], g[i]);
+  }
+}
+
+static void fe4_neg(fe4 h, const fe4 f) {
+  int i;
+  for (i = 0; i < 10; ++i) {
+    h[i] = _mm256_sub_epi64(_mm256_setzero_si256(), f[i]);
+  }
+}
+
+/*
+carry = (h + 2^(bits-1)) >> bits, h -= carry << bits
+(h + 2^63) viewed as unsigned is h ^ 2^63, so a logical shift of it is the arithmetic shift
+of h plus 2^(63-bits).
+*/
+
+static inline __m256i carry26(__m256i *h) {
+  const __m256i t = _mm256_add_epi64(*h, _mm256_set1_epi64x((int64_t) (0x8000000000000000ULL + (1ULL << 25))));
+  const __m256i c = _mm256_sub_epi64(_mm256_srli_epi64(t, 26), _mm256_set1_epi64x(1LL << 37));
+  *h = _mm256_sub_epi64(*h, _mm256_slli_epi64(c, 26));
+  return c;
+}
+
+static inline __m256i carry25(__m256i *h) {
+  const __m256i t = _mm256_add_epi64(*h, _mm256_set1_epi64x((int64_t) (0x8000000000000000ULL + (1ULL << 24))));
+  const __m256i c = _mm256_sub_epi64(_mm256_srli_epi64(t, 25), _mm256_set1_epi64x(1LL << 38));
+  *h = _mm256_sub_epi64(*h, _mm256_slli_epi64(c, 25));
+  return c;
+}
+
+static inline __m256i mul19(__m256i f) {
+  return _mm256_add_epi64(_mm256_add_epi64(_mm256_slli_epi64(f, 4), _mm256_slli_epi64(f, 1)), f);
+}
+
+static void fe4_reduce(fe4 h, __m256i h0, __m256i h1, __m256i h2, __m256i h3, __m256i h4,
+                       __m256i h5, __m256i h6, __m256i h7, __m256i h8, __m256i h9) {
+  __m256i c;
+
+  c = carry26(&h0); h1 = _mm256_add_epi64(h1, c);
+  c = carry26(&h4); h5 = _mm256_add_epi64(h5, c);
+  c = carry25(&h1); h2 = _mm256_add_epi64(h2, c);
+  c = carry25(&h5); h6 = _mm256_add_epi64(h6, c);
+  c = carry26(&h2); h3 = _mm256_add_epi64(h3, c);
+  c = carry26(&h6); h7 = _mm256_add_epi64(h7, c);
+  c = carry25(&h3); h4 = _mm256_add_epi64(h4, c);
+  c = carry25(&h7); h8 = _mm256_add_epi64(h8, c);
+  c = carry26(&h4); h5 = _mm256_add_epi64(h5, c);
+  c = carry26(&h8); h9 = _mm256_add_epi64(h9, c);
+  c = carry25(&h9); h0 = _mm256_add_epi64(h0, mul19(c));
+  c = carry26(&h0); h1 = _mm256_add_epi64(h1, c);
+
+  h[0] = h0;
+  h[1] = h1;
+  h[2] = h2;
+  h[3] = h3;
+  h[4] = h4;
+  h[5] = h5;
+  h[6] = h6;
+  h[7] = h7;
+  h[8] = h8;
+  h[9] = h9;
+}
+
+/*
+h = f * g, same preconditions and postconditions as fe_mul()
+*/
+
+static void fe4_mul(fe4 h, const fe4 f, const fe4 g) {
+  __m256i f2[10];
+  __m256i g19[10];
+  __m256i h0, h1, h2, h3, h4, h5, h6, h7, h8, h9;
+  int i;
+
+  for (i = 0; i < 10; ++i) {
+    f2[i]  = _mm256_add_epi64(f[i], f[i]);
+    g19[i] = mul19(g[i]);
+  }
+
+  h0 = MUL(f[0], g[0]); MAC(h0, f2[1], g19[9]); MAC(h0, f[2], g19[8]); MAC(h0, f2[3], g19[7]);
+  MAC(h0, f[4], g19[6]); MAC(h0, f2[5], g19[5]); MAC(h0, f[6], g19[4]); MAC(h0, f2[7], g19[3]);
+  MAC(h0, f[8], g19[2]); MAC(h0, f2[9], g19[1]);
+  h1 = MUL(f[0], g[1]); MAC(h1, f[1], g[0]); MAC(h1, f[2], g19[9]); MAC(h1, f[3], g19[8]);
+  MAC(h1, f[4], g19[7]); MAC(h1, f[5], g19[6]); MAC(h1, f[6], g19[5]); MAC(h1, f[7], g19[4]);
+  MAC(h1, f[8], g19[3]); MAC(h1, f[9], g19[2]);
+  h2 = MUL(f[0], g[2]); MAC(h2, f2[1], g[1]); MAC(h2, f[2], g[0]); MAC(h2, f2[3], g19[9]);
+  MAC(h2, f[4], g19[8]); MAC(h2, f2[5], g19[7]); MAC(h2, f[6], g19[6]); MAC(h2, f2[7], g19[5]);
+  MAC(h2, f[8], g19[4]); MAC(h2, f2[9], g19[3]);
+  h3 = MUL(f[0], g[3]); MAC(h3, f[1], g[2]); MAC(h3, f[2], g[1]); MAC(h3, f[3], g[0]);
+  MAC(h3, f[4], g19[9]); MAC(h3, f[5], g19[8]); MAC(h3, f[6], g19[7]); MAC(h3, f[7], g19[6]);
+  MAC(h3, f[8], g19[5]); MAC(h3, f[9], g19[4]);
+  h4 = MUL(f[0], g[4]); MAC(h4, f2[1], g[3]); MAC(h4, f[2], g[2]); MAC(h4, f2[3], g[1]);
+  MAC(h4, f[4], g[0]); MAC(h4, f2[5], g19[9]); MAC(h4, f[6], g19[8]); MAC(h4, f2[7], g19[7]);
+  MAC(h4, f[8], g19[6]); MAC(h4, f2[9], g19[5]);
+  h5 = MUL(f[0], g[5]); MAC(h5, f[1], g[4]); MAC(h5, f[2], g[3]); MAC(h5, f[3], g[2]);
+  MAC(h5, f[4], g[1]); MAC(h5, f[5], g[0]); MAC(h5, f[6], g19[9]); MAC(h5, f[7], g19[8]);
+  MAC(h5, f[8], g19[7]); MAC(h5, f[9], g19[6]);
+  h6 = MUL(f[0], g[6]); MAC(h6, f2[1], g[5]); MAC(h6, f[2], g[4]); MAC(h6, f2[3], g[3]);
+  MAC(h6, f[4], g[2]); MAC(h6, f2[5], g[1]); MAC(h6, f[6], g[0]); MAC(h6, f2[7], g19[9]);
+  MAC(h6, f[8], g19[8]); MAC(h6, f2[9], g19[7]);
+  h7 = MUL(f[0], g[7]); MAC(h7, f[1], g[6]); MAC(h7, f[2], g[5]); MAC(h7, f[3], g[4]);
+  MAC(h7, f[4], g[3]); MAC(h7, f[5], g[2]); MAC(h7, f[6], g[1]); MAC(h7, f[7], g[0]);
+  MAC(h7, f[8], g19[9]); MAC(h7, f[9], g19[8]);
+  h8 = MUL(f[0], g[8]); MAC(h8, f2[1], g[7]); MAC(h8, f[2], g[6]); MAC(h8, f2[3], g[5]);
+  MAC(h8, f[4], g[4]); MAC(h8, f2[5], g[3]); MAC(h8, f[6], g[2]); MAC(h8, f2[7], g[1]);
+  MAC(h8, f[8], g[0]); MAC(h8, f2[9], g19[9]);
+  h9 = MUL(f[0], g[9]); MAC(h9, f[1], g[8]); MAC(h9, f[2], g[7]); MAC(h9, f[3], g[6]);
+  MAC(h9, f[4], g[5]); MAC(h9, f[5], g[4]); MAC(h9, f[6], g[3]); MAC(h9, f[7], g[2]);
+  MAC(h9, f[8], g[1]); MAC(h9, f[9], g[0]);
+
+  fe4_reduce(h, h0, h1, h2, h3, h4, h5, h6, h7, h8, h9);
+}
+
+/*
+h = f * f, or 2 * f * f if dbl is set, same preconditions and postconditions as fe_sq()
+*/
+
+static inline void fe4_sq_common(fe4 h, const fe4 f, int dbl) {
+  __m256i f2[10];
+  __m256i f19[10];
+  __m256i f38[10];
+  __m256i h0, h1, h2, h3, h4, h5, h6, h7, h8, h9;
+  int i;
+
+  for (i = 0; i < 10; ++i) {
+    f2[i]  = _mm256_add_epi64(f[i], f[i]);
+    f19[i] = mul19(f[i]);
+    f38[i] = _mm256_add_epi64(f19[i], f19[i]);
+  }
+
+  h0 = MUL(f[0], f[0]); MAC(h0, f2[1], f38[9]); MAC(h0, f2[2], f19[8]); MAC(h0, f2[3], f38[7]);
+  MAC(h0, f2[4], f19[6]); MAC(h0, f[5], f38[5]);
+  h1 = MUL(f2[0], f[1]); MAC(h1, f2[2], f19[9]); MAC(h1, f2[3], f19[8]); MAC(h1, f2[4], f19[7]);
+  MAC(h1, f2[5], f19[6]);
+  h2 = MUL(f2[0], f[2]); MAC(h2, f[1], f2[1]); MAC(h2, f2[3], f38[9]); MAC(h2, f2[4], f19[8]);
+  MAC(h2, f2[5], f38[7]); MAC(h2, f[6], f19[6]);
+  h3 = MUL(f2[0], f[3]); MAC(h3, f2[1], f[2]); MAC(h3, f2[4], f19[9]); MAC(h3, f2[5], f19[8]);
+  MAC(h3, f2[6], f19[7]);
+  h4 = MUL(f2[0], f[4]); MAC(h4, f2[1], f2[3]); MAC(h4, f[2], f[2]); MAC(h4, f2[5], f38[9]);
+  MAC(h4, f2[6], f19[8]); MAC(h4, f[7], f38[7]);
+  h5 = MUL(f2[0], f[5]); MAC(h5, f2[1], f[4]); MAC(h5, f2[2], f[3]); MAC(h5, f2[6], f19[9]);
+  MAC(h5, f2[7], f19[8]);
+  h6 = MUL(f2[0], f[6]); MAC(h6, f2[1], f2[5]); MAC(h6, f2[2], f[4]); MAC(h6, f[3], f2[3]);
+  MAC(h6, f2[7], f38[9]); MAC(h6, f[8], f19[8]);
+  h7 = MUL(f2[0], f[7]); MAC(h7, f2[1], f[6]); MAC(h7, f2[2], f[5]); MAC(h7, f2[3], f[4]);
+  MAC(h7, f2[8], f19[9]);
+  h8 = MUL(f2[0], f[8]); MAC(h8, f2[1], f2[7]); MAC(h8, f2[2], f[6]); MAC(h8, f2[3], f2[5]);
+  MAC(h8, f[4], f[4]); MAC(h8, f[9], f38[9]);
+  h9 = MUL(f2[0], f[9]); MAC(h9, f2[1], f[8]); MAC(h9, f2[2], f[7]); MAC(h9, f2[3], f[6]);
+  MAC(h9, f2[4], f[5]);
+
+  if (dbl) {
+    h0 = _mm256_add_epi64(h0, h0);
+    h1 = _mm256_add_epi64(h1, h1);
+    h2 = _mm256_add_epi64(h2, h2);
+    h3 = _mm256_add_epi64(h3, h3);
+    h4 = _mm256_add_epi64(h4, h4);
+    h5 = _mm256_add_epi64(h5, h5);
+    h6 = _mm256_add_epi64(h6, h6);
+    h7 = _mm256_add_epi64(h7, h7);
+    h8 = _mm256_add_epi64(h8, h8);
+    h9 = _mm256_add_epi64(h9, h9);
+  }
+
+  fe4_reduce(h, h0, h1, h2, h3, h4, h5, h6, h7, h8, h9);
+}
+
+static void fe4_sq(fe4 h, const fe4 f) {
+  fe4_sq_common(h, f, 0);
+}
+
+static void fe4_sq2(fe4 h, const fe4 f) {
+  fe4_sq_common(h, f, 1);
+}
+
+static void fe4_invert(fe4 out, const fe4 z) {
+  fe4 t0;
+  fe4 t1;
+  fe4 t2;
+  fe4 t3;
+  int i;
+
+  fe4_sq(t0, z);
+  fe4_sq(t1, t0);
+  fe4_sq(t1, t1);
+  fe4_mul(t1, z, t1);
+  fe4_mul(t0, t0, t1);
+  fe4_sq(t2, t0);
+  fe4_mul(t1, t1, t2);
+  fe4_sq(t2, t1);
+  for (i = 0; i < 4; ++i) {
+    fe4_sq(t2, t2);
+  }
+  fe4_mul(t1, t2, t1);
+  fe4_sq(t2, t1);
+  for (i = 0; i < 9; ++i) {
+    fe4_sq(t2, t2);
+  }
+  fe4_mul(t2, t2, t1);
+  fe4_sq(t3, t2);
+  for (i = 0; i < 19; ++i) {
+    fe4_sq(t3, t3);
+  }
+  fe4_mul(t2, t3, t2);
+  fe4_sq(t2, t2);
+  for (i = 0; i < 9; ++i) {
+    fe4_sq(t2, t2);
+  }
+  fe4_mul(t1, t2, t1);
+  fe4_sq(t2, t1);
+  for (i = 0; i < 49; ++i) {
+    fe4_sq(t2, t2);
+  }
+  fe4_mul(t2, t2, t1);
+  fe4_sq(t3, t2);
+  for (i = 0; i < 99; ++i) {
+    fe4_sq(t3, t3);
+  }
+  fe4_mul(t2, t3, t2);
+  fe4_sq(t2, t2);
+  for (i = 0; i < 49; ++i) {
+    fe4_sq(t2, t2);
+  }
+  fe4_mul(t1, t2, t1);
+  fe4_sq(t1, t1);
+  for (i = 0; i < 4; ++i) {
+    fe4_sq(t1, t1);
+  }
+  fe4_mul(out, t1, t0);
+}
+
+static void fe4_extract(fe out, const fe4 f, int lane) {
+  int64_t tmp[4];
+  int i;
+
+  for (i = 0; i < 10; ++i) {
+    _mm256_storeu_si256((__m256i *) tmp, f[i]);
+    out[i] = (int32_t) tmp[lane];
+  }
+}
+
+static void ge4_madd(ge4_p1p1 *r, const ge4_p3 *p, const ge4_precomp *q) {
+  fe4 t0;
+  fe4_add(r->X, p->Y, p->X);
+  fe4_sub(r->Y, p->Y, p->X);
+  fe4_mul(r->Z, r->X, q->yplusx);
+  fe4_mul(r->Y, r->Y, q->yminusx);
+  fe4_mul(r->T, q->xy2d, p->T);
+  fe4_add(t0, p->Z, p->Z);
+  fe4_sub(r->X, r->Z, r->Y);
+  fe4_add(r->Y, r->Z, r->Y);
+  fe4_add(r->Z, t0, r->T);
+  fe4_sub(r->T, t0, r->T);
+}
+
+static void ge4_p1p1_to_p2(ge4_p2 *r, const ge4_p1p1 *p) {
+  fe4_mul(r->X, p->X, p->T);
+  fe4_mul(r->Y, p->Y, p->Z);
+  fe4_mul(r->Z, p->Z, p->T);
+}
+
+static void ge4_p1p1_to_p3(ge4_p3 *r, const ge4_p1p1 *p) {
+  fe4_mul(r->X, p->X, p->T);
+  fe4_mul(r->Y, p->Y, p->Z);
+  fe4_mul(r->Z, p->Z, p->T);
+  fe4_mul(r->T, p->X, p->Y);
+}
+
+static void ge4_p2_dbl(ge4_p1p1 *r, const ge4_p2 *p) {
+  fe4 t0;
+  fe4_sq(r->X, p->X);
+  fe4_sq(r->Z, p->Y);
+  fe4_sq2(r->T, p->Z);
+  fe4_add(r->Y, p->X, p->Y);
+  fe4_sq(t0, r->Y);
+  fe4_add(r->Y, r->Z, r->X);
+  fe4_sub(r->Z, r->Z, r->X);
+  fe4_sub(r->X, t0, r->Y);
+  fe4_sub(r->T, r->T, r->Z);
+}
+
+static void ge4_p3_dbl(ge4_p1p1 *r, const ge4_p3 *p) {
+  ge4_p2 q;
+  fe4_copy(q.X, p->X);
+  fe4_copy(q.Y, p->Y);
+  fe4_copy(q.Z, p->Z);
+  ge4_p2_dbl(r, &q);
+}
+
+static void ge4_p3_0(ge4_p3 *h) {
+  fe4_0(h->X);
+  fe4_1(h->Y);
+  fe4_1(h->Z);
+  fe4_0(h->T);
+}
+
+static void fe4_cmov(fe4 f, const fe4 g, __m256i mask) {
+  int i;
+  for (i = 0; i < 10; ++i) {
+    f[i] = _mm256_blendv_epi8(f[i], g[i], mask);
+  }
+}
+
+static void fe4_cmov_table(fe4 f, const fe g, __m256i mask) {
+  int i;
+  for (i = 0; i < 10; ++i) {
+    f[i] = _mm256_blendv_epi8(f[i], _mm256_set1_epi64x(g[i]), mask);
+  }
+}
+
+/*
+babs is |b| and neg is all ones for negative b in every lane, see select() in crypto-ops.c
+*/
+
+static void select4(ge4_precomp *t, int pos, __m256i babs, __m256i neg) {
+  fe4 minus;
+  int i;
+
+  fe4_1(t->yplusx);
+  fe4_1(t->yminusx);
+  fe4_0(t->xy2d);
+
+  for (i = 0; i < 8; ++i) {
+    const __m256i mask = _mm256_cmpeq_epi64(babs, _mm256_set1_epi64x(i + 1));
+    fe4_cmov_table(t->yplusx, ge_base[pos][i].yplusx, mask);
+    fe4_cmov_table(t->yminusx, ge_base[pos][i].yminusx, mask);
+    fe4_cmov_table(t->xy2d, ge_base[pos][i].xy2d, mask);
+  }
+
+  fe4_copy(minus, t->yplusx);
+  fe4_cmov(t->yplusx, t->yminusx, neg);
+  fe4_cmov(t->yminusx, minus, neg);
+  fe4_neg(minus, t->xy2d);
+  fe4_cmov(t->xy2d, minus, neg);
+}
+
+static void select4_digits(ge4_precomp *t, int pos, signed char e[4][64], int i) {
+  int64_t babs[4];
+  int64_t neg[4];
+  int lane;
+
+  for (lane = 0; lane < 4; ++lane) {
+    const signed char b = e[lane][i];
+    const unsigned char bnegative = (unsigned char) (((unsigned long long) b) >> 63);
+    babs[lane] = (unsigned char) (b - (((-bnegative) & b) << 1));
+    neg[lane]  = -(int64_t) bnegative;
+  }
+
+  select4(t, pos, _mm256_loadu_si256((const __m256i *) babs), _mm256_loadu_si256((const __m256i *) neg));
+}
+
+/*
+out[32 * i..32 * i + 31] = compressed a[32 * i..32 * i + 31] * B, i = 0..3
+
+Preconditions:
+  a[32 * i + 31] <= 127
+*/
+
+void ge_scalarmult_base_tobytes_x4(unsigned char *out, const unsigned char *a) {
+  signed char e[4][64];
+  signed char carry;
+  ge4_p1p1 r;
+  ge4_p2 s;
+  ge4_p3 h;
+  ge4_precomp t;
+  fe4 recip;
+  fe4 x;
+  fe4 y;
+  fe lane_x;
+  fe lane_y;
+  unsigned char sign[32];
+  int i;
+  int lane;
+
+  for (lane = 0; lane < 4; ++lane) {
+    const unsigned char *k = a + lane * 32;
+
+    for (i = 0; i < 32; ++i) {
+      e[lane][2 * i + 0] = (k[i] >> 0) & 15;
+      e[lane][2 * i + 1] = (k[i] >> 4) & 15;
+    }
+
+    carry = 0;
+    for (i = 0; i < 63; ++i) {
+      e[lane][i] += carry;
+      carry = e[lane][i] + 8;
+      carry >>= 4;
+      e[lane][i] -= carry << 4;
+    }
+    e[lane][63] += carry;
+  }
+
+  ge4_p3_0(&h);
+  for (i = 1; i < 64; i += 2) {
+    select4_digits(&t, i / 2, e, i);
+    ge4_madd(&r, &h, &t); ge4_p1p1_to_p3(&h, &r);
+  }
+
+  ge4_p3_dbl(&r, &h);  ge4_p1p1_to_p2(&s, &r);
+  ge4_p2_dbl(&r, &s); ge4_p1p1_to_p2(&s, &r);
+  ge4_p2_dbl(&r, &s); ge4_p1p1_to_p2(&s, &r);
+  ge4_p2_dbl(&r, &s); ge4_p1p1_to_p3(&h, &r);
+
+  for (i = 0; i < 64; i += 2) {
+    select4_digits(&t, i / 2, e, i);
+    ge4_madd(&r, &h, &t); ge4_p1p1_to_p3(&h, &r);
+  }
+
+  fe4_invert(recip, h.Z);
+  fe4_mul(x, h.X, recip);
+  fe4_mul(y, h.Y, recip);
+
+  for (lane = 0; lane < 4; ++lane) {
+    fe4_extract(lane_x, x, lane);
+    fe4_extract(lane_y, y, lane);
+
+    fe_tobytes(out + lane * 32, lane_y);
+    fe_tobytes(sign, lane_x);
+    out[lane * 32 + 31] ^= (sign[0] & 1) << 7;
+  }
+}
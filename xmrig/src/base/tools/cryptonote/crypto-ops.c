@@ -1576,6 +1576,45 @@ void ge_p3_tobytes(unsigned char *s, const ge_p3 *h) {
   s[31] ^= fe_isnegative(x) << 7;
 }
 
+/*
+ge_p3_tobytes() for count points with a single field inversion (Montgomery's trick)
+
+Preconditions:
+  0 < count <= GE_P3_TOBYTES_BATCH_MAX
+*/
+
+void ge_p3_tobytes_batch(unsigned char *s, const ge_p3 *h, int count) {
+  fe acc[GE_P3_TOBYTES_BATCH_MAX];
+  fe recip;
+  fe t;
+  fe x;
+  fe y;
+  int i;
+
+  assert(count > 0 && count <= GE_P3_TOBYTES_BATCH_MAX);
+
+  fe_copy(acc[0], h[0].Z);
+  for (i = 1; i < count; ++i) {
+    fe_mul(acc[i], acc[i - 1], h[i].Z);
+  }
+
+  fe_invert(recip, acc[count - 1]);
+
+  for (i = count - 1; i >= 0; --i) {
+    if (i > 0) {
+      fe_mul(t, recip, acc[i - 1]); /* 1/Z[i] */
+      fe_mul(recip, recip, h[i].Z); /* 1/(Z[0]...Z[i-1]) */
+    } else {
+      fe_copy(t, recip);
+    }
+
+    fe_mul(x, h[i].X, t);
+    fe_mul(y, h[i].Y, t);
+    fe_tobytes(s + 32 * i, y);
+    s[32 * i + 31] ^= fe_isnegative(x) << 7;
+  }
+}
+
 /* From ge_precomp_0.c */
 
 static void ge_precomp_0(ge_precomp *h) {
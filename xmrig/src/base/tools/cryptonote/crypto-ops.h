@@ -113,6 +113,13 @@ void ge_p3_to_p2(ge_p2 *, const ge_p3 *);
 
 void ge_p3_tobytes(unsigned char *, const ge_p3 *);
 
+/* New code, batched and vectorized versions */
+
+#define GE_P3_TOBYTES_BATCH_MAX 8
+
+void ge_p3_tobytes_batch(unsigned char *, const ge_p3 *, int);
+void ge_scalarmult_base_tobytes_x4(unsigned char *, const unsigned char *);
+
 /* From ge_scalarmult_base.c */
 
 extern const ge_precomp ge_base[32][8];
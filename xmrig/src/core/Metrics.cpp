@@ -0,0 +1,218 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "core/Metrics.h"
+#include "backend/common/Hashrate.h"
+#include "backend/common/interfaces/IBackend.h"
+#include "base/crypto/Algorithm.h"
+#include "base/net/stratum/NetworkState.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/String.h"
+#include "crypto/common/HugePagesInfo.h"
+#include "version.h"
+
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+
+
+namespace xmrig {
+
+
+static constexpr size_t kWindows                = 3;
+static const char *kWindowNames[kWindows]       = { "10s", "60s", "15m" };
+static const size_t kWindowIntervals[kWindows]  = { Hashrate::ShortInterval, Hashrate::MediumInterval, Hashrate::LargeInterval };
+
+
+#ifdef __GNUC__
+__attribute__((format(printf, 2, 3)))
+#endif
+static void append(std::string &out, const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+
+    va_list copy;
+    va_copy(copy, args);
+    const int size = vsnprintf(nullptr, 0, fmt, copy);
+    va_end(copy);
+
+    // Formatted in place, pool URLs and labels have no length limit.
+    if (size > 0) {
+        const size_t offset = out.size();
+
+        out.resize(offset + static_cast<size_t>(size) + 1);
+        vsnprintf(&out[offset], static_cast<size_t>(size) + 1, fmt, args);
+        out.resize(offset + static_cast<size_t>(size));
+    }
+
+    va_end(args);
+}
+
+
+// OpenMetrics has no null, absent per thread samples are NaN there and null in JSON, same as Json::normalize().
+static void appendNumber(std::string &out, double value, bool json)
+{
+    if (std::isnormal(value)) {
+        append(out, "%.2f", value);
+    }
+    else {
+        out.append(json ? "null" : "NaN");
+    }
+}
+
+
+static void appendHeader(std::string &out, const char *name, const char *type, const char *help)
+{
+    append(out, "# TYPE %s %s\n# HELP %s %s\n", name, type, name, help);
+}
+
+
+} // namespace xmrig
+
+
+xmrig::Metrics::Metrics() :
+    m_timestamp(Chrono::steadyMSecs())
+{
+}
+
+
+void xmrig::Metrics::update(const std::vector<IBackend *> &backends, const NetworkState *state, const Algorithm &algorithm, double highest)
+{
+    m_text.clear();
+    m_json.clear();
+
+    const char *algo      = algorithm.isValid() ? algorithm.name() : "";
+    const uint64_t uptime = (Chrono::steadyMSecs() - m_timestamp) / 1000;
+
+    double total[kWindows] = { 0.0, 0.0, 0.0 };
+    for (const IBackend *backend : backends) {
+        const Hashrate *hashrate = backend->isEnabled() ? backend->hashrate() : nullptr;
+        if (!hashrate) {
+            continue;
+        }
+
+        for (size_t i = 0; i < kWindows; ++i) {
+            total[i] += hashrate->calcIncremental(kWindowIntervals[i]);
+        }
+    }
+
+    appendHeader(m_text, "xmrig", "info", "Miner version and current algorithm.");
+    append(m_text, "xmrig_info{algo=\"%s\",version=\"%s\"} 1\n", algo, APP_VERSION);
+
+    appendHeader(m_text, "xmrig_uptime_seconds", "gauge", "Time since the miner was started.");
+    append(m_text, "xmrig_uptime_seconds %" PRIu64 "\n", uptime);
+
+    appendHeader(m_text, "xmrig_hashrate", "gauge", "Total hashrate in H/s.");
+    for (size_t i = 0; i < kWindows; ++i) {
+        append(m_text, "xmrig_hashrate{window=\"%s\"} %.2f\n", kWindowNames[i], total[i]);
+    }
+
+    appendHeader(m_text, "xmrig_hashrate_highest", "gauge", "Highest 10s hashrate for the current algorithm in H/s.");
+    append(m_text, "xmrig_hashrate_highest %.2f\n", highest);
+
+    append(m_json, "{\"version\":\"%s\",\"algo\":\"%s\",\"uptime\":%" PRIu64 ",\"hashrate\":{", APP_VERSION, algo, uptime);
+    for (size_t i = 0; i < kWindows; ++i) {
+        append(m_json, "\"%s\":%.2f,", kWindowNames[i], total[i]);
+    }
+
+    append(m_json, "\"highest\":%.2f},\"backends\":[", highest);
+
+    appendHeader(m_text, "xmrig_thread_hashrate", "gauge", "Per thread hashrate in H/s.");
+
+    std::string hugePagesText;
+    bool first = true;
+
+    for (const IBackend *backend : backends) {
+        if (!backend->isEnabled()) {
+            continue;
+        }
+
+        const char *type     = backend->type().data();
+#       ifdef XMRIG_FEATURE_API
+        const auto hugePages = backend->hugePages();
+#       else
+        const HugePagesInfo hugePages;
+#       endif
+
+        append(hugePagesText, "xmrig_hugepages{backend=\"%s\",state=\"allocated\"} %zu\n", type, hugePages.allocated);
+        append(hugePagesText, "xmrig_hugepages{backend=\"%s\",state=\"total\"} %zu\n", type, hugePages.total);
+
+        append(m_json, "%s{\"type\":\"%s\",\"hugepages\":[%zu,%zu],\"threads\":[", first ? "" : ",", type, hugePages.allocated, hugePages.total);
+        first = false;
+
+        const Hashrate *hashrate = backend->hashrate();
+        const size_t threads     = hashrate ? hashrate->threads() : 0;
+
+        for (size_t thread = 0; thread < threads; ++thread) {
+            m_json.append(thread ? ",[" : "[");
+
+            for (size_t i = 0; i < kWindows; ++i) {
+                const double value = hashrate->calcIncremental(thread, kWindowIntervals[i]);
+
+                append(m_text, "xmrig_thread_hashrate{backend=\"%s\",thread=\"%zu\",window=\"%s\"} ", type, thread, kWindowNames[i]);
+                appendNumber(m_text, value, false);
+                m_text.push_back('\n');
+
+                if (i) {
+                    m_json.push_back(',');
+                }
+
+                appendNumber(m_json, value, true);
+            }
+
+            m_json.push_back(']');
+        }
+
+        m_json.append("]}");
+    }
+
+    m_json.append("]");
+
+    appendHeader(m_text, "xmrig_hugepages", "gauge", "Huge pages used by the backend.");
+    m_text.append(hugePagesText);
+
+    if (state) {
+        const uint64_t accepted = state->accepted();
+
+        appendHeader(m_text, "xmrig_shares", "counter", "Results submitted to the pool.");
+        append(m_text, "xmrig_shares_total{result=\"accepted\"} %" PRIu64 "\n", accepted);
+        append(m_text, "xmrig_shares_total{result=\"rejected\"} %" PRIu64 "\n", state->rejected());
+
+        appendHeader(m_text, "xmrig_shares_difficulty", "counter", "Sum of difficulties of accepted results.");
+        append(m_text, "xmrig_shares_difficulty_total %" PRIu64 "\n", state->hashes());
+
+        appendHeader(m_text, "xmrig_share_latency_milliseconds", "summary", "Pool response time for accepted results.");
+        append(m_text, "xmrig_share_latency_milliseconds_count %" PRIu64 "\n", accepted);
+        append(m_text, "xmrig_share_latency_milliseconds_sum %" PRIu64 "\n", state->latencySum());
+
+        appendHeader(m_text, "xmrig_pool_difficulty", "gauge", "Difficulty of the current job.");
+        append(m_text, "xmrig_pool_difficulty %" PRIu64 "\n", state->diff());
+
+        appendHeader(m_text, "xmrig_pool_failures", "counter", "Pool connection failures.");
+        append(m_text, "xmrig_pool_failures_total %" PRIu64 "\n", state->failures());
+
+        append(m_json, ",\"results\":{\"accepted\":%" PRIu64 ",\"rejected\":%" PRIu64 ",\"hashes_total\":%" PRIu64 ",\"latency_sum\":%" PRIu64 "},\"diff\":%" PRIu64 ",\"failures\":%" PRIu64,
+               accepted, state->rejected(), state->hashes(), state->latencySum(), state->diff(), state->failures());
+    }
+
+    m_json.push_back('}');
+    m_text.append("# EOF\n");
+}
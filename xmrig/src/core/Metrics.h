@@ -0,0 +1,66 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_METRICS_H
+#define XMRIG_METRICS_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace xmrig {
+
+
+class Algorithm;
+class IBackend;
+class NetworkState;
+
+
+/**
+ * Miner metrics snapshot, rebuilt by the miner timer and handed over to the API already serialized, so scrapes
+ * don't touch backends or build a JSON DOM. Buffers are swapped with the previous snapshot and reused.
+ */
+class Metrics
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(Metrics)
+
+    Metrics();
+    ~Metrics() = default;
+
+    inline std::string &json()  { return m_json; }
+    inline std::string &text()  { return m_text; }
+
+    void update(const std::vector<IBackend *> &backends, const NetworkState *state, const Algorithm &algorithm, double highest);
+
+private:
+    const uint64_t m_timestamp;
+    std::string m_json;
+    std::string m_text;
+};
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_METRICS_H */
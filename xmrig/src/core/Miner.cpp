@@ -17,6 +17,7 @@
  */
 
 #include <algorithm>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -35,6 +36,7 @@
 #include "base/tools/Timer.h"
 #include "core/config/Config.h"
 #include "core/Controller.h"
+#include "core/Metrics.h"
 #include "crypto/common/Nonce.h"
 #include "version.h"
 
@@ -42,6 +44,7 @@
 #ifdef XMRIG_FEATURE_API
 #   include "base/api/Api.h"
 #   include "base/api/interfaces/IApiRequest.h"
+#   include "net/Network.h"
 #endif
 
 
@@ -67,6 +70,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -93,6 +101,10 @@ public:
 #       ifdef XMRIG_ALGO_RANDOMX
         Rx::destroy();
 #       endif
+
+#       ifdef XMRIG_FEATURE_ASM
+        CnRCache::destroy();
+#       endif
     }
 
 
@@ -114,6 +126,68 @@ public:
     }
 
 
+    inline IBackend *cpu() const
+    {
+        for (IBackend *backend : backends) {
+            if (backend->type() == "cpu") {
+                return backend;
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    // Threads of other groups keep their job, they are paused only with the whole miner.
+    static inline void touch(uint32_t group)
+    {
+        for (uint32_t backend = 0; backend < Nonce::MAX; ++backend) {
+            Nonce::touch(static_cast<Nonce::Backend>(backend), group);
+        }
+    }
+
+
+    inline void resume()
+    {
+        Nonce::pause(false, 0);
+
+        for (const auto &kv : groups) {
+            if (kv.second.isValid()) {
+                Nonce::pause(false, kv.first);
+            }
+        }
+    }
+
+
+    // Threads of group 0 are stopped, other groups keep mining with their own datasets.
+    inline void stop()
+    {
+        for (uint32_t backend = 0; backend < Nonce::MAX; ++backend) {
+            Nonce::stop(static_cast<Nonce::Backend>(backend), 0);
+        }
+
+        Nonce::pause(false, 0);
+
+        for (IBackend *backend : backends) {
+            if (backend->type() == "cpu") {
+                backend->setJob(Job());
+            }
+            else {
+                backend->stop();
+            }
+        }
+    }
+
+
+    inline void startTimer()
+    {
+        if (ticks == 0) {
+            ticks++;
+            timer->start(500, 500);
+        }
+    }
+
+
     inline void handleJobChange()
     {
         if (!enabled) {
@@ -128,15 +202,108 @@ public:
             backend->setJob(job);
         }
 
-        Nonce::touch();
+        touch(0);
 
         if (active && enabled) {
-            Nonce::pause(false);
+            resume();
         }
 
-        if (ticks == 0) {
-            ticks++;
-            timer->start(500, 500);
+        startTimer();
+    }
+
+
+    // Must be called with locked mutex, workers get the job without any locks.
+    inline void publish(const Job &job)
+    {
+        if (job.group() < Nonce::kMaxGroups) {
+            publishers[job.group()].publish(job);
+        }
+    }
+
+
+    // Jobs of pool groups > 0 are mined only by CPU threads of the group, with their own nonce space.
+    void setGroupJob(const Job &job)
+    {
+        IBackend *backend = cpu();
+        if (!backend) {
+            return;
+        }
+
+        backend->prepare(job);
+
+        const uint32_t group = job.group();
+
+        mutex.lock();
+
+        Job &current = groups[group];
+        if (current != job) {
+            Nonce::reset(0, group);
+        }
+
+        const Algorithm previous = current.algorithm();
+
+        current = job;
+        current.setIndex(0);
+
+#       ifdef XMRIG_ALGO_RANDOMX
+        const bool ready = initRX(current) || isLightReady(current);
+#       else
+        constexpr const bool ready = true;
+#       endif
+
+        if (!ready) {
+            Nonce::pause(true, group);
+        }
+
+        publish(current);
+
+        mutex.unlock();
+
+        startTimer();
+
+        // The job is applied by onDatasetReady(), threads of the previous algorithm are stopped before they get it.
+        if (!ready) {
+            if (previous.isValid() && previous != job.algorithm()) {
+                Job stop;
+                stop.setGroup(group);
+
+                backend->setJob(stop);
+            }
+
+            Nonce::touch(Nonce::CPU, group);
+
+            return;
+        }
+
+        applyGroupJob(backend, current);
+    }
+
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    void onGroupDatasetReady(uint32_t group)
+    {
+        IBackend *backend = cpu();
+        if (!backend) {
+            return;
+        }
+
+        const Job job = controller->miner()->job(group);
+        if (!job.isValid() || (!Rx::isReady(job) && !isLightReady(job))) {
+            return;
+        }
+
+        applyGroupJob(backend, job);
+    }
+#   endif
+
+
+    inline void applyGroupJob(IBackend *backend, const Job &job)
+    {
+        backend->setJob(job);
+        Nonce::touch(Nonce::CPU, job.group());
+
+        if (enabled) {
+            Nonce::pause(false, job.group());
         }
     }
 
@@ -344,7 +511,24 @@ public:
 
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    inline bool initRX() const { return Rx::init(job, controller->config()->rx(), controller->config()->cpu()); }
+    inline bool initRX(const Job &job) const { return Rx::init(job, controller->config()->rx(), controller->config()->cpu()); }
+
+
+    // Light mode is used only if CPU is the only backend for the algorithm, other backends need the dataset.
+    inline bool isLightReady(const Job &job) const
+    {
+        if (!Rx::isLightReady(job)) {
+            return false;
+        }
+
+        for (IBackend *backend : backends) {
+            if (backend->isEnabled() && backend->isEnabled(job.algorithm()) && backend->type() != "cpu") {
+                return false;
+            }
+        }
+
+        return true;
+    }
 #   endif
 
 
@@ -363,7 +547,10 @@ public:
     bool reset          = true;
     Controller *controller;
     Job job;
+    JobPublisher publishers[Nonce::kMaxGroups];     // snapshots of the current job of each group for workers
     mutable std::map<Algorithm::Id, double> maxHashrate;
+    std::map<uint32_t, Job> groups;
+    Metrics metrics;
     std::vector<IBackend *> backends;
     String userJobId;
     Timer *timer        = nullptr;
@@ -447,14 +634,26 @@ const std::vector<xmrig::IBackend *> &xmrig::Miner::backends() const
 }
 
 
-xmrig::Job xmrig::Miner::job() const
+xmrig::Job xmrig::Miner::job(uint32_t group) const
 {
     std::lock_guard<std::mutex> lock(mutex);
 
+    if (group > 0) {
+        const auto it = d_ptr->groups.find(group);
+
+        return it != d_ptr->groups.end() ? it->second : Job();
+    }
+
     return d_ptr->job;
 }
 
 
+xmrig::JobRef xmrig::Miner::jobSnapshot(uint32_t group) const
+{
+    return group < Nonce::kMaxGroups ? d_ptr->publishers[group].get() : JobRef();
+}
+
+
 void xmrig::Miner::execCommand(char command)
 {
     switch (command) {
@@ -500,6 +699,22 @@ void xmrig::Miner::pause()
 }
 
 
+void xmrig::Miner::pause(uint32_t group)
+{
+    mutex.lock();
+
+    Job &job = d_ptr->groups[group];
+    job.reset();
+    job.setGroup(group);
+    d_ptr->publish(job);
+
+    mutex.unlock();
+
+    Nonce::pause(true, group);
+    Nonce::touch(Nonce::CPU, group);
+}
+
+
 void xmrig::Miner::setEnabled(bool enabled)
 {
     if (d_ptr->enabled == enabled) {
@@ -531,25 +746,35 @@ void xmrig::Miner::setEnabled(bool enabled)
         return;
     }
 
-    Nonce::pause(!enabled);
+    if (enabled) {
+        d_ptr->resume();
+    }
+    else {
+        Nonce::pause(true);
+    }
+
     Nonce::touch();
 }
 
 
 void xmrig::Miner::setJob(const Job &job, bool donate)
 {
+    if (job.group() > 0) {
+        return d_ptr->setGroupJob(job);
+    }
+
     for (IBackend *backend : d_ptr->backends) {
         backend->prepare(job);
     }
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    if (job.algorithm().family() == Algorithm::RANDOM_X && !Rx::isReady(job)) {
+    if (job.algorithm().family() == Algorithm::RANDOM_X && !Rx::isReady(job) && !d_ptr->isLightReady(job)) {
         if (d_ptr->algorithm != job.algorithm()) {
-            stop();
+            d_ptr->stop();
         }
         else {
-            Nonce::pause(true);
-            Nonce::touch();
+            Nonce::pause(true, 0);
+            d_ptr->touch(0);
         }
     }
 #   endif
@@ -563,13 +788,14 @@ void xmrig::Miner::setJob(const Job &job, bool donate)
     d_ptr->reset = !(d_ptr->job.index() == 1 && index == 0 && d_ptr->userJobId == job.id());
     d_ptr->job   = job;
     d_ptr->job.setIndex(index);
+    d_ptr->publish(d_ptr->job);
 
     if (index == 0) {
         d_ptr->userJobId = job.id();
     }
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    const bool ready = d_ptr->initRX();
+    const bool ready = d_ptr->initRX(d_ptr->job) || d_ptr->isLightReady(job);
 #   else
     constexpr const bool ready = true;
 #   endif
@@ -605,6 +831,31 @@ void xmrig::Miner::onConfigChanged(Config *config, Config *previousConfig)
 {
     d_ptr->rebuild();
 
+    // Thread groups may have been changed, threads of groups without pools are stopped.
+    IBackend *cpu = d_ptr->cpu();
+    if (cpu) {
+        const auto groups = config->pools().groups();
+
+        for (uint32_t group = 1; group < Nonce::kMaxGroups; ++group) {
+            if (std::find(groups.begin(), groups.end(), group) == groups.end()) {
+                mutex.lock();
+
+                if (d_ptr->groups.erase(group)) {
+                    Job job;
+                    job.setGroup(group);
+                    d_ptr->publish(job);
+                }
+
+                mutex.unlock();
+            }
+
+            Job job = this->job(group);
+            job.setGroup(group);
+
+            cpu->setJob(job);
+        }
+    }
+
     if (config->pools() != previousConfig->pools() && config->pools().active() > 0) {
         return;
     }
@@ -641,6 +892,13 @@ void xmrig::Miner::onTimer(const Timer *)
 
     d_ptr->maxHashrate[d_ptr->algorithm] = std::max(d_ptr->maxHashrate[d_ptr->algorithm], maxHashrate);
 
+#   ifdef XMRIG_FEATURE_API
+    if (config->http().isEnabled()) {
+        d_ptr->metrics.update(d_ptr->backends, d_ptr->controller->network()->state(), d_ptr->algorithm, d_ptr->maxHashrate[d_ptr->algorithm]);
+        d_ptr->controller->api()->setMetrics(d_ptr->metrics.text(), d_ptr->metrics.json());
+    }
+#   endif
+
     const auto printTime = config->printTime();
     if (printTime && d_ptr->ticks && (d_ptr->ticks % (printTime * 2)) == 0) {
         d_ptr->printHashrate(false);
@@ -715,12 +973,20 @@ void xmrig::Miner::onRequest(IApiRequest &request)
 
 
 #ifdef XMRIG_ALGO_RANDOMX
-void xmrig::Miner::onDatasetReady()
+void xmrig::Miner::onDatasetReady(uint32_t group)
 {
-    if (!Rx::isReady(job())) {
+    if (group > 0) {
+        return d_ptr->onGroupDatasetReady(group);
+    }
+
+    const Job job = this->job();
+    if (!Rx::isReady(job) && !d_ptr->isLightReady(job)) {
         return;
     }
 
     d_ptr->handleJobChange();
+
+    // Dataset became ready while the same job is hashed in light mode, nonces must not start again.
+    d_ptr->reset = false;
 }
 #endif
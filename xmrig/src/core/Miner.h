@@ -24,6 +24,7 @@
 
 
 #include "backend/common/interfaces/IRxListener.h"
+#include "backend/common/JobSnapshot.h"
 #include "base/api/interfaces/IApiListener.h"
 #include "base/crypto/Algorithm.h"
 #include "base/kernel/interfaces/IBaseListener.h"
@@ -35,7 +36,6 @@ namespace xmrig {
 
 
 class Controller;
-class Job;
 class MinerPrivate;
 class IBackend;
 
@@ -52,9 +52,11 @@ public:
     bool isEnabled(const Algorithm &algorithm) const;
     const Algorithms &algorithms() const;
     const std::vector<IBackend *> &backends() const;
-    Job job() const;
+    Job job(uint32_t group = 0) const;
+    JobRef jobSnapshot(uint32_t group = 0) const;
     void execCommand(char command);
     void pause();
+    void pause(uint32_t group);
     void setEnabled(bool enabled);
     void setJob(const Job &job, bool donate);
     void stop();
@@ -68,7 +70,7 @@ protected:
 #   endif
 
 #   ifdef XMRIG_ALGO_RANDOMX
-    void onDatasetReady() override;
+    void onDatasetReady(uint32_t group) override;
 #   endif
 
 private:
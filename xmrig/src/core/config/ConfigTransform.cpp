@@ -175,6 +175,9 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::RandomXModeKey: /* --randomx-mode */
         return set(doc, RxConfig::kField, RxConfig::kMode, arg);
 
+    case IConfig::RandomXHybridMemKey: /* --randomx-hybrid-memory */
+        return set(doc, RxConfig::kField, RxConfig::kHybridMemory, static_cast<uint64_t>(strtoul(arg, nullptr, 10)));
+
     case IConfig::RandomX1GbPagesKey: /* --randomx-1gb-pages */
         return set(doc, RxConfig::kField, RxConfig::kOneGbPages, true);
 
@@ -262,6 +265,9 @@ void xmrig::ConfigTransform::transform(rapidjson::Document &doc, int key, const
     case IConfig::BenchHashKey:     /* --hash */
     case IConfig::UserKey:          /* --user */
     case IConfig::RotationKey:      /* --rotation */
+    case IConfig::BenchReportKey:   /* --bench-report */
+    case IConfig::BenchBaselineKey: /* --bench-baseline */
+    case IConfig::BenchThresholdKey: /* --bench-threshold */
         return transformBenchmark(doc, key, arg);
 #   endif
 
@@ -356,6 +362,15 @@ void xmrig::ConfigTransform::transformBenchmark(rapidjson::Document &doc, int ke
     case IConfig::RotationKey: /* --rotation */
         return set(doc, BenchConfig::kBenchmark, BenchConfig::kRotation, arg);
 
+    case IConfig::BenchReportKey: /* --bench-report */
+        return set(doc, BenchConfig::kBenchmark, BenchConfig::kReport, arg);
+
+    case IConfig::BenchBaselineKey: /* --bench-baseline */
+        return set(doc, BenchConfig::kBenchmark, BenchConfig::kBaseline, arg);
+
+    case IConfig::BenchThresholdKey: /* --bench-threshold */
+        return set(doc, BenchConfig::kBenchmark, BenchConfig::kThreshold, strtod(arg, nullptr));
+
     default:
         break;
     }
@@ -47,10 +47,16 @@ R"===(
     "randomx": {
         "init": -1,
         "init-avx2": -1,
+        "init-avx512": -1,
+        "init-light": -1,
         "mode": "auto",
+        "hybrid-memory": 0,
+        "dataset-cache": null,
+        "dataset-cache-max": 2,
         "1gb-pages": false,
         "rdmsr": true,
         "wrmsr": true,
+        "wrmsr-watchdog": 60,
         "cache_qos": false,
         "numa": true,
         "scratchpad_prefetch_mode": 1
@@ -60,6 +66,7 @@ R"===(
         "huge-pages": true,
         "huge-pages-jit": false,
         "hw-aes": null,
+        "soft-aes": "auto",
         "priority": null,
         "memory-pool": false,
         "yield": true,
@@ -112,6 +112,9 @@ static const option options[] = {
 #   endif
     { "seed",                  1, nullptr, IConfig::BenchSeedKey          },
     { "hash",                  1, nullptr, IConfig::BenchHashKey          },
+    { "bench-report",          1, nullptr, IConfig::BenchReportKey        },
+    { "bench-baseline",        1, nullptr, IConfig::BenchBaselineKey      },
+    { "bench-threshold",       1, nullptr, IConfig::BenchThresholdKey     },
 #   endif
 #   ifdef XMRIG_FEATURE_TLS
     { "tls",                   0, nullptr, IConfig::TlsKey                },
@@ -131,6 +134,7 @@ static const option options[] = {
     { "randomx-init",          1, nullptr, IConfig::RandomXInitKey        },
     { "randomx-no-numa",       0, nullptr, IConfig::RandomXNumaKey        },
     { "randomx-mode",          1, nullptr, IConfig::RandomXModeKey        },
+    { "randomx-hybrid-memory", 1, nullptr, IConfig::RandomXHybridMemKey   },
     { "randomx-1gb-pages",     0, nullptr, IConfig::RandomX1GbPagesKey    },
     { "1gb-pages",             0, nullptr, IConfig::RandomX1GbPagesKey    },
     { "randomx-wrmsr",         2, nullptr, IConfig::RandomXWrmsrKey       },
@@ -101,7 +101,8 @@ static inline const std::string &usage()
 #   ifdef XMRIG_ALGO_RANDOMX
     u += "      --randomx-init=N          threads count to initialize RandomX dataset\n";
     u += "      --randomx-no-numa         disable NUMA support for RandomX\n";
-    u += "      --randomx-mode=MODE       RandomX mode: auto, fast, light\n";
+    u += "      --randomx-mode=MODE       RandomX mode: auto, fast, light, hybrid\n";
+    u += "      --randomx-hybrid-memory=N memory limit in MB for precomputed dataset items in hybrid mode, 0 for all free memory\n";
     u += "      --randomx-1gb-pages       use 1GB hugepages for RandomX dataset (Linux only)\n";
     u += "      --randomx-wrmsr=N         write custom value(s) to MSR registers or disable MSR mod (-1)\n";
     u += "      --randomx-no-rdmsr        disable reverting initial MSR values on exit\n";
@@ -193,6 +194,9 @@ static inline const std::string &usage()
 #   endif
     u += "      --seed=SEED               custom RandomX seed for benchmark\n";
     u += "      --hash=HASH               compare benchmark result with specified hash\n";
+    u += "      --bench-report=FILE       append benchmark result to regression report FILE\n";
+    u += "      --bench-baseline=FILE     compare benchmark result with baseline FILE, exit with code 1 on regression\n";
+    u += "      --bench-threshold=N       allowed regression in percent (default: 5)\n";
 #   endif
 
 #   ifdef XMRIG_FEATURE_DMI
@@ -49,6 +49,33 @@ inline void single_hash(const uint8_t *__restrict__ input, size_t size, uint8_t
 }
 
 
+template<Algorithm::Id ALGO, size_t N>
+inline void multi_hash(const uint8_t *__restrict__ input, size_t size, uint8_t *__restrict__ output, cryptonight_ctx **__restrict__ ctx, uint64_t)
+{
+    static_assert(N > 1 && N <= ARGON2_MAX_MULTI, "unsupported number of hashes");
+
+    const void *inputs[N];
+    void *outputs[N];
+    void *memory[N];
+
+    for (size_t i = 0; i < N; ++i) {
+        inputs[i]  = input + i * size;
+        outputs[i] = output + i * 32;
+        memory[i]  = ctx[i]->memory;
+    }
+
+    if (ALGO == Algorithm::AR2_CHUKWA) {
+        argon2id_hash_raw_multi(3, 512, inputs, size, inputs, 16, outputs, 32, memory, N);
+    }
+    else if (ALGO == Algorithm::AR2_CHUKWA_V2) {
+        argon2id_hash_raw_multi(4, 1024, inputs, size, inputs, 16, outputs, 32, memory, N);
+    }
+    else if (ALGO == Algorithm::AR2_WRKZ) {
+        argon2id_hash_raw_multi(4, 256, inputs, size, inputs, 16, outputs, 32, memory, N);
+    }
+}
+
+
 }} // namespace xmrig::argon2
 
 
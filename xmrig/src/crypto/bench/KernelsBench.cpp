@@ -0,0 +1,1568 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/bench/KernelsBench.h"
+#include "3rdparty/rapidjson/stringbuffer.h"
+#include "3rdparty/rapidjson/writer.h"
+#include "backend/common/JobSnapshot.h"
+#include "backend/common/WorkerJob.h"
+#include "backend/cpu/Cpu.h"
+#include "base/crypto/keccak.h"
+#include "base/kernel/Platform.h"
+#include "base/tools/Chrono.h"
+#include "crypto/cn/CnCtx.h"
+#include "crypto/cn/CnHash.h"
+#include "crypto/cn/CryptoNight.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
+#ifdef XMRIG_FEATURE_CN_EXTRA_LANES
+#   include "crypto/cn/CnExtraHashes.h"
+#endif
+
+
+#ifdef XMRIG_ALGO_ARGON2
+extern "C" {
+#   include "3rdparty/argon2/lib/impl-select.h"
+}
+#endif
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "base/io/log/Log.h"
+#   include "base/kernel/Process.h"
+#   include "base/net/stratum/Job.h"
+#   include "base/tools/cryptonote/BlockTemplate.h"
+#   include "base/tools/cryptonote/SignatureEngine.h"
+#   include "base/tools/cryptonote/Signatures.h"
+#   include "base/tools/Cvt.h"
+#   include "core/config/Config.h"
+#   include "core/Controller.h"
+#   include "core/Miner.h"
+#   include "crypto/randomx/aes_hash.hpp"
+#   include "crypto/randomx/randomx.h"
+#   include "crypto/rx/RxAlgo.h"
+#   include "crypto/rx/RxCache.h"
+#   include "crypto/rx/RxDataset.h"
+#   include "net/interfaces/IJobResultListener.h"
+#   include "net/JobResult.h"
+#   include "net/JobResults.h"
+#   include <uv.h>
+#   ifdef _MSC_VER
+#       include "getopt/getopt.h"
+#   else
+#       include <getopt.h>
+#   endif
+#endif
+
+
+#ifdef XMRIG_ALGO_GHOSTRIDER
+#   include "crypto/ghostrider/ghostrider.h"
+#   include "crypto/ghostrider/sph_blake.h"
+#   include "crypto/ghostrider/sph_bmw.h"
+#   include "crypto/ghostrider/sph_cubehash.h"
+#   include "crypto/ghostrider/sph_echo.h"
+#   include "crypto/ghostrider/sph_fugue.h"
+#   include "crypto/ghostrider/sph_groestl.h"
+#   include "crypto/ghostrider/sph_hamsi.h"
+#   include "crypto/ghostrider/sph_jh.h"
+#   include "crypto/ghostrider/sph_keccak.h"
+#   include "crypto/ghostrider/sph_luffa.h"
+#   include "crypto/ghostrider/sph_shabal.h"
+#   include "crypto/ghostrider/sph_shavite.h"
+#   include "crypto/ghostrider/sph_simd.h"
+#   include "crypto/ghostrider/sph_skein.h"
+#   include "crypto/ghostrider/sph_whirlpool.h"
+#endif
+
+
+#ifdef XMRIG_ALGO_KAWPOW
+#   include "crypto/kawpow/KPCache.h"
+#   include "crypto/kawpow/KPHash.h"
+#endif
+
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+
+
+#if defined(XMRIG_ALGO_RANDOMX) && defined(XMRIG_FEATURE_SSE4_1)
+extern "C" uint32_t rx_blake2b_use_sse41;
+#endif
+
+
+// Allocations of the calling thread, the jobs kernel checks that readers of published jobs never allocate.
+static thread_local uint64_t allocations = 0;
+
+
+void *operator new(size_t size)
+{
+    ++allocations;
+
+    void *ptr = malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+
+namespace xmrig {
+
+
+static const char *kHashes              = "H/s";
+static const char *kItems               = "items/s";
+static const char *kOps                 = "ops/s";
+static constexpr size_t kBlobSize       = 76;
+static constexpr size_t kMaxHashes      = 8;
+static constexpr uint64_t kCnHeight     = 1806260;  // CN_R programs depend on the height, keep it fixed for comparable results.
+
+
+static const char *avNames[CnHash::AV_MAX] = {
+    "auto",
+    "single",
+    "double",
+    "single-soft",
+    "double-soft",
+    "triple",
+    "quad",
+    "penta",
+    "triple-soft",
+    "quad-soft",
+    "penta-soft"
+};
+
+
+static inline size_t intensity(CnHash::AlgoVariant av)
+{
+    switch (av) {
+    case CnHash::AV_DOUBLE:
+    case CnHash::AV_DOUBLE_SOFT:
+        return 2;
+
+    case CnHash::AV_TRIPLE:
+    case CnHash::AV_TRIPLE_SOFT:
+        return 3;
+
+    case CnHash::AV_QUAD:
+    case CnHash::AV_QUAD_SOFT:
+        return 4;
+
+    case CnHash::AV_PENTA:
+    case CnHash::AV_PENTA_SOFT:
+        return 5;
+
+    default:
+        break;
+    }
+
+    return 1;
+}
+
+
+static inline bool isHwAes(CnHash::AlgoVariant av)
+{
+    return av == CnHash::AV_SINGLE || av == CnHash::AV_DOUBLE || (av > CnHash::AV_DOUBLE_SOFT && av < CnHash::AV_TRIPLE_SOFT);
+}
+
+
+static void fill(uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 0x9d + 0x37);
+    }
+}
+
+
+#ifdef XMRIG_ALGO_GHOSTRIDER
+#define CORE_HASH(x) [](const uint8_t *data, size_t size, uint8_t *output) { \
+    sph_##x##_context ctx;      \
+    sph_##x##_init(&ctx);       \
+    sph_##x(&ctx, data, size);  \
+    sph_##x##_close(&ctx, output); \
+}
+
+using core_hash_func = void (*)(const uint8_t *data, size_t size, uint8_t *output);
+
+static const std::pair<const char *, core_hash_func> coreHashes[] = {
+    { "blake512",    CORE_HASH(blake512)    },
+    { "bmw512",      CORE_HASH(bmw512)      },
+    { "groestl512",  CORE_HASH(groestl512)  },
+    { "jh512",       CORE_HASH(jh512)       },
+    { "keccak512",   CORE_HASH(keccak512)   },
+    { "skein512",    CORE_HASH(skein512)    },
+    { "luffa512",    CORE_HASH(luffa512)    },
+    { "cubehash512", CORE_HASH(cubehash512) },
+    { "shavite512",  CORE_HASH(shavite512)  },
+    { "simd512",     CORE_HASH(simd512)     },
+    { "echo512",     CORE_HASH(echo512)     },
+    { "hamsi512",    CORE_HASH(hamsi512)    },
+    { "fugue512",    CORE_HASH(fugue512)    },
+    { "shabal512",   CORE_HASH(shabal512)   },
+    { "whirlpool",   CORE_HASH(whirlpool)   }
+};
+
+#undef CORE_HASH
+
+
+static const std::pair<Algorithm::Id, const char *> grAlgorithms[] = {
+    { Algorithm::CN_GR_0, "cn/dark"         },
+    { Algorithm::CN_GR_1, "cn/dark-lite"    },
+    { Algorithm::CN_GR_2, "cn/fast"         },
+    { Algorithm::CN_GR_3, "cn/lite"         },
+    { Algorithm::CN_GR_4, "cn/turtle"       },
+    { Algorithm::CN_GR_5, "cn/turtle-lite"  }
+};
+#endif
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+static constexpr uint32_t kDatasetChunk = 5000;   // must be a multiple of 5 and 8 for the AVX2 and AVX-512 dataset init code.
+#endif
+
+
+#ifdef XMRIG_ALGO_KAWPOW
+static constexpr uint32_t kKawPowHeight = 1219736;
+#endif
+
+
+} // namespace xmrig
+
+
+xmrig::KernelsBench::KernelsBench(const Options &options) :
+    m_options(options)
+{
+}
+
+
+xmrig::KernelsBench::~KernelsBench()
+{
+#   ifdef XMRIG_FEATURE_ASM
+    CnRCache::destroy();
+#   endif
+
+    VirtualMemory::destroy();
+    Cpu::release();
+}
+
+
+int xmrig::KernelsBench::exec()
+{
+    VirtualMemory::init(0, VirtualMemory::kDefaultHugePageSize);
+
+    if (!m_options.list) {
+        const auto info = Cpu::info();
+
+        if (m_options.cpu >= 0 && !Platform::setThreadAffinity(static_cast<uint64_t>(m_options.cpu))) {
+            fprintf(stderr, "failed to set affinity to CPU #%" PRId64 "\n", m_options.cpu);
+
+            return 1;
+        }
+
+        fprintf(stderr, "CPU: %s, AES: %s, AVX2: %s, asm: %s, cpu: %" PRId64 ", huge pages: %s\n",
+                info->brand(),
+                info->hasAES() ? "yes" : "no",
+                info->hasAVX2() ? "yes" : "no",
+                Assembly(info->assembly()).toString(),
+                m_options.cpu,
+                m_options.hugePages ? "yes" : "no"
+                );
+
+        if (m_options.format == FORMAT_CSV) {
+            printf("group,algo,variant,impl,unit,samples,ops,mean,median,stddev,cv,min,max\n");
+        }
+    }
+
+    runKeccak();
+    runCn();
+    runCnFinal();
+    runArgon2();
+    runRandomX();
+    runSignatures();
+    runGhostRider();
+    runKawPow();
+    runJobs();
+    runSoftAes();
+    runMiner();
+
+    fflush(stdout);
+
+    if (!m_options.list && m_count == 0) {
+        fprintf(stderr, "no kernels match \"%s\"\n", m_options.filter.data());
+
+        return 1;
+    }
+
+    if (m_failed) {
+        fprintf(stderr, "%zu check(s) failed\n", m_failed);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+
+bool xmrig::KernelsBench::isEnabled(const char *group, const char *algo, const char *variant, const char *impl) const
+{
+    char id[256];
+    snprintf(id, sizeof(id), "%s/%s/%s/%s", group, algo, variant, impl);
+
+    if (!m_options.filter.isEmpty() && strstr(id, m_options.filter.data()) == nullptr) {
+        return false;
+    }
+
+    if (m_options.list) {
+        printf("%s\n", id);
+
+        return false;
+    }
+
+    return true;
+}
+
+
+void xmrig::KernelsBench::fail(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+
+    fputc('\n', stderr);
+
+    ++m_failed;
+}
+
+
+bool xmrig::KernelsBench::measure(const char *group, const char *algo, const char *variant, const char *impl, const char *unit, uint64_t items, const std::function<void()> &fn)
+{
+    // Warm-up also calibrates how many operations fit into a single sample.
+    uint64_t ops      = 0;
+    const double ts   = Chrono::highResolutionMSecs();
+    double elapsed    = 0.0;
+
+    do {
+        fn();
+        ++ops;
+        elapsed = Chrono::highResolutionMSecs() - ts;
+    } while (elapsed < m_options.warmup);
+
+    const uint64_t perSample = std::max<uint64_t>(1, static_cast<uint64_t>(ops * m_options.sampleTime / elapsed));
+
+    std::vector<double> samples;
+    samples.reserve(m_options.samples);
+
+    for (uint32_t i = 0; i < m_options.samples; ++i) {
+        const double start = Chrono::highResolutionMSecs();
+
+        for (uint64_t j = 0; j < perSample; ++j) {
+            fn();
+        }
+
+        samples.emplace_back(static_cast<double>(perSample * items) * 1000.0 / (Chrono::highResolutionMSecs() - start));
+    }
+
+    print(group, algo, variant, impl, unit, perSample, stats(samples));
+
+    return true;
+}
+
+
+void xmrig::KernelsBench::print(const char *group, const char *algo, const char *variant, const char *impl, const char *unit, uint64_t ops, const Stats &stats)
+{
+    using namespace rapidjson;
+
+    ++m_count;
+
+    if (m_options.format == FORMAT_CSV) {
+        printf("%s,%s,%s,%s,%s,%u,%" PRIu64 ",%.2f,%.2f,%.2f,%.4f,%.2f,%.2f\n",
+               group, algo, variant, impl, unit, m_options.samples, ops, stats.mean, stats.median, stats.stddev, stats.cv, stats.min, stats.max);
+
+        fflush(stdout);
+        return;
+    }
+
+    StringBuffer buffer(nullptr, 512);
+    Writer<StringBuffer> writer(buffer);
+
+    // Numbers are written with fixed precision to keep the output stable and easy to diff.
+    auto number = [&writer](const char *key, double value, int precision) {
+        char buf[64];
+        const int size = snprintf(buf, sizeof(buf), "%.*f", precision, std::isfinite(value) ? value : 0.0);
+
+        writer.Key(key);
+        writer.RawValue(buf, static_cast<size_t>(size), kNumberType);
+    };
+
+    writer.StartObject();
+    writer.Key("group");    writer.String(group);
+    writer.Key("algo");     writer.String(algo);
+    writer.Key("variant");  writer.String(variant);
+    writer.Key("impl");     writer.String(impl);
+    writer.Key("unit");     writer.String(unit);
+    writer.Key("samples");  writer.Uint(m_options.samples);
+    writer.Key("ops");      writer.Uint64(ops);
+
+    number("mean",   stats.mean, 2);
+    number("median", stats.median, 2);
+    number("stddev", stats.stddev, 2);
+    number("cv",     stats.cv, 4);
+    number("min",    stats.min, 2);
+    number("max",    stats.max, 2);
+
+    writer.EndObject();
+
+    printf("%s\n", buffer.GetString());
+    fflush(stdout);
+}
+
+
+void xmrig::KernelsBench::runArgon2()
+{
+#   ifdef XMRIG_ALGO_ARGON2
+    argon2_impl_list impls{};
+    argon2_get_impl_list(&impls);
+
+    static const CnHash::AlgoVariant variants[] = { CnHash::AV_SINGLE, CnHash::AV_DOUBLE, CnHash::AV_TRIPLE, CnHash::AV_QUAD, CnHash::AV_PENTA };
+
+    uint8_t blob[kBlobSize * 5];
+    uint8_t hash[32 * 5];
+    fill(blob, sizeof(blob));
+
+    std::vector<const char *> names;
+    for (size_t i = 0; i < impls.count; ++i) {
+        if (!impls.entries[i].check || impls.entries[i].check()) {
+            names.emplace_back(impls.entries[i].name);
+        }
+    }
+
+    if (names.empty()) {
+        names.emplace_back(argon2_get_impl_name());
+    }
+
+    for (const auto &algorithm : Algorithm::all([](const Algorithm &algo) { return algo.family() == Algorithm::ARGON2; })) {
+        std::unique_ptr<VirtualMemory> memory;
+
+        for (const auto av : variants) {
+            const auto fn = CnHash::fn(algorithm, av, Assembly::NONE);
+            if (!fn) {
+                continue;
+            }
+
+            for (const char *name : names) {
+                if (!isEnabled("argon2", algorithm.name(), avNames[av], name)) {
+                    continue;
+                }
+
+                if (!memory) {
+                    memory = std::unique_ptr<VirtualMemory>(new VirtualMemory(algorithm.l3() * 5, m_options.hugePages, false, false));
+                }
+
+                if (impls.count) {
+                    argon2_select_impl_by_name(name);
+                }
+
+                const size_t n = intensity(av);
+                cryptonight_ctx *ctx[5] = {};
+                CnCtx::create(ctx, memory->scratchpad(), algorithm.l3(), n);
+
+                measure("argon2", algorithm.name(), avNames[av], name, kHashes, n, [&]() { fn(blob, kBlobSize, hash, ctx, 0); });
+
+                CnCtx::release(ctx, n);
+            }
+        }
+    }
+#   endif
+}
+
+
+void xmrig::KernelsBench::runCn()
+{
+    std::vector<std::pair<const char *, Algorithm> > algorithms;
+
+    for (const auto &algorithm : Algorithm::all([](const Algorithm &algo) { return algo.isCN(); })) {
+        algorithms.emplace_back("cn", algorithm);
+    }
+
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    for (const auto &algorithm : grAlgorithms) {
+        algorithms.emplace_back("cn-gr", algorithm.first);
+    }
+#   endif
+
+#   ifdef XMRIG_FEATURE_ASM
+    static const Assembly::Id assemblies[] = { Assembly::NONE, Assembly::INTEL, Assembly::RYZEN, Assembly::BULLDOZER };
+#   else
+    static const Assembly::Id assemblies[] = { Assembly::NONE };
+#   endif
+
+    const bool hasAES = Cpu::info()->hasAES();
+
+    uint8_t blob[kBlobSize * 5];
+    uint8_t hash[32 * 5];
+    fill(blob, sizeof(blob));
+
+    for (const auto &entry : algorithms) {
+        const char *group           = entry.first;
+        const Algorithm &algorithm  = entry.second;
+        const char *name            = algorithm.name();
+
+#       ifdef XMRIG_ALGO_GHOSTRIDER
+        for (const auto &algo : grAlgorithms) {
+            if (algo.first == algorithm) {
+                name = algo.second;
+            }
+        }
+#       endif
+
+        std::unique_ptr<VirtualMemory> memory;
+
+        for (int i = CnHash::AV_SINGLE; i < CnHash::AV_MAX; ++i) {
+            const auto av = static_cast<CnHash::AlgoVariant>(i);
+            if (isHwAes(av) && !hasAES) {
+                continue;
+            }
+
+            // Assembly variants fall back to the generic code if not available, report each function only once.
+            std::vector<cn_hash_fun> seen;
+
+            for (const auto assembly : assemblies) {
+                const auto fn = CnHash::fn(algorithm, av, assembly);
+                if (!fn || std::find(seen.begin(), seen.end(), fn) != seen.end()) {
+                    continue;
+                }
+
+                seen.emplace_back(fn);
+
+                const char *impl    = Assembly(assembly).toString();
+                const bool steady   = isEnabled(group, name, avNames[av], impl);
+
+                // Every hash with a new height, the cost of a block change for CN-R programs.
+#               ifdef XMRIG_FEATURE_ASM
+                const bool heightSwitch = algorithm == Algorithm::CN_R && isEnabled("cn-r-switch", name, avNames[av], impl);
+#               else
+                const bool heightSwitch = false;
+#               endif
+
+                if (!steady && !heightSwitch) {
+                    continue;
+                }
+
+                if (!memory) {
+                    memory = std::unique_ptr<VirtualMemory>(new VirtualMemory(algorithm.l3() * 5, m_options.hugePages, false, false));
+                }
+
+                const size_t n = intensity(av);
+                cryptonight_ctx *ctx[5] = {};
+                CnCtx::create(ctx, memory->scratchpad(), algorithm.l3(), n);
+
+                if (steady) {
+                    measure(group, name, avNames[av], impl, kHashes, n, [&]() { fn(blob, kBlobSize, hash, ctx, kCnHeight); });
+                }
+
+                if (heightSwitch) {
+                    uint64_t height = kCnHeight;
+
+                    measure("cn-r-switch", name, avNames[av], impl, kHashes, n, [&]() { fn(blob, kBlobSize, hash, ctx, ++height); });
+                }
+
+                CnCtx::release(ctx, n);
+            }
+        }
+    }
+}
+
+
+void xmrig::KernelsBench::runCnFinal()
+{
+#   ifdef XMRIG_FEATURE_CN_EXTRA_LANES
+    constexpr size_t kStateSize = 200;
+    constexpr size_t kHashSize  = 32;
+    constexpr size_t kLanes     = 5;
+
+    static const char *names[] = { "blake256", "groestl256", "jh256", "skein256" };
+
+    uint8_t st[kLanes][kStateSize];
+    uint8_t expected[kLanes][kHashSize];
+    uint8_t hash[kLanes][kHashSize];
+    const uint8_t *states[kLanes];
+    uint8_t *output[kLanes];
+
+    for (size_t i = 0; i < kLanes; ++i) {
+        states[i] = st[i];
+        output[i] = hash[i];
+    }
+
+    // Every lane count of each SIMD finalizer must produce exactly the same hashes as the scalar code, lane by lane.
+    for (uint32_t fn = 0; fn < 4; ++fn) {
+        for (size_t i = 0; i < kLanes; ++i) {
+            fill(st[i], kStateSize);
+            st[i][0]               = static_cast<uint8_t>((st[i][0] & ~3U) | fn);
+            st[i][1]              ^= static_cast<uint8_t>(i);
+            st[i][kStateSize - 1] ^= static_cast<uint8_t>(i * 0x11);
+
+            cn_extra_hash(fn, st[i], expected[i]);
+        }
+
+        for (size_t count = 2; count <= kLanes; ++count) {
+            memset(hash, 0, sizeof(hash));
+
+            if (cn_extra_hash_lanes(fn, states, count, output) && memcmp(hash, expected, count * kHashSize) != 0) {
+                fail("cn-final: %s x%zu lane mismatch", names[fn], count);
+            }
+        }
+
+        if (isEnabled("cn-final", names[fn], "x4", "scalar")) {
+            measure("cn-final", names[fn], "x4", "scalar", kItems, 4, [&]() {
+                for (size_t i = 0; i < 4; ++i) {
+                    cn_extra_hash(fn, states[i], output[i]);
+                }
+            });
+        }
+
+        if (cn_extra_hash_lanes(fn, states, 4, output) && isEnabled("cn-final", names[fn], "x4", "simd")) {
+            measure("cn-final", names[fn], "x4", "simd", kItems, 4, [&]() { cn_extra_hash_lanes(fn, states, 4, output); });
+        }
+    }
+
+    // Final hashes of a 5-way CryptoNight worker, lanes 0, 2, 4 and 1, 3 share a function.
+    for (size_t i = 0; i < kLanes; ++i) {
+        fill(st[i], kStateSize);
+        st[i][0]  = static_cast<uint8_t>((st[i][0] & ~3U) | (i & 1 ? 3 : 1));
+        st[i][1] ^= static_cast<uint8_t>(i);
+
+        cn_extra_hash(st[i][0] & 3, st[i], expected[i]);
+    }
+
+    memset(hash, 0, sizeof(hash));
+    cn_extra_hashes(states, kLanes, hash[0]);
+    if (memcmp(hash, expected, sizeof(hash)) != 0) {
+        fail("cn-final: x5 mixed lane mismatch");
+    }
+
+    if (isEnabled("cn-final", "mixed", "x5", "scalar")) {
+        measure("cn-final", "mixed", "x5", "scalar", kItems, kLanes, [&]() {
+            for (size_t i = 0; i < kLanes; ++i) {
+                cn_extra_hash(st[i][0] & 3, st[i], hash[i]);
+            }
+        });
+    }
+
+    if (isEnabled("cn-final", "mixed", "x5", "batched")) {
+        measure("cn-final", "mixed", "x5", "batched", kItems, kLanes, [&]() { cn_extra_hashes(states, kLanes, hash[0]); });
+    }
+#   endif
+}
+
+
+void xmrig::KernelsBench::runGhostRider()
+{
+#   ifdef XMRIG_ALGO_GHOSTRIDER
+    const char *algo = Algorithm(Algorithm::GHOSTRIDER_RTM).name();
+
+    uint8_t blob[80 * kMaxHashes];
+    uint8_t hash[64 * kMaxHashes];
+    fill(blob, sizeof(blob));
+
+    for (const auto &core : coreHashes) {
+        if (!isEnabled("ghostrider", algo, core.first, "sph")) {
+            continue;
+        }
+
+        const auto fn = core.second;
+
+        // Inner rounds of GhostRider hash the 64-byte output of the previous round.
+        measure("ghostrider", algo, core.first, "sph", kHashes, 1, [&]() { fn(blob, 64, hash); });
+    }
+
+    if (!isEnabled("ghostrider", algo, "octa", "none")) {
+        return;
+    }
+
+    const size_t l3 = Algorithm::l3(Algorithm::GHOSTRIDER_RTM);
+    VirtualMemory memory(l3 * kMaxHashes, m_options.hugePages, false, false);
+
+    cryptonight_ctx *ctx[kMaxHashes] = {};
+    CnCtx::create(ctx, memory.scratchpad(), l3, kMaxHashes);
+
+    measure("ghostrider", algo, "octa", "none", kHashes, kMaxHashes, [&]() { ghostrider::hash_octa(blob, 80, hash, ctx, nullptr, false); });
+
+    CnCtx::release(ctx, kMaxHashes);
+#   endif
+}
+
+
+/**
+ * Job publication of a pool group: the benchmark thread publishes jobs (measured), reader threads take the current
+ * snapshot and load it into a worker job as mining threads do. Every reader checks that a snapshot doesn't change while
+ * it holds a reference and that nothing is allocated in the reader path.
+ */
+void xmrig::KernelsBench::runJobs()
+{
+    constexpr size_t kReaders   = 3;
+    constexpr size_t kJobs      = 64;
+    constexpr size_t kBlobSize2 = kBlobSize * 2;
+
+    if (!isEnabled("jobs", "publisher", "publish-3-readers", "rcu")) {
+        return;
+    }
+
+    // Height of a job is also written to the start of its blob, a reused or torn snapshot breaks the pair.
+    std::vector<Job> jobs;
+    jobs.reserve(kJobs);
+
+    for (size_t i = 0; i < kJobs; ++i) {
+        uint8_t blob[kBlobSize];
+        fill(blob, sizeof(blob));
+        memcpy(blob, &i, sizeof(uint32_t));
+        memset(blob + 39, 0, 4);
+
+        char hex[kBlobSize2 + 1];
+        for (size_t j = 0; j < kBlobSize; ++j) {
+            snprintf(hex + j * 2, 3, "%02x", blob[j]);
+        }
+
+        char id[16];
+        snprintf(id, sizeof(id), "%zu", i);
+
+        jobs.emplace_back(false, Algorithm::CN_2, String());
+        jobs.back().setId(id);
+        jobs.back().setBlob(hex);
+        jobs.back().setHeight(i);
+    }
+
+    JobPublisher publisher;
+    publisher.publish(jobs[0]);
+
+    std::atomic<bool> done{ false };
+    std::atomic<uint64_t> reads{ 0 };
+    std::atomic<uint64_t> errors{ 0 };
+    std::atomic<uint64_t> readerAllocations{ 0 };
+    std::thread readers[kReaders];
+
+    for (auto &reader : readers) {
+        reader = std::thread([&]() {
+            WorkerJob<1> worker;
+            uint64_t count       = 0;
+            uint64_t mismatches  = 0;
+            const uint64_t start = allocations;
+
+            while (!done.load(std::memory_order_relaxed)) {
+                const JobRef job = publisher.get();
+
+                const uint32_t height = static_cast<uint32_t>(job->height());
+                mismatches += memcmp(job->blob(), &height, sizeof(height)) != 0;
+
+                worker.add(job, 1, Nonce::CPU);
+                mismatches += memcmp(worker.blob(), &height, sizeof(height)) != 0 || worker.currentJob().height() != height;
+
+                // The snapshot must be the same at the end, the publisher can't reuse it while it is referenced.
+                mismatches += static_cast<uint32_t>(job->height()) != height || memcmp(job->blob(), &height, sizeof(height)) != 0;
+                ++count;
+            }
+
+            readerAllocations += allocations - start;
+            reads             += count;
+            errors            += mismatches;
+        });
+    }
+
+    size_t index       = 0;
+    const double start = Chrono::highResolutionMSecs();
+
+    measure("jobs", "publisher", "publish-3-readers", "rcu", kOps, 1, [&]() { publisher.publish(jobs[++index % kJobs]); });
+
+    const double elapsed = Chrono::highResolutionMSecs() - start;
+    done = true;
+
+    for (auto &reader : readers) {
+        reader.join();
+    }
+
+    fprintf(stderr, "jobs: %" PRIu64 " reads (%.0f/s), %" PRIu64 " allocations in the reader path\n", reads.load(), reads * 1000.0 / elapsed, readerAllocations.load());
+
+    if (errors) {
+        fail("jobs: %" PRIu64 " inconsistent snapshots", errors.load());
+    }
+
+    if (readerAllocations) {
+        fail("jobs: reader path allocates memory");
+    }
+}
+
+
+void xmrig::KernelsBench::runKawPow()
+{
+#   ifdef XMRIG_ALGO_KAWPOW
+    const char *algo = Algorithm(Algorithm::KAWPOW_RVN).name();
+
+    if (!isEnabled("kawpow", algo, "hash-light", "none")) {
+        return;
+    }
+
+    KPCache cache;
+    if (!cache.init(kKawPowHeight / KPHash::EPOCH_LENGTH)) {
+        return;
+    }
+
+    uint8_t header[32];
+    uint32_t output[8];
+    uint32_t mix[8];
+    uint64_t nonce = 0;
+    fill(header, sizeof(header));
+
+    measure("kawpow", algo, "hash-light", "none", kHashes, 1, [&]() { KPHash::calculate(cache, kKawPowHeight, header, nonce++, output, mix); });
+#   endif
+}
+
+
+void xmrig::KernelsBench::runKeccak()
+{
+    constexpr size_t kLanes = 4;
+
+    alignas(32) uint64_t st[kLanes][25];
+    alignas(32) uint64_t expected[kLanes][25];
+    uint64_t *states[kLanes];
+
+    for (size_t i = 0; i < kLanes; ++i) {
+        fill(reinterpret_cast<uint8_t *>(st[i]), sizeof(st[i]));
+        st[i][0] += i;
+        states[i] = st[i];
+    }
+
+    // SIMD permutations must produce exactly the same state as the scalar code, lane by lane.
+    memcpy(expected, st, sizeof(st));
+
+    for (auto &lane : expected) {
+        keccakf(lane, 24);
+    }
+
+    if (keccakf_x2(states, 24) && keccakf_x2(states + 2, 24) && memcmp(st, expected, sizeof(st)) != 0) {
+        fail("keccakf: x2 lane mismatch");
+    }
+
+    memcpy(st, expected, sizeof(st));
+
+    for (auto &lane : expected) {
+        keccakf(lane, 24);
+    }
+
+    if (keccakf_x4(states, 24) && memcmp(st, expected, sizeof(st)) != 0) {
+        fail("keccakf: x4 lane mismatch");
+    }
+
+    uint8_t blob[kBlobSize * kLanes];
+    fill(blob, sizeof(blob));
+
+    for (size_t i = 0; i < kLanes; ++i) {
+        keccak(blob + kBlobSize * i, kBlobSize, reinterpret_cast<uint8_t *>(expected[i]));
+    }
+
+    uint8_t *md[kLanes];
+    for (size_t i = 0; i < kLanes; ++i) {
+        md[i] = reinterpret_cast<uint8_t *>(st[i]);
+    }
+
+    keccak(blob, kBlobSize, md, kLanes);
+    if (memcmp(st, expected, sizeof(st)) != 0) {
+        fail("keccak: multi-lane mismatch");
+    }
+
+    if (isEnabled("keccak", "keccakf", "x1", "scalar")) {
+        measure("keccak", "keccakf", "x1", "scalar", kItems, 1, [&]() { keccakf(st[0], 24); });
+    }
+
+    if (keccakf_x2(states, 24) && isEnabled("keccak", "keccakf", "x2", "sse2")) {
+        measure("keccak", "keccakf", "x2", "sse2", kItems, 2, [&]() { keccakf_x2(states, 24); });
+    }
+
+    if (keccakf_x4(states, 24) && isEnabled("keccak", "keccakf", "x4", "avx2")) {
+        measure("keccak", "keccakf", "x4", "avx2", kItems, 4, [&]() { keccakf_x4(states, 24); });
+    }
+
+    // Initial hash of a 4-way CryptoNight worker, one input after another or all lanes at once.
+    if (isEnabled("keccak", "keccak-76", "x4", "scalar")) {
+        measure("keccak", "keccak-76", "x4", "scalar", kItems, kLanes, [&]() {
+            for (size_t i = 0; i < kLanes; ++i) {
+                keccak(blob + kBlobSize * i, kBlobSize, md[i]);
+            }
+        });
+    }
+
+    if (isEnabled("keccak", "keccak-76", "x4", "multi")) {
+        measure("keccak", "keccak-76", "x4", "multi", kItems, kLanes, [&]() { keccak(blob, kBlobSize, md, kLanes); });
+    }
+}
+
+
+/**
+ * RandomX variants of two pool groups mined at the same time through Miner and CpuBackend: group 0 mines rx/0 and
+ * group 1 rx/wow, each with its own dataset (light mode, only the cache is needed). Every submitted result is checked
+ * against a reference VM of its variant.
+ */
+void xmrig::KernelsBench::runMiner()
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    constexpr const char *algo  = "rx/0+rx/wow";
+    constexpr size_t kResults   = 4;
+    constexpr uint64_t kTimeout = 120000;
+
+    if (!isEnabled("miner", algo, "groups-light", "cpu")) {
+        return;
+    }
+
+    class Listener : public IJobResultListener
+    {
+    public:
+        inline void onJobResult(const JobResult &result) override { results.push_back(result); }
+
+        std::vector<JobResult> results;
+    };
+
+    // rx/0 threads are not pinned (group 0), rx/wow threads are pinned to CPU 0 which belongs to group 1.
+    const String config = Process::location(Process::TempLocation, "xmrig-kernels-bench.json");
+    const String log    = Process::location(Process::TempLocation, "xmrig-kernels-bench.log");
+
+    FILE *fp = fopen(config, "w");
+    if (!fp) {
+        fail("miner: unable to write %s", config.data());
+
+        return;
+    }
+
+    fprintf(fp, "{\"autosave\":false,\"background\":true,\"log-file\":\"%s\",\"donate-level\":0,"
+                "\"randomx\":{\"mode\":\"light\",\"1gb-pages\":false,\"cache_qos\":false,\"numa\":false},"
+                "\"cpu\":{\"huge-pages\":%s,\"huge-pages-jit\":false,\"rx\":[-1],\"rx/wow\":[0],\"groups\":{\"1\":[0]}},"
+                "\"pools\":[{\"url\":\"127.0.0.1:9\"},{\"url\":\"127.0.0.1:9\",\"group\":1}]}",
+            log.data(), m_options.hugePages ? "true" : "false");
+    fclose(fp);
+
+    uint8_t seed[32];
+    uint8_t blob[kBlobSize];
+    fill(seed, sizeof(seed));
+    fill(blob, sizeof(blob));
+    memset(blob + 39, 0, 4);
+
+    // Every 4th hash is a result.
+    Job jobs[2] = { Job(false, Algorithm::RX_0, "bench"), Job(false, Algorithm::RX_WOW, "bench") };
+
+    for (size_t i = 0; i < 2; ++i) {
+        jobs[i].setId(i == 0 ? "0" : "1");
+        jobs[i].setBlob(Cvt::toHex(blob, sizeof(blob)));
+        jobs[i].setSeedHash(Cvt::toHex(seed, sizeof(seed)));
+        jobs[i].setTarget("ffffffffffffff3f");
+    }
+
+    jobs[1].setGroup(1);
+
+    char arg[512];
+    snprintf(arg, sizeof(arg), "--config=%s", config.data());
+
+    char *argv[] = { const_cast<char *>("xmrig-kernels-bench"), arg, nullptr };
+
+    // Options of the benchmark are already parsed, getopt starts again for the arguments of the miner.
+    optind = 0;
+
+    Process process(2, argv);
+    Listener listener;
+    size_t results[2] = {};
+    double elapsed    = 0.0;
+
+    {
+        // The pool of the benchmark is replaced by the pool of the controller.
+        VirtualMemory::destroy();
+
+        Controller controller(&process);
+        if (!controller.isReady() || controller.init() != 0) {
+            fail("miner: invalid configuration %s", config.data());
+
+            return;
+        }
+
+        controller.start();
+
+        JobResults::stop();
+        JobResults::setListener(&listener, controller.config()->cpu().isHwAES());
+
+        controller.miner()->setJob(jobs[0], false);
+        controller.miner()->setJob(jobs[1], false);
+
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        while ((results[0] < kResults || results[1] < kResults) && Chrono::steadyMSecs() - ts < kTimeout) {
+            uv_run(uv_default_loop(), UV_RUN_NOWAIT);
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+            results[0] = results[1] = 0;
+            for (const auto &result : listener.results) {
+                results[result.group == 0 ? 0 : 1]++;
+            }
+        }
+
+        elapsed = static_cast<double>(Chrono::steadyMSecs() - ts);
+
+        controller.stop();
+        uv_run(uv_default_loop(), UV_RUN_NOWAIT);
+    }
+
+    Log::destroy();
+    remove(config);
+
+    fprintf(stderr, "miner: %zu rx/0 (group 0) and %zu rx/wow (group 1) results in %.1f s\n", results[0], results[1], elapsed / 1000.0);
+
+    if (results[0] < kResults || results[1] < kResults) {
+        fail("miner: %s group without results", algo);
+
+        return;
+    }
+
+    // Reference hashes, the miner is stopped and doesn't use the RandomX configurations any more.
+    const auto info   = Cpu::info();
+    const int flags   = RANDOMX_FLAG_JIT | (info->hasAES() ? RANDOMX_FLAG_HARD_AES : RANDOMX_FLAG_DEFAULT);
+    size_t mismatches = 0;
+
+    for (size_t i = 0; i < 2; ++i) {
+        const RandomX_ConfigurationBase *rxConfig = RxAlgo::apply(jobs[i].algorithm());
+
+        std::unique_ptr<VirtualMemory> memory(new VirtualMemory(RxCache::maxSize(), m_options.hugePages, false, false));
+        std::unique_ptr<VirtualMemory> scratchpad(new VirtualMemory(RANDOMX_SCRATCHPAD_L3_MAX_SIZE, m_options.hugePages, false, false));
+        randomx_cache *cache = randomx_create_cache(RANDOMX_FLAG_JIT, memory->raw());
+
+        if (!cache) {
+            fail("miner: unable to allocate RandomX cache");
+
+            return;
+        }
+
+        randomx_init_cache(cache, seed, sizeof(seed), rxConfig);
+        randomx_vm *vm = randomx_create_vm(static_cast<randomx_flags>(flags), cache, nullptr, scratchpad->scratchpad(), 0, rxConfig);
+
+        for (const auto &result : listener.results) {
+            if ((result.group == 0 ? 0 : 1) != i) {
+                continue;
+            }
+
+            uint8_t input[kBlobSize];
+            uint8_t hash[32];
+            memcpy(input, blob, sizeof(input));
+            memcpy(input + 39, &result.nonce, 4);
+
+            randomx_calculate_hash(vm, input, sizeof(input), hash);
+
+            mismatches += result.algorithm != jobs[i].algorithm() || memcmp(hash, result.result(), sizeof(hash)) != 0 || reinterpret_cast<const uint64_t *>(hash)[3] >= jobs[i].target();
+        }
+
+        randomx_destroy_vm(vm);
+        randomx_release_cache(cache);
+    }
+
+    if (mismatches) {
+        fail("miner: %zu %s results mismatch", mismatches, algo);
+    }
+
+    std::vector<double> samples = { listener.results.size() * 1000.0 / elapsed };
+    print("miner", algo, "groups-light", "cpu", kItems, listener.results.size(), stats(samples));
+#   endif
+}
+
+
+void xmrig::KernelsBench::runRandomX()
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    struct Impl
+    {
+        const char *name;
+        bool jit;
+        bool avx2;
+        bool avx512;
+    };
+
+    static const Impl impls[] = {
+        { "jit-avx512",     true,   false,  true    },
+        { "jit-avx2",       true,   true,   false   },
+        { "jit",            true,   false,  false   },
+        { "interpreter",    false,  false,  false   }
+    };
+
+    const auto info = Cpu::info();
+
+#   ifdef XMRIG_FEATURE_SSE4_1
+    rx_blake2b_use_sse41 = info->has(ICpuInfo::FLAG_SSE41) ? 1 : 0;
+#   endif
+
+    int vmFlags = info->hasAES() ? RANDOMX_FLAG_HARD_AES : RANDOMX_FLAG_DEFAULT;
+    if (info->assembly() == Assembly::RYZEN || info->assembly() == Assembly::BULLDOZER) {
+        vmFlags |= RANDOMX_FLAG_AMD;
+    }
+
+    uint8_t seed[32];
+    uint8_t blob[kBlobSize];
+    uint8_t hash[32];
+    fill(seed, sizeof(seed));
+    fill(blob, sizeof(blob));
+
+    std::unique_ptr<VirtualMemory> cacheMemory;
+    std::unique_ptr<VirtualMemory> chunkMemory;
+    std::unique_ptr<VirtualMemory> datasetMemory;
+    std::unique_ptr<VirtualMemory> scratchpad;
+
+    for (const auto &algorithm : Algorithm::all([](const Algorithm &algo) { return algo.family() == Algorithm::RANDOM_X; })) {
+        const char *algo = algorithm.name();
+
+        for (const auto &impl : impls) {
+            if ((impl.avx2 && !info->hasAVX2()) || (impl.avx512 && !info->has(ICpuInfo::FLAG_AVX512F))) {
+                continue;
+            }
+
+            const bool cacheInit   = isEnabled("rx", algo, "cache-init", impl.name);
+            const bool datasetInit = isEnabled("rx", algo, "dataset-init", impl.name);
+            const bool light       = isEnabled("rx", algo, "hash-light", impl.name);
+            const bool hybrid      = impl.jit && !impl.avx2 && !impl.avx512 && isEnabled("rx", algo, "hash-hybrid-25", impl.name);
+            const bool fast        = !impl.avx2 && !impl.avx512 && m_options.rxFast && isEnabled("rx", algo, "hash-fast", impl.name);
+
+            if (!cacheInit && !datasetInit && !light && !hybrid && !fast) {
+                continue;
+            }
+
+            const RandomX_ConfigurationBase *config = RxAlgo::apply(algorithm);
+            randomx_set_optimized_dataset_init(impl.avx2 ? 1 : 0);
+            randomx_set_optimized_dataset_init_avx512(impl.avx512 ? 1 : 0);
+
+            if (!cacheMemory) {
+                cacheMemory = std::unique_ptr<VirtualMemory>(new VirtualMemory(RxCache::maxSize(), m_options.hugePages, false, false));
+                scratchpad  = std::unique_ptr<VirtualMemory>(new VirtualMemory(RANDOMX_SCRATCHPAD_L3_MAX_SIZE, m_options.hugePages, false, false));
+            }
+
+            randomx_cache *cache = randomx_create_cache(impl.jit ? RANDOMX_FLAG_JIT : RANDOMX_FLAG_DEFAULT, cacheMemory->raw());
+            if (!cache) {
+                continue;
+            }
+
+            if (cacheInit) {
+                measure("rx", algo, "cache-init", impl.name, kOps, 1, [&]() { randomx_init_cache(cache, seed, sizeof(seed), config); });
+            }
+            else {
+                randomx_init_cache(cache, seed, sizeof(seed), config);
+            }
+
+            if (datasetInit) {
+                if (!chunkMemory) {
+                    chunkMemory = std::unique_ptr<VirtualMemory>(new VirtualMemory(kDatasetChunk * RANDOMX_DATASET_ITEM_SIZE, m_options.hugePages, false, false));
+                }
+
+                randomx_dataset *dataset = randomx_create_dataset(chunkMemory->raw());
+
+                measure("rx", algo, "dataset-init", impl.name, kItems, kDatasetChunk, [&]() { randomx_init_dataset(dataset, cache, 0, kDatasetChunk); });
+
+                randomx_release_dataset(dataset);
+            }
+
+            const int flags = vmFlags | (impl.jit ? RANDOMX_FLAG_JIT : 0);
+
+            if (light) {
+                randomx_vm *vm = randomx_create_vm(static_cast<randomx_flags>(flags), cache, nullptr, scratchpad->scratchpad(), 0, config);
+                if (vm) {
+                    measure("rx", algo, "hash-light", impl.name, kHashes, 1, [&]() { randomx_calculate_hash(vm, blob, sizeof(blob), hash); });
+                    randomx_destroy_vm(vm);
+                }
+            }
+
+            if (hybrid) {
+                // First quarter of the dataset is precomputed, hashes must match the light mode.
+                const auto items    = static_cast<uint32_t>(randomx_dataset_item_count() / 4 / kDatasetChunk * kDatasetChunk);
+                auto prefixMemory   = std::unique_ptr<VirtualMemory>(new VirtualMemory(static_cast<size_t>(items) * RANDOMX_DATASET_ITEM_SIZE, m_options.hugePages, false, false));
+                randomx_dataset *prefix = prefixMemory->raw() ? randomx_create_dataset(prefixMemory->raw()) : nullptr;
+                randomx_vm *vm          = prefix ? randomx_create_vm(static_cast<randomx_flags>(flags), cache, nullptr, scratchpad->scratchpad(), 0, config) : nullptr;
+
+                if (vm) {
+                    uint8_t expected[32];
+                    randomx_calculate_hash(vm, blob, sizeof(blob), expected);
+
+                    randomx_init_dataset(prefix, cache, 0, items);
+                    randomx_set_dataset_prefix(cache, prefixMemory->raw(), items);
+
+                    uint64_t hits[2]   = {};
+                    uint64_t misses[2] = {};
+                    randomx_get_dataset_reads(vm, &hits[0], &misses[0]);
+
+                    randomx_calculate_hash(vm, blob, sizeof(blob), hash);
+                    if (memcmp(hash, expected, sizeof(hash)) != 0) {
+                        fail("%s: hybrid mode hash mismatch", algo);
+                    }
+
+                    measure("rx", algo, "hash-hybrid-25", impl.name, kHashes, 1, [&]() { randomx_calculate_hash(vm, blob, sizeof(blob), hash); });
+
+                    randomx_get_dataset_reads(vm, &hits[1], &misses[1]);
+
+                    const uint64_t reads = (hits[1] - hits[0]) + (misses[1] - misses[0]);
+                    fprintf(stderr, "%s: hybrid mode dataset hit rate %.2f%%\n", algo, reads ? (hits[1] - hits[0]) * 100.0 / reads : 0.0);
+
+                    randomx_set_dataset_prefix(cache, nullptr, 0);
+                    randomx_destroy_vm(vm);
+                }
+                else {
+                    fprintf(stderr, "%s: failed to allocate %u MB for the hybrid mode\n", algo, items / (1024 * 1024 / RANDOMX_DATASET_ITEM_SIZE));
+                }
+
+                if (prefix) {
+                    randomx_release_dataset(prefix);
+                }
+            }
+
+            if (fast) {
+                // Only memory access patterns matter for the fast mode, the dataset is not initialized to save time.
+                if (!datasetMemory) {
+                    datasetMemory = std::unique_ptr<VirtualMemory>(new VirtualMemory(RxDataset::maxSize(), m_options.hugePages, false, false));
+
+                    if (datasetMemory->raw()) {
+                        memset(datasetMemory->raw(), 0, RxDataset::maxSize());
+                    }
+                }
+
+                randomx_dataset *dataset = randomx_create_dataset(datasetMemory->raw());
+                randomx_vm *vm           = dataset ? randomx_create_vm(static_cast<randomx_flags>(flags | RANDOMX_FLAG_FULL_MEM), nullptr, dataset, scratchpad->scratchpad(), 0, config) : nullptr;
+
+                if (vm) {
+                    measure("rx", algo, "hash-fast", impl.name, kHashes, 1, [&]() { randomx_calculate_hash(vm, blob, sizeof(blob), hash); });
+                    randomx_destroy_vm(vm);
+                }
+                else {
+                    fprintf(stderr, "%s: failed to allocate %zu MB for the dataset\n", algo, RxDataset::maxSize() / 1024 / 1024);
+                }
+
+                if (dataset) {
+                    randomx_release_dataset(dataset);
+                }
+            }
+
+            randomx_release_cache(cache);
+        }
+    }
+
+    runRandomXConcurrent(vmFlags | RANDOMX_FLAG_JIT, seed, blob);
+#   endif
+}
+
+
+void xmrig::KernelsBench::runRandomXConcurrent(int flags, const uint8_t *seed, const uint8_t *blob)
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    constexpr const char *algo  = "rx/0+rx/wow";
+    constexpr size_t kChecks    = 4;
+
+    if (!isEnabled("rx", algo, "hash-light-mixed", "jit")) {
+        return;
+    }
+
+    // Two variants with different programs and scratchpad sizes, each VM refers only to its own configuration.
+    const Algorithm::Id algorithms[2] = { Algorithm::RX_0, Algorithm::RX_WOW };
+    std::unique_ptr<VirtualMemory> memory[2];
+    std::unique_ptr<VirtualMemory> scratchpads[2];
+    randomx_cache *caches[2]    = {};
+    randomx_vm *vms[2]          = {};
+    uint8_t expected[2][kChecks][32];
+
+    for (size_t i = 0; i < 2; ++i) {
+        const RandomX_ConfigurationBase *config = RxAlgo::apply(algorithms[i]);
+
+        memory[i]       = std::unique_ptr<VirtualMemory>(new VirtualMemory(RxCache::maxSize(), m_options.hugePages, false, false));
+        scratchpads[i]  = std::unique_ptr<VirtualMemory>(new VirtualMemory(RANDOMX_SCRATCHPAD_L3_MAX_SIZE, m_options.hugePages, false, false));
+        caches[i]       = randomx_create_cache(RANDOMX_FLAG_JIT, memory[i]->raw());
+
+        if (!caches[i]) {
+            break;
+        }
+
+        randomx_init_cache(caches[i], seed, 32, config);
+        vms[i] = randomx_create_vm(static_cast<randomx_flags>(flags), caches[i], nullptr, scratchpads[i]->scratchpad(), 0, config);
+    }
+
+    if (vms[0] && vms[1]) {
+        auto calculate = [blob](randomx_vm *vm, size_t index, uint8_t *out) {
+            uint8_t input[kBlobSize];
+            memcpy(input, blob, sizeof(input));
+            input[39] = static_cast<uint8_t>(index);
+
+            randomx_calculate_hash(vm, input, sizeof(input), out);
+        };
+
+        for (size_t i = 0; i < 2; ++i) {
+            for (size_t j = 0; j < kChecks; ++j) {
+                calculate(vms[i], j, expected[i][j]);
+            }
+        }
+
+        size_t mismatches[2] = {};
+        std::thread threads[2];
+
+        for (size_t i = 0; i < 2; ++i) {
+            threads[i] = std::thread([&, i]() {
+                uint8_t out[32];
+
+                for (size_t j = 0; j < kChecks; ++j) {
+                    calculate(vms[i], j, out);
+                    mismatches[i] += memcmp(out, expected[i][j], sizeof(out)) != 0;
+                }
+            });
+        }
+
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        if (mismatches[0] || mismatches[1] || memcmp(expected[0][0], expected[1][0], 32) == 0) {
+            fail("%s: concurrent hash mismatch", algo);
+        }
+
+        uint8_t hash[32];
+        measure("rx", algo, "hash-light-mixed", "jit", kHashes, 2, [&]() { calculate(vms[0], 0, hash); calculate(vms[1], 0, hash); });
+    }
+
+    for (size_t i = 0; i < 2; ++i) {
+        if (vms[i]) {
+            randomx_destroy_vm(vms[i]);
+        }
+
+        if (caches[i]) {
+            randomx_release_cache(caches[i]);
+        }
+    }
+#   endif
+}
+
+
+void xmrig::KernelsBench::runSignatures()
+{
+#   ifdef XMRIG_ALGO_RANDOMX
+    struct Impl
+    {
+        const char *name;
+        SignatureEngine::Mode mode;
+    };
+
+    // Per hash cost of a miner signature, "reference" is Job::generateMinerSignature().
+    static const Impl impls[] = {
+        { "avx2",       SignatureEngine::MODE_AVX2      },
+        { "batch",      SignatureEngine::MODE_BATCH     },
+        { "reference",  SignatureEngine::MODE_REFERENCE }
+    };
+
+    const char *algo = Algorithm(Algorithm::RX_0).name();
+
+    uint8_t blob[kBlobSize + BlockTemplate::kSignatureSize + 2];
+    uint8_t sig[BlockTemplate::kSignatureSize];
+    uint8_t pub[32];
+    uint8_t sec[32];
+    fill(blob, sizeof(blob));
+    generate_keys(pub, sec);
+
+    Job job(false, Algorithm::RX_0, String());
+    job.setBlob(Cvt::toHex(blob, sizeof(blob)));
+    job.setEphemeralKeys(pub, sec);
+
+    for (const auto &impl : impls) {
+        if (!isEnabled("rx", algo, "miner-signature", impl.name) || (impl.mode == SignatureEngine::MODE_AVX2 && !Cpu::info()->hasAVX2())) {
+            continue;
+        }
+
+        if (impl.mode == SignatureEngine::MODE_REFERENCE) {
+            measure("rx", algo, "miner-signature", impl.name, kOps, 1, [&]() { job.generateMinerSignature(blob, sizeof(blob), sig); ++blob[0]; });
+
+            continue;
+        }
+
+        SignatureEngine engine(impl.mode == SignatureEngine::MODE_AVX2);
+        if (engine.mode() != impl.mode) {
+            continue;
+        }
+
+        engine.setJob(job);
+
+        measure("rx", algo, "miner-signature", impl.name, kOps, 1, [&]() { engine.sign(blob, sizeof(blob)); ++blob[0]; });
+    }
+#   endif
+}
+
+
+/**
+ * Software AES implementations forced the same way as with the "soft-aes" option, results must be exactly the same
+ * as with AES-NI or, if AES-NI is not available, as with the lookup tables.
+ */
+void xmrig::KernelsBench::runSoftAes()
+{
+#   ifdef XMRIG_VPAES
+    static const std::pair<SoftAesImpl, const char *> impls[] = {
+        { SOFT_AES_TABLE, "table" },
+        { SOFT_AES_VPAES, "vpaes" }
+    };
+
+    const auto info = Cpu::info();
+    if (!info->has(ICpuInfo::FLAG_SSSE3)) {
+        return;
+    }
+
+    const bool hasAES = info->hasAES();
+    const Algorithm algorithm(Algorithm::CN_2);
+
+    bool cn = false;
+    for (const auto &impl : impls) {
+        cn |= isEnabled("soft-aes", algorithm.name(), "single-soft", impl.second);
+    }
+
+    if (cn) {
+        uint8_t blob[kBlobSize];
+        uint8_t expected[32];
+        uint8_t hash[32];
+        fill(blob, sizeof(blob));
+
+        std::unique_ptr<VirtualMemory> memory(new VirtualMemory(algorithm.l3(), m_options.hugePages, false, false));
+        cryptonight_ctx *ctx[1] = {};
+        CnCtx::create(ctx, memory->scratchpad(), algorithm.l3(), 1);
+
+        CnHash::setSoftAes(SOFT_AES_TABLE);
+        CnHash::fn(algorithm, hasAES ? CnHash::AV_SINGLE : CnHash::AV_SINGLE_SOFT, Assembly::NONE)(blob, sizeof(blob), expected, ctx, kCnHeight);
+
+        for (const auto &impl : impls) {
+            CnHash::setSoftAes(impl.first);
+
+            const auto fn = CnHash::fn(algorithm, CnHash::AV_SINGLE_SOFT, Assembly::NONE);
+            fn(blob, sizeof(blob), hash, ctx, kCnHeight);
+
+            if (memcmp(hash, expected, sizeof(hash)) != 0) {
+                fail("%s: %s soft AES hash mismatch", algorithm.name(), impl.second);
+            }
+
+            if (isEnabled("soft-aes", algorithm.name(), "single-soft", impl.second)) {
+                measure("soft-aes", algorithm.name(), "single-soft", impl.second, kHashes, 1, [&]() { fn(blob, sizeof(blob), hash, ctx, kCnHeight); });
+            }
+        }
+
+        CnCtx::release(ctx, 1);
+        CnHash::setSoftAes(SOFT_AES_AUTO);
+    }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    const char *algo = Algorithm(Algorithm::RX_0).name();
+
+    bool rx = false;
+    for (const auto &impl : impls) {
+        rx |= isEnabled("soft-aes", algo, "hash-fill", impl.second);
+    }
+
+    if (!rx) {
+        return;
+    }
+
+    constexpr size_t kProgramSize = 2048;
+    const RandomX_ConfigurationBase *config = RxAlgo::apply(Algorithm::RX_0);
+
+    // Scratchpad fill and hash of a VM with all functions the VM calls through the soft AES pointers.
+    auto calculate = [config](hashAes1Rx4_impl *hashFn, fillAes1Rx4_impl *fill1Fn, fillAes4Rx4_impl *fill4Fn, hashAndFillAes1Rx4_impl *hashFillFn) {
+        std::vector<uint8_t> out(RANDOMX_SCRATCHPAD_L3_MAX_SIZE + kProgramSize + 128);
+        uint8_t *scratchpad = out.data();
+        uint8_t *program    = scratchpad + RANDOMX_SCRATCHPAD_L3_MAX_SIZE;
+        uint8_t *hash       = program + kProgramSize;
+        uint8_t *state      = hash + 64;
+
+        fill(state, 64);
+        fill1Fn(state, RANDOMX_SCRATCHPAD_L3_MAX_SIZE, scratchpad);
+        fill4Fn(state, kProgramSize, program, *config);
+        hashFn(scratchpad, RANDOMX_SCRATCHPAD_L3_MAX_SIZE, hash);
+        hashFillFn(scratchpad, RANDOMX_SCRATCHPAD_L3_MAX_SIZE, hash, state);
+
+        return out;
+    };
+
+    const auto expected = hasAES ? calculate(&hashAes1Rx4<0>, &fillAes1Rx4<0>, &fillAes4Rx4<0>, &hashAndFillAes1Rx4<0, 2>)
+                                 : calculate(&hashAes1Rx4<1>, &fillAes1Rx4<1>, &fillAes4Rx4<1>, &hashAndFillAes1Rx4<1, 1>);
+
+    std::vector<uint8_t> scratchpad(RANDOMX_SCRATCHPAD_L3_MAX_SIZE);
+    alignas(16) uint8_t hash[64];
+    alignas(16) uint8_t state[64];
+    fill(state, sizeof(state));
+
+    for (const auto &impl : impls) {
+        SelectSoftAESImpl(1, impl.first);
+
+        if (calculate(GetSoftAESHashImpl(), GetSoftAESFill1Impl(), GetSoftAESFill4Impl(), GetSoftAESImpl()) != expected) {
+            fail("%s: %s soft AES hash or fill mismatch", algo, impl.second);
+        }
+
+        if (isEnabled("soft-aes", algo, "hash-fill", impl.second)) {
+            measure("soft-aes", algo, "hash-fill", impl.second, kOps, 1, [&]() { GetSoftAESImpl()(scratchpad.data(), scratchpad.size(), hash, state); });
+        }
+    }
+#   endif
+#   endif
+}
+
+
+xmrig::KernelsBench::Stats xmrig::KernelsBench::stats(std::vector<double> &samples)
+{
+    Stats out;
+    if (samples.empty()) {
+        return out;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    const size_t n = samples.size();
+    double sum     = 0.0;
+
+    for (double value : samples) {
+        sum += value;
+    }
+
+    out.mean   = sum / n;
+    out.median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+    out.min    = samples.front();
+    out.max    = samples.back();
+
+    double variance = 0.0;
+    for (double value : samples) {
+        variance += (value - out.mean) * (value - out.mean);
+    }
+
+    out.stddev = n > 1 ? std::sqrt(variance / (n - 1)) : 0.0;
+    out.cv     = out.mean > 0.0 ? out.stddev / out.mean : 0.0;
+
+    return out;
+}
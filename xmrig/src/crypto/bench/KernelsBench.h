@@ -0,0 +1,109 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_KERNELSBENCH_H
+#define XMRIG_KERNELSBENCH_H
+
+
+#include "base/tools/Object.h"
+#include "base/tools/String.h"
+
+
+#include <functional>
+#include <vector>
+
+
+namespace xmrig
+{
+
+
+/**
+ * Micro-benchmark for individual hash kernels (xmrig-kernels-bench).
+ *
+ * Every kernel is identified by "group/algo/variant/impl", runs on the calling thread,
+ * is warmed up and calibrated first and then sampled a fixed number of times.
+ * Kernels with several implementations are checked against each other first, exec() returns 1 if any check failed.
+ */
+class KernelsBench
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(KernelsBench)
+
+    enum Format {
+        FORMAT_JSON,
+        FORMAT_CSV
+    };
+
+    struct Options
+    {
+        bool hugePages      = true;
+        bool list           = false;
+        bool rxFast         = true;
+        Format format       = FORMAT_JSON;
+        int64_t cpu         = -1;
+        String filter;
+        uint32_t samples    = 7;
+        uint64_t sampleTime = 250;  // ms
+        uint64_t warmup     = 500;  // ms
+    };
+
+    KernelsBench(const Options &options);
+    ~KernelsBench();
+
+    int exec();
+
+private:
+    struct Stats
+    {
+        double mean     = 0.0;
+        double median   = 0.0;
+        double stddev   = 0.0;
+        double cv       = 0.0;
+        double min      = 0.0;
+        double max      = 0.0;
+    };
+
+    bool isEnabled(const char *group, const char *algo, const char *variant, const char *impl) const;
+    void fail(const char *format, ...);
+    bool measure(const char *group, const char *algo, const char *variant, const char *impl, const char *unit, uint64_t items, const std::function<void()> &fn);
+    void print(const char *group, const char *algo, const char *variant, const char *impl, const char *unit, uint64_t ops, const Stats &stats);
+    void runArgon2();
+    void runCn();
+    void runCnFinal();
+    void runGhostRider();
+    void runJobs();
+    void runKawPow();
+    void runKeccak();
+    void runMiner();
+    void runRandomX();
+    void runRandomXConcurrent(int flags, const uint8_t *seed, const uint8_t *blob);
+    void runSignatures();
+    void runSoftAes();
+
+    static Stats stats(std::vector<double> &samples);
+
+    const Options m_options;
+    size_t m_count  = 0;
+    size_t m_failed = 0;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_KERNELSBENCH_H */
@@ -0,0 +1,133 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+#ifdef _MSC_VER
+#   include "getopt/getopt.h"
+#else
+#   include <getopt.h>
+#endif
+
+
+#include "crypto/bench/KernelsBench.h"
+
+
+static const char *usage = "Usage: xmrig-kernels-bench [OPTIONS]\n\n"
+    "  -f, --filter=SUBSTR       run only kernels which id (group/algo/variant/impl) contains SUBSTR\n"
+    "  -l, --list                print ids of available kernels and exit\n"
+    "  -n, --samples=N           number of samples per kernel (default: 7)\n"
+    "  -t, --sample-time=MS      duration of a single sample (default: 250)\n"
+    "  -w, --warmup=MS           warm-up and calibration time (default: 500)\n"
+    "  -c, --cpu=N               pin the benchmark thread to logical CPU N\n"
+    "      --format=FORMAT       output format, json (one object per line) or csv\n"
+    "      --no-huge-pages       disable huge pages\n"
+    "      --no-rx-fast          skip RandomX fast mode, it requires more than 2 GB of memory\n"
+    "  -h, --help                display this help and exit\n";
+
+
+int main(int argc, char **argv)
+{
+    using namespace xmrig;
+
+    enum Option {
+        OPT_FORMAT = 1000,
+        OPT_NO_HUGE_PAGES,
+        OPT_NO_RX_FAST
+    };
+
+    static const option options[] = {
+        { "filter",        1, nullptr, 'f' },
+        { "list",          0, nullptr, 'l' },
+        { "samples",       1, nullptr, 'n' },
+        { "sample-time",   1, nullptr, 't' },
+        { "warmup",        1, nullptr, 'w' },
+        { "cpu",           1, nullptr, 'c' },
+        { "format",        1, nullptr, OPT_FORMAT },
+        { "no-huge-pages", 0, nullptr, OPT_NO_HUGE_PAGES },
+        { "no-rx-fast",    0, nullptr, OPT_NO_RX_FAST },
+        { "help",          0, nullptr, 'h' },
+        { nullptr,         0, nullptr, 0 }
+    };
+
+    KernelsBench::Options config;
+    int key = 0;
+
+    while ((key = getopt_long(argc, argv, "f:ln:t:w:c:h", options, nullptr)) != -1) {
+        switch (key) {
+        case 'f':
+            config.filter = static_cast<const char *>(optarg);
+            break;
+
+        case 'l':
+            config.list = true;
+            break;
+
+        case 'n':
+            config.samples = static_cast<uint32_t>(std::max(1L, strtol(optarg, nullptr, 10)));
+            break;
+
+        case 't':
+            config.sampleTime = std::max(1ULL, strtoull(optarg, nullptr, 10));
+            break;
+
+        case 'w':
+            config.warmup = strtoull(optarg, nullptr, 10);
+            break;
+
+        case 'c':
+            config.cpu = strtoll(optarg, nullptr, 10);
+            break;
+
+        case OPT_FORMAT:
+            if (strcmp(optarg, "csv") == 0) {
+                config.format = KernelsBench::FORMAT_CSV;
+            }
+            else if (strcmp(optarg, "json") != 0) {
+                fprintf(stderr, "unsupported format \"%s\"\n", optarg);
+
+                return 1;
+            }
+            break;
+
+        case OPT_NO_HUGE_PAGES:
+            config.hugePages = false;
+            break;
+
+        case OPT_NO_RX_FAST:
+            config.rxFast = false;
+            break;
+
+        case 'h':
+            printf("%s", usage);
+            return 0;
+
+        default:
+            fprintf(stderr, "%s", usage);
+            return 1;
+        }
+    }
+
+    KernelsBench bench(config);
+
+    return bench.exec();
+}
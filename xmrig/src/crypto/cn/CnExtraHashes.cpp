@@ -0,0 +1,293 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/cn/CnExtraHashes.h"
+#include "backend/cpu/Cpu.h"
+#include "crypto/cn/extra_hashes_lanes.h"
+
+
+extern "C"
+{
+#include "crypto/cn/c_groestl.h"
+#include "crypto/cn/c_blake256.h"
+#include "crypto/cn/c_jh.h"
+#include "crypto/cn/c_skein.h"
+
+extern const uint8_t sigma[][16];
+extern const uint32_t cst[16];
+}
+
+
+#include <algorithm>
+#include <emmintrin.h>
+
+
+namespace xmrig {
+
+
+void groestl256_avx2(const uint8_t *const *in, uint8_t *const *out, size_t count);
+void groestl256_ssse3(const uint8_t *const *in, uint8_t *const *out, size_t count);
+void jh256_x4_avx2(const uint8_t *const *in, uint8_t *const *out);
+void skein256_x4_avx2(const uint8_t *const *in, uint8_t *const *out);
+
+
+static constexpr size_t kStateSize  = 200;
+static constexpr size_t kHashSize   = 32;
+static constexpr size_t kMaxStates  = 8;
+
+
+struct ExtraHashesSSE2
+{
+    using V = __m128i;
+
+    static inline V xor_(V a, V b)      { return _mm_xor_si128(a, b); }
+    static inline V and_(V a, V b)      { return _mm_and_si128(a, b); }
+    static inline V or_(V a, V b)       { return _mm_or_si128(a, b); }
+    static inline V andnot(V a, V b)    { return _mm_andnot_si128(a, b); }
+    static inline V add(V a, V b)       { return _mm_add_epi64(a, b); }
+    static inline V set1(uint64_t x)    { return _mm_set1_epi64x(static_cast<int64_t>(x)); }
+
+    template<int n> static inline V shl(V a)    { return _mm_slli_epi64(a, n); }
+    template<int n> static inline V shr(V a)    { return _mm_srli_epi64(a, n); }
+    template<int n> static inline V rotl(V a)   { return n == 32 ? _mm_shuffle_epi32(a, 0xB1) : _mm_or_si128(_mm_slli_epi64(a, n), _mm_srli_epi64(a, 64 - n)); }
+
+    static inline V load(const uint8_t *const *p, size_t offset)
+    {
+        return _mm_unpacklo_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p[0] + offset)), _mm_loadl_epi64(reinterpret_cast<const __m128i *>(p[1] + offset)));
+    }
+
+    static inline void store(uint8_t *const *p, size_t offset, V v)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(p[0] + offset), v);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(p[1] + offset), _mm_unpackhi_epi64(v, v));
+    }
+};
+
+
+static inline uint32_t be32(const uint8_t *p)
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+
+template<int n>
+static inline __m128i rotr32(__m128i a)
+{
+    return _mm_or_si128(_mm_srli_epi32(a, n), _mm_slli_epi32(a, 32 - n));
+}
+
+
+static inline void blakeG(__m128i v[16], const __m128i m[16], const uint8_t *s, int a, int b, int c, int d, int e)
+{
+    v[a] = _mm_add_epi32(_mm_add_epi32(v[a], v[b]), _mm_xor_si128(m[s[e]], _mm_set1_epi32(static_cast<int>(cst[s[e + 1]]))));
+    v[d] = rotr32<16>(_mm_xor_si128(v[d], v[a]));
+    v[c] = _mm_add_epi32(v[c], v[d]);
+    v[b] = rotr32<12>(_mm_xor_si128(v[b], v[c]));
+    v[a] = _mm_add_epi32(_mm_add_epi32(v[a], v[b]), _mm_xor_si128(m[s[e + 1]], _mm_set1_epi32(static_cast<int>(cst[s[e]]))));
+    v[d] = rotr32<8>(_mm_xor_si128(v[d], v[a]));
+    v[c] = _mm_add_epi32(v[c], v[d]);
+    v[b] = rotr32<7>(_mm_xor_si128(v[b], v[c]));
+}
+
+
+static inline void blakeCompress(__m128i h[8], const __m128i m[16], uint32_t t)
+{
+    __m128i v[16];
+
+    for (int i = 0; i < 8; ++i) {
+        v[i]     = h[i];
+        v[i + 8] = _mm_set1_epi32(static_cast<int>(cst[i] ^ (i == 4 || i == 5 ? t : 0)));
+    }
+
+    for (int i = 0; i < 14; ++i) {
+        const uint8_t *s = sigma[i];
+
+        blakeG(v, m, s, 0, 4,  8, 12,  0);
+        blakeG(v, m, s, 1, 5,  9, 13,  2);
+        blakeG(v, m, s, 2, 6, 10, 14,  4);
+        blakeG(v, m, s, 3, 7, 11, 15,  6);
+        blakeG(v, m, s, 3, 4,  9, 14, 14);
+        blakeG(v, m, s, 2, 7,  8, 13, 12);
+        blakeG(v, m, s, 0, 5, 10, 15,  8);
+        blakeG(v, m, s, 1, 6, 11, 12, 10);
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        h[i] = _mm_xor_si128(h[i], _mm_xor_si128(v[i], v[i + 8]));
+    }
+}
+
+
+// BLAKE-256 of 4 states, one 32-bit word of every state per element, message words are big endian.
+static void blake256_x4(const uint8_t *const *in, uint8_t *const *out)
+{
+    static const uint32_t iv[8] = { 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19 };
+
+    __m128i h[8];
+    __m128i m[16];
+
+    for (int i = 0; i < 8; ++i) {
+        h[i] = _mm_set1_epi32(static_cast<int>(iv[i]));
+    }
+
+    for (size_t block = 0; block < 3; ++block) {
+        for (size_t i = 0; i < 16; ++i) {
+            const size_t offset = block * 64 + i * 4;
+
+            m[i] = _mm_set_epi32(static_cast<int>(be32(in[3] + offset)), static_cast<int>(be32(in[2] + offset)), static_cast<int>(be32(in[1] + offset)), static_cast<int>(be32(in[0] + offset)));
+        }
+
+        blakeCompress(h, m, static_cast<uint32_t>((block + 1) * 512));
+    }
+
+    // 8 bytes of the message, the padding bit, the final 1 bit of BLAKE-256 padding and the message length in bits.
+    for (size_t i = 0; i < 2; ++i) {
+        const size_t offset = 192 + i * 4;
+
+        m[i] = _mm_set_epi32(static_cast<int>(be32(in[3] + offset)), static_cast<int>(be32(in[2] + offset)), static_cast<int>(be32(in[1] + offset)), static_cast<int>(be32(in[0] + offset)));
+    }
+
+    for (size_t i = 2; i < 16; ++i) {
+        m[i] = _mm_setzero_si128();
+    }
+
+    m[2]  = _mm_set1_epi32(static_cast<int>(0x80000000));
+    m[13] = _mm_set1_epi32(1);
+    m[15] = _mm_set1_epi32(static_cast<int>(kStateSize * 8));
+
+    blakeCompress(h, m, kStateSize * 8);
+
+    for (size_t i = 0; i < 8; ++i) {
+        alignas(16) uint32_t x[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(x), h[i]);
+
+        for (size_t j = 0; j < 4; ++j) {
+            out[j][i * 4]     = static_cast<uint8_t>(x[j] >> 24);
+            out[j][i * 4 + 1] = static_cast<uint8_t>(x[j] >> 16);
+            out[j][i * 4 + 2] = static_cast<uint8_t>(x[j] >> 8);
+            out[j][i * 4 + 3] = static_cast<uint8_t>(x[j]);
+        }
+    }
+}
+
+
+// Runs a W-lane function over count states, a partial group is filled with the first state and its results are dropped.
+template<size_t W, typename F>
+static inline void lanes(const uint8_t *const *in, size_t count, uint8_t *const *out, F hash)
+{
+    uint8_t scratch[kHashSize];
+
+    for (size_t i = 0; i < count; i += W) {
+        const uint8_t *a[W];
+        uint8_t *b[W];
+
+        for (size_t j = 0; j < W; ++j) {
+            a[j] = i + j < count ? in[i + j]  : in[i];
+            b[j] = i + j < count ? out[i + j] : scratch;
+        }
+
+        hash(a, b);
+    }
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::cn_extra_hash_lanes(uint32_t fn, const uint8_t *const *states, size_t count, uint8_t *const *output)
+{
+    static const bool aes  = Cpu::info()->hasAES();
+    static const bool avx2 = Cpu::info()->hasAVX2();
+
+    switch (fn & 3) {
+    case 0:
+        lanes<4>(states, count, output, blake256_x4);
+        break;
+
+    case 1:
+        if (!aes) {
+            return false;
+        }
+
+        avx2 ? groestl256_avx2(states, output, count) : groestl256_ssse3(states, output, count);
+        break;
+
+    case 2:
+        avx2 ? lanes<4>(states, count, output, jh256_x4_avx2) : lanes<2>(states, count, output, ExtraHashesLanes<ExtraHashesSSE2>::jh256);
+        break;
+
+    default:
+        // Two SSE2 lanes of Skein are not faster than the scalar code.
+        if (!avx2) {
+            return false;
+        }
+
+        lanes<4>(states, count, output, skein256_x4_avx2);
+        break;
+    }
+
+    return true;
+}
+
+
+void xmrig::cn_extra_hash(uint32_t fn, const uint8_t *state, uint8_t *output)
+{
+    switch (fn & 3) {
+    case 0:
+        return blake256_hash(output, state, kStateSize);
+
+    case 1:
+        return groestl(state, kStateSize * 8, output);
+
+    case 2:
+        jh_hash(kHashSize * 8, state, kStateSize * 8, output);
+        return;
+
+    default:
+        return xmr_skein(state, output);
+    }
+}
+
+
+void xmrig::cn_extra_hashes(const uint8_t *const *states, size_t count, uint8_t *output)
+{
+    for (size_t offset = 0; offset < count; offset += kMaxStates) {
+        const size_t size = std::min(count - offset, kMaxStates);
+
+        for (uint32_t fn = 0; fn < 4; ++fn) {
+            const uint8_t *in[kMaxStates];
+            uint8_t *out[kMaxStates];
+            size_t n = 0;
+
+            for (size_t i = 0; i < size; ++i) {
+                if ((states[offset + i][0] & 3) == fn) {
+                    in[n]  = states[offset + i];
+                    out[n] = output + (offset + i) * kHashSize;
+                    ++n;
+                }
+            }
+
+            if (n == 1 || (n > 1 && !cn_extra_hash_lanes(fn, in, n, out))) {
+                for (size_t i = 0; i < n; ++i) {
+                    cn_extra_hash(fn, in[i], out[i]);
+                }
+            }
+        }
+    }
+}
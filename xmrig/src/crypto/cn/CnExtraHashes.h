@@ -0,0 +1,45 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CNEXTRAHASHES_H
+#define XMRIG_CNEXTRAHASHES_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+// final hashes of count CryptoNight states (200 bytes), 32 bytes per state one after another, the function of every
+// state is selected by state[0] & 3 and states with the same function are hashed together with SIMD if possible
+void cn_extra_hashes(const uint8_t *const *states, size_t count, uint8_t *output);
+
+// hash count states with function fn (0 - BLAKE-256, 1 - Groestl-256, 2 - JH-256, 3 - Skein-512-256) with SIMD,
+// returns false if the CPU doesn't support it or SIMD is not faster than the scalar code
+bool cn_extra_hash_lanes(uint32_t fn, const uint8_t *const *states, size_t count, uint8_t *const *output);
+
+// scalar code of c_blake256.c, c_groestl.c, c_jh.c and c_skein.c
+void cn_extra_hash(uint32_t fn, const uint8_t *state, uint8_t *output);
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CNEXTRAHASHES_H */
@@ -0,0 +1,94 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "crypto/cn/extra_hashes_lanes.h"
+#include "crypto/cn/groestl_aesni.h"
+
+
+#include <immintrin.h>
+
+
+namespace xmrig {
+
+
+struct ExtraHashesAVX2
+{
+    using V = __m256i;
+
+    static inline V xor_(V a, V b)      { return _mm256_xor_si256(a, b); }
+    static inline V and_(V a, V b)      { return _mm256_and_si256(a, b); }
+    static inline V or_(V a, V b)       { return _mm256_or_si256(a, b); }
+    static inline V andnot(V a, V b)    { return _mm256_andnot_si256(a, b); }
+    static inline V add(V a, V b)       { return _mm256_add_epi64(a, b); }
+    static inline V set1(uint64_t x)    { return _mm256_set1_epi64x(static_cast<int64_t>(x)); }
+
+    template<int n> static inline V shl(V a)    { return _mm256_slli_epi64(a, n); }
+    template<int n> static inline V shr(V a)    { return _mm256_srli_epi64(a, n); }
+    template<int n> static inline V rotl(V a)   { return n == 32 ? _mm256_shuffle_epi32(a, 0xB1) : _mm256_or_si256(_mm256_slli_epi64(a, n), _mm256_srli_epi64(a, 64 - n)); }
+
+    static inline V load(const uint8_t *const *p, size_t offset)
+    {
+        uint64_t x[4];
+        for (size_t i = 0; i < 4; ++i) {
+            memcpy(x + i, p[i] + offset, sizeof(uint64_t));
+        }
+
+        return _mm256_set_epi64x(static_cast<int64_t>(x[3]), static_cast<int64_t>(x[2]), static_cast<int64_t>(x[1]), static_cast<int64_t>(x[0]));
+    }
+
+    static inline void store(uint8_t *const *p, size_t offset, V v)
+    {
+        alignas(32) uint64_t x[4];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(x), v);
+
+        for (size_t i = 0; i < 4; ++i) {
+            memcpy(p[i] + offset, x + i, sizeof(uint64_t));
+        }
+    }
+};
+
+
+void jh256_x4_avx2(const uint8_t *const *in, uint8_t *const *out)
+{
+    ExtraHashesLanes<ExtraHashesAVX2>::jh256(in, out);
+}
+
+
+void skein256_x4_avx2(const uint8_t *const *in, uint8_t *const *out)
+{
+    ExtraHashesLanes<ExtraHashesAVX2>::skein256(in, out);
+}
+
+
+// Same code as the SSSE3 version, VEX encoding saves the register copies of two operand SSE instructions.
+void groestl256_avx2(const uint8_t *const *in, uint8_t *const *out, size_t count)
+{
+    size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        groestl256_aesni<2>(in + i, out + i);
+    }
+
+    if (i < count) {
+        groestl256_aesni<1>(in + i, out + i);
+    }
+}
+
+
+} // namespace xmrig
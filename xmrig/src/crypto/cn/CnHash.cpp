@@ -23,6 +23,16 @@
 #include "crypto/common/VirtualMemory.h"
 
 
+#ifdef XMRIG_VPAES
+#   include "base/io/log/Log.h"
+#   include "base/io/log/Tags.h"
+#   include "base/tools/Chrono.h"
+
+
+#   include <mutex>
+#endif
+
+
 #if defined(XMRIG_ARM)
 #   include "crypto/cn/CryptoNight_arm.h"
 #else
@@ -32,6 +42,21 @@
 
 #ifdef XMRIG_ALGO_ARGON2
 #   include "crypto/argon2/Hash.h"
+
+
+#   define ADD_FN_ARGON2(algo) do {                                                                \
+        m_map[algo] = new cn_hash_fun_array{};                                                     \
+        m_map[algo]->data[AV_SINGLE][Assembly::NONE]      = argon2::single_hash<algo>;             \
+        m_map[algo]->data[AV_SINGLE_SOFT][Assembly::NONE] = argon2::single_hash<algo>;             \
+        m_map[algo]->data[AV_DOUBLE][Assembly::NONE]      = argon2::multi_hash<algo, 2>;           \
+        m_map[algo]->data[AV_DOUBLE_SOFT][Assembly::NONE] = argon2::multi_hash<algo, 2>;           \
+        m_map[algo]->data[AV_TRIPLE][Assembly::NONE]      = argon2::multi_hash<algo, 3>;           \
+        m_map[algo]->data[AV_TRIPLE_SOFT][Assembly::NONE] = argon2::multi_hash<algo, 3>;           \
+        m_map[algo]->data[AV_QUAD][Assembly::NONE]        = argon2::multi_hash<algo, 4>;           \
+        m_map[algo]->data[AV_QUAD_SOFT][Assembly::NONE]   = argon2::multi_hash<algo, 4>;           \
+        m_map[algo]->data[AV_PENTA][Assembly::NONE]       = argon2::multi_hash<algo, 5>;           \
+        m_map[algo]->data[AV_PENTA_SOFT][Assembly::NONE]  = argon2::multi_hash<algo, 5>;           \
+    } while (0)
 #endif
 
 
@@ -52,6 +77,7 @@
 
 bool cn_sse41_enabled = false;
 bool cn_vaes_enabled = false;
+bool cn_vpaes_enabled = false;
 
 
 #ifdef XMRIG_FEATURE_ASM
@@ -302,6 +328,72 @@ static void patchAsmVariants()
     VirtualMemory::flushInstructionCache(base, allocation_size);
 }
 } // namespace xmrig
+
+
+#ifdef XMRIG_VPAES
+namespace xmrig {
+
+
+// Rounds per millisecond of the software AES implementation currently selected by cn_vpaes_enabled.
+static double cnSoftAesSpeed()
+{
+    alignas(16) __m128i x[8] = {};
+    const __m128i key = _mm_set_epi32(0x01234567, 0x89abcdef, 0x76543210, 0xfedcba98);
+
+    double best = 0.0;
+
+    for (int run = 0; run < 3; ++run) {
+        const double start = Chrono::highResolutionMSecs();
+        double elapsed     = 0.0;
+        uint64_t rounds    = 0;
+
+        do {
+            for (int i = 0; i < 64; ++i) {
+                aes_round<true>(key, &x[0], &x[1], &x[2], &x[3], &x[4], &x[5], &x[6], &x[7]);
+            }
+
+            rounds += 64;
+            elapsed = Chrono::highResolutionMSecs() - start;
+        } while (elapsed < 20.0);
+
+        best = std::max(best, rounds / elapsed);
+    }
+
+    return best;
+}
+
+
+static std::mutex softAesMutex;
+static SoftAesImpl softAesImpl  = SOFT_AES_AUTO;
+static bool softAesSelected     = false;
+
+
+// Soft AES algorithm variants are used only on CPUs without AES-NI, pick the faster of the lookup table and
+// vector permute implementations for them, unless the "soft-aes" option forces one.
+static void cnSelectSoftAes()
+{
+    if (!Cpu::info()->has(ICpuInfo::FLAG_SSSE3) || softAesImpl != SOFT_AES_AUTO) {
+        cn_vpaes_enabled = softAesImpl == SOFT_AES_VPAES && Cpu::info()->has(ICpuInfo::FLAG_SSSE3);
+
+        LOG_VERBOSE("%s cryptonight soft AES: %s", Tags::cpu(), cn_vpaes_enabled ? "vpaes" : "table");
+
+        return;
+    }
+
+    cn_vpaes_enabled    = false;
+    const double table  = cnSoftAesSpeed();
+
+    cn_vpaes_enabled    = true;
+    const double vpaes  = cnSoftAesSpeed();
+
+    cn_vpaes_enabled    = vpaes > table;
+
+    LOG_VERBOSE("%s cryptonight soft AES: %s (table %.0f, vpaes %.0f rounds/ms)", Tags::cpu(), cn_vpaes_enabled ? "vpaes" : "table", table, vpaes);
+}
+
+
+} // namespace xmrig
+#endif
 #else
 #   define ADD_FN_ASM(algo)
 #endif
@@ -357,17 +449,9 @@ xmrig::CnHash::CnHash()
 #   endif
 
 #   ifdef XMRIG_ALGO_ARGON2
-    m_map[Algorithm::AR2_CHUKWA] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE][Assembly::NONE]         = argon2::single_hash<Algorithm::AR2_CHUKWA>;
-    m_map[Algorithm::AR2_CHUKWA]->data[AV_SINGLE_SOFT][Assembly::NONE]    = argon2::single_hash<Algorithm::AR2_CHUKWA>;
-
-    m_map[Algorithm::AR2_CHUKWA_V2] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
-    m_map[Algorithm::AR2_CHUKWA_V2]->data[AV_SINGLE_SOFT][Assembly::NONE] = argon2::single_hash<Algorithm::AR2_CHUKWA_V2>;
-
-    m_map[Algorithm::AR2_WRKZ] = new cn_hash_fun_array{};
-    m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE][Assembly::NONE]           = argon2::single_hash<Algorithm::AR2_WRKZ>;
-    m_map[Algorithm::AR2_WRKZ]->data[AV_SINGLE_SOFT][Assembly::NONE]      = argon2::single_hash<Algorithm::AR2_WRKZ>;
+    ADD_FN_ARGON2(Algorithm::AR2_CHUKWA);
+    ADD_FN_ARGON2(Algorithm::AR2_CHUKWA_V2);
+    ADD_FN_ARGON2(Algorithm::AR2_WRKZ);
 #   endif
 
 #   ifdef XMRIG_ALGO_GHOSTRIDER
@@ -406,6 +490,17 @@ xmrig::cn_hash_fun xmrig::CnHash::fn(const Algorithm &algorithm, AlgoVariant av,
         return nullptr;
     }
 
+#   ifdef XMRIG_VPAES
+    if (av == AV_SINGLE_SOFT || av == AV_DOUBLE_SOFT || av == AV_TRIPLE_SOFT || av == AV_QUAD_SOFT || av == AV_PENTA_SOFT) {
+        std::lock_guard<std::mutex> lock(softAesMutex);
+
+        if (!softAesSelected) {
+            cnSelectSoftAes();
+            softAesSelected = true;
+        }
+    }
+#   endif
+
 #   ifdef XMRIG_ALGO_CN_HEAVY
     // cn-heavy optimization for Zen3 CPUs
     if ((av == AV_SINGLE) && (assembly != Assembly::NONE) && (Cpu::info()->arch() == ICpuInfo::ARCH_ZEN3) && (Cpu::info()->model() == 0x21)) {
@@ -434,3 +529,17 @@ xmrig::cn_hash_fun xmrig::CnHash::fn(const Algorithm &algorithm, AlgoVariant av,
 
     return it->second->data[av][Assembly::NONE];
 }
+
+
+// The implementation is selected again by the next fn() call of a soft AES variant.
+void xmrig::CnHash::setSoftAes(SoftAesImpl impl)
+{
+#   ifdef XMRIG_VPAES
+    std::lock_guard<std::mutex> lock(softAesMutex);
+
+    if (softAesImpl != impl) {
+        softAesImpl     = impl;
+        softAesSelected = false;
+    }
+#   endif
+}
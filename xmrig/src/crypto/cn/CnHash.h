@@ -28,6 +28,7 @@
 
 #include "crypto/cn/CnAlgo.h"
 #include "crypto/common/Assembly.h"
+#include "crypto/common/SoftAes.h"
 
 
 struct cryptonight_ctx;
@@ -62,6 +63,7 @@ public:
     virtual ~CnHash();
 
     static cn_hash_fun fn(const Algorithm &algorithm, AlgoVariant av, Assembly::Id assembly);
+    static void setSoftAes(SoftAesImpl impl);
 
 private:
     struct cn_hash_fun_array {
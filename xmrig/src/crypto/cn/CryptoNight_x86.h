@@ -43,11 +43,26 @@
 #include "crypto/cn/soft_aes.h"
 
 
+#ifdef XMRIG_FEATURE_ASM
+#   include "crypto/cn/r/CnRCache.h"
+#endif
+
+
 #ifdef XMRIG_VAES
 #   include "crypto/cn/CryptoNight_x86_vaes.h"
 #endif
 
 
+#ifdef XMRIG_FEATURE_CN_EXTRA_LANES
+#   include "crypto/cn/CnExtraHashes.h"
+#endif
+
+
+#ifdef XMRIG_VPAES
+#   include "crypto/cn/CryptoNight_x86_vpaes.h"
+#endif
+
+
 extern "C"
 {
 #include "crypto/cn/c_groestl.h"
@@ -80,6 +95,56 @@ static inline void do_skein_hash(const uint8_t *input, size_t len, uint8_t *outp
 void (* const extra_hashes[4])(const uint8_t *, size_t, uint8_t *) = {do_blake_hash, do_groestl_hash, do_jh_hash, do_skein_hash};
 
 
+namespace xmrig {
+
+
+// Initial and final Keccak of all lanes of a N-way hash at once.
+template<size_t N>
+static inline void cn_keccak(const uint8_t *input, size_t size, cryptonight_ctx **ctx)
+{
+    uint8_t *md[N];
+    for (size_t i = 0; i < N; ++i) {
+        md[i] = ctx[i]->state;
+    }
+
+    keccak(input, size, md, N);
+}
+
+
+template<size_t N>
+static inline void cn_keccakf(cryptonight_ctx **ctx)
+{
+    uint64_t *st[N];
+    for (size_t i = 0; i < N; ++i) {
+        st[i] = reinterpret_cast<uint64_t*>(ctx[i]->state);
+    }
+
+    keccakf(st, N, 24);
+}
+
+
+// Final hashes of all lanes, lanes with the same function (state[0] & 3) are hashed together.
+template<size_t N>
+static inline void cn_extra_hashes(cryptonight_ctx **ctx, uint8_t *output)
+{
+#   ifdef XMRIG_FEATURE_CN_EXTRA_LANES
+    const uint8_t *states[N];
+    for (size_t i = 0; i < N; ++i) {
+        states[i] = ctx[i]->state;
+    }
+
+    cn_extra_hashes(states, N, output);
+#   else
+    for (size_t i = 0; i < N; ++i) {
+        extra_hashes[ctx[i]->state[0] & 3](ctx[i]->state, 200, output + 32 * i);
+    }
+#   endif
+}
+
+
+} /* namespace xmrig */
+
+
 #if defined(__i386__) || defined(_M_IX86)
 static inline int64_t _mm_cvtsi128_si64(__m128i a)
 {
@@ -229,12 +294,31 @@ static FORCEINLINE __m128i soft_aesenc(const void* __restrict ptr, const __m128i
     return _mm_xor_si128(_mm_set_epi32(y3, y2, y1, y0), key);
 }
 
+// Main loop software AES round, the source is loaded from memory by the table variant directly.
+static FORCEINLINE __m128i cn_soft_aesenc(const void* __restrict ptr, const __m128i key)
+{
+#   ifdef XMRIG_VPAES
+    if (cn_vpaes_enabled) {
+        return xmrig::cn_aesenc_vpaes(ptr, key);
+    }
+#   endif
+
+    return soft_aesenc(ptr, key, reinterpret_cast<const uint32_t*>(saes_table));
+}
+
 template<bool SOFT_AES>
 void aes_round(__m128i key, __m128i* x0, __m128i* x1, __m128i* x2, __m128i* x3, __m128i* x4, __m128i* x5, __m128i* x6, __m128i* x7);
 
 template<>
 NOINLINE void aes_round<true>(__m128i key, __m128i* x0, __m128i* x1, __m128i* x2, __m128i* x3, __m128i* x4, __m128i* x5, __m128i* x6, __m128i* x7)
 {
+#   ifdef XMRIG_VPAES
+    if (cn_vpaes_enabled) {
+        xmrig::cn_aes_round_vpaes(key, x0, x1, x2, x3, x4, x5, x6, x7);
+        return;
+    }
+#   endif
+
     *x0 = soft_aesenc((uint32_t*)x0, key, (const uint32_t*)saes_table);
     *x1 = soft_aesenc((uint32_t*)x1, key, (const uint32_t*)saes_table);
     *x2 = soft_aesenc((uint32_t*)x2, key, (const uint32_t*)saes_table);
@@ -588,9 +672,6 @@ static inline __m128i int_sqrt_v2(const uint64_t n0)
 }
 
 
-void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
-
-
 alignas(64) static const uint32_t tweak1_table[256] = { 268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,268435456,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,805306368,0,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456,805306368,268435456 };
 
 
@@ -691,14 +772,7 @@ inline void cryptonight_single_hash(const uint8_t *__restrict__ input, size_t si
 #   ifdef XMRIG_FEATURE_ASM
     if (SOFT_AES && props.isR()) {
         if (!ctx[0]->generated_code_data.match(ALGO, height)) {
-            V4_Instruction code[256];
-            const int code_size = v4_random_math_init<ALGO>(code, height);
-
-            if (ALGO == Algorithm::CN_R) {
-                v4_soft_aes_compile_code(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), Assembly::NONE);
-            }
-
-            ctx[0]->generated_code_data = { ALGO, height };
+            CnRCache::acquire(ctx[0], height, CnRCache::SOFT_AES, Assembly::NONE);
         }
 
         ctx[0]->saes_table = reinterpret_cast<const uint32_t*>(saes_table);
@@ -740,10 +814,10 @@ inline void cryptonight_single_hash(const uint8_t *__restrict__ input, size_t si
             if (ALGO == Algorithm::CN_CCX) {
                 cx = _mm_load_si128(reinterpret_cast<const __m128i*>(&l0[interleaved_index<interleave>(idx0 & MASK)]));
                 cryptonight_conceal_tweak(cx, conc_var);
-                cx = soft_aesenc(&cx, ax0, reinterpret_cast<const uint32_t*>(saes_table));
+                cx = cn_soft_aesenc(&cx, ax0);
             }
             else {
-                cx = soft_aesenc(&l0[interleaved_index<interleave>(idx0 & MASK)], ax0, reinterpret_cast<const uint32_t*>(saes_table));
+                cx = cn_soft_aesenc(&l0[interleaved_index<interleave>(idx0 & MASK)], ax0);
             }
         }
         else {
@@ -919,24 +993,6 @@ extern cn_mainloop_fun cn_gr5_quad_mainloop_asm;
 } // namespace xmrig
 
 
-void v4_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-void v4_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM);
-
-
-template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
-{
-    v4_compile_code(code, code_size, machine_code, ASM);
-}
-
-
-template<xmrig::Algorithm::Id ALGO>
-void cn_r_compile_code_double(const V4_Instruction* code, int code_size, void* machine_code, xmrig::Assembly ASM)
-{
-    v4_compile_code_double(code, code_size, machine_code, ASM);
-}
-
-
 namespace xmrig {
 
 
@@ -946,11 +1002,7 @@ inline void cryptonight_single_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
-        ctx[0]->generated_code_data = { ALGO, height };
+        CnRCache::acquire(ctx[0], height, CnRCache::SINGLE, ASM);
     }
 
     keccak(input, size, ctx[0]->state);
@@ -1052,15 +1104,10 @@ inline void cryptonight_double_hash_asm(const uint8_t *__restrict__ input, size_
     constexpr CnAlgo<ALGO> props;
 
     if (props.isR() && !ctx[0]->generated_code_data.match(ALGO, height)) {
-        V4_Instruction code[256];
-        const int code_size = v4_random_math_init<ALGO>(code, height);
-        cn_r_compile_code_double<ALGO>(code, code_size, reinterpret_cast<void*>(ctx[0]->generated_code), ASM);
-
-        ctx[0]->generated_code_data = { ALGO, height };
+        CnRCache::acquire(ctx[0], height, CnRCache::DOUBLE, ASM);
     }
 
-    keccak(input,        size, ctx[0]->state);
-    keccak(input + size, size, ctx[1]->state);
+    cn_keccak<2>(input, size, ctx);
 
     if (props.half_mem()) {
         ctx[0]->first_half = true;
@@ -1126,11 +1173,9 @@ inline void cryptonight_double_hash_asm(const uint8_t *__restrict__ input, size_
         cn_implode_scratchpad<ALGO, false, 0>(ctx[1]);
     }
 
-    keccakf(reinterpret_cast<uint64_t*>(ctx[0]->state), 24);
-    keccakf(reinterpret_cast<uint64_t*>(ctx[1]->state), 24);
+    cn_keccakf<2>(ctx);
 
-    extra_hashes[ctx[0]->state[0] & 3](ctx[0]->state, 200, output);
-    extra_hashes[ctx[1]->state[0] & 3](ctx[1]->state, 200, output + 32);
+    cn_extra_hashes<2>(ctx, output);
 }
 
 
@@ -1187,8 +1232,7 @@ static NOINLINE void cryptonight_double_hash_gr_sse41(const uint8_t *__restrict_
         return;
     }
 
-    keccak(input,        size, ctx[0]->state);
-    keccak(input + size, size, ctx[1]->state);
+    cn_keccak<2>(input, size, ctx);
 
     if (props.half_mem()) {
         ctx[0]->first_half = true;
@@ -1232,11 +1276,9 @@ static NOINLINE void cryptonight_double_hash_gr_sse41(const uint8_t *__restrict_
         cn_implode_scratchpad<ALGO, false, 0>(ctx[1]);
     }
 
-    keccakf(reinterpret_cast<uint64_t*>(ctx[0]->state), 24);
-    keccakf(reinterpret_cast<uint64_t*>(ctx[1]->state), 24);
+    cn_keccakf<2>(ctx);
 
-    extra_hashes[ctx[0]->state[0] & 3](ctx[0]->state, 200, output);
-    extra_hashes[ctx[1]->state[0] & 3](ctx[1]->state, 200, output + 32);
+    cn_extra_hashes<2>(ctx, output);
 }
 #endif
 
@@ -1280,8 +1322,7 @@ inline void cryptonight_double_hash(const uint8_t *__restrict__ input, size_t si
         return;
     }
 
-    keccak(input,        size, ctx[0]->state);
-    keccak(input + size, size, ctx[1]->state);
+    cn_keccak<2>(input, size, ctx);
 
     uint8_t *l0  = ctx[0]->memory;
     uint8_t *l1  = ctx[1]->memory;
@@ -1355,12 +1396,12 @@ inline void cryptonight_double_hash(const uint8_t *__restrict__ input, size_t si
                 cx1 = _mm_load_si128(reinterpret_cast<const __m128i*>(&l1[idx1 & MASK]));
                 cryptonight_conceal_tweak(cx0, conc_var0);
                 cryptonight_conceal_tweak(cx1, conc_var1);
-                cx0 = soft_aesenc(&cx0, ax0, reinterpret_cast<const uint32_t*>(saes_table));
-                cx1 = soft_aesenc(&cx1, ax1, reinterpret_cast<const uint32_t*>(saes_table));
+                cx0 = cn_soft_aesenc(&cx0, ax0);
+                cx1 = cn_soft_aesenc(&cx1, ax1);
             }
             else {
-                cx0 = soft_aesenc(&l0[idx0 & MASK], ax0, reinterpret_cast<const uint32_t*>(saes_table));
-                cx1 = soft_aesenc(&l1[idx1 & MASK], ax1, reinterpret_cast<const uint32_t*>(saes_table));
+                cx0 = cn_soft_aesenc(&l0[idx0 & MASK], ax0);
+                cx1 = cn_soft_aesenc(&l1[idx1 & MASK], ax1);
             }
         }
         else {
@@ -1516,11 +1557,9 @@ inline void cryptonight_double_hash(const uint8_t *__restrict__ input, size_t si
         cn_implode_scratchpad<ALGO, SOFT_AES, 0>(ctx[1]);
     }
 
-    keccakf(h0, 24);
-    keccakf(h1, 24);
+    cn_keccakf<2>(ctx);
 
-    extra_hashes[ctx[0]->state[0] & 3](ctx[0]->state, 200, output);
-    extra_hashes[ctx[1]->state[0] & 3](ctx[1]->state, 200, output + 32);
+    cn_extra_hashes<2>(ctx, output);
 }
 
 
@@ -1536,10 +1575,7 @@ static NOINLINE void cryptonight_quad_hash_gr_sse41(const uint8_t* __restrict__
         return;
     }
 
-    keccak(input + size * 0, size, ctx[0]->state);
-    keccak(input + size * 1, size, ctx[1]->state);
-    keccak(input + size * 2, size, ctx[2]->state);
-    keccak(input + size * 3, size, ctx[3]->state);
+    cn_keccak<4>(input, size, ctx);
 
     if (props.half_mem()) {
         ctx[0]->first_half = true;
@@ -1590,15 +1626,9 @@ static NOINLINE void cryptonight_quad_hash_gr_sse41(const uint8_t* __restrict__
         cn_implode_scratchpad<ALGO, false, 0>(ctx[3]);
     }
 
-    keccakf(reinterpret_cast<uint64_t*>(ctx[0]->state), 24);
-    keccakf(reinterpret_cast<uint64_t*>(ctx[1]->state), 24);
-    keccakf(reinterpret_cast<uint64_t*>(ctx[2]->state), 24);
-    keccakf(reinterpret_cast<uint64_t*>(ctx[3]->state), 24);
+    cn_keccakf<4>(ctx);
 
-    extra_hashes[ctx[0]->state[0] & 3](ctx[0]->state, 200, output);
-    extra_hashes[ctx[1]->state[0] & 3](ctx[1]->state, 200, output + 32);
-    extra_hashes[ctx[2]->state[0] & 3](ctx[2]->state, 200, output + 64);
-    extra_hashes[ctx[3]->state[0] & 3](ctx[3]->state, 200, output + 96);
+    cn_extra_hashes<4>(ctx, output);
 }
 #endif
 
@@ -1617,7 +1647,7 @@ static NOINLINE void cryptonight_quad_hash_gr_sse41(const uint8_t* __restrict__
         c = aes_round_tweak_div(c, a);                                                  \
     }                                                                                   \
     else if (SOFT_AES) {                                                                \
-        c = soft_aesenc(&c, a, (const uint32_t*)saes_table);                            \
+        c = cn_soft_aesenc(&c, a);                                                      \
     } else {                                                                            \
         c = _mm_aesenc_si128(c, a);                                                     \
     }                                                                                   \
@@ -1736,8 +1766,9 @@ inline void cryptonight_triple_hash(const uint8_t *__restrict__ input, size_t si
         return;
     }
 
+    cn_keccak<3>(input, size, ctx);
+
     for (size_t i = 0; i < 3; i++) {
-        keccak(input + size * i, size, ctx[i]->state);
         if (props.half_mem()) {
             ctx[i]->first_half = true;
         }
@@ -1787,9 +1818,11 @@ inline void cryptonight_triple_hash(const uint8_t *__restrict__ input, size_t si
 
     for (size_t i = 0; i < 3; i++) {
         cn_implode_scratchpad<ALGO, SOFT_AES, 0>(ctx[i]);
-        keccakf(reinterpret_cast<uint64_t*>(ctx[i]->state), 24);
-        extra_hashes[ctx[i]->state[0] & 3](ctx[i]->state, 200, output + 32 * i);
     }
+
+    cn_keccakf<3>(ctx);
+
+    cn_extra_hashes<3>(ctx, output);
 }
 
 
@@ -1834,8 +1867,9 @@ inline void cryptonight_quad_hash(const uint8_t *__restrict__ input, size_t size
         return;
     }
 
+    cn_keccak<4>(input, size, ctx);
+
     for (size_t i = 0; i < 4; i++) {
-        keccak(input + size * i, size, ctx[i]->state);
         if (props.half_mem()) {
             ctx[i]->first_half = true;
         }
@@ -1918,10 +1952,9 @@ inline void cryptonight_quad_hash(const uint8_t *__restrict__ input, size_t size
         cn_implode_scratchpad<ALGO, SOFT_AES, 0>(ctx[3]);
     }
 
-    for (size_t i = 0; i < 4; i++) {
-        keccakf(reinterpret_cast<uint64_t*>(ctx[i]->state), 24);
-        extra_hashes[ctx[i]->state[0] & 3](ctx[i]->state, 200, output + 32 * i);
-    }
+    cn_keccakf<4>(ctx);
+
+    cn_extra_hashes<4>(ctx, output);
 }
 
 
@@ -1945,8 +1978,9 @@ inline void cryptonight_penta_hash(const uint8_t *__restrict__ input, size_t siz
         return;
     }
 
+    cn_keccak<5>(input, size, ctx);
+
     for (size_t i = 0; i < 5; i++) {
-        keccak(input + size * i, size, ctx[i]->state);
         if (props.half_mem()) {
             ctx[i]->first_half = true;
         }
@@ -2012,9 +2046,11 @@ inline void cryptonight_penta_hash(const uint8_t *__restrict__ input, size_t siz
 
     for (size_t i = 0; i < 5; i++) {
         cn_implode_scratchpad<ALGO, SOFT_AES, 0>(ctx[i]);
-        keccakf(reinterpret_cast<uint64_t*>(ctx[i]->state), 24);
-        extra_hashes[ctx[i]->state[0] & 3](ctx[i]->state, 200, output + 32 * i);
     }
+
+    cn_keccakf<5>(ctx);
+
+    cn_extra_hashes<5>(ctx, output);
 }
 
 
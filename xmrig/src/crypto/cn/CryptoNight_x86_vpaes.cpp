@@ -0,0 +1,39 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/cn/CryptoNight_x86_vpaes.h"
+#include "crypto/common/VpAes.h"
+
+
+void xmrig::cn_aes_round_vpaes(__m128i key, __m128i* x0, __m128i* x1, __m128i* x2, __m128i* x3, __m128i* x4, __m128i* x5, __m128i* x6, __m128i* x7)
+{
+    *x0 = vpaes_enc(*x0, key);
+    *x1 = vpaes_enc(*x1, key);
+    *x2 = vpaes_enc(*x2, key);
+    *x3 = vpaes_enc(*x3, key);
+    *x4 = vpaes_enc(*x4, key);
+    *x5 = vpaes_enc(*x5, key);
+    *x6 = vpaes_enc(*x6, key);
+    *x7 = vpaes_enc(*x7, key);
+}
+
+
+__m128i xmrig::cn_aesenc_vpaes(const void* ptr, __m128i key)
+{
+    return vpaes_enc(_mm_load_si128(reinterpret_cast<const __m128i*>(ptr)), key);
+}
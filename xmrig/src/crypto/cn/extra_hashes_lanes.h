@@ -0,0 +1,284 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_EXTRA_HASHES_LANES_H
+#define XMRIG_EXTRA_HASHES_LANES_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+
+extern "C" {
+extern const unsigned char JH256_H0[128];
+extern const unsigned char E8_bitslice_roundconstant[42][32];
+extern const uint64_t SKEIN_512_IV_256[8];
+}
+
+
+namespace xmrig {
+
+
+/**
+ * JH-256 and Skein-512-256 of several 200 byte CryptoNight states, one 64-bit word of every state per SIMD element.
+ *
+ * L provides the vector type V with L::N elements, xor_(), and_(), or_(), andnot() (~a & b), add() (64-bit),
+ * shl<n>(), shr<n>(), rotl<n>() and set1() for it, load() takes the 64-bit word at a byte offset of every input and
+ * store() writes one to every output. The message length is fixed, so padding is folded into constant words and the
+ * round structure is exactly the same as the scalar code in c_jh.c and c_skein.c.
+ */
+template<typename L>
+struct ExtraHashesLanes
+{
+    using V = typename L::V;
+
+    static inline V word(const void *p, size_t i)
+    {
+        uint64_t x;
+        memcpy(&x, static_cast<const uint8_t *>(p) + i * sizeof(x), sizeof(x));
+
+        return L::set1(x);
+    }
+
+
+    template<int n>
+    static inline V swap(V x, uint64_t mask)
+    {
+        const V m = L::set1(mask);
+
+        return L::or_(L::template shl<n>(L::and_(x, m)), L::and_(L::template shr<n>(x), m));
+    }
+
+
+    static inline void sbox(V &m0, V &m1, V &m2, V &m3, V c)
+    {
+        const V ones = L::set1(~0ULL);
+
+        m3 = L::xor_(m3, ones);
+        m0 = L::xor_(m0, L::andnot(m2, c));
+
+        const V t = L::xor_(c, L::and_(m0, m1));
+
+        m0 = L::xor_(m0, L::and_(m2, m3));
+        m3 = L::xor_(m3, L::andnot(m1, m2));
+        m1 = L::xor_(m1, L::and_(m0, m2));
+        m2 = L::xor_(m2, L::andnot(m3, m0));
+        m0 = L::xor_(m0, L::or_(m1, m3));
+        m3 = L::xor_(m3, L::and_(m1, m2));
+        m1 = L::xor_(m1, L::and_(t, m0));
+        m2 = L::xor_(m2, t);
+    }
+
+
+    static inline void mds(V &m0, V &m1, V &m2, V &m3, V &m4, V &m5, V &m6, V &m7)
+    {
+        m4 = L::xor_(m4, m1);
+        m5 = L::xor_(m5, m2);
+        m6 = L::xor_(m6, L::xor_(m0, m3));
+        m7 = L::xor_(m7, m0);
+        m0 = L::xor_(m0, m5);
+        m1 = L::xor_(m1, m6);
+        m2 = L::xor_(m2, L::xor_(m4, m7));
+        m3 = L::xor_(m3, m4);
+    }
+
+
+    template<int n>
+    static inline void jhRound(V x[8][2], int round, uint64_t mask)
+    {
+        for (int i = 0; i < 2; ++i) {
+            sbox(x[0][i], x[2][i], x[4][i], x[6][i], word(E8_bitslice_roundconstant[round], i));
+            sbox(x[1][i], x[3][i], x[5][i], x[7][i], word(E8_bitslice_roundconstant[round], i + 2));
+            mds(x[0][i], x[2][i], x[4][i], x[6][i], x[1][i], x[3][i], x[5][i], x[7][i]);
+
+            for (int j = 1; j < 8; j += 2) {
+                x[j][i] = n == 32 ? L::template rotl<32>(x[j][i]) : (n ? swap<n>(x[j][i], mask) : x[j][i]);
+            }
+        }
+    }
+
+
+    static inline void jhF8(V x[8][2], const V m[8])
+    {
+        for (int i = 0; i < 8; ++i) {
+            x[i / 2][i % 2] = L::xor_(x[i / 2][i % 2], m[i]);
+        }
+
+        for (int round = 0; round < 42; round += 7) {
+            jhRound<1>(x, round + 0, 0x5555555555555555ULL);
+            jhRound<2>(x, round + 1, 0x3333333333333333ULL);
+            jhRound<4>(x, round + 2, 0x0f0f0f0f0f0f0f0fULL);
+            jhRound<8>(x, round + 3, 0x00ff00ff00ff00ffULL);
+            jhRound<16>(x, round + 4, 0x0000ffff0000ffffULL);
+            jhRound<32>(x, round + 5, 0);
+            jhRound<0>(x, round + 6, 0);
+
+            for (int j = 1; j < 8; j += 2) {
+                const V t = x[j][0];
+                x[j][0]   = x[j][1];
+                x[j][1]   = t;
+            }
+        }
+
+        for (int i = 0; i < 8; ++i) {
+            x[4 + i / 2][i % 2] = L::xor_(x[4 + i / 2][i % 2], m[i]);
+        }
+    }
+
+
+    static void jh256(const uint8_t *const *in, uint8_t *const *out)
+    {
+        V x[8][2];
+        V m[8];
+
+        for (int i = 0; i < 16; ++i) {
+            x[i / 2][i % 2] = word(JH256_H0, i);
+        }
+
+        for (size_t block = 0; block < 3; ++block) {
+            for (size_t i = 0; i < 8; ++i) {
+                m[i] = L::load(in, block * 64 + i * 8);
+            }
+
+            jhF8(x, m);
+        }
+
+        // 8 bytes of the message and the padding bit.
+        m[0] = L::load(in, 192);
+        m[1] = L::set1(0x80);
+
+        for (size_t i = 2; i < 8; ++i) {
+            m[i] = L::set1(0);
+        }
+
+        jhF8(x, m);
+
+        // Message length in bits, big endian.
+        m[0] = m[1] = L::set1(0);
+        m[7] = L::set1(0x4006000000000000ULL);
+
+        jhF8(x, m);
+
+        for (size_t i = 0; i < 4; ++i) {
+            L::store(out, i * 8, x[6 + i / 2][i % 2]);
+        }
+    }
+
+
+    template<int r>
+    static inline void mix(V &x0, V &x1)
+    {
+        x0 = L::add(x0, x1);
+        x1 = L::xor_(L::template rotl<r>(x1), x0);
+    }
+
+
+    static inline void inject(V X[8], const V ks[9], const uint64_t ts[3], int s)
+    {
+        for (int i = 0; i < 8; ++i) {
+            X[i] = L::add(X[i], ks[(s + i) % 9]);
+        }
+
+        X[5] = L::add(X[5], L::set1(ts[s % 3]));
+        X[6] = L::add(X[6], L::set1(ts[(s + 1) % 3]));
+        X[7] = L::add(X[7], L::set1(static_cast<uint64_t>(s)));
+    }
+
+
+    static inline void threefish(V X[8], const V w[8], uint64_t t0, uint64_t t1)
+    {
+        V ks[9];
+        ks[8] = L::set1(0x1BD11BDAA9FC1A22ULL);
+
+        for (int i = 0; i < 8; ++i) {
+            ks[i] = X[i];
+            ks[8] = L::xor_(ks[8], X[i]);
+            X[i]  = w[i];
+        }
+
+        const uint64_t ts[3] = { t0, t1, t0 ^ t1 };
+
+        inject(X, ks, ts, 0);
+
+        for (int s = 1; s < 19; s += 2) {
+            mix<46>(X[0], X[1]); mix<36>(X[2], X[3]); mix<19>(X[4], X[5]); mix<37>(X[6], X[7]);
+            mix<33>(X[2], X[1]); mix<27>(X[4], X[7]); mix<14>(X[6], X[5]); mix<42>(X[0], X[3]);
+            mix<17>(X[4], X[1]); mix<49>(X[6], X[3]); mix<36>(X[0], X[5]); mix<39>(X[2], X[7]);
+            mix<44>(X[6], X[1]); mix< 9>(X[0], X[7]); mix<54>(X[2], X[5]); mix<56>(X[4], X[3]);
+            inject(X, ks, ts, s);
+
+            mix<39>(X[0], X[1]); mix<30>(X[2], X[3]); mix<34>(X[4], X[5]); mix<24>(X[6], X[7]);
+            mix<13>(X[2], X[1]); mix<50>(X[4], X[7]); mix<10>(X[6], X[5]); mix<17>(X[0], X[3]);
+            mix<25>(X[4], X[1]); mix<29>(X[6], X[3]); mix<39>(X[0], X[5]); mix<43>(X[2], X[7]);
+            mix< 8>(X[6], X[1]); mix<35>(X[0], X[7]); mix<56>(X[2], X[5]); mix<22>(X[4], X[3]);
+            inject(X, ks, ts, s + 1);
+        }
+
+        for (int i = 0; i < 8; ++i) {
+            X[i] = L::xor_(X[i], w[i]);
+        }
+    }
+
+
+    static void skein256(const uint8_t *const *in, uint8_t *const *out)
+    {
+        constexpr uint64_t first = 1ULL << 62;
+        constexpr uint64_t final = 1ULL << 63;
+        constexpr uint64_t msg   = 48ULL << 56;
+        constexpr uint64_t outT  = 63ULL << 56;
+
+        V X[8];
+        V w[8];
+
+        for (int i = 0; i < 8; ++i) {
+            X[i] = L::set1(SKEIN_512_IV_256[i]);
+        }
+
+        for (size_t block = 0; block < 3; ++block) {
+            for (size_t i = 0; i < 8; ++i) {
+                w[i] = L::load(in, block * 64 + i * 8);
+            }
+
+            threefish(X, w, (block + 1) * 64, msg | (block == 0 ? first : 0));
+        }
+
+        w[0] = L::load(in, 192);
+
+        for (size_t i = 1; i < 8; ++i) {
+            w[i] = L::set1(0);
+        }
+
+        threefish(X, w, 200, msg | final);
+
+        // Output block in counter mode, counter 0.
+        w[0] = L::set1(0);
+
+        threefish(X, w, 8, outT | first | final);
+
+        for (size_t i = 0; i < 4; ++i) {
+            L::store(out, i * 8, X[i]);
+        }
+    }
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_EXTRA_HASHES_LANES_H */
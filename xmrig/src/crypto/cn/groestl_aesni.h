@@ -0,0 +1,253 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_GROESTL_AESNI_H
+#define XMRIG_GROESTL_AESNI_H
+
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+
+namespace xmrig {
+
+
+/**
+ * Groestl-256 of 200 byte CryptoNight states with AES-NI.
+ *
+ * Every register holds one row of the 8x8 byte state, P in the low and Q in the high 8 bytes, so both permutations of
+ * a compression run together. AESENCLAST with a zero key is SubBytes after AES ShiftRows, ShiftRows is undone in the
+ * same shuffle that does ShiftBytes. States of a group are interleaved to hide AESENCLAST latency.
+ */
+// Shuffles of ShiftBytes followed by inverse AES ShiftRows, row i of P in the low and of Q in the high 8 bytes.
+static inline const __m128i *groestl_masks()
+{
+    struct Masks
+    {
+        Masks()
+        {
+            static const uint8_t shiftQ[8] = { 1, 3, 5, 7, 0, 2, 4, 6 };
+
+            for (int row = 0; row < 8; ++row) {
+                uint8_t bytes[16];
+
+                for (int j = 0; j < 8; ++j) {
+                    bytes[j]     = static_cast<uint8_t>((j + row) & 7);
+                    bytes[8 + j] = static_cast<uint8_t>(8 + ((j + shiftQ[row]) & 7));
+                }
+
+                // AES ShiftRows takes byte r + 4c from r + 4((c + r) % 4).
+                for (int k = 0; k < 16; ++k) {
+                    shift[row][(k & 3) + 4 * (((k >> 2) + (k & 3)) & 3)] = bytes[k];
+                }
+            }
+        }
+
+        alignas(16) uint8_t shift[8][16];
+    };
+
+    static const Masks masks;
+
+    return reinterpret_cast<const __m128i *>(masks.shift);
+}
+
+
+static inline __m128i groestl_mul2(__m128i a)
+{
+    const __m128i carry = _mm_and_si128(_mm_cmpgt_epi8(_mm_setzero_si128(), a), _mm_set1_epi8(0x1b));
+
+    return _mm_xor_si128(_mm_add_epi8(a, a), carry);
+}
+
+
+// Four columns to rows, row i of 2 columns ends in 16-bit word i of every register.
+static inline void groestl_to_rows(const uint8_t *block, __m128i rows[8])
+{
+    const __m128i interleave = _mm_set_epi8(15, 7, 14, 6, 13, 5, 12, 4, 11, 3, 10, 2, 9, 1, 8, 0);
+
+    const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block)), interleave);
+    const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16)), interleave);
+    const __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 32)), interleave);
+    const __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 48)), interleave);
+
+    const __m128i ab0 = _mm_unpacklo_epi16(a, b);
+    const __m128i ab1 = _mm_unpackhi_epi16(a, b);
+    const __m128i cd0 = _mm_unpacklo_epi16(c, d);
+    const __m128i cd1 = _mm_unpackhi_epi16(c, d);
+
+    const __m128i r01 = _mm_unpacklo_epi32(ab0, cd0);
+    const __m128i r23 = _mm_unpackhi_epi32(ab0, cd0);
+    const __m128i r45 = _mm_unpacklo_epi32(ab1, cd1);
+    const __m128i r67 = _mm_unpackhi_epi32(ab1, cd1);
+
+    rows[0] = _mm_move_epi64(r01);
+    rows[1] = _mm_srli_si128(r01, 8);
+    rows[2] = _mm_move_epi64(r23);
+    rows[3] = _mm_srli_si128(r23, 8);
+    rows[4] = _mm_move_epi64(r45);
+    rows[5] = _mm_srli_si128(r45, 8);
+    rows[6] = _mm_move_epi64(r67);
+    rows[7] = _mm_srli_si128(r67, 8);
+}
+
+
+template<size_t N>
+static inline void groestl_rounds(__m128i x[N][8])
+{
+    const __m128i zero   = _mm_setzero_si128();
+    const __m128i *shift = groestl_masks();
+
+    for (int r = 0; r < 10; ++r) {
+        const uint64_t round = 0x0101010101010101ULL * static_cast<uint64_t>(r);
+        const __m128i c0     = _mm_set_epi64x(-1, static_cast<int64_t>(0x7060504030201000ULL ^ round));
+        const __m128i c7     = _mm_set_epi64x(static_cast<int64_t>(~0x7060504030201000ULL ^ round), 0);
+        const __m128i q      = _mm_set_epi64x(-1, 0);
+
+        for (size_t n = 0; n < N; ++n) {
+            x[n][0] = _mm_xor_si128(x[n][0], c0);
+            x[n][7] = _mm_xor_si128(x[n][7], c7);
+
+            for (int i = 1; i < 7; ++i) {
+                x[n][i] = _mm_xor_si128(x[n][i], q);
+            }
+
+            for (int i = 0; i < 8; ++i) {
+                x[n][i] = _mm_aesenclast_si128(_mm_shuffle_epi8(x[n][i], _mm_load_si128(shift + i)), zero);
+            }
+        }
+
+        // MixBytes, b[i] = 2a[i] + 2a[i+1] + 3a[i+2] + 4a[i+3] + 5a[i+4] + 3a[i+5] + 5a[i+6] + 7a[i+7].
+        for (size_t n = 0; n < N; ++n) {
+            __m128i *a = x[n];
+            __m128i t[8];
+            __m128i y[8];
+            __m128i w[8];
+
+            for (int i = 0; i < 8; ++i) {
+                t[i] = _mm_xor_si128(a[i], a[(i + 1) & 7]);
+            }
+
+            for (int i = 0; i < 8; ++i) {
+                y[i] = _mm_xor_si128(_mm_xor_si128(t[i], t[(i + 2) & 7]), a[(i + 6) & 7]);
+            }
+
+            for (int i = 0; i < 8; ++i) {
+                w[i] = _mm_xor_si128(groestl_mul2(_mm_xor_si128(t[i], t[(i + 3) & 7])), y[(i + 4) & 7]);
+            }
+
+            for (int i = 0; i < 8; ++i) {
+                a[i] = _mm_xor_si128(groestl_mul2(w[(i + 3) & 7]), y[(i + 4) & 7]);
+            }
+        }
+    }
+}
+
+
+template<size_t N>
+static inline void groestl_compress(__m128i h[N][8], const uint8_t *const *blocks)
+{
+    __m128i x[N][8];
+
+    for (size_t n = 0; n < N; ++n) {
+        __m128i m[8];
+        groestl_to_rows(blocks[n], m);
+
+        for (int i = 0; i < 8; ++i) {
+            x[n][i] = _mm_unpacklo_epi64(_mm_xor_si128(h[n][i], m[i]), m[i]);
+        }
+    }
+
+    groestl_rounds<N>(x);
+
+    for (size_t n = 0; n < N; ++n) {
+        for (int i = 0; i < 8; ++i) {
+            h[n][i] = _mm_move_epi64(_mm_xor_si128(h[n][i], _mm_xor_si128(x[n][i], _mm_srli_si128(x[n][i], 8))));
+        }
+    }
+}
+
+
+template<size_t N>
+static inline void groestl256_aesni(const uint8_t *const *in, uint8_t *const *out)
+{
+    __m128i h[N][8];
+    const uint8_t *blocks[N];
+
+    for (size_t n = 0; n < N; ++n) {
+        for (int i = 0; i < 8; ++i) {
+            h[n][i] = _mm_setzero_si128();
+        }
+
+        // 256-bit output length, byte 62 of the initial value.
+        h[n][6] = _mm_set_epi64x(0, 0x0100000000000000LL);
+    }
+
+    for (size_t block = 0; block < 3; ++block) {
+        for (size_t n = 0; n < N; ++n) {
+            blocks[n] = in[n] + block * 64;
+        }
+
+        groestl_compress<N>(h, blocks);
+    }
+
+    // 8 bytes of the message, the padding bit and the number of blocks.
+    alignas(16) uint8_t last[N][64] = {};
+
+    for (size_t n = 0; n < N; ++n) {
+        memcpy(last[n], in[n] + 192, 8);
+        last[n][8]  = 0x80;
+        last[n][63] = 4;
+        blocks[n]   = last[n];
+    }
+
+    groestl_compress<N>(h, blocks);
+
+    // Output transformation P(h) + h, Q half of the registers is not used.
+    __m128i x[N][8];
+
+    for (size_t n = 0; n < N; ++n) {
+        for (int i = 0; i < 8; ++i) {
+            x[n][i] = h[n][i];
+        }
+    }
+
+    groestl_rounds<N>(x);
+
+    for (size_t n = 0; n < N; ++n) {
+        alignas(16) uint8_t rows[8][16];
+
+        for (int i = 0; i < 8; ++i) {
+            _mm_store_si128(reinterpret_cast<__m128i *>(rows[i]), _mm_xor_si128(h[n][i], x[n][i]));
+        }
+
+        for (int j = 4; j < 8; ++j) {
+            for (int i = 0; i < 8; ++i) {
+                out[n][8 * (j - 4) + i] = rows[i][j];
+            }
+        }
+    }
+}
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_GROESTL_AESNI_H */
@@ -0,0 +1,356 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/cn/r/CnRCache.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Object.h"
+#include "crypto/cn/CryptoNight_monero.h"
+#include "crypto/cn/CryptoNight.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+void v4_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+void v4_compile_code_double(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+void v4_soft_aes_compile_code(const V4_Instruction *code, int code_size, void *machine_code, xmrig::Assembly ASM);
+
+
+namespace xmrig {
+
+
+static constexpr size_t kCodeSize   = 0x4000;
+static constexpr size_t kMaxEntries = 16;   // soft limit, exceeded only if all programs are in use
+
+
+class CnRProgram
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(CnRProgram)
+
+    inline CnRProgram() : code(VirtualMemory::allocateExecutableMemory(kCodeSize, false)) {}
+    inline ~CnRProgram() { VirtualMemory::freeLargePagesMemory(code, kCodeSize); }
+
+    inline bool match(CnRCache::Type t, Assembly::Id a, uint64_t h) const { return height == h && type == t && assembly == a; }
+
+    void compile() const
+    {
+        V4_Instruction program[256];
+        const int size = v4_random_math_init<Algorithm::CN_R>(program, height);
+
+        switch (type) {
+        case CnRCache::SINGLE:
+            v4_compile_code(program, size, code, assembly);
+            break;
+
+        case CnRCache::DOUBLE:
+            v4_compile_code_double(program, size, code, assembly);
+            break;
+
+        case CnRCache::SOFT_AES:
+            v4_soft_aes_compile_code(program, size, code, Assembly::NONE);
+            break;
+        }
+    }
+
+    Assembly::Id assembly   = Assembly::NONE;
+    bool ahead              = false;    // compiled by background thread before it was requested
+    bool ready              = false;
+    CnRCache::Type type     = CnRCache::SINGLE;
+    uint32_t refs           = 0;
+    uint64_t height         = std::numeric_limits<uint64_t>::max();
+    uint64_t used           = 0;
+    void *code;
+};
+
+
+class CnRCachePrivate
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(CnRCachePrivate)
+
+    inline CnRCachePrivate(std::mutex &mutex) : m_mutex(mutex) { m_thread = std::thread(&CnRCachePrivate::backgroundCompile, this); }
+
+    inline ~CnRCachePrivate()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_shutdown = true;
+        }
+
+        m_cv.notify_one();
+        m_thread.join();
+
+        for (auto program : m_programs) {
+            delete program;
+        }
+    }
+
+
+    CnRProgram *acquire(std::unique_lock<std::mutex> &lock, uint64_t height, CnRCache::Type type, Assembly::Id assembly)
+    {
+        CnRProgram *program = find(type, assembly, height);
+        bool waited         = false;
+
+        // Reference taken while waiting keeps the program from being reused for another height before this thread wakes up.
+        while (program && !program->ready) {
+            waited = true;
+
+            ++program->refs;
+            m_ready.wait(lock, [program] { return program->ready; });
+            --program->refs;
+
+            if (!program->match(type, assembly, height)) {
+                program = find(type, assembly, height);
+            }
+        }
+
+        if (!program) {
+            program = reserve(type, assembly, height);
+            ++misses;
+
+            lock.unlock();
+            program->compile();
+            lock.lock();
+
+            program->ready = true;
+            m_ready.notify_all();
+        }
+        else if (waited) {
+            ++waits;
+        }
+        else {
+            ++hits;
+        }
+
+        ++program->refs;
+        program->used = ++m_counter;
+
+        if (height < std::numeric_limits<uint64_t>::max() && !find(type, assembly, height + 1)) {
+            m_queue.emplace_back(reserve(type, assembly, height + 1));
+            m_cv.notify_one();
+        }
+
+        return program;
+    }
+
+
+    // Returns nullptr if there is no compiled program for this height (interpreter is used).
+    const char *origin(uint64_t height) const
+    {
+        for (auto program : m_programs) {
+            if (program->height == height && program->ready) {
+                return program->ahead ? GREEN("compiled ahead") : YELLOW("compiled on demand");
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    void release(const void *code)
+    {
+        if (!code) {
+            return;
+        }
+
+        for (auto program : m_programs) {
+            if (program->code == code) {
+                assert(program->refs > 0);
+                --program->refs;
+
+                return;
+            }
+        }
+    }
+
+
+private:
+    CnRProgram *find(CnRCache::Type type, Assembly::Id assembly, uint64_t height) const
+    {
+        for (auto program : m_programs) {
+            if (program->match(type, assembly, height)) {
+                return program;
+            }
+        }
+
+        return nullptr;
+    }
+
+
+    // Least recently used program which is compiled and not in use, or a new one.
+    CnRProgram *reserve(CnRCache::Type type, Assembly::Id assembly, uint64_t height)
+    {
+        CnRProgram *program = nullptr;
+
+        if (m_programs.size() >= kMaxEntries) {
+            for (auto p : m_programs) {
+                if (p->ready && p->refs == 0 && (!program || p->used < program->used)) {
+                    program = p;
+                }
+            }
+        }
+
+        if (!program) {
+            program = new CnRProgram();
+            m_programs.emplace_back(program);
+        }
+
+        program->assembly   = assembly;
+        program->type       = type;
+        program->height     = height;
+        program->ahead      = false;
+        program->ready      = false;
+        program->used       = ++m_counter;
+
+        return program;
+    }
+
+
+    void backgroundCompile()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true) {
+            m_cv.wait(lock, [this] { return m_shutdown || !m_queue.empty(); });
+
+            if (m_shutdown) {
+                break;
+            }
+
+            auto program = m_queue.front();
+            m_queue.pop_front();
+
+            lock.unlock();
+            program->compile();
+            lock.lock();
+
+            program->ahead = true;
+            program->ready = true;
+            m_ready.notify_all();
+        }
+    }
+
+
+    bool m_shutdown         = false;
+    std::condition_variable m_cv;
+    std::condition_variable m_ready;
+    std::deque<CnRProgram *> m_queue;
+    std::mutex &m_mutex;
+    std::thread m_thread;
+    std::vector<CnRProgram *> m_programs;
+    uint64_t m_counter      = 0;
+
+public:
+    uint64_t hits           = 0;
+    uint64_t misses         = 0;
+    uint64_t waits          = 0;
+};
+
+
+static std::mutex mutex;
+static CnRCachePrivate *d_ptr = nullptr;
+
+
+static struct {
+    double max          = 0.0;
+    double sum          = 0.0;
+    uint64_t count      = 0;
+    uint64_t reported   = std::numeric_limits<uint64_t>::max();
+} firstHashStats;
+
+
+} // namespace xmrig
+
+
+void xmrig::CnRCache::acquire(cryptonight_ctx *ctx, uint64_t height, Type type, Assembly::Id assembly)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (!d_ptr) {
+        d_ptr = new CnRCachePrivate(mutex);
+    }
+
+    d_ptr->release(reinterpret_cast<const void *>(ctx->generated_code));
+    ctx->generated_code = nullptr;
+
+    auto program = d_ptr->acquire(lock, height, type, assembly);
+
+    ctx->generated_code             = reinterpret_cast<cn_mainloop_fun_ms_abi>(program->code);
+    ctx->generated_code_data.algo   = Algorithm::CN_R;
+    ctx->generated_code_data.height = height;
+}
+
+
+void xmrig::CnRCache::destroy()
+{
+    CnRCachePrivate *d = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::swap(d, d_ptr);
+    }
+
+    delete d;
+}
+
+
+void xmrig::CnRCache::firstHash(uint64_t height, double ms)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto &stats = firstHashStats;
+    ++stats.count;
+    stats.sum += ms;
+    stats.max  = std::max(stats.max, ms);
+
+    if (height == stats.reported) {
+        return;
+    }
+
+    stats.reported = height;
+
+    const char *origin = d_ptr ? d_ptr->origin(height) : nullptr;
+
+    LOG_VERBOSE("%s " WHITE_BOLD("cn/r") " height " CYAN_BOLD("%" PRIu64) " program %s" BLACK_BOLD(", first hash ") CYAN_BOLD("%.2f ms")
+                BLACK_BOLD(" (avg %.2f ms, max %.2f ms, cache hits %" PRIu64 " misses %" PRIu64 " waits %" PRIu64 ")"),
+                Tags::cpu(), height, origin ? origin : "interpreted", ms, stats.sum / stats.count, stats.max,
+                d_ptr ? d_ptr->hits : 0, d_ptr ? d_ptr->misses : 0, d_ptr ? d_ptr->waits : 0);
+}
+
+
+void xmrig::CnRCache::release(cryptonight_ctx *ctx)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (d_ptr) {
+        d_ptr->release(reinterpret_cast<const void *>(ctx->generated_code));
+    }
+
+    ctx->generated_code = nullptr;
+}
@@ -0,0 +1,61 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_CNRCACHE_H
+#define XMRIG_CNRCACHE_H
+
+
+#include "crypto/common/Assembly.h"
+
+
+#include <cstdint>
+
+
+struct cryptonight_ctx;
+
+
+namespace xmrig {
+
+
+/**
+ * Process wide cache of compiled CryptoNight-R main loops.
+ *
+ * Programs are shared by all threads with the same main loop type and assembly variant, as soon as height h is
+ * requested the program for height h + 1 is compiled by a background thread, so on a block change workers only
+ * swap a pointer. Programs still referenced by any ctx are never evicted.
+ */
+class CnRCache
+{
+public:
+    enum Type : uint32_t {
+        SINGLE,
+        DOUBLE,
+        SOFT_AES
+    };
+
+    static void acquire(cryptonight_ctx *ctx, uint64_t height, Type type, Assembly::Id assembly);
+    static void destroy();
+    static void firstHash(uint64_t height, double ms);
+    static void release(cryptonight_ctx *ctx);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_CNRCACHE_H */
@@ -22,17 +22,30 @@
 
 
 #include <algorithm>
+#include <cerrno>
 #include <fstream>
+#include <map>
 #include <mutex>
 #include <string>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+
+#ifndef MPOL_MF_MOVE
+#   define MPOL_MF_MOVE (1 << 1)
+#endif
 
 
 namespace xmrig {
 
 
 static std::mutex mutex;
+static std::map<uint32_t, size_t> budget;   // huge pages reserved ahead for following allocations of the node
+static size_t budgetPageSize = 0;
 constexpr size_t twoMiB = 2U * 1024U * 1024U;
 constexpr size_t oneGiB = 1024U * 1024U * 1024U;
+constexpr size_t kMovePagesBatch = 4096;
 
 
 static inline std::string sysfs_path(uint32_t node, size_t hugePageSize, bool nr)
@@ -46,6 +59,13 @@ static inline int64_t free_hugepages(uint32_t node, size_t hugePageSize)
 static inline int64_t nr_hugepages(uint32_t node, size_t hugePageSize)                      { return LinuxMemory::read(sysfs_path(node, hugePageSize, true).c_str()); }
 
 
+// Raw system call, libnuma is not a dependency, without target nodes only the current node of every page is reported.
+static inline long move_pages(size_t count, void **pages, const int *nodes, int *status, int flags)
+{
+    return syscall(SYS_move_pages, 0, count, pages, nodes, status, flags);
+}
+
+
 } // namespace xmrig
 
 
@@ -55,6 +75,12 @@ bool xmrig::LinuxMemory::reserve(size_t size, uint32_t node, size_t hugePageSize
 
     const size_t required = VirtualMemory::align(size, hugePageSize) / hugePageSize;
 
+    if (hugePageSize == budgetPageSize && budget.count(node) && budget.at(node) >= required) {
+        budget[node] -= required;
+
+        return false;
+    }
+
     const auto available = free_hugepages(node, hugePageSize);
     if (available < 0 || static_cast<size_t>(available) >= required) {
         return false;
@@ -64,6 +90,117 @@ bool xmrig::LinuxMemory::reserve(size_t size, uint32_t node, size_t hugePageSize
 }
 
 
+// Reserves huge pages for all planned allocations of the node with one sysfs write, reserve() calls of these allocations are served from the budget.
+size_t xmrig::LinuxMemory::reserveNode(uint32_t node, size_t size, size_t executableSize, size_t hugePageSize)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const size_t pages      = size ? VirtualMemory::align(size, hugePageSize) / hugePageSize : 0;
+    const size_t executable = executableSize ? VirtualMemory::align(executableSize, hugePageSize) / hugePageSize : 0;
+    const size_t required   = pages + executable;
+
+    auto available = free_hugepages(node, hugePageSize);
+    if (available < 0) {
+        return 0;
+    }
+
+    if (static_cast<size_t>(available) < required && write_nr_hugepages(node, hugePageSize, std::max<size_t>(nr_hugepages(node, hugePageSize), 0) + (required - available))) {
+        available = std::max<int64_t>(free_hugepages(node, hugePageSize), 0);
+    }
+
+    // Executable memory doesn't call reserve(), its pages are taken first.
+    const size_t reserved = std::min(static_cast<size_t>(available), required);
+
+    budget[node]   = reserved > executable ? reserved - executable : 0;
+    budgetPageSize = hugePageSize;
+
+    return reserved;
+}
+
+
+xmrig::NumaPagesInfo xmrig::LinuxMemory::numaPages(const void *p, size_t size, size_t pageSize, uint32_t node, bool migrate, bool populate)
+{
+    NumaPagesInfo info(node);
+    if (!p || !size) {
+        return info;
+    }
+
+    if (!pageSize) {
+        pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    const auto first = reinterpret_cast<uintptr_t>(p);
+    const auto end   = first + size;
+
+    std::vector<void *> pages;
+    std::vector<void *> misplaced;
+    std::vector<int> status;
+    std::vector<int> nodes;
+
+    for (uintptr_t addr = first & ~(pageSize - 1); addr < end; addr += pageSize * kMovePagesBatch) {
+        const size_t count = std::min<size_t>(kMovePagesBatch, (end - addr + pageSize - 1) / pageSize);
+
+        pages.resize(count);
+        status.assign(count, -1);
+
+        for (size_t i = 0; i < count; ++i) {
+            pages[i] = reinterpret_cast<void *>(addr + i * pageSize);
+        }
+
+        if (move_pages(count, pages.data(), nullptr, status.data(), 0) != 0) {
+            break;
+        }
+
+        // Pages are faulted in by the calling thread, so the same placement the first hash would get is reported.
+        if (populate && std::find(status.begin(), status.end(), -ENOENT) != status.end()) {
+            for (size_t i = 0; i < count; ++i) {
+                if (status[i] == -ENOENT) {
+                    auto byte = reinterpret_cast<volatile uint8_t *>(std::max(reinterpret_cast<uintptr_t>(pages[i]), first));
+                    *byte = *byte;
+                }
+            }
+
+            if (move_pages(count, pages.data(), nullptr, status.data(), 0) != 0) {
+                break;
+            }
+        }
+
+        if (migrate) {
+            misplaced.clear();
+
+            for (size_t i = 0; i < count; ++i) {
+                if (status[i] >= 0 && status[i] != static_cast<int>(node)) {
+                    misplaced.emplace_back(pages[i]);
+                }
+            }
+
+            if (!misplaced.empty()) {
+                std::vector<int> moved(misplaced.size(), -1);
+                nodes.assign(misplaced.size(), static_cast<int>(node));
+
+                if (move_pages(misplaced.size(), misplaced.data(), nodes.data(), moved.data(), MPOL_MF_MOVE) >= 0) {
+                    info.migrated += static_cast<size_t>(std::count(moved.begin(), moved.end(), static_cast<int>(node)));
+                }
+
+                move_pages(count, pages.data(), nullptr, status.data(), 0);
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            if (status[i] >= 0) {
+                ++info.total;
+
+                if (status[i] == static_cast<int>(node)) {
+                    ++info.local;
+                }
+            }
+        }
+    }
+
+    return info;
+}
+
+
 bool xmrig::LinuxMemory::write(const char *path, uint64_t value)
 {
     std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
@@ -20,6 +20,9 @@
 #define XMRIG_LINUXMEMORY_H
 
 
+#include "crypto/common/NumaPagesInfo.h"
+
+
 #include <cstdint>
 #include <cstddef>
 
@@ -31,6 +34,8 @@ class LinuxMemory
 {
 public:
     static bool reserve(size_t size, uint32_t node, size_t hugePageSize);
+    static size_t reserveNode(uint32_t node, size_t size, size_t executableSize, size_t hugePageSize);
+    static NumaPagesInfo numaPages(const void *p, size_t size, size_t pageSize, uint32_t node, bool migrate, bool populate);
 
     static bool write(const char *path, uint64_t value);
     static int64_t read(const char *path);
@@ -0,0 +1,304 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/common/MemoryPlanner.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/Cpu.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
+#include "core/config/Config.h"
+#include "crypto/common/MemoryPool.h"
+#include "crypto/common/VirtualMemory.h"
+
+
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/common/LinuxMemory.h"
+#endif
+
+
+#ifdef XMRIG_ALGO_RANDOMX
+#   include "crypto/rx/RxCache.h"
+#   include "crypto/rx/RxDataset.h"
+#   include <uv.h>
+#endif
+
+
+#include <algorithm>
+#include <cinttypes>
+#include <map>
+#include <mutex>
+#include <vector>
+
+
+namespace xmrig {
+
+
+constexpr size_t oneMiB = 1024 * 1024;
+static const char *kEvents[] = { "plan", "reserve", "arenas", "dataset", "threads" };
+
+
+struct MemoryPlanNode
+{
+    inline size_t size() const { return dataset + cache + scratchpads + (pool ? MemoryPool::kAlignment : 0); }
+
+    size_t cache        = 0;
+    size_t dataset      = 0;
+    size_t jit          = 0;
+    size_t pool         = 0;    // scratchpad pool in 2 MB pages, 0 if scratchpads are allocated by threads
+    size_t reserved     = 0;    // huge pages
+    size_t scratchpads  = 0;
+};
+
+
+static bool dataset     = false;
+static bool initialized = false;
+static bool printed     = false;
+static int64_t events[MemoryPlanner::EVENT_MAX];
+static std::map<uint32_t, MemoryPlanNode> nodes;
+static std::mutex mutex;
+static uint64_t startTs = 0;
+
+
+static void printPlan(bool reserved)
+{
+    char pages[64] = {};
+
+    for (const auto &kv : nodes) {
+        const auto &node    = kv.second;
+        const size_t size   = node.size() + node.jit;
+
+        if (!size) {
+            continue;
+        }
+
+        if (reserved) {
+            const size_t required = VirtualMemory::align(size, VirtualMemory::hugePageSize()) / VirtualMemory::hugePageSize();
+
+            snprintf(pages, sizeof(pages), " huge pages %s%zu/%zu" CLEAR "%s",
+                     node.reserved >= required ? GREEN_BOLD_S : (node.reserved == 0 ? RED_BOLD_S : YELLOW_BOLD_S), node.reserved, required, node.pool ? " pool" : "");
+        }
+
+        LOG_INFO("%s" CYAN_BOLD(" #%u") " memory plan" CYAN_BOLD(" %zu MB") BLACK_BOLD(" (dataset %zu, cache %zu, JIT %zu, scratchpads %zu MB)") "%s",
+                 Tags::cpu(),
+                 kv.first,
+                 size / oneMiB,
+                 node.dataset / oneMiB,
+                 node.cache / oneMiB,
+                 node.jit / oneMiB,
+                 node.scratchpads / oneMiB,
+                 pages
+                 );
+    }
+}
+
+
+static void printTimeline()
+{
+    std::vector<size_t> order;
+    for (size_t i = 0; i < MemoryPlanner::EVENT_MAX; ++i) {
+        if (events[i] >= 0) {
+            order.emplace_back(i);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [](size_t a, size_t b) { return events[a] < events[b]; });
+
+    char buf[256] = {};
+    int size      = 0;
+
+    for (size_t i : order) {
+        if (size < 0 || static_cast<size_t>(size) >= sizeof(buf)) {
+            break;
+        }
+
+        size += snprintf(buf + size, sizeof(buf) - size, " %s " CYAN_BOLD("%" PRId64), kEvents[i], events[i]);
+    }
+
+    LOG_INFO("%s" GREEN_BOLD(" startup") " timeline%s ms", Tags::cpu(), buf);
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::MemoryPlanner::isInitialized()
+{
+    return initialized;
+}
+
+
+rapidjson::Value xmrig::MemoryPlanner::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!initialized) {
+        return Value(kNullType);
+    }
+
+    auto &allocator = doc.GetAllocator();
+
+    Value list(kArrayType);
+    for (const auto &kv : nodes) {
+        Value node(kObjectType);
+        node.AddMember("node",          kv.first, allocator);
+        node.AddMember("dataset",       static_cast<uint64_t>(kv.second.dataset), allocator);
+        node.AddMember("cache",         static_cast<uint64_t>(kv.second.cache), allocator);
+        node.AddMember("jit",           static_cast<uint64_t>(kv.second.jit), allocator);
+        node.AddMember("scratchpads",   static_cast<uint64_t>(kv.second.scratchpads), allocator);
+        node.AddMember("pool",          static_cast<uint64_t>(kv.second.pool * VirtualMemory::kDefaultHugePageSize), allocator);
+        node.AddMember("huge-pages",    static_cast<uint64_t>(kv.second.reserved), allocator);
+
+        list.PushBack(node, allocator);
+    }
+
+    Value timeline(kObjectType);
+    for (size_t i = 0; i < EVENT_MAX; ++i) {
+        if (events[i] >= 0) {
+            timeline.AddMember(StringRef(kEvents[i]), events[i], allocator);
+        }
+    }
+
+    Value out(kObjectType);
+    out.AddMember("nodes",      list, allocator);
+    out.AddMember("timeline",   timeline, allocator);
+
+    return out;
+}
+
+
+void xmrig::MemoryPlanner::init(const Config &config, const Algorithm &algorithm)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    initialized = true;
+    startTs     = Chrono::steadyMSecs();
+
+    std::fill(std::begin(events), std::end(events), -1);
+
+    const auto &cpu             = config.cpu();
+    const size_t hugePageSize   = VirtualMemory::hugePageSize();
+    const uint32_t minIntensity = algorithm.minIntensity();
+    const uint32_t maxIntensity = algorithm.maxIntensity();
+
+    // Memory of a configured pool is allocated at startup, scratchpads are its slices.
+    bool scratchpads = algorithm.family() != Algorithm::KAWPOW && cpu.memPoolSize() == 0;
+
+#   ifdef XMRIG_ALGO_CN_HEAVY
+    // Zen3 CPUs share cn-heavy memory between threads, it doesn't use the pool.
+    if (algorithm.family() == Algorithm::CN_HEAVY && Cpu::info()->arch() == ICpuInfo::ARCH_ZEN3 && Cpu::info()->model() == 0x21) {
+        scratchpads = false;
+    }
+#   endif
+
+    const bool jit = cpu.isHugePagesJit() && algorithm.family() == Algorithm::RANDOM_X;
+
+    for (const auto &thread : cpu.threads().get(algorithm).data()) {
+        auto &node = nodes[VirtualMemory::nodeOf(thread.affinity())];
+
+        if (scratchpads) {
+            node.scratchpads += VirtualMemory::align(algorithm.l3() * std::max(std::min(thread.intensity(), maxIntensity), minIntensity), hugePageSize);
+        }
+
+        if (jit) {
+            node.jit += hugePageSize;
+        }
+    }
+
+#   ifdef XMRIG_ALGO_RANDOMX
+    const auto &rx = config.rx();
+
+    // Datasets in 1GB pages keep the cache in the same memory and size of the hybrid mode dataset is known only to the dataset itself.
+    if (algorithm.family() == Algorithm::RANDOM_X && !rx.isOneGbPages()) {
+        auto nodeset = rx.nodeset();
+        if (nodeset.empty()) {
+            nodeset.emplace_back(0);
+        }
+
+        if (rx.mode() == RxConfig::FastMode || (rx.mode() == RxConfig::AutoMode && uv_get_total_memory() >= (RxDataset::maxSize() + RxCache::maxSize()))) {
+            for (uint32_t id : nodeset) {
+                nodes[id].dataset = RxDataset::maxSize();
+            }
+        }
+
+        auto &node  = nodes[nodeset.front()];
+        node.cache  = RxCache::maxSize();
+        node.jit   += jit ? hugePageSize : 0;
+    }
+
+    dataset = algorithm.family() == Algorithm::RANDOM_X;
+#   endif
+
+    events[PLAN] = static_cast<int64_t>(Chrono::steadyMSecs() - startTs);
+
+    if (!cpu.isHugePages()) {
+        return printPlan(false);
+    }
+
+    // The pool hands out slices in 2 MB pages.
+    std::map<uint32_t, size_t> pools;
+    if (hugePageSize == VirtualMemory::kDefaultHugePageSize) {
+        for (auto &kv : nodes) {
+            kv.second.pool = kv.second.scratchpads / VirtualMemory::kDefaultHugePageSize;
+
+            if (kv.second.pool) {
+                pools.insert({ kv.first, kv.second.pool });
+            }
+        }
+    }
+
+#   ifdef XMRIG_OS_LINUX
+    for (auto &kv : nodes) {
+        kv.second.reserved = LinuxMemory::reserveNode(kv.first, kv.second.size(), kv.second.jit, hugePageSize);
+    }
+
+    events[RESERVE] = static_cast<int64_t>(Chrono::steadyMSecs() - startTs);
+
+    constexpr bool reserved = true;
+#   else
+    constexpr bool reserved = false;
+#   endif
+
+    if (!pools.empty()) {
+        VirtualMemory::initPool(pools, true);
+
+        events[ARENAS] = static_cast<int64_t>(Chrono::steadyMSecs() - startTs);
+    }
+
+    printPlan(reserved);
+}
+
+
+void xmrig::MemoryPlanner::mark(Event event)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!initialized || events[event] >= 0) {
+        return;
+    }
+
+    events[event] = static_cast<int64_t>(Chrono::steadyMSecs() - startTs);
+
+    if (!printed && events[THREADS] >= 0 && (!dataset || events[DATASET] >= 0)) {
+        printed = true;
+
+        printTimeline();
+    }
+}
@@ -0,0 +1,65 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_MEMORYPLANNER_H
+#define XMRIG_MEMORYPLANNER_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+class Algorithm;
+class Config;
+
+
+/**
+ * Startup memory plan of the first job.
+ *
+ * Huge pages needed by RandomX datasets, cache, JIT code and scratchpads of all CPU threads are summed per NUMA node
+ * before anything is allocated and reserved with one sysfs write per node. If the memory pool is not configured,
+ * scratchpads are slices of one pool per node, pools of all nodes are allocated and populated in parallel.
+ */
+class MemoryPlanner
+{
+public:
+    enum Event : uint32_t {
+        PLAN,
+        RESERVE,
+        ARENAS,
+        DATASET,
+        THREADS,
+        EVENT_MAX
+    };
+
+    static bool isInitialized();
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static void init(const Config &config, const Algorithm &algorithm);
+    static void mark(Event event);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_MEMORYPLANNER_H */
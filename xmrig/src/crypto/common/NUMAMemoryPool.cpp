@@ -32,6 +32,9 @@
 
 
 #include <algorithm>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 
 xmrig::NUMAMemoryPool::NUMAMemoryPool(size_t size, bool hugePages) :
@@ -42,6 +45,33 @@ xmrig::NUMAMemoryPool::NUMAMemoryPool(size_t size, bool hugePages) :
 }
 
 
+// Pools of all nodes are allocated at once, each one by a thread bound to its node, so pages are local and populated in parallel.
+xmrig::NUMAMemoryPool::NUMAMemoryPool(const std::map<uint32_t, size_t> &nodes, bool hugePages) :
+    m_hugePages(hugePages)
+{
+    std::mutex mutex;
+    std::vector<std::thread> threads;
+    threads.reserve(nodes.size());
+
+    for (const auto &kv : nodes) {
+        m_size += kv.second;
+
+        threads.emplace_back([this, &mutex](uint32_t node, size_t size) {
+            VirtualMemory::bindToNode(node);
+
+            auto pool = new MemoryPool(size, m_hugePages, node);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            m_map.insert({ node, pool });
+        }, kv.first, kv.second);
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+
 xmrig::NUMAMemoryPool::~NUMAMemoryPool()
 {
     for (auto kv : m_map) {
@@ -47,6 +47,7 @@ public:
     XMRIG_DISABLE_COPY_MOVE_DEFAULT(NUMAMemoryPool)
 
     NUMAMemoryPool(size_t size, bool hugePages);
+    NUMAMemoryPool(const std::map<uint32_t, size_t> &nodes, bool hugePages);
     ~NUMAMemoryPool() override;
 
 protected:
@@ -20,37 +20,47 @@
 #include "crypto/common/Nonce.h"
 
 
+#include <cstdint>
+
+
 namespace xmrig {
 
-std::atomic<bool> Nonce::m_paused = {true};
-std::atomic<uint64_t>  Nonce::m_sequence[Nonce::MAX] = { {1}, {1}, {1} };
-std::atomic<uint64_t> Nonce::m_nonces[2] = { {0}, {0} };
+Nonce::Group Nonce::m_groups[Nonce::kMaxGroups];
+
+
+Nonce::Group::Group() :
+    paused(true),
+    active{ {SIZE_MAX}, {SIZE_MAX}, {SIZE_MAX} },
+    sequence{ {1}, {1}, {1} },
+    nonces{ {0}, {0} }
+{
+}
 
 
 } // namespace xmrig
 
 
-bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask)
+bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask, uint32_t group)
 {
     mask &= 0x7FFFFFFFFFFFFFFFULL;
     if (reserveCount == 0 || mask < reserveCount - 1) {
         return false;
     }
 
-    uint64_t counter = m_nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
+    uint64_t counter = m_groups[group].nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
     while (true) {
         if (mask < counter) {
             return false;
         }
 
         if (mask - counter <= reserveCount - 1) {
-            pause(true);
+            pause(true, group);
             if (mask - counter < reserveCount - 1) {
                 return false;
             }
         }
         else if (0xFFFFFFFFUL - (uint32_t)counter < reserveCount - 1) {
-            counter = m_nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
+            counter = m_groups[group].nonces[index].fetch_add(reserveCount, std::memory_order_relaxed);
             continue;
         }
 
@@ -65,19 +75,31 @@ bool xmrig::Nonce::next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, u
 }
 
 
+void xmrig::Nonce::pause(bool paused)
+{
+    for (auto &group : m_groups) {
+        group.paused = paused;
+    }
+}
+
+
 void xmrig::Nonce::stop()
 {
     pause(false);
 
-    for (auto &i : m_sequence) {
-        i = 0;
+    for (auto &group : m_groups) {
+        for (auto &i : group.sequence) {
+            i = 0;
+        }
     }
 }
 
 
 void xmrig::Nonce::touch()
 {
-    for (auto &i : m_sequence) {
-        i++;
+    for (auto &group : m_groups) {
+        for (auto &i : group.sequence) {
+            i++;
+        }
     }
 }
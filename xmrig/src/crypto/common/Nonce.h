@@ -21,6 +21,8 @@
 
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 
 
 namespace xmrig {
@@ -37,22 +39,38 @@ public:
     };
 
 
-    static inline bool isOutdated(Backend backend, uint64_t sequence)   { return m_sequence[backend].load(std::memory_order_relaxed) != sequence; }
-    static inline bool isPaused()                                       { return m_paused.load(std::memory_order_relaxed); }
-    static inline uint64_t sequence(Backend backend)                    { return m_sequence[backend].load(std::memory_order_relaxed); }
-    static inline void pause(bool paused)                               { m_paused = paused; }
-    static inline void reset(uint8_t index)                             { m_nonces[index] = 0; }
-    static inline void stop(Backend backend)                            { m_sequence[backend] = 0; }
-    static inline void touch(Backend backend)                           { m_sequence[backend]++; }
+    // Threads can be split into independent groups, each group mines its own job (see Miner::setJob) and
+    // has its own nonce space and sequence, group 0 is the only group used by the GPU backends.
+    static constexpr uint32_t kMaxGroups = 4;
 
-    static bool next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask);
+    static inline bool isOutdated(Backend backend, uint64_t sequence, uint32_t group = 0)   { return m_groups[group].sequence[backend].load(std::memory_order_relaxed) != sequence; }
+    static inline bool isParked(Backend backend, size_t id, uint32_t group = 0)             { return id >= m_groups[group].active[backend].load(std::memory_order_relaxed); }
+    static inline bool isPaused(uint32_t group = 0)                                         { return m_groups[group].paused.load(std::memory_order_relaxed); }
+    static inline uint64_t sequence(Backend backend, uint32_t group = 0)                    { return m_groups[group].sequence[backend].load(std::memory_order_relaxed); }
+    static inline void park(Backend backend, size_t active, uint32_t group = 0)             { m_groups[group].active[backend] = active; }
+    static inline void pause(bool paused, uint32_t group)                                   { m_groups[group].paused = paused; }
+    static inline void reset(uint8_t index, uint32_t group = 0)                             { m_groups[group].nonces[index] = 0; }
+    static inline void stop(Backend backend, uint32_t group = 0)                            { m_groups[group].sequence[backend] = 0; }
+    static inline void touch(Backend backend, uint32_t group = 0)                           { m_groups[group].sequence[backend]++; }
+
+    static bool next(uint8_t index, uint32_t *nonce, uint32_t reserveCount, uint64_t mask, uint32_t group = 0);
+    static void pause(bool paused);
     static void stop();
     static void touch();
 
 private:
-    static std::atomic<bool> m_paused;
-    static std::atomic<uint64_t> m_sequence[MAX];
-    static std::atomic<uint64_t> m_nonces[2];
+    // The nonce counters are bumped by every thread of the group, keep them off the cache line polled by the hot loop.
+    struct alignas(64) Group
+    {
+        Group();
+
+        std::atomic<bool> paused;
+        std::atomic<size_t> active[MAX];    // threads with id >= active are parked
+        std::atomic<uint64_t> sequence[MAX];
+        alignas(64) std::atomic<uint64_t> nonces[2];
+    };
+
+    static Group m_groups[kMaxGroups];
 };
 
 
@@ -0,0 +1,40 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/common/NumaPagesInfo.h"
+#include "3rdparty/rapidjson/document.h"
+
+
+rapidjson::Value xmrig::NumaPagesInfo::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    if (!isValid()) {
+        return Value(kNullType);
+    }
+
+    Value obj(kObjectType);
+    obj.AddMember("node",       node, allocator);
+    obj.AddMember("local",      static_cast<uint64_t>(local), allocator);
+    obj.AddMember("total",      static_cast<uint64_t>(total), allocator);
+    obj.AddMember("migrated",   static_cast<uint64_t>(migrated), allocator);
+    obj.AddMember("percent",    percent(), allocator);
+
+    return obj;
+}
@@ -0,0 +1,72 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_NUMAPAGESINFO_H
+#define XMRIG_NUMAPAGESINFO_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <cstdint>
+#include <cstddef>
+
+
+namespace xmrig {
+
+
+// Placement of the resident pages of a memory block relative to the NUMA node it belongs to.
+class NumaPagesInfo
+{
+public:
+    enum Mode : uint32_t {
+        MODE_OFF,
+        MODE_REPORT,
+        MODE_MIGRATE
+    };
+
+    NumaPagesInfo() = default;
+    inline NumaPagesInfo(uint32_t node) : node(node) {}
+
+    size_t local        = 0;
+    size_t migrated     = 0;
+    size_t total        = 0;    // pages present in memory, never touched pages have no placement yet
+    uint32_t node       = 0;
+
+    inline bool isValid() const          { return total > 0; }
+    inline bool isFullyLocal() const     { return local == total; }
+    inline double percent() const        { return total == 0 ? 0.0 : static_cast<double>(local) / total * 100.0; }
+    inline void reset()                  { local = 0; migrated = 0; total = 0; }
+
+    inline NumaPagesInfo &operator+=(const NumaPagesInfo &other)
+    {
+        local    += other.local;
+        migrated += other.migrated;
+        total    += other.total;
+
+        return *this;
+    }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_NUMAPAGESINFO_H */
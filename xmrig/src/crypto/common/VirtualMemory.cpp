@@ -30,6 +30,11 @@
 #endif
 
 
+#ifdef XMRIG_OS_LINUX
+#   include "crypto/common/LinuxMemory.h"
+#endif
+
+
 #include <cinttypes>
 #include <mutex>
 
@@ -103,17 +108,42 @@ xmrig::HugePagesInfo xmrig::VirtualMemory::hugePages() const
 }
 
 
+xmrig::NumaPagesInfo xmrig::VirtualMemory::numaPages(uint32_t node, bool migrate, bool populate) const
+{
+#   ifdef XMRIG_OS_LINUX
+    const size_t pageSize = isOneGbPages() ? kOneGiB : (isHugePages() ? hugePageSize() : 0);
+
+    return LinuxMemory::numaPages(m_scratchpad, m_size, pageSize, node, migrate, populate);
+#   else
+    return { node };
+#   endif
+}
+
+
 #ifndef XMRIG_FEATURE_HWLOC
+bool xmrig::VirtualMemory::bindToNode(uint32_t)
+{
+    return false;
+}
+
+
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t)
 {
     return 0;
 }
+
+
+uint32_t xmrig::VirtualMemory::nodeOf(int64_t)
+{
+    return 0;
+}
 #endif
 
 
 void xmrig::VirtualMemory::destroy()
 {
     delete pool;
+    pool = nullptr;
 }
 
 
@@ -132,3 +162,24 @@ void xmrig::VirtualMemory::init(size_t poolSize, size_t hugePageSize)
         pool = new MemoryPool(poolSize, hugePageSize > 0);
     }
 }
+
+
+// Replaces the pool with one sized by the memory planner, pool size of each node is in 2 MB pages.
+void xmrig::VirtualMemory::initPool(const std::map<uint32_t, size_t> &nodes, bool hugePages)
+{
+    IMemoryPool *planned = nullptr;
+
+#   ifdef XMRIG_FEATURE_HWLOC
+    if (Cpu::info()->nodes() > 1) {
+        planned = new NUMAMemoryPool(nodes, hugePages);
+    } else
+#   endif
+    {
+        planned = new MemoryPool(nodes.empty() ? 0 : nodes.begin()->second, hugePages, nodes.empty() ? 0 : nodes.begin()->first);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    delete pool;
+    pool = planned;
+}
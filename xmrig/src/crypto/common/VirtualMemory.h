@@ -23,11 +23,13 @@
 
 #include "base/tools/Object.h"
 #include "crypto/common/HugePagesInfo.h"
+#include "crypto/common/NumaPagesInfo.h"
 
 
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
+#include <map>
 #include <utility>
 
 
@@ -55,13 +57,16 @@ public:
     inline static void flushInstructionCache(void *p1, void *p2)    { flushInstructionCache(p1, static_cast<uint8_t*>(p2) - static_cast<uint8_t*>(p1)); }
 
     HugePagesInfo hugePages() const;
+    NumaPagesInfo numaPages(uint32_t node, bool migrate, bool populate = false) const;
 
     static bool isHugepagesAvailable();
     static bool isOneGbPagesAvailable();
     static bool protectRW(void *p, size_t size);
     static bool protectRWX(void *p, size_t size);
     static bool protectRX(void *p, size_t size);
+    static bool bindToNode(uint32_t nodeId);
     static uint32_t bindToNUMANode(int64_t affinity);
+    static uint32_t nodeOf(int64_t affinity);
     static void *allocateExecutableMemory(size_t size, bool hugePages);
     static void *allocateLargePagesMemory(size_t size);
     static void *allocateOneGbPagesMemory(size_t size);
@@ -69,6 +74,7 @@ public:
     static void flushInstructionCache(void *p, size_t size);
     static void freeLargePagesMemory(void *p, size_t size);
     static void init(size_t poolSize, size_t hugePageSize);
+    static void initPool(const std::map<uint32_t, size_t> &nodes, bool hugePages);
 
     static inline constexpr size_t align(size_t pos, size_t align = kDefaultHugePageSize)   { return ((pos - 1) / align + 1) * align; }
     static inline size_t alignToHugePageSize(size_t pos)                                    { return align(pos, hugePageSize()); }
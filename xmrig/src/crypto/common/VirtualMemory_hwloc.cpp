@@ -23,18 +23,45 @@
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/platform/HwlocCpuInfo.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/Platform.h"
 
 
 #include <hwloc.h>
 
 
+bool xmrig::VirtualMemory::bindToNode(uint32_t nodeId)
+{
+    auto cpu         = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_obj_t node = hwloc_get_numanode_obj_by_os_index(cpu->topology(), nodeId);
+    if (!node) {
+        return false;
+    }
+
+    if (cpu->membind(node->nodeset)) {
+        Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(node->cpuset)));
+
+        return true;
+    }
+
+    return false;
+}
+
+
 uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t affinity)
 {
-    if (affinity < 0 || Cpu::info()->nodes() < 2) {
+    if (Cpu::info()->nodes() < 2) {
+        return 0;
+    }
+
+    auto cpu = static_cast<HwlocCpuInfo *>(Cpu::info());
+
+    // Memory of a thread without affinity is not bound, the thread may come from a worker pinned to another node.
+    if (affinity < 0) {
+        cpu->unbind();
+
         return 0;
     }
 
-    auto cpu       = static_cast<HwlocCpuInfo *>(Cpu::info());
     hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(cpu->topology(), static_cast<unsigned>(affinity));
 
     if (pu == nullptr || !cpu->membind(pu->nodeset)) {
@@ -45,3 +72,16 @@ uint32_t xmrig::VirtualMemory::bindToNUMANode(int64_t affinity)
 
     return hwloc_bitmap_first(pu->nodeset);
 }
+
+
+uint32_t xmrig::VirtualMemory::nodeOf(int64_t affinity)
+{
+    if (affinity < 0 || Cpu::info()->nodes() < 2) {
+        return 0;
+    }
+
+    auto cpu       = static_cast<HwlocCpuInfo *>(Cpu::info());
+    hwloc_obj_t pu = hwloc_get_pu_obj_by_os_index(cpu->topology(), static_cast<unsigned>(affinity));
+
+    return pu ? hwloc_bitmap_first(pu->nodeset) : 0;
+}
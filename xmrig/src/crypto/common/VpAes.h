@@ -0,0 +1,161 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_VPAES_H
+#define XMRIG_VPAES_H
+
+
+#ifdef __GNUC__
+#   include <x86intrin.h>
+#else
+#   include <intrin.h>
+#endif
+
+#include <cstdint>
+
+
+/**
+ * Single AES round with the same result as AESENC/AESDEC, built from SSSE3 byte shuffles without any memory lookups
+ * indexed by data. Translation units including this file must be compiled with SSSE3 enabled.
+ *
+ * Bytes are mapped to GF((2^4)^2) with the tower polynomial t^2 + 2t + 2, where the inverse of i*t + k needs only
+ * GF(2^4) inverses: with j = k + 2i, io = 1/(1/i + 2/k) + i + k and jo = 1/(1/i + 2/j) + i + j the inverse is
+ * (1/io + 1/jo)/2 * t + 1/io. Each GF(2^4) operation is a 16 entry pshufb table, zero is mapped to 0x80 so pshufb
+ * returns zero for it. Output tables combine the mapping back to the AES basis with the S-box affine transform and
+ * the (Inv)MixColumns multipliers.
+ */
+
+
+namespace xmrig {
+
+
+enum VpAesTable {
+    kInv,
+    kInv2,
+    kMul2,
+    kShiftRows,
+    kInvShiftRows,
+    kRotate1,
+    kRotate3,
+    kEncInLo,
+    kEncInHi,
+    kEncOut1Io,
+    kEncOut1Jo,
+    kEncOut2Io,
+    kEncOut2Jo,
+    kDecInLo,
+    kDecInHi,
+    kDecOut9Io,
+    kDecOut9Jo,
+    kDecOut11Io,
+    kDecOut11Jo,
+    kDecOut13Io,
+    kDecOut13Jo,
+    kDecOut14Io,
+    kDecOut14Jo
+};
+
+
+alignas(16) static const uint8_t vpaes_tables[][16] = {
+    { 0x80, 0x01, 0x09, 0x0E, 0x0D, 0x0B, 0x07, 0x06, 0x0F, 0x02, 0x0C, 0x05, 0x0A, 0x04, 0x03, 0x08 },
+    { 0x80, 0x02, 0x01, 0x0F, 0x09, 0x05, 0x0E, 0x0C, 0x0D, 0x04, 0x0B, 0x0A, 0x07, 0x08, 0x06, 0x03 },
+    { 0x00, 0x02, 0x04, 0x06, 0x08, 0x0A, 0x0C, 0x0E, 0x03, 0x01, 0x07, 0x05, 0x0B, 0x09, 0x0F, 0x0D },
+    { 0x00, 0x05, 0x0A, 0x0F, 0x04, 0x09, 0x0E, 0x03, 0x08, 0x0D, 0x02, 0x07, 0x0C, 0x01, 0x06, 0x0B },
+    { 0x00, 0x0D, 0x0A, 0x07, 0x04, 0x01, 0x0E, 0x0B, 0x08, 0x05, 0x02, 0x0F, 0x0C, 0x09, 0x06, 0x03 },
+    { 0x01, 0x02, 0x03, 0x00, 0x05, 0x06, 0x07, 0x04, 0x09, 0x0A, 0x0B, 0x08, 0x0D, 0x0E, 0x0F, 0x0C },
+    { 0x03, 0x00, 0x01, 0x02, 0x07, 0x04, 0x05, 0x06, 0x0B, 0x08, 0x09, 0x0A, 0x0F, 0x0C, 0x0D, 0x0E },
+    { 0x00, 0x01, 0x1C, 0x1D, 0x2D, 0x2C, 0x31, 0x30, 0x27, 0x26, 0x3B, 0x3A, 0x0A, 0x0B, 0x16, 0x17 },
+    { 0x00, 0x86, 0xFD, 0x7B, 0x8E, 0x08, 0x73, 0xF5, 0x77, 0xF1, 0x8A, 0x0C, 0xF9, 0x7F, 0x04, 0x82 },
+    { 0x00, 0x54, 0xB6, 0xA6, 0xE3, 0xA7, 0x10, 0x44, 0xF2, 0x11, 0xB7, 0x01, 0xF3, 0x55, 0x45, 0xE2 },
+    { 0x00, 0x4B, 0x9F, 0x89, 0x61, 0x3C, 0x16, 0x5D, 0xC2, 0xA3, 0x2A, 0xB5, 0x77, 0xFE, 0xE8, 0xD4 },
+    { 0x00, 0xA8, 0x77, 0x57, 0xDD, 0x55, 0x20, 0x88, 0xFF, 0x22, 0x75, 0x02, 0xFD, 0xAA, 0x8A, 0xDF },
+    { 0x00, 0x96, 0x25, 0x09, 0xC2, 0x78, 0x2C, 0xBA, 0x9F, 0x5D, 0x54, 0x71, 0xEE, 0xE7, 0xCB, 0xB3 },
+    { 0x2C, 0x99, 0xF0, 0x45, 0xF7, 0x42, 0x2B, 0x9E, 0x38, 0x8D, 0xE4, 0x51, 0xE3, 0x56, 0x3F, 0x8A },
+    { 0x00, 0xA7, 0xA8, 0x0F, 0xED, 0x4A, 0x45, 0xE2, 0xD1, 0x76, 0x79, 0xDE, 0x3C, 0x9B, 0x94, 0x33 },
+    { 0x00, 0xE7, 0xF0, 0x03, 0x3B, 0x2F, 0xF3, 0x14, 0xE4, 0xDF, 0xDC, 0x2C, 0xC8, 0xCB, 0x38, 0x17 },
+    { 0x00, 0xEE, 0x1F, 0xCE, 0x75, 0x4A, 0xD1, 0x3F, 0x20, 0x55, 0x9B, 0x84, 0xA4, 0x6A, 0xBB, 0xF1 },
+    { 0x00, 0xD9, 0x1A, 0xBA, 0x7B, 0x02, 0xA0, 0x79, 0x63, 0x18, 0xA2, 0xB8, 0xDB, 0x61, 0xC1, 0xC3 },
+    { 0x00, 0xD2, 0x57, 0xB4, 0x4C, 0x7D, 0xE3, 0x31, 0x66, 0x2A, 0x9E, 0xC9, 0xAF, 0x1B, 0xF8, 0x85 },
+    { 0x00, 0x9B, 0x3F, 0x6A, 0xBB, 0x75, 0x55, 0xCE, 0xF1, 0x4A, 0x20, 0x1F, 0xEE, 0x84, 0xD1, 0xA4 },
+    { 0x00, 0x96, 0x8F, 0x3A, 0x07, 0x24, 0xB5, 0x23, 0xAC, 0xAB, 0x91, 0x1E, 0xB2, 0x88, 0x3D, 0x19 },
+    { 0x00, 0xBA, 0xA0, 0x02, 0xDB, 0xC3, 0xA2, 0x18, 0xB8, 0x63, 0x61, 0xC1, 0x79, 0x7B, 0xD9, 0x1A },
+    { 0x00, 0xB4, 0xE3, 0x7D, 0xAF, 0x85, 0x9E, 0x2A, 0xC9, 0x66, 0x1B, 0xF8, 0x31, 0x4C, 0xD2, 0x57 }
+};
+
+
+static inline __m128i vpaes_table(VpAesTable id)                { return _mm_load_si128(reinterpret_cast<const __m128i *>(vpaes_tables[id])); }
+static inline __m128i vpaes_lookup(VpAesTable id, __m128i index) { return _mm_shuffle_epi8(vpaes_table(id), index); }
+
+
+static inline void vpaes_inverse(__m128i x, VpAesTable lo, VpAesTable hi, __m128i &io, __m128i &jo)
+{
+    const __m128i mask = _mm_set1_epi8(0x0F);
+
+    x = _mm_xor_si128(vpaes_lookup(lo, _mm_and_si128(x, mask)), vpaes_lookup(hi, _mm_and_si128(_mm_srli_epi16(x, 4), mask)));
+
+    const __m128i i  = _mm_and_si128(_mm_srli_epi16(x, 4), mask);
+    const __m128i k  = _mm_and_si128(x, mask);
+    const __m128i j  = _mm_xor_si128(k, vpaes_lookup(kMul2, i));
+    const __m128i ii = vpaes_lookup(kInv, i);
+
+    io = _mm_xor_si128(vpaes_lookup(kInv, _mm_xor_si128(ii, vpaes_lookup(kInv2, k))), _mm_xor_si128(i, k));
+    jo = _mm_xor_si128(vpaes_lookup(kInv, _mm_xor_si128(ii, vpaes_lookup(kInv2, j))), _mm_xor_si128(i, j));
+}
+
+
+static inline __m128i vpaes_output(__m128i io, __m128i jo, VpAesTable p)
+{
+    return _mm_xor_si128(vpaes_lookup(p, io), vpaes_lookup(static_cast<VpAesTable>(p + 1), jo));
+}
+
+
+static inline __m128i vpaes_enc(__m128i x, __m128i key)
+{
+    __m128i io, jo;
+    vpaes_inverse(_mm_shuffle_epi8(x, vpaes_table(kShiftRows)), kEncInLo, kEncInHi, io, jo);
+
+    // S-box output without the 0x63 constant, MixColumns keeps that constant as is.
+    const __m128i a  = vpaes_output(io, jo, kEncOut1Io);
+    const __m128i t  = _mm_xor_si128(vpaes_output(io, jo, kEncOut2Io), _mm_shuffle_epi8(a, vpaes_table(kRotate1)));
+    const __m128i u  = _mm_xor_si128(t, _mm_shuffle_epi8(a, vpaes_table(kRotate3)));
+
+    return _mm_xor_si128(_mm_xor_si128(_mm_shuffle_epi8(t, vpaes_table(kRotate1)), u), _mm_xor_si128(key, _mm_set1_epi8(0x63)));
+}
+
+
+static inline __m128i vpaes_dec(__m128i x, __m128i key)
+{
+    const __m128i rotate = vpaes_table(kRotate1);
+
+    __m128i io, jo;
+    vpaes_inverse(_mm_shuffle_epi8(x, vpaes_table(kInvShiftRows)), kDecInLo, kDecInHi, io, jo);
+
+    // InvMixColumns 14*a0 + 11*a1 + 13*a2 + 9*a3 in Horner form.
+    __m128i r = vpaes_output(io, jo, kDecOut9Io);
+    r = _mm_xor_si128(_mm_shuffle_epi8(r, rotate), vpaes_output(io, jo, kDecOut13Io));
+    r = _mm_xor_si128(_mm_shuffle_epi8(r, rotate), vpaes_output(io, jo, kDecOut11Io));
+    r = _mm_xor_si128(_mm_shuffle_epi8(r, rotate), vpaes_output(io, jo, kDecOut14Io));
+
+    return _mm_xor_si128(r, key);
+}
+
+
+} // namespace xmrig
+
+
+#endif /* XMRIG_VPAES_H */
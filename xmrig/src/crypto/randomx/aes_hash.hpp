@@ -30,16 +30,44 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cstddef>
 
+#include "crypto/common/SoftAes.h"
+
+struct RandomX_ConfigurationBase;
+
+typedef void (hashAes1Rx4_impl)(const void *input, size_t inputSize, void *hash);
+typedef void (fillAes1Rx4_impl)(void *state, size_t outputSize, void *buffer);
+typedef void (fillAes4Rx4_impl)(void *state, size_t outputSize, void *buffer, const RandomX_ConfigurationBase &config);
 typedef void (hashAndFillAes1Rx4_impl)(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state);
 
+extern hashAes1Rx4_impl* softAESHashImpl;
+extern fillAes1Rx4_impl* softAESFill1Impl;
+extern fillAes4Rx4_impl* softAESFill4Impl;
 extern hashAndFillAes1Rx4_impl* softAESImpl;
 
+inline hashAes1Rx4_impl* GetSoftAESHashImpl()
+{
+  return softAESHashImpl;
+}
+
+inline fillAes1Rx4_impl* GetSoftAESFill1Impl()
+{
+  return softAESFill1Impl;
+}
+
+inline fillAes4Rx4_impl* GetSoftAESFill4Impl()
+{
+  return softAESFill4Impl;
+}
+
 inline hashAndFillAes1Rx4_impl* GetSoftAESImpl()
 {
   return softAESImpl;
 }
 
-void SelectSoftAESImpl(size_t threadsCount);
+// Benchmarks table based and (if supported) vector permute soft AES variants and selects the fastest one,
+// impl restricts the choice to one implementation.
+void SelectSoftAESImpl(size_t threadsCount, xmrig::SoftAesImpl impl = xmrig::SOFT_AES_AUTO);
+bool IsSoftAESVectorPermute();
 
 template<int softAes>
 void hashAes1Rx4(const void *input, size_t inputSize, void *hash);
@@ -48,7 +76,7 @@ template<int softAes>
 void fillAes1Rx4(void *state, size_t outputSize, void *buffer);
 
 template<int softAes>
-void fillAes4Rx4(void *state, size_t outputSize, void *buffer);
+void fillAes4Rx4(void *state, size_t outputSize, void *buffer, const RandomX_ConfigurationBase &config);
 
 template<int softAes, int unroll>
 void hashAndFillAes1Rx4(void *scratchpad, size_t scratchpadSize, void *hash, void* fill_state);
@@ -0,0 +1,44 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/randomx/aes_hash.hpp"
+#include "crypto/randomx/soft_aes.h"
+#include "crypto/common/VpAes.h"
+
+
+// Soft AES variant 3: vector permute AES, this file is compiled with SSSE3 enabled.
+template<>
+FORCE_INLINE rx_vec_i128 aesenc<3>(rx_vec_i128 in, rx_vec_i128 key) {
+	return xmrig::vpaes_enc(in, key);
+}
+
+template<>
+FORCE_INLINE rx_vec_i128 aesdec<3>(rx_vec_i128 in, rx_vec_i128 key) {
+	return xmrig::vpaes_dec(in, key);
+}
+
+
+#include "crypto/randomx/aes_hash_impl.hpp"
+
+
+template void hashAes1Rx4<3>(const void *input, size_t inputSize, void *hash);
+template void fillAes1Rx4<3>(void *state, size_t outputSize, void *buffer);
+template void fillAes4Rx4<3>(void *state, size_t outputSize, void *buffer, const RandomX_ConfigurationBase &config);
+template void hashAndFillAes1Rx4<3,1>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+template void hashAndFillAes1Rx4<3,2>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
+template void hashAndFillAes1Rx4<3,4>(void* scratchpad, size_t scratchpadSize, void* hash, void* fill_state);
@@ -81,7 +81,7 @@ namespace randomx {
 	void BytecodeMachine::compileInstruction(RANDOMX_GEN_ARGS) {
 		uint32_t opcode = instr.opcode;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IADD_RS) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IADD_RS) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IADD_RS;
@@ -99,9 +99,9 @@ namespace randomx {
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IADD_RS;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IADD_RS;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IADD_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IADD_M) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IADD_M;
@@ -109,18 +109,18 @@ namespace randomx {
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			if (src != dst) {
 				ibc.isrc = &nreg->r[src];
-				ibc.memMask = AddressMask[instr.getModMem()];
+				ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			}
 			else {
 				ibc.isrc = &zero;
-				ibc.memMask = ScratchpadL3Mask;
+				ibc.memMask = bytecodeConfig->ScratchpadL3Mask_Calculated;
 			}
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IADD_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IADD_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_ISUB_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_ISUB_R) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::ISUB_R;
@@ -135,9 +135,9 @@ namespace randomx {
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_ISUB_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_ISUB_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_ISUB_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_ISUB_M) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::ISUB_M;
@@ -145,18 +145,18 @@ namespace randomx {
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			if (src != dst) {
 				ibc.isrc = &nreg->r[src];
-				ibc.memMask = AddressMask[instr.getModMem()];
+				ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			}
 			else {
 				ibc.isrc = &zero;
-				ibc.memMask = ScratchpadL3Mask;
+				ibc.memMask = bytecodeConfig->ScratchpadL3Mask_Calculated;
 			}
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_ISUB_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_ISUB_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IMUL_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IMUL_R) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IMUL_R;
@@ -171,9 +171,9 @@ namespace randomx {
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IMUL_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IMUL_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IMUL_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IMUL_M) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IMUL_M;
@@ -181,18 +181,18 @@ namespace randomx {
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			if (src != dst) {
 				ibc.isrc = &nreg->r[src];
-				ibc.memMask = AddressMask[instr.getModMem()];
+				ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			}
 			else {
 				ibc.isrc = &zero;
-				ibc.memMask = ScratchpadL3Mask;
+				ibc.memMask = bytecodeConfig->ScratchpadL3Mask_Calculated;
 			}
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IMUL_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IMUL_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IMULH_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IMULH_R) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IMULH_R;
@@ -201,9 +201,9 @@ namespace randomx {
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IMULH_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IMULH_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IMULH_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IMULH_M) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IMULH_M;
@@ -211,18 +211,18 @@ namespace randomx {
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			if (src != dst) {
 				ibc.isrc = &nreg->r[src];
-				ibc.memMask = AddressMask[instr.getModMem()];
+				ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			}
 			else {
 				ibc.isrc = &zero;
-				ibc.memMask = ScratchpadL3Mask;
+				ibc.memMask = bytecodeConfig->ScratchpadL3Mask_Calculated;
 			}
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IMULH_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IMULH_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_ISMULH_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_ISMULH_R) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::ISMULH_R;
@@ -231,9 +231,9 @@ namespace randomx {
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_ISMULH_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_ISMULH_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_ISMULH_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_ISMULH_M) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::ISMULH_M;
@@ -241,18 +241,18 @@ namespace randomx {
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			if (src != dst) {
 				ibc.isrc = &nreg->r[src];
-				ibc.memMask = AddressMask[instr.getModMem()];
+				ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			}
 			else {
 				ibc.isrc = &zero;
-				ibc.memMask = ScratchpadL3Mask;
+				ibc.memMask = bytecodeConfig->ScratchpadL3Mask_Calculated;
 			}
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_ISMULH_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_ISMULH_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IMUL_RCP) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IMUL_RCP) {
 			uint64_t divisor = instr.getImm32();
 			if (!isZeroOrPowerOf2(divisor)) {
 				auto dst = instr.dst % RegistersCount;
@@ -267,18 +267,18 @@ namespace randomx {
 			}
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IMUL_RCP;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IMUL_RCP;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_INEG_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_INEG_R) {
 			auto dst = instr.dst % RegistersCount;
 			ibc.type = InstructionType::INEG_R;
 			ibc.idst = &nreg->r[dst];
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_INEG_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_INEG_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IXOR_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IXOR_R) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IXOR_R;
@@ -293,9 +293,9 @@ namespace randomx {
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IXOR_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IXOR_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IXOR_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IXOR_M) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IXOR_M;
@@ -303,18 +303,18 @@ namespace randomx {
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			if (src != dst) {
 				ibc.isrc = &nreg->r[src];
-				ibc.memMask = AddressMask[instr.getModMem()];
+				ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			}
 			else {
 				ibc.isrc = &zero;
-				ibc.memMask = ScratchpadL3Mask;
+				ibc.memMask = bytecodeConfig->ScratchpadL3Mask_Calculated;
 			}
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IXOR_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IXOR_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IROR_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IROR_R) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IROR_R;
@@ -329,9 +329,9 @@ namespace randomx {
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IROR_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IROR_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_IROL_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_IROL_R) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::IROL_R;
@@ -346,9 +346,9 @@ namespace randomx {
 			registerUsage[dst] = i;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_IROL_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_IROL_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_ISWAP_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_ISWAP_R) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			if (src != dst) {
@@ -363,9 +363,9 @@ namespace randomx {
 			}
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_ISWAP_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_ISWAP_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FSWAP_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FSWAP_R) {
 			auto dst = instr.dst % RegistersCount;
 			ibc.type = InstructionType::FSWAP_R;
 			if (dst < RegisterCountFlt)
@@ -374,9 +374,9 @@ namespace randomx {
 				ibc.fdst = &nreg->e[dst - RegisterCountFlt];
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FSWAP_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FSWAP_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FADD_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FADD_R) {
 			auto dst = instr.dst % RegisterCountFlt;
 			auto src = instr.src % RegisterCountFlt;
 			ibc.type = InstructionType::FADD_R;
@@ -384,21 +384,21 @@ namespace randomx {
 			ibc.fsrc = &nreg->a[src];
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FADD_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FADD_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FADD_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FADD_M) {
 			auto dst = instr.dst % RegisterCountFlt;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::FADD_M;
 			ibc.fdst = &nreg->f[dst];
 			ibc.isrc = &nreg->r[src];
-			ibc.memMask = AddressMask[instr.getModMem()];
+			ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FADD_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FADD_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FSUB_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FSUB_R) {
 			auto dst = instr.dst % RegisterCountFlt;
 			auto src = instr.src % RegisterCountFlt;
 			ibc.type = InstructionType::FSUB_R;
@@ -406,29 +406,29 @@ namespace randomx {
 			ibc.fsrc = &nreg->a[src];
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FSUB_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FSUB_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FSUB_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FSUB_M) {
 			auto dst = instr.dst % RegisterCountFlt;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::FSUB_M;
 			ibc.fdst = &nreg->f[dst];
 			ibc.isrc = &nreg->r[src];
-			ibc.memMask = AddressMask[instr.getModMem()];
+			ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FSUB_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FSUB_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FSCAL_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FSCAL_R) {
 			auto dst = instr.dst % RegisterCountFlt;
 			ibc.fdst = &nreg->f[dst];
 			ibc.type = InstructionType::FSCAL_R;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FSCAL_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FSCAL_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FMUL_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FMUL_R) {
 			auto dst = instr.dst % RegisterCountFlt;
 			auto src = instr.src % RegisterCountFlt;
 			ibc.type = InstructionType::FMUL_R;
@@ -436,29 +436,29 @@ namespace randomx {
 			ibc.fsrc = &nreg->a[src];
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FMUL_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FMUL_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FDIV_M) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FDIV_M) {
 			auto dst = instr.dst % RegisterCountFlt;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::FDIV_M;
 			ibc.fdst = &nreg->e[dst];
 			ibc.isrc = &nreg->r[src];
-			ibc.memMask = AddressMask[instr.getModMem()];
+			ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FDIV_M;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FDIV_M;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_FSQRT_R) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_FSQRT_R) {
 			auto dst = instr.dst % RegisterCountFlt;
 			ibc.type = InstructionType::FSQRT_R;
 			ibc.fdst = &nreg->e[dst];
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_FSQRT_R;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_FSQRT_R;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_CBRANCH) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_CBRANCH) {
 			ibc.type = InstructionType::CBRANCH;
 			//jump condition
 			int creg = instr.dst % RegistersCount;
@@ -474,18 +474,18 @@ namespace randomx {
 			}
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_CBRANCH;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_CBRANCH;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_CFROUND) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_CFROUND) {
 			auto src = instr.src % RegistersCount;
 			ibc.isrc = &nreg->r[src];
 			ibc.type = InstructionType::CFROUND;
 			ibc.imm = instr.getImm32() & 63;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_CFROUND;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_CFROUND;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_ISTORE) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_ISTORE) {
 			auto dst = instr.dst % RegistersCount;
 			auto src = instr.src % RegistersCount;
 			ibc.type = InstructionType::ISTORE;
@@ -493,14 +493,14 @@ namespace randomx {
 			ibc.isrc = &nreg->r[src];
 			ibc.imm = signExtend2sCompl(instr.getImm32());
 			if (instr.getModCond() < StoreL3Condition)
-				ibc.memMask = AddressMask[instr.getModMem()];
+				ibc.memMask = bytecodeConfig->AddressMask_Calculated[instr.getModMem()];
 			else
-				ibc.memMask = ScratchpadL3Mask;
+				ibc.memMask = bytecodeConfig->ScratchpadL3Mask_Calculated;
 			return;
 		}
-		opcode -= RandomX_CurrentConfig.RANDOMX_FREQ_ISTORE;
+		opcode -= bytecodeConfig->RANDOMX_FREQ_ISTORE;
 
-		if (opcode < RandomX_CurrentConfig.RANDOMX_FREQ_NOP) {
+		if (opcode < bytecodeConfig->RANDOMX_FREQ_NOP) {
 			ibc.type = InstructionType::NOP;
 			return;
 		}
@@ -80,17 +80,18 @@ namespace randomx {
 			nreg = &regFile;
 		}
 
-		void compileProgram(Program& program, InstructionByteCode* bytecode, NativeRegisterFile& regFile) {
+		void compileProgram(Program& program, InstructionByteCode* bytecode, NativeRegisterFile& regFile, const RandomX_ConfigurationBase& cfg) {
 			beginCompilation(regFile);
-			for (unsigned i = 0; i < RandomX_CurrentConfig.ProgramSize; ++i) {
+			bytecodeConfig = &cfg;
+			for (unsigned i = 0; i < cfg.ProgramSize; ++i) {
 				auto& instr = program(i);
 				auto& ibc = bytecode[i];
 				compileInstruction(instr, i, ibc);
 			}
 		}
 
-		static void executeBytecode(InstructionByteCode* bytecode, uint8_t* scratchpad, ProgramConfiguration& config) {
-			for (int pc = 0; pc < static_cast<int>(RandomX_CurrentConfig.ProgramSize); ++pc) {
+		static void executeBytecode(InstructionByteCode* bytecode, uint32_t programSize, uint8_t* scratchpad, ProgramConfiguration& config) {
+			for (int pc = 0; pc < static_cast<int>(programSize); ++pc) {
 				auto& ibc = bytecode[pc];
 				executeInstruction(ibc, pc, scratchpad, config);
 			}
@@ -244,6 +245,7 @@ namespace randomx {
 		static const int_reg_t zero;
 		int registerUsage[RegistersCount];
 		NativeRegisterFile* nreg;
+		const RandomX_ConfigurationBase* bytecodeConfig = nullptr;
 
 		static void* getScratchpadAddress(InstructionByteCode& ibc, uint8_t* scratchpad) {
 			uint32_t addr = (*ibc.isrc + ibc.imm) & ibc.memMask;
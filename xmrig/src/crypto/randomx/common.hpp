@@ -73,7 +73,6 @@ namespace randomx {
 	constexpr uint32_t ArgonBlockSize = 1024;
 	constexpr int SuperscalarMaxSize = 3 * RANDOMX_SUPERSCALAR_MAX_LATENCY + 2;
 	constexpr size_t CacheLineSize = RANDOMX_DATASET_ITEM_SIZE;
-	#define ScratchpadSize RandomX_CurrentConfig.ScratchpadL3_Size
 	#define CacheLineAlignMask RandomX_ConfigurationBase::CacheLineAlignMask_Calculated
 	#define DatasetExtraItems RandomX_ConfigurationBase::DatasetExtraItems_Calculated
 	constexpr int StoreL3Condition = 14;
@@ -126,9 +125,6 @@ namespace randomx {
 		double hi;
 	};
 
-	#define AddressMask RandomX_CurrentConfig.AddressMask_Calculated
-	#define ScratchpadL3Mask RandomX_CurrentConfig.ScratchpadL3Mask_Calculated
-	#define ScratchpadL3Mask64 RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated
 	constexpr int RegistersCount = 8;
 	constexpr int RegisterCountFlt = RegistersCount / 2;
 	constexpr int RegisterNeedsDisplacement = 5; //x86 r13 register
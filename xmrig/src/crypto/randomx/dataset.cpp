@@ -72,42 +72,47 @@ namespace randomx {
 	template void deallocCache<LargePageAllocator>(randomx_cache* cache);
 
 	void initCache(randomx_cache* cache, const void* key, size_t keySize) {
+		const RandomX_ConfigurationBase* config = cache->rxConfig;
 		argon2_context context;
 
 		context.out = nullptr;
 		context.outlen = 0;
 		context.pwd = CONST_CAST(uint8_t *)key;
 		context.pwdlen = (uint32_t)keySize;
-		context.salt = CONST_CAST(uint8_t *)RandomX_CurrentConfig.ArgonSalt;
-		context.saltlen = (uint32_t)strlen(RandomX_CurrentConfig.ArgonSalt);
+		context.salt = CONST_CAST(uint8_t *)config->ArgonSalt;
+		context.saltlen = (uint32_t)strlen(config->ArgonSalt);
 		context.secret = nullptr;
 		context.secretlen = 0;
 		context.ad = nullptr;
 		context.adlen = 0;
-		context.t_cost = RandomX_CurrentConfig.ArgonIterations;
-		context.m_cost = RandomX_CurrentConfig.ArgonMemory;
-		context.lanes = RandomX_CurrentConfig.ArgonLanes;
+		context.t_cost = config->ArgonIterations;
+		context.m_cost = RandomX_ConfigurationBase::ArgonMemory;
+		context.lanes = config->ArgonLanes;
 		context.threads = 1;
 		context.allocate_cbk = nullptr;
 		context.free_cbk = nullptr;
 		context.flags = ARGON2_DEFAULT_FLAGS;
 		context.version = ARGON2_VERSION_NUMBER;
 
-		argon2_ctx_mem(&context, Argon2_d, cache->memory, RandomX_CurrentConfig.ArgonMemory * 1024);
+		argon2_ctx_mem(&context, Argon2_d, cache->memory, RandomX_ConfigurationBase::ArgonMemory * 1024);
 
 		randomx::Blake2Generator gen(key, keySize);
-		for (uint32_t i = 0; i < RandomX_CurrentConfig.CacheAccesses; ++i) {
+		for (uint32_t i = 0; i < RandomX_ConfigurationBase::CacheAccesses; ++i) {
 			randomx::generateSuperscalar(cache->programs[i], gen);
 		}
 	}
 
 	void initCacheCompile(randomx_cache* cache, const void* key, size_t keySize) {
 		initCache(cache, key, keySize);
+		compileDatasetInit(cache);
+	}
 
+	void compileDatasetInit(randomx_cache* cache) {
 #		ifdef XMRIG_SECURE_JIT
 		cache->jit->enableWriting();
 #		endif
 
+		cache->jit->setConfig(cache->rxConfig);
 		cache->jit->generateSuperscalarHash(cache->programs);
 		cache->jit->generateDatasetInitCode();
 		cache->datasetInit  = cache->jit->getDatasetInitFunc();
@@ -127,7 +132,7 @@ namespace randomx {
 	constexpr uint64_t superscalarAdd7 = 9549104520008361294ULL;
 
 	static inline uint8_t* getMixBlock(uint64_t registerValue, uint8_t *memory) {
-		const uint32_t mask = (RandomX_CurrentConfig.ArgonMemory * randomx::ArgonBlockSize) / CacheLineSize - 1;
+		const uint32_t mask = (RandomX_ConfigurationBase::ArgonMemory * randomx::ArgonBlockSize) / CacheLineSize - 1;
 		return memory + (registerValue & mask) * CacheLineSize;
 	}
 
@@ -143,7 +148,7 @@ namespace randomx {
 		rl[5] = rl[0] ^ superscalarAdd5;
 		rl[6] = rl[0] ^ superscalarAdd6;
 		rl[7] = rl[0] ^ superscalarAdd7;
-		for (unsigned i = 0; i < RandomX_CurrentConfig.CacheAccesses; ++i) {
+		for (unsigned i = 0; i < RandomX_ConfigurationBase::CacheAccesses; ++i) {
 			mixBlock = getMixBlock(registerValue, cache->memory);
 			rx_prefetch_nta(mixBlock);
 			SuperscalarProgram& prog = cache->programs[i];
@@ -43,10 +43,13 @@ struct randomx_dataset {
 /* Global scope for C binding */
 struct randomx_cache {
 	uint8_t* memory = nullptr;
+	const RandomX_ConfigurationBase* rxConfig = nullptr;
 	randomx::JitCompiler* jit = nullptr;
 	randomx::CacheInitializeFunc* initialize;
 	randomx::DatasetInitFunc* datasetInit;
 	randomx::SuperscalarProgram programs[RANDOMX_CACHE_MAX_ACCESSES];
+	uint8_t* datasetPrefix = nullptr;    //precomputed dataset items [0, datasetPrefixItems) used by light VMs
+	uint32_t datasetPrefixItems = 0;
 
 	bool isInitialized() const {
 		return programs[0].getSize() != 0;
@@ -72,6 +75,7 @@ namespace randomx {
 
 	void initCache(randomx_cache*, const void*, size_t);
 	void initCacheCompile(randomx_cache*, const void*, size_t);
+	void compileDatasetInit(randomx_cache*);
 	void initDatasetItem(randomx_cache* cache, uint8_t* out, uint64_t blockNumber);
 	void initDataset(randomx_cache* cache, uint8_t* dataset, uint32_t startBlock, uint32_t endBlock);
 }
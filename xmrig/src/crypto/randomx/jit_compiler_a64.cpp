@@ -48,6 +48,10 @@ void randomx_set_optimized_dataset_init(int value)
 	optimizedDatasetInit = value;
 }
 
+void randomx_set_optimized_dataset_init_avx512(int)
+{
+}
+
 namespace ARMV8A {
 
 constexpr uint32_t B           = 0x14000000;
@@ -129,10 +133,10 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 	uint32_t codePos = MainLoopBegin + 4;
 
 	// and w16, w10, ScratchpadL3Mask64
-	emit32(0x121A0000 | 16 | (10 << 5) | ((RandomX_CurrentConfig.Log2_ScratchpadL3 - 7) << 10), code, codePos);
+	emit32(0x121A0000 | 16 | (10 << 5) | ((rxConfig->Log2_ScratchpadL3 - 7) << 10), code, codePos);
 
 	// and w17, w18, ScratchpadL3Mask64
-	emit32(0x121A0000 | 17 | (18 << 5) | ((RandomX_CurrentConfig.Log2_ScratchpadL3 - 7) << 10), code, codePos);
+	emit32(0x121A0000 | 17 | (18 << 5) | ((rxConfig->Log2_ScratchpadL3 - 7) << 10), code, codePos);
 
 	codePos = PrologueSize;
 	literalPos = ImulRcpLiteralsEnd;
@@ -141,12 +145,12 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 	for (uint32_t i = 0; i < RegistersCount; ++i)
 		reg_changed_offset[i] = codePos;
 
-	for (uint32_t i = 0; i < program.getSize(); ++i)
+	for (uint32_t i = 0; i < rxConfig->ProgramSize; ++i)
 	{
 		Instruction& instr = program(i);
 		instr.src %= RegistersCount;
 		instr.dst %= RegistersCount;
-		(this->*engine[instr.opcode])(instr, codePos);
+		(this->*rxConfig->JIT_Engine[instr.opcode])(instr, codePos);
 	}
 
 	// Update spMix2
@@ -159,11 +163,11 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 
 	// and w18, w18, CacheLineAlignMask
 	codePos = (((uint8_t*)randomx_program_aarch64_cacheline_align_mask1) - ((uint8_t*)randomx_program_aarch64));
-	emit32(0x121A0000 | 18 | (18 << 5) | ((RandomX_CurrentConfig.Log2_DatasetBaseSize - 7) << 10), code, codePos);
+	emit32(0x121A0000 | 18 | (18 << 5) | ((rxConfig->Log2_DatasetBaseSize - 7) << 10), code, codePos);
 
 	// and w10, w10, CacheLineAlignMask
 	codePos = (((uint8_t*)randomx_program_aarch64_cacheline_align_mask2) - ((uint8_t*)randomx_program_aarch64));
-	emit32(0x121A0000 | 10 | (10 << 5) | ((RandomX_CurrentConfig.Log2_DatasetBaseSize - 7) << 10), code, codePos);
+	emit32(0x121A0000 | 10 | (10 << 5) | ((rxConfig->Log2_DatasetBaseSize - 7) << 10), code, codePos);
 
 	// Update spMix1
 	// eor x10, config.readReg0, config.readReg1
@@ -175,7 +179,7 @@ void JitCompilerA64::generateProgram(Program& program, ProgramConfiguration& con
 #	endif
 }
 
-void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration& config, uint32_t datasetOffset)
+void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration& config, uint32_t datasetOffset, const uint8_t*, uint32_t, uint64_t(&)[2])
 {
 	if (!allocatedSize) {
 		allocate(CodeSize);
@@ -189,10 +193,10 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 	uint32_t codePos = MainLoopBegin + 4;
 
 	// and w16, w10, ScratchpadL3Mask64
-	emit32(0x121A0000 | 16 | (10 << 5) | ((RandomX_CurrentConfig.Log2_ScratchpadL3 - 7) << 10), code, codePos);
+	emit32(0x121A0000 | 16 | (10 << 5) | ((rxConfig->Log2_ScratchpadL3 - 7) << 10), code, codePos);
 
 	// and w17, w18, ScratchpadL3Mask64
-	emit32(0x121A0000 | 17 | (18 << 5) | ((RandomX_CurrentConfig.Log2_ScratchpadL3 - 7) << 10), code, codePos);
+	emit32(0x121A0000 | 17 | (18 << 5) | ((rxConfig->Log2_ScratchpadL3 - 7) << 10), code, codePos);
 
 	codePos = PrologueSize;
 	literalPos = ImulRcpLiteralsEnd;
@@ -201,12 +205,12 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 	for (uint32_t i = 0; i < RegistersCount; ++i)
 		reg_changed_offset[i] = codePos;
 
-	for (uint32_t i = 0; i < program.getSize(); ++i)
+	for (uint32_t i = 0; i < rxConfig->ProgramSize; ++i)
 	{
 		Instruction& instr = program(i);
 		instr.src %= RegistersCount;
 		instr.dst %= RegistersCount;
-		(this->*engine[instr.opcode])(instr, codePos);
+		(this->*rxConfig->JIT_Engine[instr.opcode])(instr, codePos);
 	}
 
 	// Update spMix2
@@ -219,7 +223,7 @@ void JitCompilerA64::generateProgramLight(Program& program, ProgramConfiguration
 
 	// and w2, w9, CacheLineAlignMask
 	codePos = (((uint8_t*)randomx_program_aarch64_light_cacheline_align_mask) - ((uint8_t*)randomx_program_aarch64));
-	emit32(0x121A0000 | 2 | (9 << 5) | ((RandomX_CurrentConfig.Log2_DatasetBaseSize - 7) << 10), code, codePos);
+	emit32(0x121A0000 | 2 | (9 << 5) | ((rxConfig->Log2_DatasetBaseSize - 7) << 10), code, codePos);
 
 	// Update spMix1
 	// eor x10, config.readReg0, config.readReg1
@@ -266,7 +270,7 @@ void JitCompilerA64::generateSuperscalarHash(SuperscalarProgram(&programs)[N])
 	for (size_t i = 0; i < RandomX_ConfigurationBase::CacheAccesses; ++i)
 	{
 		// and x11, x10, CacheSize / CacheLineSize - 1
-		emit32(0x92400000 | 11 | (10 << 5) | ((RandomX_CurrentConfig.Log2_CacheSize - 1) << 10), code, codePos);
+		emit32(0x92400000 | 11 | (10 << 5) | ((rxConfig->Log2_CacheSize - 1) << 10), code, codePos);
 
 		p1 = ((uint8_t*)randomx_calc_dataset_item_aarch64_prefetch) + 4;
 		p2 = (uint8_t*)randomx_calc_dataset_item_aarch64_mix;
@@ -500,12 +504,12 @@ void JitCompilerA64::emitMemLoad(uint32_t dst, uint32_t src, Instruction& instr,
 
 	if (src != dst)
 	{
-		imm &= instr.getModMem() ? (RandomX_CurrentConfig.ScratchpadL1_Size - 1) : (RandomX_CurrentConfig.ScratchpadL2_Size - 1);
+		imm &= instr.getModMem() ? (rxConfig->ScratchpadL1_Size - 1) : (rxConfig->ScratchpadL2_Size - 1);
 		emitAddImmediate(tmp_reg, src, imm, code, k);
 
 		constexpr uint32_t t = 0x927d0000 | tmp_reg | (tmp_reg << 5);
-		const uint32_t andInstrL1 = t | ((RandomX_CurrentConfig.Log2_ScratchpadL1 - 4) << 10);
-		const uint32_t andInstrL2 = t | ((RandomX_CurrentConfig.Log2_ScratchpadL2 - 4) << 10);
+		const uint32_t andInstrL1 = t | ((rxConfig->Log2_ScratchpadL1 - 4) << 10);
+		const uint32_t andInstrL2 = t | ((rxConfig->Log2_ScratchpadL2 - 4) << 10);
 
 		emit32(instr.getModMem() ? andInstrL1 : andInstrL2, code, k);
 
@@ -514,7 +518,7 @@ void JitCompilerA64::emitMemLoad(uint32_t dst, uint32_t src, Instruction& instr,
 	}
 	else
 	{
-		imm = (imm & ScratchpadL3Mask) >> 3;
+		imm = (imm & rxConfig->ScratchpadL3Mask_Calculated) >> 3;
 		emitMovImmediate(tmp_reg, imm, code, k);
 
 		// ldr tmp_reg, [x2, tmp_reg, lsl 3]
@@ -532,12 +536,12 @@ void JitCompilerA64::emitMemLoadFP(uint32_t src, Instruction& instr, uint8_t* co
 	uint32_t imm = instr.getImm32();
 	constexpr uint32_t tmp_reg = 18;
 
-	imm &= instr.getModMem() ? (RandomX_CurrentConfig.ScratchpadL1_Size - 1) : (RandomX_CurrentConfig.ScratchpadL2_Size - 1);
+	imm &= instr.getModMem() ? (rxConfig->ScratchpadL1_Size - 1) : (rxConfig->ScratchpadL2_Size - 1);
 	emitAddImmediate(tmp_reg, src, imm, code, k);
 
 	constexpr uint32_t t = 0x927d0000 | tmp_reg | (tmp_reg << 5);
-	const uint32_t andInstrL1 = t | ((RandomX_CurrentConfig.Log2_ScratchpadL1 - 4) << 10);
-	const uint32_t andInstrL2 = t | ((RandomX_CurrentConfig.Log2_ScratchpadL2 - 4) << 10);
+	const uint32_t andInstrL1 = t | ((rxConfig->Log2_ScratchpadL1 - 4) << 10);
+	const uint32_t andInstrL2 = t | ((rxConfig->Log2_ScratchpadL2 - 4) << 10);
 
 	emit32(instr.getModMem() ? andInstrL1 : andInstrL2, code, k);
 
@@ -1059,16 +1063,16 @@ void JitCompilerA64::h_ISTORE(Instruction& instr, uint32_t& codePos)
 	uint32_t imm = instr.getImm32();
 
 	if (instr.getModCond() < StoreL3Condition)
-		imm &= instr.getModMem() ? (RandomX_CurrentConfig.ScratchpadL1_Size - 1) : (RandomX_CurrentConfig.ScratchpadL2_Size - 1);
+		imm &= instr.getModMem() ? (rxConfig->ScratchpadL1_Size - 1) : (rxConfig->ScratchpadL2_Size - 1);
 	else
-		imm &= RandomX_CurrentConfig.ScratchpadL3_Size - 1;
+		imm &= rxConfig->ScratchpadL3_Size - 1;
 
 	emitAddImmediate(tmp_reg, dst, imm, code, k);
 
 	constexpr uint32_t t = 0x927d0000 | tmp_reg | (tmp_reg << 5);
-	const uint32_t andInstrL1 = t | ((RandomX_CurrentConfig.Log2_ScratchpadL1 - 4) << 10);
-	const uint32_t andInstrL2 = t | ((RandomX_CurrentConfig.Log2_ScratchpadL2 - 4) << 10);
-	const uint32_t andInstrL3 = t | ((RandomX_CurrentConfig.Log2_ScratchpadL3 - 4) << 10);
+	const uint32_t andInstrL1 = t | ((rxConfig->Log2_ScratchpadL1 - 4) << 10);
+	const uint32_t andInstrL2 = t | ((rxConfig->Log2_ScratchpadL2 - 4) << 10);
+	const uint32_t andInstrL3 = t | ((rxConfig->Log2_ScratchpadL3 - 4) << 10);
 
 	emit32((instr.getModCond() < StoreL3Condition) ? (instr.getModMem() ? andInstrL1 : andInstrL2) : andInstrL3, code, k);
 
@@ -1082,6 +1086,5 @@ void JitCompilerA64::h_NOP(Instruction& instr, uint32_t& codePos)
 {
 }
 
-InstructionGeneratorA64 JitCompilerA64::engine[256] = {};
 
 }
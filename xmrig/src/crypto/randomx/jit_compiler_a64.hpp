@@ -52,12 +52,17 @@ namespace randomx {
 
 		void prepare() {}
 		void generateProgram(Program&, ProgramConfiguration&, uint32_t);
-		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t);
+		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t, const uint8_t*, uint32_t, uint64_t(&)[2]);
 
 		template<size_t N>
 		void generateSuperscalarHash(SuperscalarProgram(&programs)[N]);
 
 		void generateDatasetInitCode() {}
+		void disableDatasetInitAVX512() {}
+		void setScratchpadPrefetchMode(int) {}
+
+		inline bool isDatasetInitAVX512() const { return false; }
+		inline uint32_t getDatasetInitBatch() const { return 1; }
 
 		inline ProgramFunc *getProgramFunc() const {
 #			ifdef XMRIG_SECURE_JIT
@@ -74,10 +79,11 @@ namespace randomx {
 		void enableWriting() const;
 		void enableExecution() const;
 
-		static InstructionGeneratorA64 engine[256];
+		void setConfig(const RandomX_ConfigurationBase* config) { rxConfig = config; }
 
 	private:
 		const bool hugePages;
+		const RandomX_ConfigurationBase* rxConfig = nullptr;
 		uint32_t reg_changed_offset[8]{};
 		uint8_t* code = nullptr;
 		uint32_t literalPos;
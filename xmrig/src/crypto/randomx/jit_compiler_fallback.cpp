@@ -37,3 +37,8 @@ void randomx_set_huge_pages_jit(bool)
 void randomx_set_optimized_dataset_init(int)
 {
 }
+
+
+void randomx_set_optimized_dataset_init_avx512(int)
+{
+}
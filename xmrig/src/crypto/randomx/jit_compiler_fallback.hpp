@@ -50,7 +50,7 @@ namespace randomx {
 		void generateProgram(Program&, ProgramConfiguration&, uint32_t) {
 
 		}
-		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t) {
+		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t, const uint8_t*, uint32_t, uint64_t(&)[2]) {
 
 		}
 		template<size_t N>
@@ -59,6 +59,14 @@ namespace randomx {
 		}
 		void generateDatasetInitCode() {
 
+		}
+		void disableDatasetInitAVX512() {}
+		void setScratchpadPrefetchMode(int) {}
+		bool isDatasetInitAVX512() const {
+			return false;
+		}
+		uint32_t getDatasetInitBatch() const {
+			return 1;
 		}
 		ProgramFunc* getProgramFunc() {
 			return nullptr;
@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 static bool hugePagesJIT = false;
 static int optimizedDatasetInit = -1;
+static int optimizedDatasetInitAVX512 = -1;
 
 void randomx_set_huge_pages_jit(bool hugePages)
 {
@@ -64,6 +65,11 @@ void randomx_set_optimized_dataset_init(int value)
 	optimizedDatasetInit = value;
 }
 
+void randomx_set_optimized_dataset_init_avx512(int value)
+{
+	optimizedDatasetInitAVX512 = value;
+}
+
 namespace randomx {
 	/*
 
@@ -196,13 +202,13 @@ namespace randomx {
 
 	void JitCompilerX86::enableWriting() const {
 		uint8_t* p1 = alignToPage(code, 4096);
-		uint8_t* p2 = code + CodeSize;
+		uint8_t* p2 = (allocatedSize > CodeSize * 2) ? (allocatedCode + allocatedSize) : (code + CodeSize);
 		xmrig::VirtualMemory::protectRW(p1, p2 - p1);
 	}
 
 	void JitCompilerX86::enableExecution() const {
 		uint8_t* p1 = alignToPage(code, 4096);
-		uint8_t* p2 = code + CodeSize;
+		uint8_t* p2 = (allocatedSize > CodeSize * 2) ? (allocatedCode + allocatedSize) : (code + CodeSize);
 		xmrig::VirtualMemory::protectRX(p1, p2 - p1);
 	}
 
@@ -267,9 +273,27 @@ namespace randomx {
 			initDatasetAVX2 = false;
 		}
 
+		initDatasetAVX512 = false;
+
+		if (optimizedInitDatasetEnable && xmrig::Cpu::info()->has(xmrig::ICpuInfo::FLAG_AVX512F)) {
+			// Dataset init using AVX-512, takes precedence over AVX2:
+			// -1 = Auto detect
+			//  0 = Always disabled
+			// +1 = Always enabled
+			if (optimizedDatasetInitAVX512 > 0) {
+				initDatasetAVX512 = true;
+			}
+			else if (optimizedDatasetInitAVX512 < 0) {
+				// Same rule as for AVX2 on Intel, vector code loses to scalar JIT code when both hyper-threads are busy.
+				// Unknown for AMD CPUs with AVX-512, keep it disabled there.
+				initDatasetAVX512 = (xmrig::Cpu::info()->vendor() == xmrig::ICpuInfo::VENDOR_INTEL) && (xmrig::Cpu::info()->cores() == xmrig::Cpu::info()->threads());
+			}
+		}
+
 		hasXOP = xmrig::Cpu::info()->hasXOP();
 
-		allocatedSize = initDatasetAVX2 ? (CodeSize * 4) : (CodeSize * 2);
+		// AVX-512 dataset init code is about 2x larger than AVX2 code
+		allocatedSize = initDatasetAVX512 ? (CodeSize * 8) : (initDatasetAVX2 ? (CodeSize * 4) : (CodeSize * 2));
 		allocatedCode = static_cast<uint8_t*>(allocExecutableMemory(allocatedSize,
 #			ifdef XMRIG_SECURE_JIT
 			false
@@ -304,10 +328,8 @@ namespace randomx {
 	}
 
 	void JitCompilerX86::prepare() {
-		for (size_t i = 0; i < sizeof(engine); i += 64)
-			rx_prefetch_nta((const char*)(&engine) + i);
-		for (size_t i = 0; i < sizeof(RandomX_CurrentConfig); i += 64)
-			rx_prefetch_nta((const char*)(&RandomX_CurrentConfig) + i);
+		for (size_t i = 0; i < sizeof(RandomX_ConfigurationBase); i += 64)
+			rx_prefetch_nta((const char*)(rxConfig) + i);
 	}
 
 	void JitCompilerX86::generateProgram(Program& prog, ProgramConfiguration& pcfg, uint32_t flags) {
@@ -324,26 +346,84 @@ namespace randomx {
 		generateProgramEpilogue(prog, pcfg);
 	}
 
-	void JitCompilerX86::generateProgramLight(Program& prog, ProgramConfiguration& pcfg, uint32_t datasetOffset) {
+	void JitCompilerX86::generateProgramLight(Program& prog, ProgramConfiguration& pcfg, uint32_t datasetOffset, const uint8_t* prefix, uint32_t prefixItems, uint64_t(&reads)[2]) {
 		generateProgramPrologue(prog, pcfg);
 		emit(codeReadDatasetLightSshInit, readDatasetLightInitSize, code, codePos);
 		*(uint32_t*)(code + codePos) = 0xc381;
 		codePos += 2;
 		emit32(datasetOffset / CacheLineSize, code, codePos);
-		emitByte(0xe8, code, codePos);
-		emit32(superScalarHashOffset - (codePos + 4), code, codePos);
+
+		if (prefixItems) {
+			//items below prefixItems are loaded from memory, r8-r15 and rbx are saved on the stack at this point
+			static constexpr uint8_t loadItem[] = {
+				0x4C, 0x8B, 0x03,       // mov r8, [rbx]
+				0x4C, 0x8B, 0x4B, 0x08, // mov r9, [rbx+8]
+				0x4C, 0x8B, 0x53, 0x10, // mov r10, [rbx+16]
+				0x4C, 0x8B, 0x5B, 0x18, // mov r11, [rbx+24]
+				0x4C, 0x8B, 0x63, 0x20, // mov r12, [rbx+32]
+				0x4C, 0x8B, 0x6B, 0x28, // mov r13, [rbx+40]
+				0x4C, 0x8B, 0x73, 0x30, // mov r14, [rbx+48]
+				0x4C, 0x8B, 0x7B, 0x38, // mov r15, [rbx+56]
+			};
+
+			*(uint32_t*)(code + codePos) = 0xfb81; // cmp ebx, prefixItems
+			codePos += 2;
+			emit32(prefixItems, code, codePos);
+			emitByte(0x73, code, codePos); // jae miss
+			const uint32_t jaePos = codePos++;
+
+			emit32(0x06e3c148, code, codePos); // shl rbx, 6
+			emitByte(0x49, code, codePos); // mov r8, prefix
+			emitByte(0xb8, code, codePos);
+			emit64(reinterpret_cast<uint64_t>(prefix), code, codePos);
+			emitByte(0x4c, code, codePos); // add rbx, r8
+			emitByte(0x01, code, codePos);
+			emitByte(0xc3, code, codePos);
+			emitByte(0x49, code, codePos); // mov r9, &reads[0]
+			emitByte(0xb9, code, codePos);
+			emit64(reinterpret_cast<uint64_t>(&reads[0]), code, codePos);
+			emitByte(0x49, code, codePos); // inc qword ptr [r9]
+			emitByte(0xff, code, codePos);
+			emitByte(0x01, code, codePos);
+			emit(loadItem, code, codePos);
+			emitByte(0xeb, code, codePos); // jmp fin
+			const uint32_t jmpPos = codePos++;
+
+			code[jaePos] = static_cast<uint8_t>(codePos - (jaePos + 1));
+
+			emitByte(0x49, code, codePos); // mov r8, &reads[1]
+			emitByte(0xb8, code, codePos);
+			emit64(reinterpret_cast<uint64_t>(&reads[1]), code, codePos);
+			emitByte(0x49, code, codePos); // inc qword ptr [r8]
+			emitByte(0xff, code, codePos);
+			emitByte(0x00, code, codePos);
+			emitByte(0xe8, code, codePos);
+			emit32(superScalarHashOffset - (codePos + 4), code, codePos);
+
+			code[jmpPos] = static_cast<uint8_t>(codePos - (jmpPos + 1));
+		}
+		else {
+			emitByte(0xe8, code, codePos);
+			emit32(superScalarHashOffset - (codePos + 4), code, codePos);
+		}
+
 		emit(codeReadDatasetLightSshFin, readDatasetLightFinSize, code, codePos);
 		generateProgramEpilogue(prog, pcfg);
 	}
 
 	template<size_t N>
 	void JitCompilerX86::generateSuperscalarHash(SuperscalarProgram(&programs)[N]) {
+		if (initDatasetAVX512) {
+			generateDatasetInitAVX512(programs);
+			return;
+		}
+
 		uint8_t* p = code;
 		if (initDatasetAVX2) {
 			codePos = 0;
 			emit(codeDatasetInitAVX2Prologue, datasetInitAVX2PrologueSize, code, codePos);
 
-			for (unsigned j = 0; j < RandomX_CurrentConfig.CacheAccesses; ++j) {
+			for (unsigned j = 0; j < RandomX_ConfigurationBase::CacheAccesses; ++j) {
 				SuperscalarProgram& prog = programs[j];
 				uint32_t pos = codePos;
 				for (uint32_t i = 0, n = prog.getSize(); i < n; ++i) {
@@ -352,10 +432,10 @@ namespace randomx {
 				codePos = pos;
 				emit(codeSshLoad, codeSshLoadSize, code, codePos);
 				emit(codeDatasetInitAVX2SshLoad, datasetInitAVX2SshLoadSize, code, codePos);
-				if (j < RandomX_CurrentConfig.CacheAccesses - 1) {
+				if (j < RandomX_ConfigurationBase::CacheAccesses - 1) {
 					*(uint32_t*)(code + codePos) = 0xd88b49 + (static_cast<uint32_t>(prog.getAddressRegister()) << 16);
 					codePos += 3;
-					emit(RandomX_CurrentConfig.codeSshPrefetchTweaked, codeSshPrefetchSize, code, codePos);
+					emit(rxConfig->codeSshPrefetchTweaked, codeSshPrefetchSize, code, codePos);
 					uint8_t* p = code + codePos;
 					emit(codeDatasetInitAVX2SshPrefetch, datasetInitAVX2SshPrefetchSize, code, codePos);
 					p[3] += prog.getAddressRegister() << 3;
@@ -374,7 +454,7 @@ namespace randomx {
 
 		memcpy(code + superScalarHashOffset, codeSshInit, codeSshInitSize);
 		codePos = superScalarHashOffset + codeSshInitSize;
-		for (unsigned j = 0; j < RandomX_CurrentConfig.CacheAccesses; ++j) {
+		for (unsigned j = 0; j < RandomX_ConfigurationBase::CacheAccesses; ++j) {
 			SuperscalarProgram& prog = programs[j];
 			uint32_t pos = codePos;
 			for (uint32_t i = 0, n = prog.getSize(); i < n; ++i) {
@@ -382,10 +462,10 @@ namespace randomx {
 			}
 			codePos = pos;
 			emit(codeSshLoad, codeSshLoadSize, code, codePos);
-			if (j < RandomX_CurrentConfig.CacheAccesses - 1) {
+			if (j < RandomX_ConfigurationBase::CacheAccesses - 1) {
 				*(uint32_t*)(code + codePos) = 0xd88b49 + (static_cast<uint32_t>(prog.getAddressRegister()) << 16);
 				codePos += 3;
-				emit(RandomX_CurrentConfig.codeSshPrefetchTweaked, codeSshPrefetchSize, code, codePos);
+				emit(rxConfig->codeSshPrefetchTweaked, codeSshPrefetchSize, code, codePos);
 			}
 		}
 		emitByte(0xc3, code, codePos);
@@ -395,16 +475,370 @@ namespace randomx {
 	void JitCompilerX86::generateSuperscalarHash(SuperscalarProgram(&programs)[RANDOMX_CACHE_MAX_ACCESSES]);
 
 	void JitCompilerX86::generateDatasetInitCode() {
-		// AVX2 code is generated in generateSuperscalarHash()
-		if (!initDatasetAVX2) {
+		// AVX2 and AVX-512 code is generated in generateSuperscalarHash()
+		if (!initDatasetAVX2 && !initDatasetAVX512) {
 			memcpy(code, codeDatasetInit, datasetInitSize);
 		}
 	}
 
+	/*
+
+	AVX-512 DATASET INIT, 8 items per pass:
+
+	; rbx   -> end item
+	; rbp   -> current item
+	; rsi   -> dataset pointer
+	; rdi   -> cache memory
+	; rsp   -> 64 bytes of scratch space to extract cache line addresses for prefetching
+	; zmm0  -> "r0" of 8 items, one 64-bit lane per item
+	; ...
+	; zmm7  -> "r7"
+	; zmm16-zmm25 -> temporary
+	; zmm26 -> dataset offsets of 8 items: 0, 64, ..., 448
+	; zmm27 -> cache line offsets of the current mix blocks
+	; zmm28 -> 0, 1, ..., 7
+	; zmm29 -> 1, 2, ..., 8
+	; zmm30 -> cache line mask
+	; zmm31 -> low 32 bits mask
+
+	*/
+
+	enum AVX512Register : uint32_t {
+		zmmTmp0         = 16,
+		zmmTmp1         = 17,
+		zmmMul0         = 18,
+		zmmMul1         = 19,
+		zmmMul2         = 20,
+		zmmMul3         = 21,
+		zmmMul4         = 22,
+		zmmMul5         = 23,
+		zmmGather       = 24,
+		zmmOffsets      = 26,
+		zmmAddress      = 27,
+		zmmIndex        = 28,
+		zmmIndex1       = 29,
+		zmmCacheMask    = 30,
+		zmmLowMask      = 31
+	};
+
+	static const uint64_t datasetInitAVX512Constants[8] = {
+		6364136223846793005ULL,  // superscalarMul0
+		9298411001130361340ULL,  // superscalarAdd1
+		12065312585734608966ULL, // superscalarAdd2
+		9306329213124626780ULL,  // superscalarAdd3
+		5281919268842080866ULL,  // superscalarAdd4
+		10536153434571861004ULL, // superscalarAdd5
+		3398623926847679864ULL,  // superscalarAdd6
+		9549104520008361294ULL   // superscalarAdd7
+	};
+
+	// EVEX.512.W1 instruction with register operands, reg can be an opcode extension
+	static void emitEVEX(uint32_t map, uint32_t pp, uint32_t opcode, uint32_t reg, uint32_t vvvv, uint32_t rm, uint8_t* code, uint32_t& codePos) {
+		code[codePos + 0] = 0x62;
+		code[codePos + 1] = static_cast<uint8_t>(((~reg & 8) << 4) | ((~rm & 16) << 2) | ((~rm & 8) << 2) | (~reg & 16) | map);
+		code[codePos + 2] = static_cast<uint8_t>(0x84 | ((~vvvv & 15) << 3) | pp);
+		code[codePos + 3] = static_cast<uint8_t>(0x40 | ((~vvvv & 16) >> 1));
+		code[codePos + 4] = static_cast<uint8_t>(opcode);
+		code[codePos + 5] = static_cast<uint8_t>(0xC0 | ((reg & 7) << 3) | (rm & 7));
+		codePos += 6;
+	}
+
+	// vpgatherqq/vpscatterqq with [base + zmm_index + disp8 * 8] operand
+	static void emitEVEXVSIB(uint32_t opcode, uint32_t reg, uint32_t base, uint32_t index, uint32_t disp8, uint32_t k, uint8_t* code, uint32_t& codePos) {
+		code[codePos + 0] = 0x62;
+		code[codePos + 1] = static_cast<uint8_t>(((~reg & 8) << 4) | ((~index & 8) << 3) | 0x20 | (~reg & 16) | 2);
+		code[codePos + 2] = 0xFD;
+		code[codePos + 3] = static_cast<uint8_t>(0x40 | ((~index & 16) >> 1) | k);
+		code[codePos + 4] = static_cast<uint8_t>(opcode);
+		code[codePos + 5] = static_cast<uint8_t>(0x44 | ((reg & 7) << 3));
+		code[codePos + 6] = static_cast<uint8_t>(((index & 7) << 3) | base);
+		code[codePos + 7] = static_cast<uint8_t>(disp8);
+		codePos += 8;
+	}
+
+	// vmovdqu64 [rsp], zmm (store = true) or vmovdqu64 zmm, [rsp]
+	static void emitStackMove(bool store, uint32_t reg, uint8_t* code, uint32_t& codePos) {
+		code[codePos + 0] = 0x62;
+		code[codePos + 1] = static_cast<uint8_t>(((~reg & 8) << 4) | 0x60 | (~reg & 16) | 1);
+		code[codePos + 2] = 0xFE;
+		code[codePos + 3] = 0x48;
+		code[codePos + 4] = store ? 0x7F : 0x6F;
+		code[codePos + 5] = static_cast<uint8_t>(0x04 | ((reg & 7) << 3));
+		code[codePos + 6] = 0x24;
+		codePos += 7;
+	}
+
+	static void vpaddq(uint32_t dst, uint32_t a, uint32_t b, uint8_t* code, uint32_t& codePos)   { emitEVEX(1, 1, 0xD4, dst, a, b, code, codePos); }
+	static void vpsubq(uint32_t dst, uint32_t a, uint32_t b, uint8_t* code, uint32_t& codePos)   { emitEVEX(1, 1, 0xFB, dst, a, b, code, codePos); }
+	static void vpxorq(uint32_t dst, uint32_t a, uint32_t b, uint8_t* code, uint32_t& codePos)   { emitEVEX(1, 1, 0xEF, dst, a, b, code, codePos); }
+	static void vpandq(uint32_t dst, uint32_t a, uint32_t b, uint8_t* code, uint32_t& codePos)   { emitEVEX(1, 1, 0xDB, dst, a, b, code, codePos); }
+	static void vpmuludq(uint32_t dst, uint32_t a, uint32_t b, uint8_t* code, uint32_t& codePos) { emitEVEX(1, 1, 0xF4, dst, a, b, code, codePos); }
+
+	// Shifts and rotations by immediate: the opcode extension goes to ModRM.reg, the destination to EVEX.vvvv
+	static void emitShift(uint32_t opcode, uint32_t ext, uint32_t dst, uint32_t src, uint32_t imm, uint8_t* code, uint32_t& codePos) {
+		emitEVEX(1, 1, opcode, ext, dst, src, code, codePos);
+		code[codePos++] = static_cast<uint8_t>(imm);
+	}
+
+	static void vpsrlq(uint32_t dst, uint32_t src, uint32_t imm, uint8_t* code, uint32_t& codePos) { emitShift(0x73, 2, dst, src, imm, code, codePos); }
+	static void vpsllq(uint32_t dst, uint32_t src, uint32_t imm, uint8_t* code, uint32_t& codePos) { emitShift(0x73, 6, dst, src, imm, code, codePos); }
+	static void vpsraq(uint32_t dst, uint32_t src, uint32_t imm, uint8_t* code, uint32_t& codePos) { emitShift(0x72, 4, dst, src, imm, code, codePos); }
+	static void vprorq(uint32_t dst, uint32_t src, uint32_t imm, uint8_t* code, uint32_t& codePos) { emitShift(0x72, 0, dst, src, imm, code, codePos); }
+
+	// vpbroadcastq zmm, r64
+	static void vpbroadcastq(uint32_t dst, uint32_t gpr, uint8_t* code, uint32_t& codePos) { emitEVEX(2, 1, 0x7C, dst, 0, gpr, code, codePos); }
+
+	// kxnorw k, k, k - gather and scatter instructions clear their mask
+	static void kxnorw(uint32_t k, uint8_t* code, uint32_t& codePos) {
+		const uint8_t t[] = { 0xC5, static_cast<uint8_t>(0x84 | ((~k & 15) << 3)), 0x46, static_cast<uint8_t>(0xC0 | (k << 3) | k) };
+		memcpy(code + codePos, t, sizeof(t));
+		codePos += sizeof(t);
+	}
+
+	// mov rax, imm64; vpbroadcastq zmm, rax
+	static void broadcastImm(uint32_t dst, uint64_t imm, uint8_t* code, uint32_t& codePos) {
+		*(uint16_t*)(code + codePos) = 0xB848;
+		codePos += 2;
+		memcpy(code + codePos, &imm, sizeof(imm));
+		codePos += sizeof(imm);
+		vpbroadcastq(dst, 0, code, codePos);
+	}
+
+	// Low 64 bits of 64x64 bit product from 32x32 bit multiplications, dst can be the same register as a or b
+	static void emitMul64(uint32_t dst, uint32_t a, uint32_t b, uint8_t* code, uint32_t& codePos) {
+		vpsrlq(zmmMul0, a, 32, code, codePos);
+		vpmuludq(zmmMul0, zmmMul0, b, code, codePos);      // hi(a) * lo(b)
+		vpsrlq(zmmMul1, b, 32, code, codePos);
+		vpmuludq(zmmMul1, zmmMul1, a, code, codePos);      // lo(a) * hi(b)
+		vpaddq(zmmMul0, zmmMul0, zmmMul1, code, codePos);
+		vpsllq(zmmMul0, zmmMul0, 32, code, codePos);
+		vpmuludq(dst, a, b, code, codePos);                // lo(a) * lo(b)
+		vpaddq(dst, dst, zmmMul0, code, codePos);
+	}
+
+	// High 64 bits of 64x64 bit product (signed or unsigned), dst can be the same register as a or b
+	static void emitMulHigh64(bool sign, uint32_t dst, uint32_t a, uint32_t b, uint8_t* code, uint32_t& codePos) {
+		vpsrlq(zmmMul0, a, 32, code, codePos);             // hi(a)
+		vpsrlq(zmmMul1, b, 32, code, codePos);             // hi(b)
+		vpmuludq(zmmMul2, a, b, code, codePos);            // ll
+		vpmuludq(zmmMul3, a, zmmMul1, code, codePos);      // lh
+		vpmuludq(zmmMul4, zmmMul0, b, code, codePos);      // hl
+		vpmuludq(zmmMul5, zmmMul0, zmmMul1, code, codePos); // hh
+
+		// carry from the low 64 bits: ((ll >> 32) + lo(lh) + lo(hl)) >> 32
+		vpsrlq(zmmMul2, zmmMul2, 32, code, codePos);
+		vpandq(zmmMul0, zmmMul3, zmmLowMask, code, codePos);
+		vpaddq(zmmMul2, zmmMul2, zmmMul0, code, codePos);
+		vpandq(zmmMul0, zmmMul4, zmmLowMask, code, codePos);
+		vpaddq(zmmMul2, zmmMul2, zmmMul0, code, codePos);
+		vpsrlq(zmmMul2, zmmMul2, 32, code, codePos);
+
+		vpsrlq(zmmMul3, zmmMul3, 32, code, codePos);
+		vpsrlq(zmmMul4, zmmMul4, 32, code, codePos);
+		vpaddq(zmmMul5, zmmMul5, zmmMul3, code, codePos);
+		vpaddq(zmmMul5, zmmMul5, zmmMul4, code, codePos);
+
+		if (sign) {
+			// signed = unsigned - (a < 0 ? b : 0) - (b < 0 ? a : 0)
+			vpsraq(zmmMul0, a, 63, code, codePos);
+			vpandq(zmmMul0, zmmMul0, b, code, codePos);
+			vpsubq(zmmMul5, zmmMul5, zmmMul0, code, codePos);
+			vpsraq(zmmMul0, b, 63, code, codePos);
+			vpandq(zmmMul0, zmmMul0, a, code, codePos);
+			vpsubq(zmmMul5, zmmMul5, zmmMul0, code, codePos);
+		}
+
+		vpaddq(dst, zmmMul5, zmmMul2, code, codePos);
+	}
+
+	// Converts 8 register values in zmm to cache line offsets and prefetches them
+	static void emitPrefetchAVX512(uint32_t reg, uint8_t* code, uint32_t& codePos) {
+		vpandq(zmmAddress, reg, zmmCacheMask, code, codePos);
+		vpsllq(zmmAddress, zmmAddress, 6, code, codePos);
+		emitStackMove(true, zmmAddress, code, codePos);
+
+		for (uint32_t i = 0; i < 8; ++i) {
+			const uint8_t t[] = {
+				0x48, 0x8B, 0x44, 0x24, static_cast<uint8_t>(i * 8),   // mov rax, [rsp + i * 8]
+				0x0F, 0x18, 0x04, 0x07                                // prefetchnta [rdi + rax]
+			};
+			memcpy(code + codePos, t, sizeof(t));
+			codePos += sizeof(t);
+		}
+	}
+
+	void JitCompilerX86::generateDatasetInitAVX512(SuperscalarProgram* programs) {
+		codePos = 0;
+
+#		ifdef _WIN32
+		static const uint8_t prologue[] = {
+			0x53, 0x55, 0x57, 0x56,                     // push rbx, rbp, rdi, rsi
+			0x48, 0x83, 0xEC, 0x60,                     // sub rsp, 96
+			0xC5, 0xFA, 0x7F, 0x74, 0x24, 0x40,         // vmovdqu [rsp+64], xmm6
+			0xC5, 0xFA, 0x7F, 0x7C, 0x24, 0x50,         // vmovdqu [rsp+80], xmm7
+			0x48, 0x8B, 0x39,                           // mov rdi, [rcx] ; cache->memory
+			0x48, 0x89, 0xD6,                           // mov rsi, rdx   ; dataset
+			0x4C, 0x89, 0xC5,                           // mov rbp, r8    ; start item
+			0x4C, 0x89, 0xCB                            // mov rbx, r9    ; end item
+		};
+		static const uint8_t epilogue[] = {
+			0xC5, 0xF8, 0x77,                           // vzeroupper
+			0xC5, 0xFA, 0x6F, 0x74, 0x24, 0x40,         // vmovdqu xmm6, [rsp+64]
+			0xC5, 0xFA, 0x6F, 0x7C, 0x24, 0x50,         // vmovdqu xmm7, [rsp+80]
+			0x48, 0x83, 0xC4, 0x60,                     // add rsp, 96
+			0x5E, 0x5F, 0x5D, 0x5B,                     // pop rsi, rdi, rbp, rbx
+			0xC3                                        // ret
+		};
+#		else
+		static const uint8_t prologue[] = {
+			0x53, 0x55,                                 // push rbx, rbp
+			0x48, 0x83, 0xEC, 0x40,                     // sub rsp, 64
+			0x48, 0x8B, 0x3F,                           // mov rdi, [rdi] ; cache->memory
+			0x48, 0x89, 0xD5,                           // mov rbp, rdx   ; start item
+			0x48, 0x89, 0xCB                            // mov rbx, rcx   ; end item
+		};
+		static const uint8_t epilogue[] = {
+			0xC5, 0xF8, 0x77,                           // vzeroupper
+			0x48, 0x83, 0xC4, 0x40,                     // add rsp, 64
+			0x5D, 0x5B,                                 // pop rbp, rbx
+			0xC3                                        // ret
+		};
+#		endif
+
+		emit(prologue, code, codePos);
+
+		// constants
+		emitByte(0xB8, code, codePos);
+		emit32(0xFFFFFFFFU, code, codePos);                                                                  // mov eax, 0xFFFFFFFF
+		vpbroadcastq(zmmLowMask, 0, code, codePos);
+		emitByte(0xB8, code, codePos);
+		emit32(RandomX_ConfigurationBase::ArgonMemory * (ArgonBlockSize / CacheLineSize) - 1, code, codePos);   // mov eax, cache mask
+		vpbroadcastq(zmmCacheMask, 0, code, codePos);
+
+		for (uint32_t i = 0; i < 8; ++i) {
+			emit32(0x2444C748, code, codePos);                                                               // mov qword ptr [rsp + i * 8], i
+			emitByte(static_cast<uint8_t>(i * 8), code, codePos);
+			emit32(i, code, codePos);
+		}
+
+		emitStackMove(false, zmmIndex, code, codePos);
+		broadcastImm(zmmTmp0, 1, code, codePos);
+		vpaddq(zmmIndex1, zmmIndex, zmmTmp0, code, codePos);
+		vpsllq(zmmOffsets, zmmIndex, 6, code, codePos);
+
+		const uint32_t loopBegin = codePos;
+
+		// r0 = (itemNumber + 1) * superscalarMul0, r1-r7 = r0 ^ superscalarAdd1-7
+		vpbroadcastq(zmmTmp0, 5, code, codePos);                                                             // rbp
+		vpaddq(0, zmmTmp0, zmmIndex1, code, codePos);
+		vpaddq(zmmTmp0, zmmTmp0, zmmIndex, code, codePos);
+		emitPrefetchAVX512(zmmTmp0, code, codePos);
+
+		broadcastImm(zmmTmp1, datasetInitAVX512Constants[0], code, codePos);
+		emitMul64(0, 0, zmmTmp1, code, codePos);
+
+		for (uint32_t i = 1; i < 8; ++i) {
+			broadcastImm(zmmTmp1, datasetInitAVX512Constants[i], code, codePos);
+			vpxorq(i, 0, zmmTmp1, code, codePos);
+		}
+
+		for (uint32_t j = 0; j < RandomX_ConfigurationBase::CacheAccesses; ++j) {
+			SuperscalarProgram& prog = programs[j];
+
+			for (uint32_t i = 0, n = prog.getSize(); i < n; ++i) {
+				generateSuperscalarCodeAVX512(prog(i), code, codePos);
+			}
+
+			// xor with the mix blocks, gathers alternate between two registers and masks to break dependency chains
+			for (uint32_t i = 0; i < 8; ++i) {
+				const uint32_t k = 1 + (i & 1);
+				kxnorw(k, code, codePos);
+				emitEVEXVSIB(0x91, zmmGather + (i & 1), 7, zmmAddress, i, k, code, codePos);               // vpgatherqq zmm{k}, [rdi + zmmAddress + i * 8]
+				vpxorq(i, i, zmmGather + (i & 1), code, codePos);
+			}
+
+			if (j < RandomX_ConfigurationBase::CacheAccesses - 1) {
+				emitPrefetchAVX512(prog.getAddressRegister(), code, codePos);
+			}
+		}
+
+		// store 8 dataset items
+		for (uint32_t i = 0; i < 8; ++i) {
+			const uint32_t k = 1 + (i & 1);
+			kxnorw(k, code, codePos);
+			emitEVEXVSIB(0xA1, i, 6, zmmOffsets, i, k, code, codePos);                                       // vpscatterqq [rsi + zmmOffsets + i * 8]{k}, zmm
+		}
+
+		static const uint8_t loopEnd[] = {
+			0x48, 0x83, 0xC5, 0x08,                     // add rbp, 8
+			0x48, 0x81, 0xC6, 0x00, 0x02, 0x00, 0x00,   // add rsi, 512
+			0x48, 0x39, 0xDD,                           // cmp rbp, rbx
+			0x0F, 0x82                                  // jb loop_begin
+		};
+
+		emit(loopEnd, code, codePos);
+		emit32(loopBegin - (codePos + 4), code, codePos);
+		emit(epilogue, code, codePos);
+	}
+
+	void JitCompilerX86::generateSuperscalarCodeAVX512(Instruction& instr, uint8_t* code, uint32_t& codePos) {
+		const uint32_t dst = instr.dst;
+		const uint32_t src = instr.src;
+
+		switch ((SuperscalarInstructionType)instr.opcode)
+		{
+		case randomx::SuperscalarInstructionType::ISUB_R:
+			vpsubq(dst, dst, src, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::IXOR_R:
+			vpxorq(dst, dst, src, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::IADD_RS:
+			if (instr.getModShift()) {
+				vpsllq(zmmTmp0, src, instr.getModShift(), code, codePos);
+				vpaddq(dst, dst, zmmTmp0, code, codePos);
+			}
+			else {
+				vpaddq(dst, dst, src, code, codePos);
+			}
+			break;
+		case randomx::SuperscalarInstructionType::IMUL_R:
+			emitMul64(dst, dst, src, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::IROR_C:
+			vprorq(dst, dst, instr.getImm32() & 63, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::IADD_C7:
+		case randomx::SuperscalarInstructionType::IADD_C8:
+		case randomx::SuperscalarInstructionType::IADD_C9:
+			broadcastImm(zmmTmp0, signExtend2sCompl(instr.getImm32()), code, codePos);
+			vpaddq(dst, dst, zmmTmp0, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::IXOR_C7:
+		case randomx::SuperscalarInstructionType::IXOR_C8:
+		case randomx::SuperscalarInstructionType::IXOR_C9:
+			broadcastImm(zmmTmp0, signExtend2sCompl(instr.getImm32()), code, codePos);
+			vpxorq(dst, dst, zmmTmp0, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::IMULH_R:
+			emitMulHigh64(false, dst, dst, src, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::ISMULH_R:
+			emitMulHigh64(true, dst, dst, src, code, codePos);
+			break;
+		case randomx::SuperscalarInstructionType::IMUL_RCP:
+			broadcastImm(zmmTmp0, randomx_reciprocal_fast(instr.getImm32()), code, codePos);
+			emitMul64(dst, dst, zmmTmp0, code, codePos);
+			break;
+		default:
+			UNREACHABLE;
+		}
+	}
+
 	void JitCompilerX86::generateProgramPrologue(Program& prog, ProgramConfiguration& pcfg) {
 		codePos = ADDR(randomx_program_prologue_first_load) - ADDR(randomx_program_prologue);
-		*(uint32_t*)(code + codePos + 4) = RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated;
-		*(uint32_t*)(code + codePos + 14) = RandomX_CurrentConfig.ScratchpadL3Mask64_Calculated;
+		*(uint32_t*)(code + codePos + 4) = rxConfig->ScratchpadL3Mask64_Calculated;
+		*(uint32_t*)(code + codePos + 14) = rxConfig->ScratchpadL3Mask64_Calculated;
 		if (hasAVX) {
 			uint32_t* p = (uint32_t*)(code + codePos + 61);
 			*p = (*p & 0xFF000000U) | 0x0077F8C5U;
@@ -429,16 +863,16 @@ namespace randomx {
 			r[j] = k;
 		}
 
-		for (int i = 0, n = static_cast<int>(RandomX_CurrentConfig.ProgramSize); i < n; i += 4) {
+		for (int i = 0, n = static_cast<int>(rxConfig->ProgramSize); i < n; i += 4) {
 			Instruction& instr1 = prog(i);
 			Instruction& instr2 = prog(i + 1);
 			Instruction& instr3 = prog(i + 2);
 			Instruction& instr4 = prog(i + 3);
 
-			InstructionGeneratorX86 gen1 = engine[instr1.opcode];
-			InstructionGeneratorX86 gen2 = engine[instr2.opcode];
-			InstructionGeneratorX86 gen3 = engine[instr3.opcode];
-			InstructionGeneratorX86 gen4 = engine[instr4.opcode];
+			InstructionGeneratorX86 gen1 = rxConfig->JIT_Engine[instr1.opcode];
+			InstructionGeneratorX86 gen2 = rxConfig->JIT_Engine[instr2.opcode];
+			InstructionGeneratorX86 gen3 = rxConfig->JIT_Engine[instr3.opcode];
+			InstructionGeneratorX86 gen4 = rxConfig->JIT_Engine[instr4.opcode];
 
 			(*gen1)(this, instr1);
 			(*gen2)(this, instr2);
@@ -453,7 +887,9 @@ namespace randomx {
 	void JitCompilerX86::generateProgramEpilogue(Program& prog, ProgramConfiguration& pcfg) {
 		*(uint64_t*)(code + codePos) = 0xc03349c08b49ull + (static_cast<uint64_t>(pcfg.readReg0) << 16) + (static_cast<uint64_t>(pcfg.readReg1) << 40);
 		codePos += 6;
-		emit(RandomX_CurrentConfig.codePrefetchScratchpadTweaked, RandomX_CurrentConfig.codePrefetchScratchpadTweakedSize, code, codePos);
+		const uint32_t prefetchPos = codePos;
+		emit(rxConfig->codePrefetchScratchpadTweaked, rxConfig->codePrefetchScratchpadTweakedSize, code, codePos);
+		randomx_apply_scratchpad_prefetch_mode(code + prefetchPos, prefetchMode >= 0 ? prefetchMode : randomx_get_scratchpad_prefetch_mode());
 		memcpy(code + codePos, codeLoopStore, loopStoreSize);
 		codePos += loopStoreSize;
 
@@ -731,7 +1167,7 @@ namespace randomx {
 			*(uint32_t*)(code + codePos) = 0xe181;
 			codePos += 2;
 		}
-		emit32(AddressMask[instr.getModMem()], code, codePos);
+		emit32(rxConfig->AddressMask_Calculated[instr.getModMem()], code, codePos);
 	}
 
 	template void JitCompilerX86::genAddressReg<false>(const Instruction& instr, const uint32_t src, uint8_t* code, uint32_t& codePos);
@@ -745,13 +1181,13 @@ namespace randomx {
 		emit32(instr.getImm32(), code, codePos);
 		emitByte(0x25, code, codePos);
 
-		const uint32_t mask1 = AddressMask[instr.getModMem()];
-		const uint32_t mask2 = ScratchpadL3Mask;
+		const uint32_t mask1 = rxConfig->AddressMask_Calculated[instr.getModMem()];
+		const uint32_t mask2 = rxConfig->ScratchpadL3Mask_Calculated;
 		emit32((instr.mod < (StoreL3Condition << 4)) ? mask1 : mask2, code, codePos);
 	}
 
 	FORCE_INLINE void JitCompilerX86::genAddressImm(const Instruction& instr, uint8_t* code, uint32_t& codePos) {
-		emit32(instr.getImm32() & ScratchpadL3Mask, code, codePos);
+		emit32(instr.getImm32() & rxConfig->ScratchpadL3Mask_Calculated, code, codePos);
 	}
 
 	void JitCompilerX86::h_IADD_RS(const Instruction& instr) {
@@ -948,7 +1384,7 @@ namespace randomx {
 		}
 		else {
 			*(uint64_t*)(p + pos) = 0x86F6FB62C4D08B49ULL + (dst << 16) + (dst << 59);
-			*(uint32_t*)(p + pos + 8) = instr.getImm32() & ScratchpadL3Mask;
+			*(uint32_t*)(p + pos + 8) = instr.getImm32() & rxConfig->ScratchpadL3Mask_Calculated;
 			pos += 12;
 		}
 
@@ -1426,6 +1862,5 @@ namespace randomx {
 		emitByte(0x90, code, codePos);
 	}
 
-	alignas(64) InstructionGeneratorX86 JitCompilerX86::engine[256] = {};
 
 }
@@ -35,6 +35,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 #include "crypto/randomx/common.hpp"
 
+// Patches prefetch instructions of a copy of randomx_prefetch_scratchpad, defined in randomx.cpp
+void randomx_apply_scratchpad_prefetch_mode(uint8_t* code, int mode);
+
 namespace randomx {
 
 	class Program;
@@ -53,10 +56,15 @@ namespace randomx {
 		~JitCompilerX86();
 		void prepare();
 		void generateProgram(Program&, ProgramConfiguration&, uint32_t);
-		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t);
+		void generateProgramLight(Program&, ProgramConfiguration&, uint32_t, const uint8_t*, uint32_t, uint64_t(&)[2]);
 		template<size_t N>
 		void generateSuperscalarHash(SuperscalarProgram (&programs)[N]);
 		void generateDatasetInitCode();
+		void disableDatasetInitAVX512() { initDatasetAVX512 = false; }
+		void setScratchpadPrefetchMode(int mode) { prefetchMode = mode; }
+
+		inline bool isDatasetInitAVX512() const { return initDatasetAVX512; }
+		inline uint32_t getDatasetInitBatch() const { return initDatasetAVX512 ? 8 : (initDatasetAVX2 ? 5 : 1); }
 
 		inline ProgramFunc *getProgramFunc() const {
 #			ifdef XMRIG_SECURE_JIT
@@ -81,15 +89,17 @@ namespace randomx {
 		void enableWriting() const;
 		void enableExecution() const;
 
-		alignas(64) static InstructionGeneratorX86 engine[256];
+		void setConfig(const RandomX_ConfigurationBase* config) { rxConfig = config; }
 
 	private:
+		const RandomX_ConfigurationBase* rxConfig = nullptr;
 		int registerUsage[RegistersCount] = {};
 		uint8_t* code = nullptr;
 		uint32_t codePos = 0;
 		uint32_t codePosFirst = 0;
 		uint32_t vm_flags = 0;
 		uint32_t prevCFROUND = 0;
+		int prefetchMode = -1;
 
 #		ifdef XMRIG_FIX_RYZEN
 		std::pair<const void*, const void*> mainLoopBounds;
@@ -99,6 +109,7 @@ namespace randomx {
 		bool hasAVX;
 		bool hasAVX2;
 		bool initDatasetAVX2;
+		bool initDatasetAVX512;
 		bool hasXOP;
 
 		uint8_t* allocatedCode = nullptr;
@@ -110,14 +121,17 @@ namespace randomx {
 		void generateProgramPrologue(Program&, ProgramConfiguration&);
 		void generateProgramEpilogue(Program&, ProgramConfiguration&);
 		template<bool rax>
-		static void genAddressReg(const Instruction&, const uint32_t src, uint8_t* code, uint32_t& codePos);
-		static void genAddressRegDst(const Instruction&, uint8_t* code, uint32_t& codePos);
-		static void genAddressImm(const Instruction&, uint8_t* code, uint32_t& codePos);
+		void genAddressReg(const Instruction&, const uint32_t src, uint8_t* code, uint32_t& codePos);
+		void genAddressRegDst(const Instruction&, uint8_t* code, uint32_t& codePos);
+		void genAddressImm(const Instruction&, uint8_t* code, uint32_t& codePos);
 		static uint32_t genSIB(int scale, int index, int base) { return (scale << 6) | (index << 3) | base; }
 
 		template<bool AVX2>
 		void generateSuperscalarCode(Instruction& inst, uint8_t* code, uint32_t& codePos);
 
+		void generateDatasetInitAVX512(SuperscalarProgram* programs);
+		static void generateSuperscalarCodeAVX512(Instruction& inst, uint8_t* code, uint32_t& codePos);
+
 		static void emitByte(uint8_t val, uint8_t* code, uint32_t& codePos) {
 			code[codePos] = val;
 			++codePos;
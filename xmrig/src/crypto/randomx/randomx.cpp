@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "backend/cpu/Cpu.h"
 #include "crypto/common/VirtualMemory.h"
+#include <atomic>
 #include <mutex>
 
 #include <cassert>
@@ -193,13 +194,53 @@ RandomX_ConfigurationBase::RandomX_ConfigurationBase()
 static uint32_t Log2(size_t value) { return (value > 1) ? (Log2(value / 2) + 1) : 0; }
 #endif
 
-static int scratchpadPrefetchMode = 1;
+// Read by JIT compilers of all VMs, every generated program picks up the current mode.
+static std::atomic<int> scratchpadPrefetchMode{ 1 };
 
 void randomx_set_scratchpad_prefetch_mode(int mode)
 {
-	scratchpadPrefetchMode = mode;
+	scratchpadPrefetchMode.store(mode, std::memory_order_relaxed);
 }
 
+int randomx_get_scratchpad_prefetch_mode()
+{
+	return scratchpadPrefetchMode.load(std::memory_order_relaxed);
+}
+
+#if defined(XMRIG_FEATURE_ASM) && (defined(_M_X64) || defined(__x86_64__))
+void randomx_apply_scratchpad_prefetch_mode(uint8_t* code, int mode)
+{
+	const bool hasBMI2 = xmrig::Cpu::info()->hasBMI2();
+
+	uint32_t* a = (uint32_t*)(code + (hasBMI2 ? 11 : 8));
+	uint32_t* b = (uint32_t*)(code + (hasBMI2 ? 21 : 22));
+
+	switch (mode)
+	{
+	case 0:
+		*a = 0x00401F0FUL; // 4-byte nop
+		*b = 0x00401F0FUL; // 4-byte nop
+		break;
+
+	case 1:
+	default:
+		*a = 0x060C180FUL; // prefetcht0 [rsi+rax]
+		*b = 0x160C180FUL; // prefetcht0 [rsi+rdx]
+		break;
+
+	case 2:
+		*a = 0x0604180FUL; // prefetchnta [rsi+rax]
+		*b = 0x1604180FUL; // prefetchnta [rsi+rdx]
+		break;
+
+	case 3:
+		*a = 0x060C8B48UL; // mov rcx, [rsi+rax]
+		*b = 0x160C8B48UL; // mov rcx, [rsi+rdx]
+		break;
+	}
+}
+#endif
+
 void RandomX_ConfigurationBase::Apply()
 {
 	const uint32_t ScratchpadL1Mask_Calculated = (ScratchpadL1_Size / sizeof(uint64_t) - 1) * 8;
@@ -226,41 +267,14 @@ void RandomX_ConfigurationBase::Apply()
 	*(uint32_t*)(codePrefetchScratchpadTweaked + (hasBMI2 ? 7 : 4)) = ScratchpadL3Mask64_Calculated;
 	*(uint32_t*)(codePrefetchScratchpadTweaked + (hasBMI2 ? 17 : 18)) = ScratchpadL3Mask64_Calculated;
 
-	// Apply scratchpad prefetch mode
-	{
-		uint32_t* a = (uint32_t*)(codePrefetchScratchpadTweaked + (hasBMI2 ? 11 : 8));
-		uint32_t* b = (uint32_t*)(codePrefetchScratchpadTweaked + (hasBMI2 ? 21 : 22));
-
-		switch (scratchpadPrefetchMode)
-		{
-		case 0:
-			*a = 0x00401F0FUL; // 4-byte nop
-			*b = 0x00401F0FUL; // 4-byte nop
-			break;
-
-		case 1:
-		default:
-			*a = 0x060C180FUL; // prefetcht0 [rsi+rax]
-			*b = 0x160C180FUL; // prefetcht0 [rsi+rdx]
-			break;
-
-		case 2:
-			*a = 0x0604180FUL; // prefetchnta [rsi+rax]
-			*b = 0x1604180FUL; // prefetchnta [rsi+rdx]
-			break;
-
-		case 3:
-			*a = 0x060C8B48UL; // mov rcx, [rsi+rax]
-			*b = 0x160C8B48UL; // mov rcx, [rsi+rdx]
-			break;
-		}
-	}
+	// Default scratchpad prefetch mode, JitCompilerX86 patches the mode into every program it generates
+	randomx_apply_scratchpad_prefetch_mode(codePrefetchScratchpadTweaked, randomx_get_scratchpad_prefetch_mode());
 
 typedef void(randomx::JitCompilerX86::* InstructionGeneratorX86_2)(const randomx::Instruction&);
 
 #define JIT_HANDLE(x, prev) do { \
 		const InstructionGeneratorX86_2 p = &randomx::JitCompilerX86::h_##x; \
-		memcpy(randomx::JitCompilerX86::engine + k, &p, sizeof(p)); \
+		memcpy(JIT_Engine + k, &p, sizeof(JIT_Engine[k])); \
 	} while (0)
 
 #elif (XMRIG_ARM == 8)
@@ -271,7 +285,7 @@ typedef void(randomx::JitCompilerX86::* InstructionGeneratorX86_2)(const randomx
 	Log2_DatasetBaseSize = Log2(DatasetBaseSize);
 	Log2_CacheSize = Log2((ArgonMemory * randomx::ArgonBlockSize) / randomx::CacheLineSize);
 
-#define JIT_HANDLE(x, prev) randomx::JitCompilerA64::engine[k] = &randomx::JitCompilerA64::h_##x
+#define JIT_HANDLE(x, prev) JIT_Engine[k] = &randomx::JitCompilerA64::h_##x
 
 #else
 #define JIT_HANDLE(x, prev)
@@ -352,14 +366,12 @@ typedef void(randomx::JitCompilerX86::* InstructionGeneratorX86_2)(const randomx
 #undef INST_HANDLE
 }
 
-RandomX_ConfigurationMonero RandomX_MoneroConfig;
-RandomX_ConfigurationWownero RandomX_WowneroConfig;
-RandomX_ConfigurationArqma RandomX_ArqmaConfig;
-RandomX_ConfigurationGraft RandomX_GraftConfig;
-RandomX_ConfigurationSafex RandomX_SafexConfig;
-RandomX_ConfigurationKeva RandomX_KevaConfig;
-
-alignas(64) RandomX_ConfigurationBase RandomX_CurrentConfig;
+alignas(64) RandomX_ConfigurationMonero RandomX_MoneroConfig;
+alignas(64) RandomX_ConfigurationWownero RandomX_WowneroConfig;
+alignas(64) RandomX_ConfigurationArqma RandomX_ArqmaConfig;
+alignas(64) RandomX_ConfigurationGraft RandomX_GraftConfig;
+alignas(64) RandomX_ConfigurationSafex RandomX_SafexConfig;
+alignas(64) RandomX_ConfigurationKeva RandomX_KevaConfig;
 
 static std::mutex vm_pool_mutex;
 
@@ -403,9 +415,11 @@ extern "C" {
 		return cache;
 	}
 
-	void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize) {
+	void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize, const RandomX_ConfigurationBase *config) {
 		assert(cache != nullptr);
 		assert(keySize == 0 || key != nullptr);
+		assert(config != nullptr);
+		cache->rxConfig = config;
 		cache->initialize(cache, key, keySize);
 	}
 
@@ -425,7 +439,7 @@ extern "C" {
 		return dataset;
 	}
 
-	#define DatasetItemCount ((RandomX_CurrentConfig.DatasetBaseSize + RandomX_CurrentConfig.DatasetExtraSize) / RANDOMX_DATASET_ITEM_SIZE)
+	#define DatasetItemCount ((RandomX_ConfigurationBase::DatasetBaseSize + RandomX_ConfigurationBase::DatasetExtraSize) / RANDOMX_DATASET_ITEM_SIZE)
 
 	unsigned long randomx_dataset_item_count() {
 		return DatasetItemCount;
@@ -439,6 +453,38 @@ extern "C" {
 		cache->datasetInit(cache, dataset->memory + startItem * randomx::CacheLineSize, startItem, startItem + itemCount);
 	}
 
+	unsigned long randomx_dataset_init_batch(randomx_cache *cache) {
+		assert(cache != nullptr);
+		return cache->jit ? cache->jit->getDatasetInitBatch() : 1;
+	}
+
+	bool randomx_dataset_init_avx512(randomx_cache *cache) {
+		assert(cache != nullptr);
+		return cache->jit && cache->jit->isDatasetInitAVX512();
+	}
+
+	void randomx_disable_dataset_init_avx512(randomx_cache *cache) {
+		assert(cache != nullptr);
+		if (!randomx_dataset_init_avx512(cache)) {
+			return;
+		}
+
+		cache->jit->disableDatasetInitAVX512();
+		randomx::compileDatasetInit(cache);
+	}
+
+	void randomx_calculate_dataset_item(randomx_cache *cache, unsigned long itemNumber, void *output) {
+		assert(cache != nullptr && cache->isInitialized());
+		randomx::initDatasetItem(cache, static_cast<uint8_t*>(output), itemNumber);
+	}
+
+	void randomx_set_dataset_prefix(randomx_cache *cache, void *memory, unsigned long itemCount) {
+		assert(cache != nullptr);
+		assert(memory != nullptr || itemCount == 0);
+		cache->datasetPrefix = static_cast<uint8_t*>(memory);
+		cache->datasetPrefixItems = memory ? itemCount : 0;
+	}
+
 	void *randomx_get_dataset_memory(randomx_dataset *dataset) {
 		assert(dataset != nullptr);
 		return dataset->memory;
@@ -448,9 +494,11 @@ extern "C" {
 		delete dataset;
 	}
 
-	randomx_vm* randomx_create_vm(randomx_flags flags, randomx_cache* cache, randomx_dataset* dataset, uint8_t* scratchpad, uint32_t node) {
+	randomx_vm* randomx_create_vm(randomx_flags flags, randomx_cache* cache, randomx_dataset* dataset, uint8_t* scratchpad, uint32_t node, const RandomX_ConfigurationBase* config) {
 		assert(cache != nullptr || (flags & RANDOMX_FLAG_FULL_MEM));
 		assert(cache == nullptr || cache->isInitialized());
+		assert(cache == nullptr || cache->rxConfig == config);
+		assert(config != nullptr);
 		assert(dataset != nullptr || !(flags & RANDOMX_FLAG_FULL_MEM));
 
 		randomx_vm* vm = nullptr;
@@ -523,6 +571,8 @@ extern "C" {
 					UNREACHABLE;
 			}
 
+			vm->setConfig(config);
+
 			if (cache != nullptr) {
 				vm->setCache(cache);
 			}
@@ -551,6 +601,7 @@ extern "C" {
 	void randomx_vm_set_cache(randomx_vm *machine, randomx_cache* cache) {
 		assert(machine != nullptr);
 		assert(cache != nullptr && cache->isInitialized());
+		assert(cache->rxConfig == machine->getConfig());
 		machine->setCache(cache);
 	}
 
@@ -564,6 +615,22 @@ extern "C" {
 		vm->~randomx_vm();
 	}
 
+	void randomx_vm_set_scratchpad_prefetch_mode(randomx_vm *machine, int mode) {
+		assert(machine != nullptr);
+		machine->setScratchpadPrefetchMode(mode);
+	}
+
+	void randomx_get_dataset_reads(randomx_vm *machine, uint64_t *hits, uint64_t *misses) {
+		assert(machine != nullptr);
+		*hits = machine->getDatasetHits();
+		*misses = machine->getDatasetMisses();
+	}
+
+	const RandomX_ConfigurationBase *randomx_vm_get_config(randomx_vm *machine) {
+		assert(machine != nullptr);
+		return machine->getConfig();
+	}
+
 	void randomx_calculate_hash(randomx_vm *machine, const void *input, size_t inputSize, void *output) {
 		assert(machine != nullptr);
 		assert(inputSize == 0 || input != nullptr);
@@ -572,7 +639,7 @@ extern "C" {
 		rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), input, inputSize);
 		machine->initScratchpad(&tempHash);
 		machine->resetRoundingMode();
-		for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
+		for (uint32_t chain = 0; chain < machine->getConfig()->ProgramCount - 1; ++chain) {
 			machine->run(&tempHash);
 			rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile));
 		}
@@ -589,7 +656,7 @@ extern "C" {
 		PROFILE_SCOPE(RandomX_hash);
 
 		machine->resetRoundingMode();
-		for (uint32_t chain = 0; chain < RandomX_CurrentConfig.ProgramCount - 1; ++chain) {
+		for (uint32_t chain = 0; chain < machine->getConfig()->ProgramCount - 1; ++chain) {
 			machine->run(&tempHash);
 			rx_blake2b_wrapper::run(tempHash, sizeof(tempHash), machine->getRegisterFile(), sizeof(randomx::RegisterFile));
 		}
@@ -57,6 +57,12 @@ struct randomx_dataset;
 struct randomx_cache;
 class randomx_vm;
 
+namespace randomx {
+	class Instruction;
+	class JitCompilerA64;
+	class JitCompilerX86;
+}
+
 
 struct RandomX_ConfigurationBase
 {
@@ -132,6 +138,13 @@ struct RandomX_ConfigurationBase
 	uint32_t ScratchpadL3Mask_Calculated;
 	uint32_t ScratchpadL3Mask64_Calculated;
 
+	// JIT instruction generators indexed by opcode, filled by Apply() from the instruction frequencies
+#	if defined(_M_X64) || defined(__x86_64__)
+	alignas(64) void (*JIT_Engine[256])(randomx::JitCompilerX86*, const randomx::Instruction&);
+#	elif (XMRIG_ARM == 8)
+	void (randomx::JitCompilerA64::*JIT_Engine[256])(randomx::Instruction&, uint32_t&);
+#	endif
+
 #	if (XMRIG_ARM == 8)
 	uint32_t Log2_ScratchpadL1;
 	uint32_t Log2_ScratchpadL2;
@@ -155,20 +168,25 @@ extern RandomX_ConfigurationGraft RandomX_GraftConfig;
 extern RandomX_ConfigurationSafex RandomX_SafexConfig;
 extern RandomX_ConfigurationKeva RandomX_KevaConfig;
 
-extern RandomX_ConfigurationBase RandomX_CurrentConfig;
-
+/**
+ * Calculates derived parameters and JIT tables of a configuration. Every cache and VM refers to its own configuration,
+ * so caches and VMs of different RandomX variants can hash at the same time. A configuration must be applied once
+ * before it is used and never while it is in use, xmrig::RxAlgo::apply() takes care of it.
+ */
 template<typename T>
-void randomx_apply_config(const T& config)
+const RandomX_ConfigurationBase *randomx_apply_config(T& config)
 {
 	static_assert(sizeof(T) == sizeof(RandomX_ConfigurationBase), "Invalid RandomX configuration struct size");
 	static_assert(std::is_base_of<RandomX_ConfigurationBase, T>::value, "Incompatible RandomX configuration struct");
-	RandomX_CurrentConfig = config;
-	RandomX_CurrentConfig.Apply();
+	config.Apply();
+	return &config;
 }
 
 void randomx_set_scratchpad_prefetch_mode(int mode);
+int randomx_get_scratchpad_prefetch_mode();
 void randomx_set_huge_pages_jit(bool hugePages);
 void randomx_set_optimized_dataset_init(int value);
+void randomx_set_optimized_dataset_init_avx512(int value);
 
 #if defined(__cplusplus)
 extern "C" {
@@ -194,8 +212,9 @@ RANDOMX_EXPORT randomx_cache *randomx_create_cache(randomx_flags flags, uint8_t
  * @param cache is a pointer to a previously allocated randomx_cache structure. Must not be NULL.
  * @param key is a pointer to memory which contains the key value. Must not be NULL.
  * @param keySize is the number of bytes of the key.
+ * @param config is a pointer to an applied configuration of the RandomX variant. Must not be NULL.
 */
-RANDOMX_EXPORT void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize);
+RANDOMX_EXPORT void randomx_init_cache(randomx_cache *cache, const void *key, size_t keySize, const RandomX_ConfigurationBase *config);
 
 /**
  * Releases all memory occupied by the randomx_cache structure.
@@ -235,6 +254,51 @@ RANDOMX_EXPORT unsigned long randomx_dataset_item_count(void);
 */
 RANDOMX_EXPORT void randomx_init_dataset(randomx_dataset *dataset, randomx_cache *cache, unsigned long startItem, unsigned long itemCount);
 
+/**
+ * Gets the number of items the dataset initialization code of the cache computes per pass.
+ * itemCount passed to randomx_init_dataset must be a multiple of this value.
+ *
+ * @param cache is a pointer to a previously allocated and initialized randomx_cache structure. Must not be NULL.
+ *
+ * @return 8 for AVX-512 code, 5 for AVX2 code, 1 otherwise.
+*/
+RANDOMX_EXPORT unsigned long randomx_dataset_init_batch(randomx_cache *cache);
+
+/**
+ * Checks if the dataset initialization code of the cache uses AVX-512.
+ *
+ * @param cache is a pointer to a previously allocated and initialized randomx_cache structure. Must not be NULL.
+*/
+RANDOMX_EXPORT bool randomx_dataset_init_avx512(randomx_cache *cache);
+
+/**
+ * Regenerates the dataset initialization code of the cache without AVX-512,
+ * used as a fallback if the AVX-512 code produced wrong results.
+ *
+ * @param cache is a pointer to a previously allocated and initialized randomx_cache structure. Must not be NULL.
+*/
+RANDOMX_EXPORT void randomx_disable_dataset_init_avx512(randomx_cache *cache);
+
+/**
+ * Calculates a single dataset item with the portable implementation, used as a reference
+ * for the optimized dataset initialization code.
+ *
+ * @param cache is a pointer to a previously allocated and initialized randomx_cache structure. Must not be NULL.
+ * @param itemNumber is the item number.
+ * @param output is a pointer to a buffer of RANDOMX_DATASET_ITEM_SIZE bytes.
+*/
+RANDOMX_EXPORT void randomx_calculate_dataset_item(randomx_cache *cache, unsigned long itemNumber, void *output);
+
+/**
+ * Makes light mode VMs read dataset items [0, itemCount) from memory instead of computing them from the cache.
+ * The items must be computed from this cache, for example by randomx_init_dataset. Pass NULL and 0 to disable.
+ *
+ * @param cache is a pointer to a previously allocated and initialized randomx_cache structure. Must not be NULL.
+ * @param memory is a pointer to itemCount * RANDOMX_DATASET_ITEM_SIZE bytes of dataset items.
+ * @param itemCount is the number of items in memory.
+*/
+RANDOMX_EXPORT void randomx_set_dataset_prefix(randomx_cache *cache, void *memory, unsigned long itemCount);
+
 /**
  * Returns a pointer to the internal memory buffer of the dataset structure. The size
  * of the internal memory buffer is randomx_dataset_item_count() * RANDOMX_DATASET_ITEM_SIZE.
@@ -267,6 +331,8 @@ RANDOMX_EXPORT void randomx_release_dataset(randomx_dataset *dataset);
  *        NULL if RANDOMX_FLAG_FULL_MEM is set.
  * @param dataset is a pointer to a randomx_dataset structure. Can be NULL
  *        if RANDOMX_FLAG_FULL_MEM is not set.
+ * @param config is a pointer to an applied configuration of the RandomX variant. Must not be NULL
+ *        and must match the configuration of the cache if RANDOMX_FLAG_FULL_MEM is not set.
  *
  * @return Pointer to an initialized randomx_vm structure.
  *         Returns NULL if:
@@ -275,7 +341,7 @@ RANDOMX_EXPORT void randomx_release_dataset(randomx_dataset *dataset);
  *         (3) cache parameter is NULL and RANDOMX_FLAG_FULL_MEM is not set
  *         (4) dataset parameter is NULL and RANDOMX_FLAG_FULL_MEM is set
 */
-RANDOMX_EXPORT randomx_vm *randomx_create_vm(randomx_flags flags, randomx_cache *cache, randomx_dataset *dataset, uint8_t *scratchpad, uint32_t node);
+RANDOMX_EXPORT randomx_vm *randomx_create_vm(randomx_flags flags, randomx_cache *cache, randomx_dataset *dataset, uint8_t *scratchpad, uint32_t node, const RandomX_ConfigurationBase *config);
 
 /**
  * Reinitializes a virtual machine with a new Cache. This function should be called anytime
@@ -303,6 +369,31 @@ RANDOMX_EXPORT void randomx_vm_set_dataset(randomx_vm *machine, randomx_dataset
 */
 RANDOMX_EXPORT void randomx_destroy_vm(randomx_vm *machine);
 
+/**
+ * Overrides the scratchpad prefetch mode set by randomx_set_scratchpad_prefetch_mode for a single virtual machine,
+ * used by programs generated after this call. Without an override programs use the global mode at the time they are
+ * generated. Only JIT compiled machines on x86-64 support it.
+ *
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+ * @param mode is the prefetch mode (0-3) or -1 to use the global mode.
+*/
+RANDOMX_EXPORT void randomx_vm_set_scratchpad_prefetch_mode(randomx_vm *machine, int mode);
+
+/**
+ * Gets the number of dataset reads of a light mode virtual machine served from the dataset prefix (hits)
+ * and computed from the cache (misses). Always 0 if the machine doesn't count them (full mode, ARM64 JIT).
+ *
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+*/
+RANDOMX_EXPORT void randomx_get_dataset_reads(randomx_vm *machine, uint64_t *hits, uint64_t *misses);
+
+/**
+ * Gets the configuration of the RandomX variant used by a virtual machine.
+ *
+ * @param machine is a pointer to a randomx_vm structure. Must not be NULL.
+*/
+RANDOMX_EXPORT const RandomX_ConfigurationBase *randomx_vm_get_config(randomx_vm *machine);
+
 /**
  * Calculates a RandomX hash value.
  *
@@ -581,7 +581,7 @@ namespace randomx {
 	static int scheduleUop(ExecutionPort::type uop, ExecutionPort::type(&portBusy)[CYCLE_MAP_SIZE][3], int cycle) {
 		//The scheduling here is done optimistically by checking port availability in order P5 -> P0 -> P1 to not overload
 		//port P1 (multiplication) by instructions that can go to any port.
-		for (; cycle < static_cast<int>(RandomX_CurrentConfig.SuperscalarLatency) + 4; ++cycle) {
+		for (; cycle < static_cast<int>(RandomX_ConfigurationBase::SuperscalarLatency) + 4; ++cycle) {
 			if ((uop & ExecutionPort::P5) != 0 && !portBusy[cycle][2]) {
 				if (commit) {
 					if (trace) std::cout << "; P5 at cycle " << cycle << std::endl;
@@ -626,7 +626,7 @@ namespace randomx {
 		}
 		else {
 			//macro-ops with 2 uOPs are scheduled conservatively by requiring both uOPs to execute in the same cycle
-			for (; cycle < static_cast<int>(RandomX_CurrentConfig.SuperscalarLatency) + 4; ++cycle) {
+			for (; cycle < static_cast<int>(RandomX_ConfigurationBase::SuperscalarLatency) + 4; ++cycle) {
 
 				int cycle1 = scheduleUop<false>(mop.getUop1(), portBusy, cycle);
 				int cycle2 = scheduleUop<false>(mop.getUop2(), portBusy, cycle);
@@ -669,7 +669,7 @@ namespace randomx {
 		//Since a decode cycle produces on average 3.45 macro-ops and there are only 3 ALU ports, execution ports are always
 		//saturated first. The cycle limit is present only to guarantee loop termination.
 		//Program size is limited to SuperscalarMaxSize instructions.
-		for (decodeCycle = 0; decodeCycle < static_cast<int>(RandomX_CurrentConfig.SuperscalarLatency) && !portsSaturated && programSize < 3 * static_cast<int>(RandomX_CurrentConfig.SuperscalarLatency) + 2; ++decodeCycle) {
+		for (decodeCycle = 0; decodeCycle < static_cast<int>(RandomX_ConfigurationBase::SuperscalarLatency) && !portsSaturated && programSize < 3 * static_cast<int>(RandomX_ConfigurationBase::SuperscalarLatency) + 2; ++decodeCycle) {
 
 			//select a decode configuration
 			decodeBuffer = decodeBuffer->fetchNext(currentInstruction.getType(), decodeCycle, mulCount, gen);
@@ -683,7 +683,7 @@ namespace randomx {
 
 				//if we have issued all macro-ops for the current RandomX instruction, create a new instruction
 				if (macroOpIndex >= currentInstruction.getInfo().getSize()) {
-					if (portsSaturated || programSize >= 3 * static_cast<int>(RandomX_CurrentConfig.SuperscalarLatency) + 2)
+					if (portsSaturated || programSize >= 3 * static_cast<int>(RandomX_ConfigurationBase::SuperscalarLatency) + 2)
 						break;
 					//select an instruction so that the first macro-op fits into the current slot
 					currentInstruction.createForSlot(gen, decodeBuffer->getCounts()[bufferIndex], decodeBuffer->getIndex(), decodeBuffer->getSize() == bufferIndex + 1, bufferIndex == 0);
@@ -783,7 +783,7 @@ namespace randomx {
 				macroOpCount++;
 
 				//terminating condition
-				if (scheduleCycle >= static_cast<int>(RandomX_CurrentConfig.SuperscalarLatency)) {
+				if (scheduleCycle >= static_cast<int>(RandomX_ConfigurationBase::SuperscalarLatency)) {
 					portsSaturated = true;
 				}
 				cycle = topCycle;
@@ -112,17 +112,23 @@ namespace randomx {
 
 	template<int softAes>
 	void VmBase<softAes>::getFinalResult(void* out) {
-		hashAes1Rx4<softAes>(scratchpad, ScratchpadSize, &reg.a);
+		if (!softAes) {
+			hashAes1Rx4<0>(scratchpad, rxConfig->ScratchpadL3_Size, &reg.a);
+		}
+		else {
+			(*GetSoftAESHashImpl())(scratchpad, rxConfig->ScratchpadL3_Size, &reg.a);
+		}
+
 		rx_blake2b_wrapper::run(out, RANDOMX_HASH_SIZE, &reg, sizeof(RegisterFile));
 	}
 
 	template<int softAes>
 	void VmBase<softAes>::hashAndFill(void* out, uint64_t (&fill_state)[8]) {
 		if (!softAes) {
-			hashAndFillAes1Rx4<0, 2>(scratchpad, ScratchpadSize, &reg.a, fill_state);
+			hashAndFillAes1Rx4<0, 2>(scratchpad, rxConfig->ScratchpadL3_Size, &reg.a, fill_state);
 		}
 		else {
-			(*GetSoftAESImpl())(scratchpad, ScratchpadSize, &reg.a, fill_state);
+			(*GetSoftAESImpl())(scratchpad, rxConfig->ScratchpadL3_Size, &reg.a, fill_state);
 		}
 
 		rx_blake2b_wrapper::run(out, RANDOMX_HASH_SIZE, &reg, sizeof(RegisterFile));
@@ -130,13 +136,23 @@ namespace randomx {
 
 	template<int softAes>
 	void VmBase<softAes>::initScratchpad(void* seed) {
-		fillAes1Rx4<softAes>(seed, ScratchpadSize, scratchpad);
+		if (!softAes) {
+			fillAes1Rx4<0>(seed, rxConfig->ScratchpadL3_Size, scratchpad);
+		}
+		else {
+			(*GetSoftAESFill1Impl())(seed, rxConfig->ScratchpadL3_Size, scratchpad);
+		}
 	}
 
 	template<int softAes>
 	void VmBase<softAes>::generateProgram(void* seed) {
 		PROFILE_SCOPE(RandomX_generate_program);
-		fillAes4Rx4<softAes>(seed, 128 + RandomX_CurrentConfig.ProgramSize * 8, &program);
+		if (!softAes) {
+			fillAes4Rx4<0>(seed, 128 + rxConfig->ProgramSize * 8, &program, *rxConfig);
+		}
+		else {
+			(*GetSoftAESFill4Impl())(seed, 128 + rxConfig->ProgramSize * 8, &program, *rxConfig);
+		}
 	}
 
 	template class VmBase<false>;
@@ -42,6 +42,7 @@ public:
 	virtual void hashAndFill(void* out, uint64_t (&fill_state)[8]) = 0;
 	virtual void setDataset(randomx_dataset* dataset) { }
 	virtual void setCache(randomx_cache* cache) { }
+	virtual void setScratchpadPrefetchMode(int mode) { }
 	virtual void initScratchpad(void* seed) = 0;
 	virtual void run(void* seed) = 0;
 	void resetRoundingMode();
@@ -49,6 +50,9 @@ public:
 	void setFlags(uint32_t flags) { vm_flags = flags; }
 	uint32_t getFlags() const { return vm_flags; }
 
+	virtual void setConfig(const RandomX_ConfigurationBase* config) { rxConfig = config; }
+	const RandomX_ConfigurationBase* getConfig() const { return rxConfig; }
+
 	randomx::RegisterFile *getRegisterFile() {
 		return &reg;
 	}
@@ -62,18 +66,23 @@ public:
 		return program;
 	}
 
+	uint64_t getDatasetHits() const { return datasetReads[0]; }
+	uint64_t getDatasetMisses() const { return datasetReads[1]; }
+
 protected:
 	void initialize();
 	alignas(64) randomx::Program program;
 	alignas(64) randomx::RegisterFile reg;
 	alignas(16) randomx::ProgramConfiguration config;
 	randomx::MemoryRegisters mem;
+	const RandomX_ConfigurationBase* rxConfig = nullptr;
 	uint8_t* scratchpad = nullptr;
 	union {
 		randomx_cache* cachePtr = nullptr;
 		randomx_dataset* datasetPtr;
 	};
 	uint64_t datasetOffset;
+	uint64_t datasetReads[2] = {};    //light mode reads served from the dataset prefix and computed from the cache
 	uint32_t vm_flags;
 };
 
@@ -61,7 +61,7 @@ namespace randomx {
 #		ifdef XMRIG_ARM
 		memcpy(reg.f, config.eMask, sizeof(config.eMask));
 #		endif
-		compiler.getProgramFunc()(reg, mem, scratchpad, RandomX_CurrentConfig.ProgramIterations);
+		compiler.getProgramFunc()(reg, mem, scratchpad, rxConfig->ProgramIterations);
 	}
 
 	template class CompiledVm<false>;
@@ -45,7 +45,9 @@ namespace randomx {
 		void* operator new(size_t, void* ptr) { return ptr; }
 		void operator delete(void*) {}
 
+		void setConfig(const RandomX_ConfigurationBase* cfg) override { randomx_vm::setConfig(cfg); compiler.setConfig(cfg); }
 		void setDataset(randomx_dataset* dataset) override;
+		void setScratchpadPrefetchMode(int mode) override { compiler.setScratchpadPrefetchMode(mode); }
 		void run(void* seed) override;
 
 		using VmBase<softAes>::mem;
@@ -55,6 +57,7 @@ namespace randomx {
 		using VmBase<softAes>::scratchpad;
 		using VmBase<softAes>::datasetPtr;
 		using VmBase<softAes>::datasetOffset;
+		using VmBase<softAes>::rxConfig;
 
 	protected:
 		void execute();
@@ -55,7 +55,7 @@ namespace randomx {
 		compiler.enableWriting();
 #		endif
 
-		compiler.generateProgramLight(program, config, datasetOffset);
+		compiler.generateProgramLight(program, config, datasetOffset, cachePtr->datasetPrefix, cachePtr->datasetPrefixItems, datasetReads);
 
 		CompiledVm<softAes>::execute();
 	}
@@ -50,6 +50,7 @@ namespace randomx {
 		using CompiledVm<softAes>::config;
 		using CompiledVm<softAes>::cachePtr;
 		using CompiledVm<softAes>::datasetOffset;
+		using CompiledVm<softAes>::datasetReads;
 	};
 
 	using CompiledLightVmDefault = CompiledLightVm<1>;
@@ -54,17 +54,17 @@ namespace randomx {
 		for(unsigned i = 0; i < RegisterCountFlt; ++i)
 			nreg.a[i] = rx_load_vec_f128(&reg.a[i].lo);
 
-		compileProgram(program, bytecode, nreg);
+		compileProgram(program, bytecode, nreg, *rxConfig);
 
 		uint32_t spAddr0 = mem.mx;
 		uint32_t spAddr1 = mem.ma;
 
-		for(unsigned ic = 0; ic < RandomX_CurrentConfig.ProgramIterations; ++ic) {
+		for(unsigned ic = 0; ic < rxConfig->ProgramIterations; ++ic) {
 			uint64_t spMix = nreg.r[config.readReg0] ^ nreg.r[config.readReg1];
 			spAddr0 ^= spMix;
-			spAddr0 &= ScratchpadL3Mask64;
+			spAddr0 &= rxConfig->ScratchpadL3Mask64_Calculated;
 			spAddr1 ^= spMix >> 32;
-			spAddr1 &= ScratchpadL3Mask64;
+			spAddr1 &= rxConfig->ScratchpadL3Mask64_Calculated;
 			
 			for (unsigned i = 0; i < RegistersCount; ++i)
 				nreg.r[i] ^= load64(scratchpad + spAddr0 + 8 * i);
@@ -75,7 +75,7 @@ namespace randomx {
 			for (unsigned i = 0; i < RegisterCountFlt; ++i)
 				nreg.e[i] = maskRegisterExponentMantissa(config, rx_cvt_packed_int_vec_f128(scratchpad + spAddr1 + 8 * (RegisterCountFlt + i)));
 
-			executeBytecode(bytecode, scratchpad, config);
+			executeBytecode(bytecode, rxConfig->ProgramSize, scratchpad, config);
 
 			mem.mx ^= nreg.r[config.readReg2] ^ nreg.r[config.readReg3];
 			mem.mx &= CacheLineAlignMask;
@@ -48,6 +48,7 @@ namespace randomx {
 		using VmBase<softAes>::reg;
 		using VmBase<softAes>::datasetPtr;
 		using VmBase<softAes>::datasetOffset;
+		using VmBase<softAes>::rxConfig;
 
 		void* operator new(size_t, void* ptr) { return ptr; }
 		void operator delete(void*) {}
@@ -28,6 +28,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "crypto/randomx/vm_interpreted_light.hpp"
 #include "crypto/randomx/dataset.hpp"
+#include <cstring>
 
 namespace randomx {
 
@@ -41,8 +42,15 @@ namespace randomx {
 	void InterpretedLightVm<softAes>::datasetRead(uint64_t address, int_reg_t(&r)[8]) {
 		uint32_t itemNumber = address / CacheLineSize;
 		int_reg_t rl[8];
-		
-		initDatasetItem(cachePtr, (uint8_t*)rl, itemNumber);
+
+		if (itemNumber < cachePtr->datasetPrefixItems) {
+			++datasetReads[0];
+			memcpy(rl, cachePtr->datasetPrefix + static_cast<size_t>(itemNumber) * CacheLineSize, sizeof(rl));
+		}
+		else {
+			++datasetReads[1];
+			initDatasetItem(cachePtr, (uint8_t*)rl, itemNumber);
+		}
 
 		for (unsigned q = 0; q < 8; ++q)
 			r[q] ^= rl[q];
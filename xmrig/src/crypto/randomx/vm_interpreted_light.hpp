@@ -38,6 +38,7 @@ namespace randomx {
 	public:
 		using VmBase<softAes>::mem;
 		using VmBase<softAes>::cachePtr;
+		using VmBase<softAes>::datasetReads;
 
 		void* operator new(size_t, void* ptr) { return ptr; }
 		void operator delete(void*) {}
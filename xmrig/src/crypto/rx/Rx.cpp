@@ -20,7 +20,11 @@
 #include "crypto/rx/Rx.h"
 #include "backend/cpu/CpuConfig.h"
 #include "backend/cpu/CpuThreads.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
 #include "crypto/rx/RxConfig.h"
+#include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxDiskCache.h"
 #include "crypto/rx/RxQueue.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/randomx/aes_hash.hpp"
@@ -32,6 +36,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_RESCTRL
+#   include "hw/resctrl/Resctrl.h"
+#endif
+
+
 namespace xmrig {
 
 
@@ -39,7 +48,9 @@ class RxPrivate;
 
 
 static bool osInitialized   = false;
+static bool softAesSelected = false;
 static RxPrivate *d_ptr     = nullptr;
+static SoftAesImpl softAes  = SOFT_AES_AUTO;
 
 
 class RxPrivate
@@ -66,12 +77,48 @@ xmrig::RxDataset *xmrig::Rx::dataset(const Job &job, uint32_t nodeId)
 }
 
 
+std::vector<xmrig::NumaPagesInfo> xmrig::Rx::numaPages()
+{
+    return d_ptr ? d_ptr->queue.numaPages() : std::vector<NumaPagesInfo>();
+}
+
+
+std::shared_ptr<xmrig::RxDataset> xmrig::Rx::lightDataset(const Job &job, uint32_t threadId)
+{
+    return d_ptr->queue.lightDataset(job, threadId);
+}
+
+
+bool xmrig::Rx::isLightReady(const Job &job)
+{
+    return d_ptr && d_ptr->queue.isLightReady(job);
+}
+
+
+uint64_t xmrig::Rx::initTime()
+{
+    return d_ptr ? d_ptr->queue.initTime() : 0;
+}
+
+
+void xmrig::Rx::addLightHashes(uint32_t group, uint64_t count)
+{
+    d_ptr->queue.addLightHashes(group, count);
+}
+
+
 void xmrig::Rx::destroy()
 {
 #   ifdef XMRIG_FEATURE_MSR
     RxMsr::destroy();
 #   endif
 
+#   ifdef XMRIG_FEATURE_RESCTRL
+    Resctrl::destroy();
+#   endif
+
+    RxDiskCache::cancel();
+
     delete d_ptr;
 
     d_ptr = nullptr;
@@ -100,9 +147,19 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
         RxMsr::destroy();
 #       endif
 
+#       ifdef XMRIG_FEATURE_RESCTRL
+        Resctrl::destroy();
+#       endif
+
         return true;
     }
 
+#   ifdef XMRIG_FEATURE_RESCTRL
+    if (!Resctrl::isInitialized()) {
+        Resctrl::init(config.resctrl(), cpu.threads().get(seed.algorithm()).data());
+    }
+#   endif
+
 #   ifdef XMRIG_FEATURE_MSR
     if (!RxMsr::isInitialized()) {
         RxMsr::init(config, cpu.threads().get(seed.algorithm()).data());
@@ -124,23 +181,32 @@ bool xmrig::Rx::init(const T &seed, const RxConfig &config, const CpuConfig &cpu
     randomx_set_scratchpad_prefetch_mode(config.scratchpadPrefetchMode());
     randomx_set_huge_pages_jit(cpu.isHugePagesJit());
     randomx_set_optimized_dataset_init(config.initDatasetAVX2());
+    randomx_set_optimized_dataset_init_avx512(config.initDatasetAVX512());
+    RxDataset::setHybridMemory(static_cast<size_t>(config.hybridMemory()) * 1024 * 1024);
+    RxDataset::setNumaAudit(cpu.numaAudit());
+    RxDiskCache::setConfig(config.datasetCache(), config.datasetCacheMax());
 
     if (!osInitialized) {
 #       ifdef XMRIG_FIX_RYZEN
         RxFix::setupMainLoopExceptionFrame();
 #       endif
 
-        if (!cpu.isHwAES()) {
-            SelectSoftAESImpl(cpu.threads().get(seed.algorithm()).count());
-        }
         osInitialized = true;
     }
 
+    if (!cpu.isHwAES() && (!softAesSelected || softAes != cpu.softAes())) {
+        softAes         = cpu.softAes();
+        softAesSelected = true;
+
+        SelectSoftAESImpl(cpu.threads().get(seed.algorithm()).count(), softAes);
+        LOG_VERBOSE("%ssoft AES: %s", Tags::randomx(), IsSoftAESVectorPermute() ? "vpaes" : "table");
+    }
+
     if (isReady(seed)) {
         return true;
     }
 
-    d_ptr->queue.enqueue(seed, config.nodeset(), config.threads(cpu.limit()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
+    d_ptr->queue.enqueue(seed, config.nodeset(), config.threads(cpu.limit()), config.lightThreads(cpu.threads().get(seed.algorithm()).count()), cpu.isHugePages(), config.isOneGbPages(), config.mode(), cpu.priority());
 
     return false;
 }
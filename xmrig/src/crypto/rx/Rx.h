@@ -22,11 +22,13 @@
 
 
 #include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
 
 #include "crypto/common/HugePagesInfo.h"
+#include "crypto/common/NumaPagesInfo.h"
 
 
 namespace xmrig
@@ -47,6 +49,11 @@ class Rx
 public:
     static HugePagesInfo hugePages();
     static RxDataset *dataset(const Job &job, uint32_t nodeId);
+    static std::vector<NumaPagesInfo> numaPages();
+    static std::shared_ptr<RxDataset> lightDataset(const Job &job, uint32_t threadId);
+    static bool isLightReady(const Job &job);
+    static uint64_t initTime();
+    static void addLightHashes(uint32_t group, uint64_t count);
     static void destroy();
     static void init(IRxListener *listener);
     template<typename T> static bool init(const T &seed, const RxConfig &config, const CpuConfig &cpu);
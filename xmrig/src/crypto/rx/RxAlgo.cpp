@@ -21,11 +21,32 @@
 #include "crypto/rx/RxAlgo.h"
 
 
-xmrig::Algorithm::Id xmrig::RxAlgo::apply(Algorithm::Id algorithm)
+#include <mutex>
+#include <set>
+
+
+namespace xmrig {
+
+
+static std::mutex mutex;
+static std::set<const RandomX_ConfigurationBase *> applied;
+
+
+} // namespace xmrig
+
+
+const RandomX_ConfigurationBase *xmrig::RxAlgo::apply(Algorithm::Id algorithm)
 {
-    randomx_apply_config(*base(algorithm));
+    auto config = const_cast<RandomX_ConfigurationBase *>(base(algorithm));
+
+    // Caches and VMs of other threads read applied configurations, each one is calculated only once.
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (applied.insert(config).second) {
+        randomx_apply_config(*config);
+    }
 
-    return algorithm;
+    return config;
 }
 
 
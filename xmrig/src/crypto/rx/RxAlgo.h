@@ -38,7 +38,7 @@ namespace xmrig
 class RxAlgo
 {
 public:
-    static Algorithm::Id apply(Algorithm::Id algorithm);
+    static const RandomX_ConfigurationBase *apply(Algorithm::Id algorithm);
     static const RandomX_ConfigurationBase *base(Algorithm::Id algorithm);
     static uint32_t programCount(Algorithm::Id algorithm);
     static uint32_t programIterations(Algorithm::Id algorithm);
@@ -23,9 +23,11 @@
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/tools/Chrono.h"
+#include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxDiskCache.h"
 #include "crypto/rx/RxSeed.h"
 
 
@@ -79,14 +81,21 @@ public:
     }
 
 
-    inline void initDataset(uint32_t threads, int priority)
+    inline void initDataset(uint32_t threads, int priority, const std::function<void(RxCache *)> &cacheReady)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        m_ready = m_dataset->init(m_seed.data(), threads, priority);
+        RxDiskCache::cancel();
+
+        m_ready = m_dataset->init(m_seed.data(), RxAlgo::apply(m_seed.algorithm()), threads, priority, cacheReady,
+                                  [this](void *raw, size_t size) { return RxDiskCache::load(m_seed, raw, size); });
 
         if (m_ready) {
             LOG_INFO("%s" GREEN_BOLD("dataset ready") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
+
+            if (!m_dataset->isLoaded()) {
+                RxDiskCache::save(m_seed, m_dataset->raw(), randomx_dataset_item_count() * RANDOMX_DATASET_ITEM_SIZE);
+            }
         }
     }
 
@@ -110,6 +119,23 @@ private:
                      Chrono::steadyMSecs() - ts
                      );
         }
+        else if (m_dataset->prefixItems()) {
+            const auto pages = m_dataset->hugePages();
+
+            LOG_INFO("%s" YELLOW_BOLD("hybrid mode") CYAN_BOLD(" %zu MB") BLACK_BOLD(" (%zu+%zu)") " precomputed " CYAN_BOLD("%.1f%%") " of dataset, huge pages %s%1.0f%% %u/%u" CLEAR " %sJIT" BLACK_BOLD(" (%" PRIu64 " ms)"),
+                     Tags::randomx(),
+                     pages.size / oneMiB,
+                     m_dataset->size(false) / oneMiB,
+                     RxCache::maxSize() / oneMiB,
+                     m_dataset->prefixItems() * 100.0 / randomx_dataset_item_count(),
+                     (pages.isFullyAllocated() ? GREEN_BOLD_S : (pages.allocated == 0 ? RED_BOLD_S : YELLOW_BOLD_S)),
+                     pages.percent(),
+                     pages.allocated,
+                     pages.total,
+                     m_dataset->cache()->isJIT() ? GREEN_BOLD_S "+" : RED_BOLD_S "-",
+                     Chrono::steadyMSecs() - ts
+                     );
+        }
         else {
             LOG_WARN(CLEAR "%s" YELLOW_BOLD_S "failed to allocate RandomX dataset, switching to slow mode" BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), Chrono::steadyMSecs() - ts);
         }
@@ -163,7 +189,15 @@ xmrig::RxDataset *xmrig::RxBasicStorage::dataset(const Job &job, uint32_t) const
 }
 
 
-void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+// The dataset is not bound to any NUMA node, so there is no local node to audit against.
+std::vector<xmrig::NumaPagesInfo> xmrig::RxBasicStorage::numaPages() const
+{
+    return {};
+}
+
+
+void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority,
+                                 const std::function<void(RxCache *)> &cacheReady)
 {
     d_ptr->setSeed(seed);
 
@@ -171,5 +205,5 @@ void xmrig::RxBasicStorage::init(const RxSeed &seed, uint32_t threads, bool huge
         return;
     }
 
-    d_ptr->initDataset(threads, priority);
+    d_ptr->initDataset(threads, priority, cacheReady);
 }
@@ -43,7 +43,9 @@ protected:
     bool isAllocated() const override;
     HugePagesInfo hugePages() const override;
     RxDataset *dataset(const Job &job, uint32_t nodeId) const override;
-    void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) override;
+    std::vector<NumaPagesInfo> numaPages() const override;
+    void init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority,
+              const std::function<void(RxCache *)> &cacheReady) override;
 
 private:
     RxBasicStoragePrivate *d_ptr;
@@ -55,16 +55,17 @@ xmrig::RxCache::~RxCache()
 }
 
 
-bool xmrig::RxCache::init(const Buffer &seed)
+bool xmrig::RxCache::init(const Buffer &seed, const RandomX_ConfigurationBase *config)
 {
-    if (m_seed == seed) {
+    if (m_seed == seed && m_config == config) {
         return false;
     }
 
-    m_seed = seed;
+    m_seed   = seed;
+    m_config = config;
 
     if (m_cache) {
-        randomx_init_cache(m_cache, m_seed.data(), m_seed.size());
+        randomx_init_cache(m_cache, m_seed.data(), m_seed.size(), m_config);
 
         return true;
     }
@@ -38,6 +38,7 @@
 
 
 struct randomx_cache;
+struct RandomX_ConfigurationBase;
 
 
 namespace xmrig
@@ -55,10 +56,11 @@ public:
 
     inline bool isJIT() const               { return m_jit; }
     inline const Buffer &seed() const       { return m_seed; }
+    inline const RandomX_ConfigurationBase *config() const { return m_config; }
     inline randomx_cache *get() const       { return m_cache; }
     inline size_t size() const              { return maxSize(); }
 
-    bool init(const Buffer &seed);
+    bool init(const Buffer &seed, const RandomX_ConfigurationBase *config);
     HugePagesInfo hugePages() const;
 
     static inline constexpr size_t maxSize() { return RANDOMX_CACHE_MAX_SIZE; }
@@ -68,6 +70,7 @@ private:
 
     bool m_jit              = true;
     Buffer m_seed;
+    const RandomX_ConfigurationBase *m_config = nullptr;
     randomx_cache *m_cache  = nullptr;
     VirtualMemory *m_memory = nullptr;
 };
@@ -41,11 +41,17 @@ namespace xmrig {
 
 const char *RxConfig::kInit                     = "init";
 const char *RxConfig::kInitAVX2                 = "init-avx2";
+const char *RxConfig::kInitAVX512               = "init-avx512";
+const char *RxConfig::kInitLight                = "init-light";
+const char *RxConfig::kDatasetCache             = "dataset-cache";
+const char *RxConfig::kDatasetCacheMax          = "dataset-cache-max";
 const char *RxConfig::kField                    = "randomx";
+const char *RxConfig::kHybridMemory             = "hybrid-memory";
 const char *RxConfig::kMode                     = "mode";
 const char *RxConfig::kOneGbPages               = "1gb-pages";
 const char *RxConfig::kRdmsr                    = "rdmsr";
 const char *RxConfig::kWrmsr                    = "wrmsr";
+const char *RxConfig::kWrmsrWatchdog            = "wrmsr-watchdog";
 const char *RxConfig::kScratchpadPrefetchMode   = "scratchpad_prefetch_mode";
 const char *RxConfig::kCacheQoS                 = "cache_qos";
 
@@ -54,7 +60,7 @@ const char *RxConfig::kNUMA                     = "numa";
 #endif
 
 
-static const std::array<const char *, RxConfig::ModeMax> modeNames = { "auto", "fast", "light" };
+static const std::array<const char *, RxConfig::ModeMax> modeNames = { "auto", "fast", "light", "hybrid" };
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -80,30 +86,38 @@ static_assert (kMsrArraySize == ICpuInfo::MSR_MOD_MAX, "kMsrArraySize and MSR_MO
 bool xmrig::RxConfig::read(const rapidjson::Value &value)
 {
     if (value.IsObject()) {
-        m_threads         = Json::getInt(value, kInit, m_threads);
-        m_initDatasetAVX2 = Json::getInt(value, kInitAVX2, m_initDatasetAVX2);
-        m_mode            = readMode(Json::getValue(value, kMode));
-        m_rdmsr           = Json::getBool(value, kRdmsr, m_rdmsr);
+        m_threads           = Json::getInt(value, kInit, m_threads);
+        m_initDatasetAVX2   = Json::getInt(value, kInitAVX2, m_initDatasetAVX2);
+        m_initDatasetAVX512 = Json::getInt(value, kInitAVX512, m_initDatasetAVX512);
+        m_initLight         = Json::getInt(value, kInitLight, m_initLight);
+        m_mode              = readMode(Json::getValue(value, kMode));
+        m_hybridMemory      = Json::getUint(value, kHybridMemory, m_hybridMemory);
+        m_datasetCache      = Json::getString(value, kDatasetCache);
+        m_datasetCacheMax   = Json::getUint(value, kDatasetCacheMax, m_datasetCacheMax);
+        m_rdmsr             = Json::getBool(value, kRdmsr, m_rdmsr);
 
 #       ifdef XMRIG_FEATURE_MSR
         readMSR(Json::getValue(value, kWrmsr));
 #       endif
 
+        m_wrmsrWatchdog = Json::getUint(value, kWrmsrWatchdog, m_wrmsrWatchdog);
+
         m_cacheQoS = Json::getBool(value, kCacheQoS, m_cacheQoS);
 
+#       ifdef XMRIG_FEATURE_RESCTRL
+        m_resctrl.read(Json::getValue(value, ResctrlConfig::kField));
+#       endif
+
 #       ifdef XMRIG_OS_LINUX
         m_oneGbPages = Json::getBool(value, kOneGbPages, m_oneGbPages);
 #       endif
 
 #       ifdef XMRIG_FEATURE_HWLOC
-        if (m_mode == LightMode) {
+        const auto &numa = Json::getValue(value, kNUMA);
+        if (m_mode == LightMode || m_mode == HybridMode) {
             m_numa = false;
-
-            return true;
         }
-
-        const auto &numa = Json::getValue(value, kNUMA);
-        if (numa.IsArray()) {
+        else if (numa.IsArray()) {
             m_nodeset.reserve(numa.Size());
 
             for (const auto &node : numa.GetArray()) {
@@ -137,7 +151,12 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
     Value obj(kObjectType);
     obj.AddMember(StringRef(kInit),         m_threads, allocator);
     obj.AddMember(StringRef(kInitAVX2),     m_initDatasetAVX2, allocator);
+    obj.AddMember(StringRef(kInitAVX512),   m_initDatasetAVX512, allocator);
+    obj.AddMember(StringRef(kInitLight),    m_initLight, allocator);
     obj.AddMember(StringRef(kMode),         StringRef(modeName()), allocator);
+    obj.AddMember(StringRef(kHybridMemory), m_hybridMemory, allocator);
+    obj.AddMember(StringRef(kDatasetCache), m_datasetCache.toJSON(), allocator);
+    obj.AddMember(StringRef(kDatasetCacheMax), m_datasetCacheMax, allocator);
     obj.AddMember(StringRef(kOneGbPages),   m_oneGbPages, allocator);
     obj.AddMember(StringRef(kRdmsr),        m_rdmsr, allocator);
 
@@ -159,8 +178,14 @@ rapidjson::Value xmrig::RxConfig::toJSON(rapidjson::Document &doc) const
     obj.AddMember(StringRef(kWrmsr), false, allocator);
 #   endif
 
+    obj.AddMember(StringRef(kWrmsrWatchdog), m_wrmsrWatchdog, allocator);
+
     obj.AddMember(StringRef(kCacheQoS), m_cacheQoS, allocator);
 
+#   ifdef XMRIG_FEATURE_RESCTRL
+    obj.AddMember(StringRef(ResctrlConfig::kField), m_resctrl.toJSON(doc), allocator);
+#   endif
+
 #   ifdef XMRIG_FEATURE_HWLOC
     if (!m_nodeset.empty()) {
         Value numa(kArrayType);
@@ -200,6 +225,20 @@ const char *xmrig::RxConfig::modeName() const
 }
 
 
+uint32_t xmrig::RxConfig::lightThreads(uint32_t threads) const
+{
+    if (m_mode == LightMode || m_mode == HybridMode || m_initLight == 0) {
+        return 0;
+    }
+
+    if (m_initLight > 0) {
+        return std::min(static_cast<uint32_t>(m_initLight), threads);
+    }
+
+    return std::max((threads + 3) / 4, 1U);
+}
+
+
 uint32_t xmrig::RxConfig::threads(uint32_t limit) const
 {
     if (m_threads > 0) {
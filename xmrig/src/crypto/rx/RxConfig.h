@@ -21,6 +21,7 @@
 
 
 #include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
 
 
 #ifdef XMRIG_FEATURE_MSR
@@ -28,6 +29,11 @@
 #endif
 
 
+#ifdef XMRIG_FEATURE_RESCTRL
+#   include "hw/resctrl/ResctrlConfig.h"
+#endif
+
+
 #include <vector>
 
 
@@ -41,6 +47,7 @@ public:
         AutoMode,
         FastMode,
         LightMode,
+        HybridMode,
         ModeMax
     };
 
@@ -53,14 +60,20 @@ public:
     };
 
     static const char *kCacheQoS;
+    static const char *kDatasetCache;
+    static const char *kDatasetCacheMax;
     static const char *kField;
+    static const char *kHybridMemory;
     static const char *kInit;
     static const char *kInitAVX2;
+    static const char *kInitAVX512;
+    static const char *kInitLight;
     static const char *kMode;
     static const char *kOneGbPages;
     static const char *kRdmsr;
     static const char *kScratchpadPrefetchMode;
     static const char *kWrmsr;
+    static const char *kWrmsrWatchdog;
 
 #   ifdef XMRIG_FEATURE_HWLOC
     static const char *kNUMA;
@@ -76,14 +89,21 @@ public:
 #   endif
 
     const char *modeName() const;
+    uint32_t lightThreads(uint32_t threads) const;
     uint32_t threads(uint32_t limit = 100) const;
 
-    inline int initDatasetAVX2() const  { return m_initDatasetAVX2; }
-    inline bool isOneGbPages() const    { return m_oneGbPages; }
-    inline bool rdmsr() const           { return m_rdmsr; }
-    inline bool wrmsr() const           { return m_wrmsr; }
-    inline bool cacheQoS() const        { return m_cacheQoS; }
-    inline Mode mode() const            { return m_mode; }
+    inline int initDatasetAVX2() const      { return m_initDatasetAVX2; }
+    inline int initDatasetAVX512() const    { return m_initDatasetAVX512; }
+    inline int initLight() const            { return m_initLight; }
+    inline bool isOneGbPages() const        { return m_oneGbPages; }
+    inline bool rdmsr() const               { return m_rdmsr; }
+    inline bool wrmsr() const               { return m_wrmsr; }
+    inline uint32_t wrmsrWatchdog() const   { return m_wrmsrWatchdog; }
+    inline bool cacheQoS() const            { return m_cacheQoS; }
+    inline Mode mode() const                { return m_mode; }
+    inline uint32_t hybridMemory() const    { return m_hybridMemory; }
+    inline const char *datasetCache() const { return m_datasetCache.data(); }
+    inline uint32_t datasetCacheMax() const { return m_datasetCacheMax; }
 
     inline ScratchpadPrefetchMode scratchpadPrefetchMode() const { return m_scratchpadPrefetchMode; }
 
@@ -92,6 +112,10 @@ public:
     const MsrItems &msrPreset() const;
 #   endif
 
+#   ifdef XMRIG_FEATURE_RESCTRL
+    inline const ResctrlConfig &resctrl() const { return m_resctrl; }
+#   endif
+
 private:
 #   ifdef XMRIG_FEATURE_MSR
     uint32_t msrMod() const;
@@ -105,18 +129,28 @@ private:
 
     bool m_cacheQoS = false;
 
+#   ifdef XMRIG_FEATURE_RESCTRL
+    ResctrlConfig m_resctrl;
+#   endif
+    uint32_t m_wrmsrWatchdog = 60;  // seconds between checks of MSR values, 0 means disabled
+
     static Mode readMode(const rapidjson::Value &value);
 
-    bool m_oneGbPages     = false;
-    bool m_rdmsr          = true;
-    int m_threads         = -1;
-    int m_initDatasetAVX2 = -1;
-    Mode m_mode           = AutoMode;
+    bool m_oneGbPages       = false;
+    bool m_rdmsr            = true;
+    int m_threads           = -1;
+    int m_initDatasetAVX2   = -1;
+    int m_initDatasetAVX512 = -1;
+    int m_initLight         = -1;   // threads hashing in light mode while dataset is initialized, -1 means auto
+    Mode m_mode             = AutoMode;
+    uint32_t m_hybridMemory = 0;    // MB, 0 means all free memory
+    String m_datasetCache;          // directory for full datasets, null means disabled
+    uint32_t m_datasetCacheMax = 2; // dataset files kept in the directory
 
     ScratchpadPrefetchMode m_scratchpadPrefetchMode = ScratchpadPrefetchT0;
 
 #   ifdef XMRIG_FEATURE_HWLOC
-    bool m_numa           = true;
+    bool m_numa             = true;
     std::vector<uint32_t> m_nodeset;
 #   endif
 
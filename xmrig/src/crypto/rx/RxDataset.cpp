@@ -18,16 +18,19 @@
  */
 
 #include "crypto/rx/RxDataset.h"
-#include "backend/cpu/Cpu.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
 #include "base/kernel/Platform.h"
+#include "base/tools/Chrono.h"
 #include "crypto/common/VirtualMemory.h"
 #include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
+#include "crypto/rx/RxVm.h"
 
 
+#include <cinttypes>
+#include <random>
 #include <thread>
 #include <uv.h>
 
@@ -35,17 +38,69 @@
 namespace xmrig {
 
 
-static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, int priority)
+static constexpr uint32_t kVerifySamples = 64;
+static constexpr size_t kHybridMinSize   = 64 * 1024 * 1024;
+static constexpr size_t kHybridReserve   = 256 * 1024 * 1024;  // scratchpads, JIT code and everything else
+static size_t hybridMemory               = 0;
+static NumaPagesInfo::Mode numaAudit     = NumaPagesInfo::MODE_OFF;
+
+
+// Memory for precomputed dataset items in hybrid mode, by default all free memory except the cache and a reserve.
+static size_t hybridSize()
+{
+    const size_t datasetSize = randomx_dataset_item_count() * RANDOMX_DATASET_ITEM_SIZE;
+    size_t size              = hybridMemory;
+
+    if (!size) {
+        const uint64_t free = uv_get_free_memory();
+        const uint64_t used = RxCache::maxSize() + kHybridReserve;
+
+        size = free > used ? static_cast<size_t>(free - used) : 0;
+    }
+
+    size = std::min(size, datasetSize) & ~(VirtualMemory::kDefaultHugePageSize - 1);
+
+    return size >= kHybridMinSize ? size : 0;
+}
+
+
+static const char *datasetInitName(RxCache *cache)
+{
+    if (randomx_dataset_init_avx512(cache->get())) {
+        return "AVX-512";
+    }
+
+    if (randomx_dataset_init_batch(cache->get()) > 1) {
+        return "AVX2";
+    }
+
+    return cache->isJIT() ? "JIT" : "interpreter";
+}
+
+
+static void init_dataset_wrapper(randomx_dataset *dataset, randomx_cache *cache, uint32_t startItem, uint32_t itemCount, int priority, uint64_t *time)
 {
     Platform::setThreadPriority(priority);
 
-    if (Cpu::info()->hasAVX2() && (itemCount % 5)) {
-        randomx_init_dataset(dataset, cache, startItem, itemCount - (itemCount % 5));
-        randomx_init_dataset(dataset, cache, startItem + itemCount - 5, 5);
+    const uint64_t ts    = Chrono::steadyMSecs();
+    const uint32_t batch = randomx_dataset_init_batch(cache);
+
+    if (itemCount < batch) {
+        auto memory = static_cast<uint8_t *>(randomx_get_dataset_memory(dataset));
+
+        for (uint32_t i = startItem; i < startItem + itemCount; ++i) {
+            randomx_calculate_dataset_item(cache, i, memory + static_cast<size_t>(i) * RANDOMX_DATASET_ITEM_SIZE);
+        }
+    }
+    else if (itemCount % batch) {
+        randomx_init_dataset(dataset, cache, startItem, itemCount - (itemCount % batch));
+        randomx_init_dataset(dataset, cache, startItem + itemCount - batch, batch);
     }
     else {
         randomx_init_dataset(dataset, cache, startItem, itemCount);
     }
+
+    *time = Chrono::steadyMSecs() - ts;
 }
 
 
@@ -80,42 +135,66 @@ xmrig::RxDataset::RxDataset(RxCache *cache) :
 xmrig::RxDataset::~RxDataset()
 {
     randomx_release_dataset(m_dataset);
+    randomx_release_dataset(m_prefix);
 
     delete m_cache;
     delete m_memory;
 }
 
 
-bool xmrig::RxDataset::init(const Buffer &seed, uint32_t numThreads, int priority)
+bool xmrig::RxDataset::init(const Buffer &seed, const RandomX_ConfigurationBase *config, uint32_t numThreads, int priority, const std::function<void(RxCache *)> &cacheReady,
+                            const std::function<bool(void *, size_t)> &load)
 {
+    m_loaded = false;
+
     if (!m_cache || !m_cache->get()) {
         return false;
     }
 
-    m_cache->init(seed);
+    if (m_prefix) {
+        randomx_set_dataset_prefix(m_cache->get(), nullptr, 0);
+    }
+
+    m_cache->init(seed, config);
 
-    if (!get()) {
+    // Cache is ready and stays read only until the next seed, light mode VMs can use it while items are initialized.
+    // Not in hybrid mode, dataset prefix is attached to the cache only after initialization.
+    if (m_dataset && cacheReady) {
+        cacheReady(m_cache);
+    }
+
+    randomx_dataset *dataset = m_dataset ? m_dataset : m_prefix;
+    if (!dataset) {
         return true;
     }
 
-    const uint64_t datasetItemCount = randomx_dataset_item_count();
+    const uint64_t itemCount = m_dataset ? randomx_dataset_item_count() : m_prefixItems;
 
-    if (numThreads > 1) {
-        std::vector<std::thread> threads;
-        threads.reserve(numThreads);
+    // Loaded dataset is checked against the cache same way as AVX-512 init, a file from another build or config is never used.
+    if (m_dataset && load && load(raw(), itemCount * RANDOMX_DATASET_ITEM_SIZE)) {
+        if (verify(dataset, itemCount, numThreads)) {
+            m_loaded = true;
 
-        for (uint64_t i = 0; i < numThreads; ++i) {
-            const uint32_t a = (datasetItemCount * i) / numThreads;
-            const uint32_t b = (datasetItemCount * (i + 1)) / numThreads;
-            threads.emplace_back(init_dataset_wrapper, m_dataset, m_cache->get(), a, b - a, priority);
+            return true;
         }
 
-        for (uint32_t i = 0; i < numThreads; ++i) {
-            threads[i].join();
-        }
+        LOG_ERR("%s" RED_BOLD("loaded dataset doesn't match the cache, initializing it again"), Tags::randomx());
     }
-    else {
-        init_dataset_wrapper(m_dataset, m_cache->get(), 0, datasetItemCount, priority);
+
+    initItems(dataset, itemCount, numThreads, priority);
+
+    if (randomx_dataset_init_avx512(m_cache->get()) && !verify(dataset, itemCount, numThreads)) {
+        LOG_ERR("%s" RED_BOLD("AVX-512 dataset init produced wrong results, switching to fallback code"), Tags::randomx());
+
+        randomx_disable_dataset_init_avx512(m_cache->get());
+        initItems(dataset, itemCount, numThreads, priority);
+    }
+
+    if (m_prefix) {
+        randomx_set_dataset_prefix(m_cache->get(), randomx_get_dataset_memory(m_prefix), m_prefixItems);
+
+        // Reads of the previous seed or prefix size are not mixed into the hit rate of this one.
+        RxVm::resetHitRate();
     }
 
     return true;
@@ -153,6 +232,9 @@ size_t xmrig::RxDataset::size(bool cache) const
     if (m_dataset) {
         size += maxSize();
     }
+    else if (m_memory) {
+        size += m_memory->size();
+    }
 
     if (cache && m_cache) {
         size += RxCache::maxSize();
@@ -184,6 +266,32 @@ void *xmrig::RxDataset::raw() const
 }
 
 
+void xmrig::RxDataset::auditNumaPages()
+{
+    if (numaAudit == NumaPagesInfo::MODE_OFF || !m_dataset || !m_memory) {
+        return;
+    }
+
+    const uint64_t ts = Chrono::steadyMSecs();
+    m_numaPages       = m_memory->numaPages(m_node, numaAudit == NumaPagesInfo::MODE_MIGRATE);
+
+    if (!m_numaPages.isValid()) {
+        return;
+    }
+
+    LOG_INFO("%s" CYAN_BOLD("#%u ") "dataset NUMA local %s%1.1f%% %zu/%zu" CLEAR BLACK_BOLD(" (%zu migrated, %" PRIu64 " ms)"),
+             Tags::randomx(),
+             m_node,
+             m_numaPages.isFullyLocal() ? GREEN_BOLD_S : (m_numaPages.local == 0 ? RED_BOLD_S : YELLOW_BOLD_S),
+             m_numaPages.percent(),
+             m_numaPages.local,
+             m_numaPages.total,
+             m_numaPages.migrated,
+             Chrono::steadyMSecs() - ts
+             );
+}
+
+
 void xmrig::RxDataset::setRaw(const void *raw)
 {
     if (!m_dataset) {
@@ -195,6 +303,93 @@ void xmrig::RxDataset::setRaw(const void *raw)
 }
 
 
+void xmrig::RxDataset::setHybridMemory(size_t size)
+{
+    hybridMemory = size;
+}
+
+
+void xmrig::RxDataset::setNumaAudit(NumaPagesInfo::Mode mode)
+{
+    numaAudit = mode;
+}
+
+
+bool xmrig::RxDataset::verify(randomx_dataset *dataset, uint64_t datasetItemCount, uint32_t numThreads) const
+{
+    const auto memory = static_cast<const uint8_t *>(randomx_get_dataset_memory(dataset));
+
+    numThreads = std::max(numThreads, 1U);
+
+    // Both ends of every thread range (full and partial passes) and random items.
+    std::vector<uint64_t> items;
+    items.reserve(numThreads * 2 + kVerifySamples);
+
+    for (uint64_t i = 0; i < numThreads; ++i) {
+        items.emplace_back((datasetItemCount * i) / numThreads);
+        items.emplace_back((datasetItemCount * (i + 1)) / numThreads - 1);
+    }
+
+    std::mt19937_64 rng(Chrono::steadyMSecs());
+    for (uint32_t i = 0; i < kVerifySamples; ++i) {
+        items.emplace_back(rng() % datasetItemCount);
+    }
+
+    uint8_t item[RANDOMX_DATASET_ITEM_SIZE];
+
+    for (uint64_t i : items) {
+        randomx_calculate_dataset_item(m_cache->get(), i, item);
+
+        if (memcmp(item, memory + i * RANDOMX_DATASET_ITEM_SIZE, sizeof(item)) != 0) {
+            LOG_ERR("%s" RED("dataset item ") RED_BOLD("%" PRIu64) RED(" mismatch"), Tags::randomx(), i);
+
+            return false;
+        }
+    }
+
+    LOG_VERBOSE("%s" BLACK_BOLD("dataset verified, %zu items checked"), Tags::randomx(), items.size());
+
+    return true;
+}
+
+
+void xmrig::RxDataset::initItems(randomx_dataset *dataset, uint64_t datasetItemCount, uint32_t numThreads, int priority)
+{
+    numThreads = std::max(numThreads, 1U);
+
+    std::vector<uint64_t> time(numThreads);
+
+    if (numThreads > 1) {
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+
+        for (uint64_t i = 0; i < numThreads; ++i) {
+            const uint32_t a = (datasetItemCount * i) / numThreads;
+            const uint32_t b = (datasetItemCount * (i + 1)) / numThreads;
+            threads.emplace_back(init_dataset_wrapper, dataset, m_cache->get(), a, b - a, priority, &time[i]);
+        }
+
+        for (uint32_t i = 0; i < numThreads; ++i) {
+            threads[i].join();
+        }
+    }
+    else {
+        init_dataset_wrapper(dataset, m_cache->get(), 0, datasetItemCount, priority, &time[0]);
+    }
+
+    if (Log::verbose() > 0) {
+        const char *impl = datasetInitName(m_cache);
+
+        for (uint32_t i = 0; i < numThreads; ++i) {
+            const uint32_t count = ((datasetItemCount * (i + 1)) / numThreads) - ((datasetItemCount * i) / numThreads);
+
+            LOG_VERBOSE("%s" CYAN_BOLD("#%u ") BLACK_BOLD("dataset init thread ") WHITE_BOLD("%u") BLACK_BOLD(" %s %u items") " %" PRIu64 " ms" BLACK_BOLD(" (%.0f items/s)"),
+                        Tags::randomx(), m_node, i, impl, count, time[i], time[i] ? count * 1000.0 / time[i] : 0.0);
+        }
+    }
+}
+
+
 void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
 {
     if (m_mode == RxConfig::LightMode) {
@@ -203,9 +398,17 @@ void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
         return;
     }
 
+    if (m_mode == RxConfig::HybridMode) {
+        allocatePrefix(hugePages);
+
+        return;
+    }
+
     if (m_mode == RxConfig::AutoMode && uv_get_total_memory() < (maxSize() + RxCache::maxSize())) {
         LOG_ERR(CLEAR "%s" RED_BOLD_S "not enough memory for RandomX dataset", Tags::randomx());
 
+        allocatePrefix(hugePages);
+
         return;
     }
 
@@ -224,3 +427,18 @@ void xmrig::RxDataset::allocate(bool hugePages, bool oneGbPages)
     }
 #   endif
 }
+
+
+void xmrig::RxDataset::allocatePrefix(bool hugePages)
+{
+    const size_t size = hybridSize();
+    if (!size) {
+        LOG_ERR(CLEAR "%s" RED_BOLD_S "not enough memory for RandomX hybrid mode", Tags::randomx());
+
+        return;
+    }
+
+    m_memory      = new VirtualMemory(size, hugePages, false, false, m_node);
+    m_prefix      = randomx_create_dataset(m_memory->raw());
+    m_prefixItems = static_cast<uint32_t>(size / RANDOMX_DATASET_ITEM_SIZE);
+}
@@ -24,13 +24,16 @@
 #include "base/tools/Buffer.h"
 #include "base/tools/Object.h"
 #include "crypto/common/HugePagesInfo.h"
+#include "crypto/common/NumaPagesInfo.h"
 #include "crypto/randomx/configuration.h"
 #include "crypto/rx/RxConfig.h"
 
 #include <atomic>
+#include <functional>
 
 
 struct randomx_dataset;
+struct RandomX_ConfigurationBase;
 
 
 namespace xmrig
@@ -52,28 +55,42 @@ public:
 
     inline randomx_dataset *get() const     { return m_dataset; }
     inline RxCache *cache() const           { return m_cache; }
+    inline bool isLoaded() const            { return m_loaded; }
+    inline const NumaPagesInfo &numaPages() const { return m_numaPages; }
+    inline uint32_t prefixItems() const     { return m_prefixItems; }
     inline void setCache(RxCache *cache)    { m_cache = cache; }
 
-    bool init(const Buffer &seed, uint32_t numThreads, int priority);
+    bool init(const Buffer &seed, const RandomX_ConfigurationBase *config, uint32_t numThreads, int priority, const std::function<void(RxCache *)> &cacheReady = nullptr,
+              const std::function<bool(void *, size_t)> &load = nullptr);
     bool isHugePages() const;
     bool isOneGbPages() const;
     HugePagesInfo hugePages(bool cache = true) const;
     size_t size(bool cache = true) const;
     uint8_t *tryAllocateScrathpad();
     void *raw() const;
+    void auditNumaPages();
     void setRaw(const void *raw);
 
     static inline constexpr size_t maxSize() { return RANDOMX_DATASET_MAX_SIZE; }
+    static void setHybridMemory(size_t size);
+    static void setNumaAudit(NumaPagesInfo::Mode mode);
 
 private:
+    bool verify(randomx_dataset *dataset, uint64_t datasetItemCount, uint32_t numThreads) const;
     void allocate(bool hugePages, bool oneGbPages);
+    void allocatePrefix(bool hugePages);
+    void initItems(randomx_dataset *dataset, uint64_t datasetItemCount, uint32_t numThreads, int priority);
 
     const RxConfig::Mode m_mode = RxConfig::FastMode;
+    bool m_loaded               = false;   // full dataset was loaded by init() instead of computed
     const uint32_t m_node;
+    NumaPagesInfo m_numaPages;
     randomx_dataset *m_dataset  = nullptr;
+    randomx_dataset *m_prefix   = nullptr;  // hybrid mode, first m_prefixItems items of the dataset
     RxCache *m_cache            = nullptr;
     size_t m_scratchpadLimit    = 0;
     std::atomic<size_t> m_scratchpadOffset{};
+    uint32_t m_prefixItems      = 0;
     VirtualMemory *m_memory     = nullptr;
 };
 
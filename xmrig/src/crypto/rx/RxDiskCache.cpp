@@ -0,0 +1,354 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "crypto/rx/RxDiskCache.h"
+#include "base/io/log/Log.h"
+#include "base/io/log/Tags.h"
+#include "base/kernel/Platform.h"
+#include "base/tools/Chrono.h"
+#include "base/tools/Cvt.h"
+#include "crypto/rx/RxSeed.h"
+
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <uv.h>
+#include <vector>
+
+
+namespace xmrig {
+
+
+static const char kMagic[8]         = { 'X', 'M', 'R', 'I', 'G', 'R', 'X', 'D' };
+static const char *kExtension       = ".rxd";
+static constexpr size_t kChunkSize  = 64 * 1024 * 1024;
+static constexpr size_t kSeedSize   = 32;
+static constexpr uint32_t kVersion  = 1;
+
+
+struct RxDiskCacheHeader
+{
+    char magic[sizeof(kMagic)];
+    uint32_t version;
+    uint32_t algorithm;
+    uint64_t size;
+    uint64_t checksum;
+    uint8_t seed[kSeedSize];
+};
+
+
+// xxHash64 style rounds over 4 interleaved lanes, fast enough to not add noticeable time to a 2 GB read.
+class RxDiskCacheChecksum
+{
+public:
+    void update(const uint8_t *data, size_t size)
+    {
+        uint64_t w[4];
+
+        for (size_t i = 0; i + sizeof(w) <= size; i += sizeof(w)) {
+            memcpy(w, data + i, sizeof(w));
+
+            for (size_t j = 0; j < 4; ++j) {
+                m_lanes[j] = rotl(m_lanes[j] + w[j] * kPrime2, 31) * kPrime1;
+            }
+        }
+    }
+
+    inline uint64_t value() const { return rotl(m_lanes[0], 1) + rotl(m_lanes[1], 7) + rotl(m_lanes[2], 12) + rotl(m_lanes[3], 18); }
+
+private:
+    static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+
+    static inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+    uint64_t m_lanes[4] = { kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1 };
+};
+
+
+static std::atomic<bool> cancelled{};
+static std::mutex mutex;
+static std::string cachePath;
+static std::thread writer;
+static uint32_t cacheMax = 0;
+
+
+static std::string fileName(const std::string &path, const RxSeed &seed)
+{
+    std::string name = seed.algorithm().name();
+    std::replace(name.begin(), name.end(), '/', '-');
+
+    return path + "/" + name + "-" + Cvt::toHex(seed.data()).data() + kExtension;
+}
+
+
+static bool isCacheable(const RxSeed &seed, size_t size)
+{
+    return seed.data().size() == kSeedSize && size > 0 && size % 32 == 0;
+}
+
+
+static void setHeader(RxDiskCacheHeader &header, const RxSeed &seed, size_t size)
+{
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    memcpy(header.seed, seed.data().data(), kSeedSize);
+
+    header.version   = kVersion;
+    header.algorithm = seed.algorithm().id();
+    header.size      = size;
+}
+
+
+static void setModified(const std::string &file)
+{
+    const auto now = static_cast<double>(time(nullptr));
+
+    uv_fs_t req{};
+    uv_fs_utime(uv_default_loop(), &req, file.c_str(), now, now, nullptr);
+    uv_fs_req_cleanup(&req);
+}
+
+
+static void removeFile(const std::string &file)
+{
+    uv_fs_t req{};
+    uv_fs_unlink(uv_default_loop(), &req, file.c_str(), nullptr);
+    uv_fs_req_cleanup(&req);
+}
+
+
+// Only the newest files are kept, the current seed is always the newest one because it was just written or loaded.
+static void evict(const std::string &path, uint32_t max)
+{
+    uv_fs_t req{};
+    if (uv_fs_scandir(uv_default_loop(), &req, path.c_str(), 0, nullptr) < 0) {
+        uv_fs_req_cleanup(&req);
+
+        return;
+    }
+
+    std::vector<std::pair<double, std::string> > files;
+    const size_t extSize = strlen(kExtension);
+    uv_dirent_t entry;
+
+    while (uv_fs_scandir_next(&req, &entry) != UV_EOF) {
+        const size_t size = strlen(entry.name);
+        if (entry.type == UV_DIRENT_DIR || size <= extSize || strcmp(entry.name + size - extSize, kExtension) != 0) {
+            continue;
+        }
+
+        const std::string file = path + "/" + entry.name;
+
+        uv_fs_t stat{};
+        if (uv_fs_stat(uv_default_loop(), &stat, file.c_str(), nullptr) == 0) {
+            files.emplace_back(stat.statbuf.st_mtim.tv_sec + stat.statbuf.st_mtim.tv_nsec / 1e9, file);
+        }
+
+        uv_fs_req_cleanup(&stat);
+    }
+
+    uv_fs_req_cleanup(&req);
+
+    if (files.size() <= max) {
+        return;
+    }
+
+    std::sort(files.begin(), files.end(), [](const std::pair<double, std::string> &a, const std::pair<double, std::string> &b) { return a.first > b.first; });
+
+    for (size_t i = max; i < files.size(); ++i) {
+        removeFile(files[i].second);
+
+        LOG_VERBOSE("%s" BLACK_BOLD("dataset file ") WHITE_BOLD("%s") BLACK_BOLD(" removed from cache"), Tags::randomx(), files[i].second.c_str());
+    }
+}
+
+
+static void write(std::string path, uint32_t max, RxSeed seed, const uint8_t *raw, size_t size)
+{
+    Platform::setThreadPriority(0);
+
+    const uint64_t ts = Chrono::steadyMSecs();
+
+    uv_fs_t req{};
+    uv_fs_mkdir(uv_default_loop(), &req, path.c_str(), 0755, nullptr);
+    uv_fs_req_cleanup(&req);
+
+    const std::string file = fileName(path, seed);
+    const std::string tmp  = file + ".tmp";
+
+    FILE *fp = fopen(tmp.c_str(), "wb");
+    if (!fp) {
+        LOG_WARN("%s" YELLOW("failed to create dataset file ") YELLOW_BOLD("%s"), Tags::randomx(), tmp.c_str());
+
+        return;
+    }
+
+    RxDiskCacheHeader header;
+    setHeader(header, seed, size);
+
+    RxDiskCacheChecksum checksum;
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+    for (size_t offset = 0; ok && offset < size; offset += kChunkSize) {
+        if (cancelled.load(std::memory_order_relaxed)) {
+            ok = false;
+            break;
+        }
+
+        const size_t n = std::min(kChunkSize, size - offset);
+
+        checksum.update(raw + offset, n);
+        ok = fwrite(raw + offset, 1, n, fp) == n;
+    }
+
+    if (ok) {
+        header.checksum = checksum.value();
+        ok = fseek(fp, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, fp) == 1;
+    }
+
+    ok = fclose(fp) == 0 && ok;
+
+    if (ok) {
+        removeFile(file);
+        ok = rename(tmp.c_str(), file.c_str()) == 0;
+    }
+
+    if (!ok) {
+        removeFile(tmp);
+
+        if (!cancelled) {
+            LOG_WARN("%s" YELLOW("failed to write dataset file ") YELLOW_BOLD("%s"), Tags::randomx(), file.c_str());
+        }
+
+        return;
+    }
+
+    LOG_INFO("%s" GREEN_BOLD("dataset saved") " to " WHITE_BOLD("%s") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), file.c_str(), Chrono::steadyMSecs() - ts);
+
+    evict(path, max);
+}
+
+
+} // namespace xmrig
+
+
+bool xmrig::RxDiskCache::load(const RxSeed &seed, void *raw, size_t size)
+{
+    std::string path;
+    uint32_t max = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        path = cachePath;
+        max  = cacheMax;
+    }
+
+    if (path.empty() || !raw || !isCacheable(seed, size)) {
+        return false;
+    }
+
+    const uint64_t ts      = Chrono::steadyMSecs();
+    const std::string file = fileName(path, seed);
+
+    FILE *fp = fopen(file.c_str(), "rb");
+    if (!fp) {
+        return false;
+    }
+
+    RxDiskCacheHeader expected;
+    RxDiskCacheHeader header;
+    setHeader(expected, seed, size);
+
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 && memcmp(header.magic, expected.magic, sizeof(kMagic)) == 0 && header.version == expected.version &&
+              header.algorithm == expected.algorithm && header.size == expected.size && memcmp(header.seed, expected.seed, kSeedSize) == 0;
+
+    RxDiskCacheChecksum checksum;
+    auto dst = static_cast<uint8_t *>(raw);
+
+    for (size_t offset = 0; ok && offset < size; offset += kChunkSize) {
+        const size_t n = std::min(kChunkSize, size - offset);
+
+        ok = fread(dst + offset, 1, n, fp) == n;
+        checksum.update(dst + offset, n);
+    }
+
+    fclose(fp);
+
+    if (!ok || checksum.value() != header.checksum) {
+        LOG_WARN("%s" YELLOW("dataset file ") YELLOW_BOLD("%s") YELLOW(" is corrupted, removed"), Tags::randomx(), file.c_str());
+
+        removeFile(file);
+
+        return false;
+    }
+
+    setModified(file);
+    evict(path, max);
+
+    LOG_INFO("%s" GREEN_BOLD("dataset loaded") " from " WHITE_BOLD("%s") BLACK_BOLD(" (%" PRIu64 " ms)"), Tags::randomx(), file.c_str(), Chrono::steadyMSecs() - ts);
+
+    return true;
+}
+
+
+void xmrig::RxDiskCache::cancel()
+{
+    if (!writer.joinable()) {
+        return;
+    }
+
+    cancelled = true;
+    writer.join();
+    cancelled = false;
+}
+
+
+void xmrig::RxDiskCache::save(const RxSeed &seed, const void *raw, size_t size)
+{
+    cancel();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (cachePath.empty() || !raw || !isCacheable(seed, size)) {
+        return;
+    }
+
+    writer = std::thread(write, cachePath, cacheMax, seed, static_cast<const uint8_t *>(raw), size);
+}
+
+
+void xmrig::RxDiskCache::setConfig(const char *path, uint32_t max)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    cachePath = path ? path : "";
+    cacheMax  = std::max(max, 1U);
+
+    while (cachePath.size() > 1 && (cachePath.back() == '/' || cachePath.back() == '\\')) {
+        cachePath.pop_back();
+    }
+}
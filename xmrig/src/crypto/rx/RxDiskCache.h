@@ -0,0 +1,53 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RX_DISKCACHE_H
+#define XMRIG_RX_DISKCACHE_H
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+class RxSeed;
+
+
+/**
+ * Full RandomX datasets stored on disk, one file per algorithm and seed hash in the "dataset-cache" directory.
+ *
+ * Files are written by a low priority background thread after the dataset is initialized and loaded instead of
+ * initialization on the next start, only the newest "dataset-cache-max" files are kept.
+ */
+class RxDiskCache
+{
+public:
+    static bool load(const RxSeed &seed, void *raw, size_t size);
+    static void cancel();
+    static void save(const RxSeed &seed, const void *raw, size_t size);
+    static void setConfig(const char *path, uint32_t max);
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RX_DISKCACHE_H */
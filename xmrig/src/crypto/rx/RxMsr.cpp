@@ -19,14 +19,22 @@
 
 
 #include "crypto/rx/RxMsr.h"
+#include "3rdparty/rapidjson/document.h"
 #include "backend/cpu/Cpu.h"
 #include "backend/cpu/CpuThread.h"
 #include "base/io/log/Log.h"
+#include "base/kernel/interfaces/ITimerListener.h"
 #include "base/tools/Chrono.h"
+#include "base/tools/Timer.h"
 #include "crypto/rx/RxConfig.h"
 #include "hw/msr/Msr.h"
 
 
+#ifdef XMRIG_FEATURE_RESCTRL
+#   include "hw/resctrl/Resctrl.h"
+#endif
+
+
 #include <algorithm>
 #include <set>
 
@@ -125,6 +133,147 @@ static bool wrmsr(const MsrItems &preset, const std::vector<CpuThread> &threads,
 }
 
 
+// Periodically reads back the preset registers, MSR values can be reset by suspend/resume, microcode updates or other software.
+class RxMsrWatchdog : public ITimerListener
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(RxMsrWatchdog)
+
+    RxMsrWatchdog(const MsrItems &preset, const char *name, uint64_t interval) :
+        m_name(name),
+        m_preset(preset),
+        m_msr(Msr::get()),
+        m_interval(interval)
+    {
+        // Same CPUs as the preset was written to, on Windows the driver doesn't select a CPU.
+        if (get_cpu(0) < 0) {
+            m_cpus.emplace_back(-1);
+        }
+        else {
+            for (int32_t pu : Cpu::info()->units()) {
+                m_cpus.emplace_back(pu);
+            }
+        }
+
+        m_timer = new Timer(this, interval, interval);
+    }
+
+    ~RxMsrWatchdog() override { delete m_timer; }
+
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        Value out(kObjectType);
+        out.AddMember("preset",     StringRef(m_name), allocator);
+        out.AddMember("interval",   m_interval / 1000, allocator);
+        out.AddMember("checks",     m_checks, allocator);
+        out.AddMember("drifts",     m_drifts, allocator);
+        out.AddMember("reapplied",  m_reapplied, allocator);
+        out.AddMember("last-drift", m_lastDrift, allocator);
+
+        Value cpus(kArrayType);
+        cpus.Reserve(static_cast<SizeType>(m_cpus.size()), allocator);
+
+        for (const auto &cpu : m_cpus) {
+            Value item(kObjectType);
+            item.AddMember("cpu",       cpu.id, allocator);
+            item.AddMember("status",    StringRef(cpu.status), allocator);
+            item.AddMember("drifts",    cpu.drifts, allocator);
+
+            cpus.PushBack(item, allocator);
+        }
+
+        out.AddMember("cpus", cpus, allocator);
+
+        return out;
+    }
+
+protected:
+    void onTimer(const Timer *) override
+    {
+        ++m_checks;
+
+        for (auto &cpu : m_cpus) {
+            check(cpu);
+        }
+    }
+
+private:
+    struct CpuStatus
+    {
+        inline CpuStatus(int32_t id) : id(id) {}
+
+        const int32_t id;
+        const char *status  = "ok";
+        uint64_t drifts     = 0;
+    };
+
+
+    void check(CpuStatus &cpu)
+    {
+        bool drift = false;
+
+        for (const auto &item : m_preset) {
+            const auto current = m_msr->read(item.reg(), cpu.id, false);
+            if (!current.isValid()) {
+                cpu.status = "unreadable";
+
+                return;
+            }
+
+            const uint64_t expected = MsrItem::maskedValue(current.value(), item.value(), item.mask());
+            if (current.value() != expected) {
+                LOG_WARN("%s " YELLOW_BOLD("CPU %d register ") CYAN_BOLD("0x%08" PRIx32) YELLOW_BOLD(" changed to ") CYAN_BOLD("0x%016" PRIx64) YELLOW_BOLD(", expected ") CYAN_BOLD("0x%016" PRIx64),
+                         Msr::tag(), cpu.id, item.reg(), current.value(), expected);
+
+                drift = true;
+            }
+        }
+
+        if (!drift) {
+            cpu.status = "ok";
+
+            return;
+        }
+
+        ++cpu.drifts;
+        ++m_drifts;
+        m_lastDrift = Chrono::currentMSecsSinceEpoch();
+
+        for (const auto &item : m_preset) {
+            if (!m_msr->write(item, cpu.id)) {
+                cpu.status = "drift";
+
+                return;
+            }
+        }
+
+        ++m_reapplied;
+        cpu.status = "reapplied";
+
+        LOG_NOTICE("%s " GREEN_BOLD("register values for \"%s\" preset have been set again on CPU %d"), Msr::tag(), m_name, cpu.id);
+    }
+
+
+    const char *m_name;
+    const MsrItems m_preset;
+    std::shared_ptr<Msr> m_msr;
+    std::vector<CpuStatus> m_cpus;
+    Timer *m_timer          = nullptr;
+    uint64_t m_checks       = 0;
+    uint64_t m_drifts       = 0;
+    uint64_t m_interval;
+    uint64_t m_lastDrift    = 0;
+    uint64_t m_reapplied    = 0;
+};
+
+
+static RxMsrWatchdog *watchdog = nullptr;
+
+
 } // namespace xmrig
 
 
@@ -151,8 +300,21 @@ bool xmrig::RxMsr::init(const RxConfig &config, const std::vector<CpuThread> &th
         m_cacheQoS = false;
     }
 
+#   ifdef XMRIG_FEATURE_RESCTRL
+    // Raw PQR_ASSOC and L3 mask writes conflict with the kernel which owns them when resctrl filesystem is mounted.
+    if (m_cacheQoS && Resctrl::isMounted()) {
+        LOG_WARN("%s " YELLOW_BOLD("resctrl filesystem is mounted, cache QoS is disabled, use \"resctrl\" option instead"), Msr::tag());
+
+        m_cacheQoS = false;
+    }
+#   endif
+
     if ((m_enabled = wrmsr(preset, threads, m_cacheQoS, config.rdmsr()))) {
         LOG_NOTICE("%s " GREEN_BOLD("register values for \"%s\" preset have been set successfully") BLACK_BOLD(" (%" PRIu64 " ms)"), Msr::tag(), config.msrPresetName(), Chrono::steadyMSecs() - ts);
+
+        if (config.wrmsrWatchdog() > 0) {
+            watchdog = new RxMsrWatchdog(preset, config.msrPresetName(), config.wrmsrWatchdog() * 1000ULL);
+        }
     }
     else {
         LOG_ERR("%s " RED_BOLD("FAILED TO APPLY MSR MOD, HASHRATE WILL BE LOW"), Msr::tag());
@@ -171,6 +333,9 @@ void xmrig::RxMsr::destroy()
     m_initialized = false;
     m_enabled     = false;
 
+    delete watchdog;
+    watchdog = nullptr;
+
     if (items.empty()) {
         return;
     }
@@ -181,3 +346,9 @@ void xmrig::RxMsr::destroy()
         LOG_ERR("%s " RED_BOLD("failed to restore initial state" BLACK_BOLD(" (%" PRIu64 " ms)")), Msr::tag(), Chrono::steadyMSecs() - ts);
     }
 }
+
+
+rapidjson::Value xmrig::RxMsr::toJSON(rapidjson::Document &doc)
+{
+    return watchdog ? watchdog->toJSON(doc) : rapidjson::Value(rapidjson::kNullType);
+}
@@ -21,6 +21,9 @@
 #define XMRIG_RXMSR_H
 
 
+#include "3rdparty/rapidjson/fwd.h"
+
+
 #include <vector>
 
 
@@ -39,6 +42,7 @@ public:
     static inline bool isInitialized()  { return m_initialized; }
 
     static bool init(const RxConfig &config, const std::vector<CpuThread> &threads);
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
     static void destroy();
 
 private:
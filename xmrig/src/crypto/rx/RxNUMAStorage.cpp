@@ -18,21 +18,20 @@
  */
 
 #include "crypto/rx/RxNUMAStorage.h"
-#include "backend/cpu/Cpu.h"
-#include "backend/cpu/platform/HwlocCpuInfo.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
-#include "base/kernel/Platform.h"
 #include "base/tools/Chrono.h"
+#include "crypto/common/VirtualMemory.h"
+#include "crypto/randomx/randomx.h"
 #include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
+#include "crypto/rx/RxDiskCache.h"
 #include "crypto/rx/RxSeed.h"
 
 
 #include <map>
 #include <mutex>
-#include <hwloc.h>
 #include <thread>
 
 
@@ -43,24 +42,6 @@ constexpr size_t oneMiB = 1024 * 1024;
 static std::mutex mutex;
 
 
-static bool bindToNUMANode(uint32_t nodeId)
-{
-    auto cpu         = static_cast<HwlocCpuInfo *>(Cpu::info());
-    hwloc_obj_t node = hwloc_get_numanode_obj_by_os_index(cpu->topology(), nodeId);
-    if (!node) {
-        return false;
-    }
-
-    if (cpu->membind(node->nodeset)) {
-        Platform::setThreadAffinity(static_cast<uint64_t>(hwloc_bitmap_first(node->cpuset)));
-
-        return true;
-    }
-
-    return false;
-}
-
-
 static inline void printSkipped(uint32_t nodeId, const char *reason)
 {
     LOG_WARN("%s" CYAN_BOLD("#%u ") RED_BOLD("skipped") YELLOW(" (%s)"), Tags::randomx(), nodeId, reason);
@@ -165,7 +146,7 @@ public:
     }
 
 
-    inline void initDatasets(uint32_t threads, int priority)
+    inline void initDatasets(uint32_t threads, int priority, const std::function<void(RxCache *)> &cacheReady)
     {
         uint64_t ts = Chrono::steadyMSecs();
         uint32_t id = 0;
@@ -176,8 +157,11 @@ public:
             }
         }
 
+        RxDiskCache::cancel();
+
         auto primary = dataset(id);
-        primary->init(m_seed.data(), threads, priority);
+        primary->init(m_seed.data(), RxAlgo::apply(m_seed.algorithm()), threads, priority, cacheReady,
+                      [this](void *raw, size_t size) { return RxDiskCache::load(m_seed, raw, size); });
 
         printDatasetReady(id, ts);
 
@@ -193,6 +177,14 @@ public:
             join();
         }
 
+        for (auto const &item : m_datasets) {
+            item.second->auditNumaPages();
+        }
+
+        if (!primary->isLoaded()) {
+            RxDiskCache::save(m_seed, primary->raw(), randomx_dataset_item_count() * RANDOMX_DATASET_ITEM_SIZE);
+        }
+
         m_ready = true;
     }
 
@@ -208,12 +200,25 @@ public:
     }
 
 
+    inline std::vector<NumaPagesInfo> numaPages() const
+    {
+        std::vector<NumaPagesInfo> pages;
+        for (auto const &item : m_datasets) {
+            if (item.second->numaPages().isValid()) {
+                pages.emplace_back(item.second->numaPages());
+            }
+        }
+
+        return pages;
+    }
+
+
 private:
     static void allocate(RxNUMAStoragePrivate *d_ptr, uint32_t nodeId, bool hugePages, bool oneGbPages)
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        if (!bindToNUMANode(nodeId)) {
+        if (!VirtualMemory::bindToNode(nodeId)) {
             printSkipped(nodeId, "can't bind memory");
 
             return;
@@ -237,7 +242,7 @@ private:
     {
         const uint64_t ts = Chrono::steadyMSecs();
 
-        bindToNUMANode(nodeId);
+        VirtualMemory::bindToNode(nodeId);
 
         auto cache = new RxCache(hugePages, nodeId);
         if (!cache->get()) {
@@ -372,7 +377,18 @@ xmrig::RxDataset *xmrig::RxNUMAStorage::dataset(const Job &job, uint32_t nodeId)
 }
 
 
-void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode, int priority)
+std::vector<xmrig::NumaPagesInfo> xmrig::RxNUMAStorage::numaPages() const
+{
+    if (!d_ptr->isAllocated()) {
+        return {};
+    }
+
+    return d_ptr->numaPages();
+}
+
+
+void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode, int priority,
+                                const std::function<void(RxCache *)> &cacheReady)
 {
     d_ptr->setSeed(seed);
 
@@ -380,5 +396,5 @@ void xmrig::RxNUMAStorage::init(const RxSeed &seed, uint32_t threads, bool hugeP
         return;
     }
 
-    d_ptr->initDatasets(threads, priority);
+    d_ptr->initDatasets(threads, priority, cacheReady);
 }
@@ -23,8 +23,11 @@
 #include "base/io/Async.h"
 #include "base/io/log/Log.h"
 #include "base/io/log/Tags.h"
+#include "base/tools/Chrono.h"
 #include "base/tools/Cvt.h"
+#include "crypto/common/MemoryPlanner.h"
 #include "crypto/rx/RxBasicStorage.h"
+#include "crypto/rx/RxDataset.h"
 
 
 #ifdef XMRIG_FEATURE_HWLOC
@@ -32,6 +35,10 @@
 #endif
 
 
+#include <algorithm>
+#include <cinttypes>
+
+
 xmrig::RxQueue::RxQueue(IRxListener *listener) :
     m_listener(listener)
 {
@@ -43,14 +50,16 @@ xmrig::RxQueue::RxQueue(IRxListener *listener) :
 xmrig::RxQueue::~RxQueue()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    m_state = STATE_SHUTDOWN;
+    m_shutdown = true;
     lock.unlock();
 
     m_cv.notify_one();
 
     m_thread.join();
 
-    delete m_storage;
+    for (auto &kv : m_slots) {
+        kv.second.light.reset();
+    }
 }
 
 
@@ -59,18 +68,63 @@ xmrig::RxDataset *xmrig::RxQueue::dataset(const Job &job, uint32_t nodeId)
     std::lock_guard<std::mutex> lock(m_mutex);
 
     if (isReadyUnsafe(job)) {
-        return m_storage->dataset(job, nodeId);
+        return slot(job.group())->storage->dataset(job, nodeId);
     }
 
     return nullptr;
 }
 
 
+std::shared_ptr<xmrig::RxDataset> xmrig::RxQueue::lightDataset(const Job &job, uint32_t threadId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (isLightReadyUnsafe(job) && threadId < slot(job.group())->lightThreads) {
+        return slot(job.group())->light;
+    }
+
+    return {};
+}
+
+
 xmrig::HugePagesInfo xmrig::RxQueue::hugePages()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    return m_storage && m_state == STATE_IDLE ? m_storage->hugePages() : HugePagesInfo();
+    HugePagesInfo pages;
+
+    for (const auto &kv : m_slots) {
+        if (kv.second.storage && kv.second.state == STATE_IDLE) {
+            pages += kv.second.storage->hugePages();
+        }
+    }
+
+    return pages;
+}
+
+
+std::vector<xmrig::NumaPagesInfo> xmrig::RxQueue::numaPages()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::vector<NumaPagesInfo> pages;
+
+    for (const auto &kv : m_slots) {
+        if (kv.second.storage && kv.second.state == STATE_IDLE) {
+            const auto storage = kv.second.storage->numaPages();
+            pages.insert(pages.end(), storage.begin(), storage.end());
+        }
+    }
+
+    return pages;
+}
+
+
+uint64_t xmrig::RxQueue::initTime()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return m_initTime;
 }
 
 
@@ -83,93 +137,238 @@ bool xmrig::RxQueue::isReady(const T &seed)
 }
 
 
-void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
+bool xmrig::RxQueue::isLightReady(const Job &job)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    return isLightReadyUnsafe(job);
+}
+
+
+void xmrig::RxQueue::addLightHashes(uint32_t group, uint64_t count)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    const auto it = m_slots.find(group);
+    if (it != m_slots.end()) {
+        it->second.lightHashes.fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+
+void xmrig::RxQueue::enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, uint32_t lightThreads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
 
-    if (!m_storage) {
+    Slot &slot = m_slots[seed.group()];
+
+    if (!slot.storage) {
 #       ifdef XMRIG_FEATURE_HWLOC
         if (!nodeset.empty()) {
-            m_storage = new RxNUMAStorage(nodeset);
+            slot.storage.reset(new RxNUMAStorage(nodeset));
         }
         else
 #       endif
         {
-            m_storage = new RxBasicStorage();
+            slot.storage.reset(new RxBasicStorage());
         }
     }
 
-    if (m_state == STATE_PENDING && m_seed == seed) {
+    if (slot.state == STATE_PENDING && slot.seed == seed) {
         return;
     }
 
-    m_queue.emplace_back(seed, nodeset, threads, hugePages, oneGbPages, mode, priority);
-    m_seed  = seed;
-    m_state = STATE_PENDING;
+    // Only the last seed of a group is initialized, datasets of other groups are not touched.
+    m_queue.remove_if([&seed](const RxQueueItem &item) { return item.seed.group() == seed.group(); });
+    m_queue.emplace_back(seed, nodeset, threads, lightThreads, hugePages, oneGbPages, mode, priority);
+
+    slot.seed  = seed;
+    slot.state = STATE_PENDING;
+
+    // Workers still hashing the previous seed in light mode release it when the miner pauses for the new one.
+    auto light = std::move(slot.light);
 
     lock.unlock();
 
+    light.reset();
+
     m_cv.notify_one();
 }
 
 
+bool xmrig::RxQueue::isLightReadyUnsafe(const Job &job) const
+{
+    const Slot *slot = this->slot(job.group());
+
+    return slot && slot->light && slot->state == STATE_PENDING && !isQueued(job.group()) && slot->seed == job;
+}
+
+
+bool xmrig::RxQueue::isQueued(uint32_t group) const
+{
+    return std::any_of(m_queue.begin(), m_queue.end(), [group](const RxQueueItem &item) { return item.seed.group() == group; });
+}
+
+
+const xmrig::RxQueue::Slot *xmrig::RxQueue::slot(uint32_t group) const
+{
+    const auto it = m_slots.find(group);
+
+    return it != m_slots.end() ? &it->second : nullptr;
+}
+
+
 template<typename T>
 bool xmrig::RxQueue::isReadyUnsafe(const T &seed) const
 {
-    return m_storage != nullptr && m_storage->isAllocated() && m_state == STATE_IDLE && m_seed == seed;
+    const Slot *slot = this->slot(seed.group());
+
+    return slot && slot->storage && slot->storage->isAllocated() && slot->state == STATE_IDLE && slot->seed == seed;
 }
 
 
 void xmrig::RxQueue::backgroundInit()
 {
-    while (m_state != STATE_SHUTDOWN) {
-        std::unique_lock<std::mutex> lock(m_mutex);
+    std::unique_lock<std::mutex> lock(m_mutex);
 
-        if (m_state == STATE_IDLE) {
-            m_cv.wait(lock, [this]{ return m_state != STATE_IDLE; });
-        }
+    while (true) {
+        m_cv.wait(lock, [this]{ return m_shutdown || !m_queue.empty(); });
 
-        if (m_state != STATE_PENDING) {
-            continue;
+        if (m_shutdown) {
+            return;
         }
 
-        const auto item = m_queue.back();
-        m_queue.clear();
+        const auto item      = m_queue.front();
+        const uint32_t group = item.seed.group();
+        Slot &slot           = m_slots[group];
+
+        m_queue.pop_front();
 
         lock.unlock();
 
-        LOG_INFO("%s" MAGENTA_BOLD("init dataset%s") " algo " WHITE_BOLD("%s (") CYAN_BOLD("%u") WHITE_BOLD(" threads)") BLACK_BOLD(" seed %s..."),
+        char group_buf[24] = {};
+        if (group > 0) {
+            snprintf(group_buf, sizeof(group_buf), " group %u", group);
+        }
+
+        LOG_INFO("%s" MAGENTA_BOLD("init dataset%s") "%s algo " WHITE_BOLD("%s (") CYAN_BOLD("%u") WHITE_BOLD(" threads)") BLACK_BOLD(" seed %s..."),
                  Tags::randomx(),
                  item.nodeset.size() > 1 ? "s" : "",
+                 group_buf,
                  item.seed.algorithm().name(),
                  item.threads,
                  Cvt::toHex(item.seed.data().data(), 8).data()
                  );
 
-        m_storage->init(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority);
+        // Cache must not be initialized again while it is used by light mode VMs.
+        while (!slot.lightRef.expired() && !m_shutdown) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+
+        const uint64_t ts = Chrono::steadyMSecs();
+
+        slot.storage->init(item.seed, item.threads, item.hugePages, item.oneGbPages, item.mode, item.priority, [this, &item](RxCache *cache) { onCacheReady(cache, item); });
+
+        MemoryPlanner::mark(MemoryPlanner::DATASET);
 
         lock.lock();
 
-        if (m_state == STATE_SHUTDOWN || !m_queue.empty()) {
+        m_initTime = Chrono::steadyMSecs() - ts;
+
+        auto light = std::move(slot.light);
+        lock.unlock();
+        light.reset();
+        lock.lock();
+
+        if (m_shutdown) {
+            return;
+        }
+
+        if (isQueued(group)) {
             continue;
         }
 
         // Update seed here again in case there was more than one item in the queue
-        m_seed = item.seed;
-        m_state = STATE_IDLE;
+        slot.seed  = item.seed;
+        slot.state = STATE_IDLE;
+
+        m_ready.insert(group);
         m_async->send();
     }
 }
 
 
+void xmrig::RxQueue::onCacheReady(RxCache *cache, const RxQueueItem &item)
+{
+    if (item.lightThreads == 0) {
+        return;
+    }
+
+    const uint32_t group = item.seed.group();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Slot *slot = &m_slots[group];
+    lock.unlock();
+
+    const uint64_t ts = Chrono::steadyMSecs();
+    slot->lightHashes = 0;
+
+    std::shared_ptr<RxDataset> light(new RxDataset(cache), [slot, ts](RxDataset *dataset) {
+        dataset->setCache(nullptr);
+        delete dataset;
+
+        const uint64_t hashes  = slot->lightHashes.load(std::memory_order_relaxed);
+        const uint64_t elapsed = Chrono::steadyMSecs() - ts;
+
+        if (hashes) {
+            LOG_INFO("%s" WHITE_BOLD("light mode ") CYAN_BOLD("%" PRIu64) WHITE_BOLD(" hashes") BLACK_BOLD(" in %.1f s (%.1f H/s) while dataset was initialized"),
+                     Tags::randomx(), hashes, elapsed / 1000.0, elapsed ? hashes * 1000.0 / elapsed : 0.0);
+        }
+    });
+
+    lock.lock();
+
+    if (slot->state != STATE_PENDING || isQueued(group) || slot->seed != item.seed) {
+        return;
+    }
+
+    slot->light        = light;
+    slot->lightRef     = light;
+    slot->lightThreads = item.lightThreads;
+
+    m_ready.insert(group);
+
+    lock.unlock();
+
+    LOG_INFO("%s" WHITE_BOLD("cache ready, ") CYAN_BOLD("%u") WHITE_BOLD(" threads hash in light mode"), Tags::randomx(), item.lightThreads);
+
+    m_async->send();
+}
+
+
 void xmrig::RxQueue::onReady()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
-    const bool ready = m_listener && m_state == STATE_IDLE;
+
+    std::vector<uint32_t> groups;
+
+    for (uint32_t group : m_ready) {
+        const Slot *slot = this->slot(group);
+
+        if (slot && (slot->state == STATE_IDLE || slot->light)) {
+            groups.push_back(group);
+        }
+    }
+
+    m_ready.clear();
     lock.unlock();
 
-    if (ready) {
-        m_listener->onDatasetReady();
+    if (!m_listener) {
+        return;
+    }
+
+    for (uint32_t group : groups) {
+        m_listener->onDatasetReady(group);
     }
 }
 
@@ -25,13 +25,20 @@
 #include "base/kernel/interfaces/IAsyncListener.h"
 #include "base/tools/Object.h"
 #include "crypto/common/HugePagesInfo.h"
+#include "crypto/common/NumaPagesInfo.h"
 #include "crypto/rx/RxConfig.h"
 #include "crypto/rx/RxSeed.h"
 
 
+#include <atomic>
 #include <condition_variable>
+#include <list>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 
 namespace xmrig
@@ -40,19 +47,21 @@ namespace xmrig
 
 class IRxListener;
 class IRxStorage;
+class RxCache;
 class RxDataset;
 
 
 class RxQueueItem
 {
 public:
-    RxQueueItem(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) :
+    RxQueueItem(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, uint32_t lightThreads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority) :
         hugePages(hugePages),
         oneGbPages(oneGbPages),
         priority(priority),
         mode(mode),
         seed(seed),
         nodeset(nodeset),
+        lightThreads(lightThreads),
         threads(threads)
     {}
 
@@ -62,10 +71,15 @@ public:
     const RxConfig::Mode mode;
     const RxSeed seed;
     const std::vector<uint32_t> nodeset;
+    const uint32_t lightThreads;
     const uint32_t threads;
 };
 
 
+/**
+ * Every pool group (RxSeed::group()) has its own dataset storage, so groups can mine different RandomX variants or
+ * seeds at the same time. Datasets are initialized one after another by a single background thread.
+ */
 class RxQueue : public IAsyncListener
 {
 public:
@@ -75,9 +89,14 @@ public:
     ~RxQueue() override;
 
     HugePagesInfo hugePages();
+    std::vector<NumaPagesInfo> numaPages();
     RxDataset *dataset(const Job &job, uint32_t nodeId);
+    std::shared_ptr<RxDataset> lightDataset(const Job &job, uint32_t threadId);
     template<typename T> bool isReady(const T &seed);
-    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
+    bool isLightReady(const Job &job);
+    uint64_t initTime();
+    void addLightHashes(uint32_t group, uint64_t count);
+    void enqueue(const RxSeed &seed, const std::vector<uint32_t> &nodeset, uint32_t threads, uint32_t lightThreads, bool hugePages, bool oneGbPages, RxConfig::Mode mode, int priority);
 
 protected:
     inline void onAsync() override  { onReady(); }
@@ -85,23 +104,41 @@ protected:
 private:
     enum State {
         STATE_IDLE,
-        STATE_PENDING,
-        STATE_SHUTDOWN
+        STATE_PENDING
+    };
+
+    struct Slot
+    {
+        std::unique_ptr<IRxStorage> storage;
+        RxSeed seed;
+        State state             = STATE_IDLE;
+        uint32_t lightThreads   = 0;
+        std::atomic<uint64_t> lightHashes{};
+
+        // Light mode view of the cache while the dataset is initialized, workers hold references until they switch
+        // to the dataset, the cache is not initialized again before all of them are released.
+        std::shared_ptr<RxDataset> light;
+        std::weak_ptr<RxDataset> lightRef;
     };
 
+    bool isLightReadyUnsafe(const Job &job) const;
+    bool isQueued(uint32_t group) const;
+    const Slot *slot(uint32_t group) const;
     template<typename T> bool isReadyUnsafe(const T &seed) const;
     void backgroundInit();
+    void onCacheReady(RxCache *cache, const RxQueueItem &item);
     void onReady();
 
     IRxListener *m_listener = nullptr;
-    IRxStorage *m_storage   = nullptr;
-    RxSeed m_seed;
-    State m_state = STATE_IDLE;
+    uint64_t m_initTime     = 0;
+    std::atomic<bool> m_shutdown{};
     std::condition_variable m_cv;
+    std::list<RxQueueItem> m_queue;
+    std::map<uint32_t, Slot> m_slots;
     std::mutex m_mutex;
+    std::set<uint32_t> m_ready;         // groups with a new dataset or light mode cache, see onReady()
     std::shared_ptr<Async> m_async;
     std::thread m_thread;
-    std::vector<RxQueueItem> m_queue;
 };
 
 
@@ -44,13 +44,15 @@ class RxSeed
 public:
     RxSeed() = default;
 
-    inline RxSeed(const Algorithm &algorithm, const Buffer &seed) : m_algorithm(algorithm), m_data(seed)    {}
-    inline RxSeed(const Job &job) : m_algorithm(job.algorithm()), m_data(job.seed())                        {}
+    inline RxSeed(const Algorithm &algorithm, const Buffer &seed) : m_algorithm(algorithm), m_data(seed)                        {}
+    inline RxSeed(const Job &job) : m_algorithm(job.algorithm()), m_data(job.seed()), m_group(job.group())                     {}
 
+    // Pool group is not a part of the seed, it only selects the dataset storage of the group (see RxQueue).
     inline bool isEqual(const Job &job) const           { return m_algorithm == job.algorithm() && m_data == job.seed(); }
     inline bool isEqual(const RxSeed &other) const      { return m_algorithm == other.m_algorithm && m_data == other.m_data; }
     inline const Algorithm &algorithm() const           { return m_algorithm; }
     inline const Buffer &data() const                   { return m_data; }
+    inline uint32_t group() const                       { return m_group; }
 
     inline bool operator!=(const Job &job) const        { return !isEqual(job); }
     inline bool operator!=(const RxSeed &other) const   { return !isEqual(other); }
@@ -60,6 +62,7 @@ public:
 private:
     Algorithm m_algorithm;
     Buffer m_data;
+    uint32_t m_group = 0;
 };
 
 
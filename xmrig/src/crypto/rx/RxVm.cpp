@@ -20,17 +20,55 @@
 
 #include "crypto/randomx/randomx.h"
 #include "backend/cpu/Cpu.h"
+#include "crypto/rx/RxAlgo.h"
 #include "crypto/rx/RxCache.h"
 #include "crypto/rx/RxDataset.h"
 #include "crypto/rx/RxVm.h"
 
 
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+
 #if defined(XMRIG_FEATURE_SSE4_1)
 extern "C" uint32_t rx_blake2b_use_sse41;
 #endif
 
 
-randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node)
+namespace xmrig {
+
+
+struct LightVm
+{
+    randomx_vm *vm;
+    uint64_t hits;      // reads before the last reset of the hit rate
+    uint64_t misses;
+};
+
+
+static std::mutex mutex;
+static std::vector<LightVm> lightVms;
+static uint64_t hits        = 0;    // of destroyed VMs
+static uint64_t misses      = 0;
+
+
+static inline void datasetReads(const LightVm &light, uint64_t &h, uint64_t &m)
+{
+    uint64_t vmHits   = 0;
+    uint64_t vmMisses = 0;
+    randomx_get_dataset_reads(light.vm, &vmHits, &vmMisses);
+
+    h += vmHits - light.hits;
+    m += vmMisses - light.misses;
+}
+
+
+} // namespace xmrig
+
+
+randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node, Algorithm::Id algorithm)
 {
     int flags = 0;
 
@@ -55,13 +93,63 @@ randomx_vm *xmrig::RxVm::create(RxDataset *dataset, uint8_t *scratchpad, bool so
     rx_blake2b_use_sse41 = Cpu::info()->has(ICpuInfo::FLAG_SSE41) ? 1 : 0;
 #   endif
 
-    return randomx_create_vm(static_cast<randomx_flags>(flags), !dataset->get() ? dataset->cache()->get() : nullptr, dataset->get(), scratchpad, node);
+    auto vm = randomx_create_vm(static_cast<randomx_flags>(flags), !dataset->get() ? dataset->cache()->get() : nullptr, dataset->get(), scratchpad, node, RxAlgo::apply(algorithm));
+
+    if (vm && !dataset->get()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        lightVms.push_back({ vm, 0, 0 });
+    }
+
+    return vm;
+}
+
+
+// Share of light mode dataset reads served by hybrid mode precomputed items, NaN if there were none.
+double xmrig::RxVm::hitRate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t h = hits;
+    uint64_t m = misses;
+
+    for (const auto &light : lightVms) {
+        datasetReads(light, h, m);
+    }
+
+    return h ? (h * 100.0 / (h + m)) : (m ? 0.0 : NAN);
+}
+
+
+// Counters of running VMs are not touched, JIT code updates them, reads so far become their new baseline.
+void xmrig::RxVm::resetHitRate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    hits   = 0;
+    misses = 0;
+
+    for (auto &light : lightVms) {
+        randomx_get_dataset_reads(light.vm, &light.hits, &light.misses);
+    }
 }
 
 
 void xmrig::RxVm::destroy(randomx_vm* vm)
 {
-    if (vm) {
-        randomx_destroy_vm(vm);
+    if (!vm) {
+        return;
     }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = std::find_if(lightVms.begin(), lightVms.end(), [vm](const LightVm &light) { return light.vm == vm; });
+        if (it != lightVms.end()) {
+            datasetReads(*it, hits, misses);
+
+            lightVms.erase(it);
+        }
+    }
+
+    randomx_destroy_vm(vm);
 }
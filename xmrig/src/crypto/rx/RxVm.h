@@ -21,6 +21,9 @@
 #define XMRIG_RX_VM_H
 
 
+#include "base/crypto/Algorithm.h"
+
+
 #include <cstdint>
 
 
@@ -38,8 +41,10 @@ class RxDataset;
 class RxVm
 {
 public:
-    static randomx_vm *create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node);
+    static randomx_vm *create(RxDataset *dataset, uint8_t *scratchpad, bool softAes, const Assembly &assembly, uint32_t node, Algorithm::Id algorithm);
+    static double hitRate();
     static void destroy(randomx_vm *vm);
+    static void resetHitRate();
 };
 
 
@@ -0,0 +1,104 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "hw/energy/EnergyConfig.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+#include <algorithm>
+#include <array>
+#include <strings.h>
+
+
+namespace xmrig {
+
+
+const char *EnergyConfig::kController       = "controller";
+const char *EnergyConfig::kEnabled          = "enabled";
+const char *EnergyConfig::kField            = "energy";
+const char *EnergyConfig::kInterval         = "interval";
+const char *EnergyConfig::kMinThreads       = "min-threads";
+const char *EnergyConfig::kPath             = "path";
+const char *EnergyConfig::kPowerCap         = "power-cap";
+
+const char *EnergyConfig::kDefaultPath      = "/sys/class/powercap";
+
+
+static const std::array<const char *, EnergyConfig::ModeMax> modeNames = { "off", "efficiency", "power-cap" };
+
+
+} // namespace xmrig
+
+
+const char *xmrig::EnergyConfig::modeName(Mode mode)
+{
+    return mode < ModeMax ? modeNames[mode] : modeNames[ModeOff];
+}
+
+
+rapidjson::Value xmrig::EnergyConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value obj(kObjectType);
+
+    obj.AddMember(StringRef(kEnabled),      m_enabled, allocator);
+    obj.AddMember(StringRef(kPath),         m_path.toJSON(), allocator);
+    obj.AddMember(StringRef(kController),   StringRef(modeName(m_mode)), allocator);
+    obj.AddMember(StringRef(kPowerCap),     m_powerCap, allocator);
+    obj.AddMember(StringRef(kInterval),     m_interval, allocator);
+    obj.AddMember(StringRef(kMinThreads),   m_minThreads, allocator);
+
+    return obj;
+}
+
+
+void xmrig::EnergyConfig::read(const rapidjson::Value &value)
+{
+    if (value.IsObject()) {
+        m_enabled       = Json::getBool(value, kEnabled, m_enabled);
+        m_path          = Json::getString(value, kPath);
+        m_powerCap      = std::max(Json::getDouble(value, kPowerCap, m_powerCap), 0.0);
+        m_interval      = std::max(Json::getUint(value, kInterval, m_interval), 15U);
+        m_minThreads    = std::max(Json::getUint(value, kMinThreads, m_minThreads), 1U);
+
+        setMode(Json::getValue(value, kController));
+    }
+    else if (value.IsBool()) {
+        m_enabled = value.GetBool();
+    }
+}
+
+
+void xmrig::EnergyConfig::setMode(const rapidjson::Value &value)
+{
+    if (value.IsString()) {
+        for (size_t i = 0; i < modeNames.size(); ++i) {
+            if (strcasecmp(value.GetString(), modeNames[i]) == 0) {
+                m_mode = static_cast<Mode>(i);
+
+                return;
+            }
+        }
+    }
+
+    m_mode = ModeOff;
+}
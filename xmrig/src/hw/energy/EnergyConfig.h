@@ -0,0 +1,79 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_ENERGYCONFIG_H
+#define XMRIG_ENERGYCONFIG_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
+
+
+namespace xmrig {
+
+
+class EnergyConfig
+{
+public:
+    enum Mode : uint32_t {
+        ModeOff,
+        ModeEfficiency,     // park or unpark threads to maximize hashes per joule
+        ModePowerCap,       // park threads while package power is above the cap
+        ModeMax
+    };
+
+    static const char *kController;
+    static const char *kEnabled;
+    static const char *kField;
+    static const char *kInterval;
+    static const char *kMinThreads;
+    static const char *kPath;
+    static const char *kPowerCap;
+
+    static const char *kDefaultPath;
+
+    EnergyConfig() = default;
+
+    inline bool isEnabled() const           { return m_enabled; }
+    inline const char *path() const         { return m_path.isNull() ? kDefaultPath : m_path.data(); }
+    inline double powerCap() const          { return m_powerCap; }
+    inline Mode mode() const                { return m_mode; }
+    inline uint32_t minThreads() const      { return m_minThreads; }
+    inline uint64_t interval() const        { return m_interval * 1000ULL; }
+
+    static const char *modeName(Mode mode);
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    void read(const rapidjson::Value &value);
+
+private:
+    void setMode(const rapidjson::Value &value);
+
+    bool m_enabled          = false;
+    double m_powerCap       = 0.0;
+    Mode m_mode             = ModeOff;
+    String m_path;
+    uint32_t m_interval     = 30;
+    uint32_t m_minThreads   = 1;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_ENERGYCONFIG_H */
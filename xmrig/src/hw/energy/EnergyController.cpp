@@ -0,0 +1,140 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "hw/energy/EnergyController.h"
+
+
+#include <algorithm>
+#include <cmath>
+
+
+xmrig::EnergyController::EnergyController(const EnergyConfig &config, size_t threads, uint64_t now) :
+    m_cap(config.powerCap()),
+    m_mode(config.mode()),
+    m_min(std::min<size_t>(config.minThreads(), threads)),
+    m_threads(threads),
+    m_interval(config.interval()),
+    m_active(threads),
+    m_bestActive(threads),
+    m_next(now + config.interval())
+{
+}
+
+
+bool xmrig::EnergyController::isEqual(const EnergyConfig &config, size_t threads) const
+{
+    return m_threads  == threads &&
+           m_mode     == config.mode() &&
+           m_cap      == config.powerCap() &&
+           m_interval == config.interval() &&
+           m_min      == std::min<size_t>(config.minThreads(), threads);
+}
+
+
+bool xmrig::EnergyController::update(uint64_t now, double power, double hashrate)
+{
+    if (!isEnabled() || now < m_next) {
+        return false;
+    }
+
+    m_next = now + m_interval;
+
+    if (!std::isnormal(power) || power <= 0.0) {
+        return false;
+    }
+
+    if (m_mode == EnergyConfig::ModePowerCap) {
+        return powerCap(power);
+    }
+
+    if (!std::isnormal(hashrate) || hashrate <= 0.0) {
+        return false;
+    }
+
+    return efficiency(hashrate / power);
+}
+
+
+bool xmrig::EnergyController::efficiency(double hpj)
+{
+    if (m_active != m_bestActive) {
+        if (hpj > m_best) {
+            m_best       = hpj;
+            m_bestActive = m_active;
+        }
+        else {
+            m_direction = -m_direction;
+            m_hold      = kHoldIntervals;
+
+            return setActive(m_bestActive);
+        }
+    }
+    else {
+        // Conditions drift (temperature, clocks, other load), so the best value is measured again.
+        m_best = hpj;
+
+        if (m_hold > 0) {
+            --m_hold;
+
+            return false;
+        }
+    }
+
+    auto next = static_cast<int64_t>(m_active) + m_direction;
+    if (next < static_cast<int64_t>(m_min) || next > static_cast<int64_t>(m_threads)) {
+        m_direction = -m_direction;
+        next        = static_cast<int64_t>(m_active) + m_direction;
+    }
+
+    if (next < static_cast<int64_t>(m_min) || next > static_cast<int64_t>(m_threads)) {
+        return false;
+    }
+
+    return setActive(static_cast<size_t>(next));
+}
+
+
+bool xmrig::EnergyController::powerCap(double power)
+{
+    if (m_cap <= 0.0) {
+        return false;
+    }
+
+    if (power > m_cap && m_active > m_min) {
+        return setActive(m_active - 1);
+    }
+
+    if (power < m_cap * 0.9 && m_active < m_threads) {
+        return setActive(m_active + 1);
+    }
+
+    return false;
+}
+
+
+bool xmrig::EnergyController::setActive(size_t active)
+{
+    if (active == m_active) {
+        return false;
+    }
+
+    m_active = active;
+
+    return true;
+}
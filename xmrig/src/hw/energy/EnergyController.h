@@ -0,0 +1,78 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_ENERGYCONTROLLER_H
+#define XMRIG_ENERGYCONTROLLER_H
+
+
+#include "hw/energy/EnergyConfig.h"
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig {
+
+
+/**
+ * Closed loop controller of the number of active (not parked) threads.
+ *
+ * A decision is made once per interval, so hashrate and power are measured with the new threads count only.
+ * Efficiency mode is a hill climb on hashes per joule: a step which made it worse is reverted and the other direction
+ * is tried after a few intervals. Power cap mode parks one thread per interval while power is above the cap and
+ * unparks one while it is below 90% of the cap.
+ */
+class EnergyController
+{
+public:
+    EnergyController(const EnergyConfig &config, size_t threads, uint64_t now);
+
+    inline bool isEnabled() const   { return m_mode != EnergyConfig::ModeOff; }
+    inline EnergyConfig::Mode mode() const { return m_mode; }
+    inline size_t active() const    { return m_active; }
+    inline size_t threads() const   { return m_threads; }
+
+    bool isEqual(const EnergyConfig &config, size_t threads) const;
+    bool update(uint64_t now, double power, double hashrate);
+
+private:
+    bool efficiency(double hpj);
+    bool powerCap(double power);
+    bool setActive(size_t active);
+
+    constexpr static uint32_t kHoldIntervals = 8;
+
+    const double m_cap;
+    const EnergyConfig::Mode m_mode;
+    const size_t m_min;
+    const size_t m_threads;
+    const uint64_t m_interval;
+    double m_best       = 0.0;
+    int m_direction     = -1;
+    size_t m_active;
+    size_t m_bestActive;
+    uint32_t m_hold     = 0;
+    uint64_t m_next;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_ENERGYCONTROLLER_H */
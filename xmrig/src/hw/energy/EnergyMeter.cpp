@@ -0,0 +1,117 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "hw/energy/EnergyMeter.h"
+#include "3rdparty/fmt/core.h"
+
+
+#include <cmath>
+#include <fstream>
+
+
+namespace xmrig {
+
+
+constexpr size_t kMaxZones      = 64;
+constexpr size_t kMaxSamples    = 64;
+
+
+static int64_t readCounter(const std::string &path, const char *name)
+{
+    std::ifstream file(fmt::format("{}/{}", path, name));
+    uint64_t value = 0;
+
+    if (!file.is_open() || !(file >> value)) {
+        return -1;
+    }
+
+    return static_cast<int64_t>(value);
+}
+
+
+} // namespace xmrig
+
+
+xmrig::EnergyMeter::EnergyMeter(const char *path) :
+    m_path(path)
+{
+    for (size_t i = 0; i < kMaxZones; ++i) {
+        Zone zone;
+        zone.path = fmt::format("{}/intel-rapl:{}", m_path, i);
+
+        const int64_t value = readCounter(zone.path, "energy_uj");
+        if (value < 0) {
+            break;
+        }
+
+        const int64_t range = readCounter(zone.path, "max_energy_range_uj");
+
+        zone.last  = static_cast<uint64_t>(value);
+        zone.range = range > 0 ? static_cast<uint64_t>(range) : 0;
+
+        m_zones.emplace_back(std::move(zone));
+    }
+}
+
+
+double xmrig::EnergyMeter::power() const
+{
+    if (m_samples.size() < 2) {
+        return nan("");
+    }
+
+    const auto &last = m_samples.back();
+
+    for (const auto &sample : m_samples) {
+        if (last.first - sample.first <= kWindow) {
+            return last.first > sample.first ? (last.second - sample.second) * 1000.0 / static_cast<double>(last.first - sample.first) : nan("");
+        }
+    }
+
+    return nan("");
+}
+
+
+void xmrig::EnergyMeter::update(uint64_t timestamp)
+{
+    for (auto &zone : m_zones) {
+        const int64_t value = readCounter(zone.path, "energy_uj");
+        if (value < 0) {
+            continue;
+        }
+
+        const auto current = static_cast<uint64_t>(value);
+
+        // The counter takes values from 0 to max_energy_range_uj inclusive.
+        const uint64_t delta = current >= zone.last ? (current - zone.last) : (zone.range >= zone.last ? zone.range - zone.last + current + 1 : current);
+
+        // A real wraparound happens only close to the end of the range, anything else is a bogus read, the next delta is counted from it.
+        if (current >= zone.last || !zone.range || delta <= zone.range / 2) {
+            m_energy += delta / 1e6;
+        }
+
+        zone.last = current;
+    }
+
+    m_samples.emplace_back(timestamp, m_energy);
+
+    while (m_samples.size() > kMaxSamples || (m_samples.size() > 2 && timestamp - m_samples[1].first >= kWindow)) {
+        m_samples.pop_front();
+    }
+}
@@ -0,0 +1,76 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_ENERGYMETER_H
+#define XMRIG_ENERGYMETER_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace xmrig {
+
+
+/**
+ * Package energy counters of the Linux powercap interface (RAPL), all top level "intel-rapl:N" zones are summed.
+ *
+ * Any directory with the same layout can be used instead of /sys/class/powercap, each zone needs only "energy_uj"
+ * and optional "max_energy_range_uj" files, so the meter can be driven by plain files for testing.
+ */
+class EnergyMeter
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(EnergyMeter)
+
+    constexpr static uint64_t kWindow = 10000;
+
+    EnergyMeter(const char *path);
+
+    inline bool isAvailable() const     { return !m_zones.empty(); }
+    inline const std::string &path() const { return m_path; }
+    inline double energy() const        { return m_energy; }
+    inline size_t zones() const         { return m_zones.size(); }
+
+    double power() const;  // average over the last kWindow milliseconds, NaN if not enough samples
+    void update(uint64_t timestamp);
+
+private:
+    struct Zone
+    {
+        std::string path;
+        uint64_t last   = 0;
+        uint64_t range  = 0;
+    };
+
+    double m_energy = 0.0;                                  // joules since start
+    std::deque<std::pair<uint64_t, double> > m_samples;     // timestamp, energy
+    std::string m_path;
+    std::vector<Zone> m_zones;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_ENERGYMETER_H */
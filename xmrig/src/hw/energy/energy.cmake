@@ -0,0 +1,17 @@
+if (WITH_ENERGY AND XMRIG_OS_LINUX)
+    add_definitions(/DXMRIG_FEATURE_ENERGY)
+
+    list(APPEND HEADERS
+        src/hw/energy/EnergyConfig.h
+        src/hw/energy/EnergyController.h
+        src/hw/energy/EnergyMeter.h
+        )
+
+    list(APPEND SOURCES
+        src/hw/energy/EnergyConfig.cpp
+        src/hw/energy/EnergyController.cpp
+        src/hw/energy/EnergyMeter.cpp
+        )
+else()
+    remove_definitions(/DXMRIG_FEATURE_ENERGY)
+endif()
@@ -0,0 +1,190 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "hw/perf/PerfCounters.h"
+#include "base/io/log/Log.h"
+
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+
+namespace xmrig {
+
+
+static const char *kTag = YELLOW_BG_BOLD(WHITE_BOLD_S " perf    ");
+static std::atomic<bool> warned{ false };
+
+
+static const char *names[PerfCounters::COUNTER_MAX] = { "cycles", "instructions", "llc-misses", "dtlb-misses", "stalled-cycles" };
+
+
+static inline uint64_t cache_event(uint64_t cache, uint64_t op, uint64_t result)
+{
+    return cache | (op << 8) | (result << 16);
+}
+
+
+static int perf_open(uint32_t type, uint64_t config, int group)
+{
+    perf_event_attr attr{};
+    attr.size           = sizeof(attr);
+    attr.type           = type;
+    attr.config         = config;
+    attr.disabled       = group < 0 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group, PERF_FLAG_FD_CLOEXEC));
+}
+
+
+} // namespace xmrig
+
+
+xmrig::PerfCounters::PerfCounters()
+{
+    for (int &fd : m_fd) {
+        fd = -1;
+    }
+
+    for (uint32_t i = 0; i < COUNTER_MAX; ++i) {
+        open(static_cast<Counter>(i));
+    }
+
+    if (!isAvailable()) {
+        if (!warned.exchange(true)) {
+            LOG_WARN("%s " YELLOW_BOLD("hardware performance counters are not available (\"%s\")"), tag(), strerror(errno));
+        }
+
+        return;
+    }
+
+    ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+
+xmrig::PerfCounters::~PerfCounters()
+{
+    for (int fd : m_fd) {
+        if (fd >= 0 && fd != m_leader) {
+            close(fd);
+        }
+    }
+
+    if (m_leader >= 0) {
+        close(m_leader);
+    }
+}
+
+
+const char *xmrig::PerfCounters::name(Counter counter)
+{
+    return counter < COUNTER_MAX ? names[counter] : nullptr;
+}
+
+
+const char *xmrig::PerfCounters::tag()
+{
+    return kTag;
+}
+
+
+bool xmrig::PerfCounters::read(uint64_t *values) const
+{
+    if (!isAvailable()) {
+        return false;
+    }
+
+    struct {
+        uint64_t nr;
+        uint64_t timeEnabled;
+        uint64_t timeRunning;
+        uint64_t values[COUNTER_MAX];
+    } data{};
+
+    if (::read(m_leader, &data, sizeof(data)) <= 0 || data.nr != m_count || data.timeRunning == 0) {
+        return false;
+    }
+
+    // The group may be multiplexed with other users of the PMU, extrapolate to the full enabled time.
+    const double scale = static_cast<double>(data.timeEnabled) / data.timeRunning;
+
+    memset(values, 0, sizeof(uint64_t) * COUNTER_MAX);
+
+    for (size_t i = 0; i < m_count; ++i) {
+        values[m_order[i]] = static_cast<uint64_t>(data.values[i] * scale);
+    }
+
+    return true;
+}
+
+
+bool xmrig::PerfCounters::open(Counter counter)
+{
+    int fd = -1;
+
+    switch (counter) {
+    case CYCLES:
+        fd = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, m_leader);
+        break;
+
+    case INSTRUCTIONS:
+        fd = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, m_leader);
+        break;
+
+    case LLC_MISSES:
+        fd = perf_open(PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS), m_leader);
+        if (fd < 0) {
+            fd = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, m_leader);
+        }
+        break;
+
+    case DTLB_MISSES:
+        fd = perf_open(PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS), m_leader);
+        break;
+
+    case STALLED_CYCLES:
+        fd = perf_open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND, m_leader);
+        break;
+
+    default:
+        break;
+    }
+
+    if (fd < 0) {
+        return false;
+    }
+
+    if (m_leader < 0) {
+        m_leader = fd;
+    }
+
+    m_fd[counter]       = fd;
+    m_order[m_count++]  = counter;
+
+    return true;
+}
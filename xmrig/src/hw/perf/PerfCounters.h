@@ -0,0 +1,77 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PERFCOUNTERS_H
+#define XMRIG_PERFCOUNTERS_H
+
+
+#include "base/tools/Object.h"
+
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace xmrig
+{
+
+
+/**
+ * Group of hardware performance counters attached to the calling thread (perf_event_open).
+ *
+ * Must be constructed on the thread to be measured, reading is allowed from any thread.
+ */
+class PerfCounters
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE(PerfCounters)
+
+    enum Counter : uint32_t {
+        CYCLES,
+        INSTRUCTIONS,
+        LLC_MISSES,
+        DTLB_MISSES,
+        STALLED_CYCLES,
+        COUNTER_MAX
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    static const char *name(Counter counter);
+    static const char *tag();
+
+    inline bool has(Counter counter) const  { return m_fd[counter] >= 0; }
+    inline bool isAvailable() const         { return m_leader >= 0; }
+
+    bool read(uint64_t *values) const;
+
+private:
+    bool open(Counter counter);
+
+    int m_fd[COUNTER_MAX]{};
+    int m_leader                    = -1;
+    size_t m_count                  = 0;
+    uint32_t m_order[COUNTER_MAX]{};
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_PERFCOUNTERS_H */
@@ -0,0 +1,143 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "hw/perf/PerfStats.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+#include <cstring>
+
+
+xmrig::PerfStats::PerfStats(size_t threads) :
+    m_threads(threads)
+{
+}
+
+
+xmrig::PerfStats::Metrics xmrig::PerfStats::total() const
+{
+    uint64_t delta[PerfCounters::COUNTER_MAX]{};
+    uint64_t hashes = 0;
+    uint32_t mask   = ~0U;
+    bool valid      = false;
+
+    for (const auto &thread : m_threads) {
+        if (!thread.metrics.valid) {
+            continue;
+        }
+
+        for (size_t i = 0; i < PerfCounters::COUNTER_MAX; ++i) {
+            delta[i] += thread.delta[i];
+        }
+
+        hashes += thread.deltaHashes;
+        mask   &= thread.metrics.mask;
+        valid   = true;
+    }
+
+    return valid ? calc(delta, hashes, mask) : Metrics();
+}
+
+
+void xmrig::PerfStats::add(size_t threadId, const PerfCounters *counters, uint64_t hashCount, uint64_t timestamp)
+{
+    if (!counters || threadId >= m_threads.size()) {
+        return;
+    }
+
+    uint64_t values[PerfCounters::COUNTER_MAX];
+    if (!counters->read(values)) {
+        return;
+    }
+
+    m_available    = true;
+    Thread &thread = m_threads[threadId];
+
+    if (thread.timestamp && (timestamp - thread.timestamp) < kInterval) {
+        return;
+    }
+
+    if (thread.timestamp) {
+        uint32_t mask = 0;
+
+        for (uint32_t i = 0; i < PerfCounters::COUNTER_MAX; ++i) {
+            if (counters->has(static_cast<PerfCounters::Counter>(i))) {
+                mask |= 1U << i;
+            }
+
+            thread.delta[i] = values[i] - thread.values[i];
+        }
+
+        thread.deltaHashes = hashCount - thread.hashes;
+        thread.metrics     = calc(thread.delta, thread.deltaHashes, mask);
+    }
+
+    memcpy(thread.values, values, sizeof(values));
+    thread.hashes    = hashCount;
+    thread.timestamp = timestamp;
+}
+
+
+rapidjson::Value xmrig::PerfStats::toJSON(const Metrics &metrics, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    if (!metrics.valid) {
+        return Value(kNullType);
+    }
+
+    auto &allocator = doc.GetAllocator();
+
+    auto value = [&metrics](PerfCounters::Counter counter, double d) {
+        return metrics.has(counter) ? Json::normalize(d, true) : Value(kNullType);
+    };
+
+    Value out(kObjectType);
+    out.AddMember("ipc",                    value(PerfCounters::INSTRUCTIONS, metrics.ipc), allocator);
+    out.AddMember("llc-misses-per-hash",    value(PerfCounters::LLC_MISSES, metrics.llc), allocator);
+    out.AddMember("dtlb-misses-per-hash",   value(PerfCounters::DTLB_MISSES, metrics.dtlb), allocator);
+    out.AddMember("stalled-cycles",         value(PerfCounters::STALLED_CYCLES, metrics.stalled), allocator);
+
+    return out;
+}
+
+
+xmrig::PerfStats::Metrics xmrig::PerfStats::calc(const uint64_t *delta, uint64_t hashes, uint32_t mask)
+{
+    Metrics metrics;
+    const uint64_t cycles = delta[PerfCounters::CYCLES];
+
+    if (!(mask & (1U << PerfCounters::CYCLES)) || cycles == 0) {
+        mask &= ~((1U << PerfCounters::INSTRUCTIONS) | (1U << PerfCounters::STALLED_CYCLES));
+    }
+
+    if (hashes == 0) {
+        mask &= ~((1U << PerfCounters::LLC_MISSES) | (1U << PerfCounters::DTLB_MISSES));
+    }
+
+    metrics.valid   = true;
+    metrics.mask    = mask;
+    metrics.ipc     = cycles ? static_cast<double>(delta[PerfCounters::INSTRUCTIONS]) / cycles : 0.0;
+    metrics.stalled = cycles ? static_cast<double>(delta[PerfCounters::STALLED_CYCLES]) / cycles : 0.0;
+    metrics.llc     = hashes ? static_cast<double>(delta[PerfCounters::LLC_MISSES]) / hashes : 0.0;
+    metrics.dtlb    = hashes ? static_cast<double>(delta[PerfCounters::DTLB_MISSES]) / hashes : 0.0;
+
+    return metrics;
+}
@@ -0,0 +1,86 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_PERFSTATS_H
+#define XMRIG_PERFSTATS_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "hw/perf/PerfCounters.h"
+
+
+#include <vector>
+
+
+namespace xmrig
+{
+
+
+class PerfStats
+{
+public:
+    XMRIG_DISABLE_COPY_MOVE_DEFAULT(PerfStats)
+
+    constexpr static uint64_t kInterval = 10000;
+
+    struct Metrics
+    {
+        bool valid      = false;
+        uint32_t mask   = 0;
+        double ipc      = 0.0;
+        double llc      = 0.0;  // LLC misses per hash
+        double dtlb     = 0.0;  // dTLB misses per hash
+        double stalled  = 0.0;  // fraction of stalled cycles
+
+        inline bool has(PerfCounters::Counter counter) const { return valid && (mask & (1U << counter)); }
+    };
+
+    PerfStats(size_t threads);
+
+    inline bool isAvailable() const                     { return m_available; }
+    inline const Metrics &get(size_t threadId) const    { return m_threads[threadId].metrics; }
+    inline void reset(size_t threadId)                  { if (threadId < m_threads.size()) { m_threads[threadId] = Thread(); } }
+    inline void resize(size_t threads)                  { m_threads.resize(threads); }
+
+    Metrics total() const;
+    void add(size_t threadId, const PerfCounters *counters, uint64_t hashCount, uint64_t timestamp);
+
+    static rapidjson::Value toJSON(const Metrics &metrics, rapidjson::Document &doc);
+
+private:
+    struct Thread
+    {
+        Metrics metrics;
+        uint64_t delta[PerfCounters::COUNTER_MAX]{};
+        uint64_t values[PerfCounters::COUNTER_MAX]{};
+        uint64_t deltaHashes    = 0;
+        uint64_t hashes         = 0;
+        uint64_t timestamp      = 0;
+    };
+
+    static Metrics calc(const uint64_t *delta, uint64_t hashes, uint32_t mask);
+
+    bool m_available = false;
+    std::vector<Thread> m_threads;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_PERFSTATS_H */
@@ -0,0 +1,15 @@
+if (WITH_PERF AND XMRIG_OS_LINUX)
+    add_definitions(/DXMRIG_FEATURE_PERF)
+
+    list(APPEND HEADERS
+        src/hw/perf/PerfCounters.h
+        src/hw/perf/PerfStats.h
+        )
+
+    list(APPEND SOURCES
+        src/hw/perf/PerfCounters.cpp
+        src/hw/perf/PerfStats.cpp
+        )
+else()
+    remove_definitions(/DXMRIG_FEATURE_PERF)
+endif()
@@ -0,0 +1,457 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hw/resctrl/Resctrl.h"
+#include "3rdparty/rapidjson/document.h"
+#include "backend/cpu/CpuThread.h"
+#include "base/io/log/Log.h"
+#include "base/tools/Chrono.h"
+#include "hw/resctrl/ResctrlConfig.h"
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+
+namespace xmrig {
+
+
+static const char *kTag = CYAN_BG_BOLD(WHITE_BOLD_S " resctrl ");
+static const char *kMonitoring[] = { "llc_occupancy", "mbm_total_bytes", "mbm_local_bytes" };
+
+
+// Resource name ("L3", "MB") to values by domain id, as in the "schemata" file.
+using Schemata = std::map<std::string, std::vector<std::pair<int, std::string> > >;
+
+
+static std::vector<std::string> readLines(const std::string &path)
+{
+    std::vector<std::string> lines;
+    std::ifstream file(path);
+    std::string line;
+
+    while (std::getline(file, line)) {
+        const size_t first = line.find_first_not_of(" \t");
+        if (first == std::string::npos) {
+            continue;
+        }
+
+        lines.emplace_back(line.substr(first, line.find_last_not_of(" \t\r") - first + 1));
+    }
+
+    return lines;
+}
+
+
+static std::vector<std::string> readDir(const std::string &path, bool directories)
+{
+    std::vector<std::string> out;
+    DIR *dir = opendir(path.c_str());
+    if (!dir) {
+        return out;
+    }
+
+    while (dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+
+        struct stat st{};
+        if (stat((path + "/" + entry->d_name).c_str(), &st) == 0 && S_ISDIR(st.st_mode) == directories) {
+            out.emplace_back(entry->d_name);
+        }
+    }
+
+    closedir(dir);
+    std::sort(out.begin(), out.end());
+
+    return out;
+}
+
+
+// Every call is a separate write(), the kernel parses only one task id per write to "tasks". Files are created and
+// appended only for a test directory tree, in resctrl filesystem they always exist and the offset is ignored.
+static bool writeFile(const std::string &path, const std::string &data, bool append = false)
+{
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    const bool result = write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    close(fd);
+
+    return result;
+}
+
+
+static Schemata readSchemata(const std::string &path)
+{
+    Schemata schemata;
+
+    for (const auto &line : readLines(path + "/schemata")) {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+
+        auto &values = schemata[line.substr(0, colon)];
+        std::stringstream ss(line.substr(colon + 1));
+        std::string item;
+
+        while (std::getline(ss, item, ';')) {
+            const size_t eq = item.find('=');
+            if (eq != std::string::npos) {
+                values.emplace_back(atoi(item.c_str()), item.substr(eq + 1));
+            }
+        }
+    }
+
+    return schemata;
+}
+
+
+// Schemata line for every domain of the resource, domains without configured value keep the default group value.
+static std::string schemataLine(const char *resource, const ResctrlConfig::Domains &domains, const Schemata &schemata)
+{
+    const auto it = schemata.find(resource);
+    if (domains.empty() || it == schemata.end()) {
+        return {};
+    }
+
+    const auto all = domains.find(ResctrlConfig::kAllDomains);
+    std::string line = resource;
+    line += ":";
+
+    for (const auto &kv : it->second) {
+        const auto value = domains.find(kv.first);
+
+        line += std::to_string(kv.first) + "=" + (value != domains.end() ? value->second : (all != domains.end() ? all->second : kv.second)) + ";";
+    }
+
+    line.back() = '\n';
+
+    return line;
+}
+
+
+static std::vector<std::string> processTasks()
+{
+    return readDir("/proc/self/task", true);
+}
+
+
+class ResctrlGroup
+{
+public:
+    inline ResctrlGroup(const std::string &root, const char *name) : m_name(name), m_path(root + "/" + name), m_root(root) {}
+
+    inline const std::string &name() const { return m_name; }
+
+
+    bool create()
+    {
+        if (mkdir(m_path.c_str(), 0755) == 0) {
+            m_created = true;
+
+            return true;
+        }
+
+        if (errno == EEXIST) {
+            return true;
+        }
+
+        LOG_ERR("%s " RED("failed to create group ") RED_BOLD("\"%s\"") RED(" (%s)"), kTag, m_name.c_str(), strerror(errno));
+
+        return false;
+    }
+
+
+    bool setSchemata(const ResctrlConfig::Domains &l3, const ResctrlConfig::Domains &mb, const Schemata &root)
+    {
+        std::string schemata;
+
+        for (const char *resource : { "L3", "MB" }) {
+            const auto &domains = strcmp(resource, "L3") == 0 ? l3 : mb;
+            const auto line     = schemataLine(resource, domains, root);
+
+            if (!domains.empty() && line.empty()) {
+                LOG_WARN("%s " YELLOW("resource ") YELLOW_BOLD("%s") YELLOW(" is not supported, ignored for group ") YELLOW_BOLD("\"%s\""), kTag, resource, m_name.c_str());
+            }
+
+            schemata += line;
+        }
+
+        if (schemata.empty() || writeFile(m_path + "/schemata", schemata)) {
+            return true;
+        }
+
+        const auto status = readLines(m_root + "/info/last_cmd_status");
+
+        LOG_ERR("%s " RED("failed to set schemata for group ") RED_BOLD("\"%s\"") RED(" (%s)"), kTag, m_name.c_str(), status.empty() ? strerror(errno) : status.front().c_str());
+
+        return false;
+    }
+
+
+    bool setCpus(const std::set<int64_t> &cpus)
+    {
+        std::string list;
+        for (int64_t cpu : cpus) {
+            list += (list.empty() ? "" : ",") + std::to_string(cpu);
+        }
+
+        return writeFile(m_path + "/cpus_list", list + "\n");
+    }
+
+
+    size_t addTasks(const std::vector<std::string> &tasks)
+    {
+        size_t count = 0;
+
+        for (const auto &task : tasks) {
+            if (writeFile(m_path + "/tasks", task + "\n", true)) {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+
+    void remove()
+    {
+        // Kernel moves tasks and CPUs of the removed group back to the default group.
+        if (m_created && rmdir(m_path.c_str()) != 0) {
+            LOG_VERBOSE("%s " YELLOW("failed to remove group ") YELLOW_BOLD("\"%s\"") YELLOW(" (%s)"), kTag, m_name.c_str(), strerror(errno));
+        }
+    }
+
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const
+    {
+        using namespace rapidjson;
+        auto &allocator = doc.GetAllocator();
+
+        Value out(kObjectType);
+        out.AddMember("name",     Value(m_name.c_str(), allocator), allocator);
+        out.AddMember("created",  m_created, allocator);
+
+        Value schemata(kArrayType);
+        for (const auto &line : readLines(m_path + "/schemata")) {
+            schemata.PushBack(Value(line.c_str(), allocator), allocator);
+        }
+
+        const auto cpus = readLines(m_path + "/cpus_list");
+
+        out.AddMember("schemata", schemata, allocator);
+        out.AddMember("tasks",    static_cast<uint64_t>(readLines(m_path + "/tasks").size()), allocator);
+        out.AddMember("cpus",     cpus.empty() ? Value(kNullType) : Value(cpus.front().c_str(), allocator), allocator);
+
+        // Monitoring counters are available only if the kernel and CPU support them, values can be "Unavailable".
+        Value monitoring(kArrayType);
+
+        for (const auto &domain : readDir(m_path + "/mon_data", true)) {
+            Value item(kObjectType);
+            item.AddMember("domain", Value(domain.c_str(), allocator), allocator);
+
+            for (const char *name : kMonitoring) {
+                const auto value = readLines(m_path + "/mon_data/" + domain + "/" + name);
+                if (!value.empty() && isdigit(static_cast<unsigned char>(value.front()[0]))) {
+                    item.AddMember(StringRef(name), static_cast<uint64_t>(strtoull(value.front().c_str(), nullptr, 10)), allocator);
+                }
+            }
+
+            monitoring.PushBack(item, allocator);
+        }
+
+        out.AddMember("monitoring", monitoring, allocator);
+
+        return out;
+    }
+
+
+private:
+    bool m_created = false;
+    const std::string m_name;
+    const std::string m_path;
+    const std::string m_root;
+};
+
+
+static bool initialized = false;
+static std::string root;
+static std::vector<ResctrlGroup> groups;
+
+
+} // namespace xmrig
+
+
+bool xmrig::Resctrl::init(const ResctrlConfig &config, const std::vector<CpuThread> &threads)
+{
+    destroy();
+
+    initialized = true;
+
+    if (!config.isEnabled()) {
+        return false;
+    }
+
+    const uint64_t ts = Chrono::steadyMSecs();
+
+    if (!isMounted(config.path())) {
+        LOG_WARN("%s " YELLOW("filesystem is not mounted at ") YELLOW_BOLD("%s"), kTag, config.path());
+
+        return false;
+    }
+
+    root = config.path();
+
+    const auto schemata = readSchemata(root);
+    ResctrlGroup group(root, config.group());
+
+    if (!group.create()) {
+        return false;
+    }
+
+    groups.emplace_back(group);
+
+    if (!group.setSchemata(config.l3(), config.mb(), schemata)) {
+        destroy();
+
+        return false;
+    }
+
+    // Same rule as cache QoS with MSR, CPUs are assigned to the group only if every mining thread has affinity.
+    std::set<int64_t> cpus;
+    for (const auto &thread : threads) {
+        if (thread.affinity() < 0) {
+            cpus.clear();
+            break;
+        }
+
+        cpus.insert(thread.affinity());
+    }
+
+    if (!cpus.empty() && !group.setCpus(cpus)) {
+        LOG_WARN("%s " YELLOW("failed to assign mining CPUs to group ") YELLOW_BOLD("\"%s\""), kTag, group.name().c_str());
+    }
+
+    const auto own     = processTasks();
+    const size_t moved = group.addTasks(own);
+
+    LOG_INFO("%s " GREEN_BOLD("group ") WHITE_BOLD("\"%s\"") GREEN_BOLD(" ready") ", " CYAN_BOLD("%zu") " threads, " CYAN_BOLD("%zu") " CPUs" BLACK_BOLD(" (%" PRIu64 " ms)"),
+             kTag, group.name().c_str(), moved, cpus.size(), Chrono::steadyMSecs() - ts);
+
+    if (config.others()) {
+        ResctrlGroup others(root, config.others());
+
+        if (others.create()) {
+            groups.emplace_back(others);
+
+            if (others.setSchemata(config.othersL3(), config.othersMB(), schemata)) {
+                std::vector<std::string> tasks;
+                for (const auto &task : readLines(root + "/tasks")) {
+                    if (std::find(own.begin(), own.end(), task) == own.end()) {
+                        tasks.emplace_back(task);
+                    }
+                }
+
+                // Some kernel threads can't be moved, new tasks inherit the group of their parent.
+                LOG_INFO("%s " CYAN_BOLD("%zu") " of " CYAN_BOLD("%zu") " other tasks moved to group " WHITE_BOLD("\"%s\""), kTag, others.addTasks(tasks), tasks.size(), others.name().c_str());
+            }
+        }
+    }
+
+    return true;
+}
+
+
+bool xmrig::Resctrl::isEnabled()
+{
+    return !groups.empty();
+}
+
+
+bool xmrig::Resctrl::isInitialized()
+{
+    return initialized;
+}
+
+
+bool xmrig::Resctrl::isMounted(const char *path)
+{
+    struct stat st{};
+
+    return stat((std::string(path ? path : ResctrlConfig::kDefaultPath) + "/info").c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+
+const char *xmrig::Resctrl::tag()
+{
+    return kTag;
+}
+
+
+rapidjson::Value xmrig::Resctrl::toJSON(rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    if (groups.empty()) {
+        return Value(kNullType);
+    }
+
+    auto &allocator = doc.GetAllocator();
+
+    Value out(kObjectType);
+    out.AddMember("path", Value(root.c_str(), allocator), allocator);
+
+    Value list(kArrayType);
+    for (const auto &group : groups) {
+        list.PushBack(group.toJSON(doc), allocator);
+    }
+
+    out.AddMember("groups", list, allocator);
+
+    return out;
+}
+
+
+void xmrig::Resctrl::destroy()
+{
+    initialized = false;
+
+    for (auto it = groups.rbegin(); it != groups.rend(); ++it) {
+        it->remove();
+    }
+
+    groups.clear();
+}
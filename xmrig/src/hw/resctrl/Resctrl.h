@@ -0,0 +1,60 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RESCTRL_H
+#define XMRIG_RESCTRL_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+
+
+#include <vector>
+
+
+namespace xmrig
+{
+
+
+class CpuThread;
+class ResctrlConfig;
+
+
+/**
+ * Cache and memory bandwidth partitioning through the Linux resctrl filesystem (Intel RDT, AMD PQoS).
+ *
+ * Miner process is moved to a dedicated control group with configured L3 way masks and MBA values, with affinity
+ * set for all mining threads their CPUs are assigned to the group too. Optionally all other tasks of the system are
+ * moved to another group. Any directory with the same layout can be used instead of /sys/fs/resctrl for testing.
+ */
+class Resctrl
+{
+public:
+    static bool init(const ResctrlConfig &config, const std::vector<CpuThread> &threads);
+    static bool isEnabled();
+    static bool isInitialized();
+    static bool isMounted(const char *path = nullptr);
+    static const char *tag();
+    static rapidjson::Value toJSON(rapidjson::Document &doc);
+    static void destroy();
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RESCTRL_H */
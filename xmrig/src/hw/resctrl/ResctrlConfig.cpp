@@ -0,0 +1,164 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hw/resctrl/ResctrlConfig.h"
+#include "3rdparty/rapidjson/document.h"
+#include "base/io/json/Json.h"
+
+
+#include <cstdlib>
+#include <cstring>
+
+
+namespace xmrig {
+
+
+const char *ResctrlConfig::kEnabled         = "enabled";
+const char *ResctrlConfig::kField           = "resctrl";
+const char *ResctrlConfig::kGroup           = "group";
+const char *ResctrlConfig::kL3              = "l3";
+const char *ResctrlConfig::kMB              = "mb";
+const char *ResctrlConfig::kOthers          = "others";
+const char *ResctrlConfig::kOthersL3        = "others-l3";
+const char *ResctrlConfig::kOthersMB        = "others-mb";
+const char *ResctrlConfig::kPath            = "path";
+
+const char *ResctrlConfig::kDefaultGroup    = "xmrig";
+const char *ResctrlConfig::kDefaultPath     = "/sys/fs/resctrl";
+
+
+static const char *kAllDomainsKey           = "*";
+
+
+static bool readValue(const rapidjson::Value &value, std::string &out)
+{
+    if (value.IsString() && value.GetStringLength() > 0) {
+        out = value.GetString();
+
+        return true;
+    }
+
+    if (value.IsUint()) {
+        out = std::to_string(value.GetUint());
+
+        return true;
+    }
+
+    return false;
+}
+
+
+} // namespace xmrig
+
+
+rapidjson::Value xmrig::ResctrlConfig::toJSON(rapidjson::Document &doc) const
+{
+    using namespace rapidjson;
+    auto &allocator = doc.GetAllocator();
+
+    Value obj(kObjectType);
+
+    obj.AddMember(StringRef(kEnabled),      m_enabled, allocator);
+    obj.AddMember(StringRef(kPath),         m_path.toJSON(), allocator);
+    obj.AddMember(StringRef(kGroup),        m_group.toJSON(), allocator);
+    obj.AddMember(StringRef(kL3),           toJSON(m_l3, doc), allocator);
+    obj.AddMember(StringRef(kMB),           toJSON(m_mb, doc), allocator);
+    obj.AddMember(StringRef(kOthers),       m_others.toJSON(), allocator);
+    obj.AddMember(StringRef(kOthersL3),     toJSON(m_othersL3, doc), allocator);
+    obj.AddMember(StringRef(kOthersMB),     toJSON(m_othersMB, doc), allocator);
+
+    return obj;
+}
+
+
+void xmrig::ResctrlConfig::read(const rapidjson::Value &value)
+{
+    if (value.IsObject()) {
+        m_enabled   = Json::getBool(value, kEnabled, m_enabled);
+        m_path      = Json::getString(value, kPath);
+        m_group     = Json::getString(value, kGroup);
+        m_others    = Json::getString(value, kOthers);
+        m_l3        = readDomains(Json::getValue(value, kL3));
+        m_mb        = readDomains(Json::getValue(value, kMB));
+        m_othersL3  = readDomains(Json::getValue(value, kOthersL3));
+        m_othersMB  = readDomains(Json::getValue(value, kOthersMB));
+
+        // Group names are directories in the resctrl filesystem.
+        if (m_group.contains("/") || m_group == "." || m_group == "..") {
+            m_group = nullptr;
+        }
+
+        if (m_others.contains("/") || m_others == "." || m_others == ".." || m_others == group()) {
+            m_others = nullptr;
+        }
+    }
+    else if (value.IsBool()) {
+        m_enabled = value.GetBool();
+    }
+}
+
+
+xmrig::ResctrlConfig::Domains xmrig::ResctrlConfig::readDomains(const rapidjson::Value &value)
+{
+    Domains domains;
+    std::string str;
+
+    if (readValue(value, str)) {
+        domains.insert({ kAllDomains, str });
+    }
+    else if (value.IsObject()) {
+        for (const auto &member : value.GetObject()) {
+            const char *key = member.name.GetString();
+            char *end       = nullptr;
+            const long id   = strtol(key, &end, 10);
+
+            if (strcmp(key, kAllDomainsKey) == 0) {
+                if (readValue(member.value, str)) {
+                    domains[kAllDomains] = str;
+                }
+            }
+            else if (end != key && *end == '\0' && id >= 0 && readValue(member.value, str)) {
+                domains[static_cast<int>(id)] = str;
+            }
+        }
+    }
+
+    return domains;
+}
+
+
+rapidjson::Value xmrig::ResctrlConfig::toJSON(const Domains &domains, rapidjson::Document &doc)
+{
+    using namespace rapidjson;
+
+    if (domains.empty()) {
+        return Value(kNullType);
+    }
+
+    if (domains.size() == 1 && domains.begin()->first == kAllDomains) {
+        return Value(domains.begin()->second.c_str(), doc.GetAllocator());
+    }
+
+    Value obj(kObjectType);
+
+    for (const auto &kv : domains) {
+        obj.AddMember(Value(kv.first == kAllDomains ? kAllDomainsKey : std::to_string(kv.first).c_str(), doc.GetAllocator()), Value(kv.second.c_str(), doc.GetAllocator()), doc.GetAllocator());
+    }
+
+    return obj;
+}
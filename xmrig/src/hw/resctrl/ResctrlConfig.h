@@ -0,0 +1,87 @@
+/* XMRig
+ * Copyright (c) 2018-2021 SChernykh   <https://github.com/SChernykh>
+ * Copyright (c) 2016-2021 XMRig       <https://github.com/xmrig>, <support@xmrig.com>
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef XMRIG_RESCTRLCONFIG_H
+#define XMRIG_RESCTRLCONFIG_H
+
+
+#include "3rdparty/rapidjson/fwd.h"
+#include "base/tools/String.h"
+
+
+#include <map>
+#include <string>
+
+
+namespace xmrig {
+
+
+class ResctrlConfig
+{
+public:
+    // Resource values by L3 domain id, kAllDomains is used for domains without own value.
+    using Domains = std::map<int, std::string>;
+
+    constexpr static int kAllDomains = -1;
+
+    static const char *kEnabled;
+    static const char *kField;
+    static const char *kGroup;
+    static const char *kL3;
+    static const char *kMB;
+    static const char *kOthers;
+    static const char *kOthersL3;
+    static const char *kOthersMB;
+    static const char *kPath;
+
+    static const char *kDefaultGroup;
+    static const char *kDefaultPath;
+
+    ResctrlConfig() = default;
+
+    inline bool isEnabled() const           { return m_enabled; }
+    inline const char *group() const        { return m_group.isEmpty() ? kDefaultGroup : m_group.data(); }
+    inline const char *others() const       { return m_others.data(); }
+    inline const char *path() const         { return m_path.isNull() ? kDefaultPath : m_path.data(); }
+    inline const Domains &l3() const        { return m_l3; }
+    inline const Domains &mb() const        { return m_mb; }
+    inline const Domains &othersL3() const  { return m_othersL3; }
+    inline const Domains &othersMB() const  { return m_othersMB; }
+
+    rapidjson::Value toJSON(rapidjson::Document &doc) const;
+    void read(const rapidjson::Value &value);
+
+private:
+    static Domains readDomains(const rapidjson::Value &value);
+    static rapidjson::Value toJSON(const Domains &domains, rapidjson::Document &doc);
+
+    bool m_enabled          = false;
+    Domains m_l3;           // L3 way masks (hex) of the mining group
+    Domains m_mb;           // memory bandwidth allocation (percent or MBps) of the mining group
+    Domains m_othersL3;
+    Domains m_othersMB;
+    String m_group;
+    String m_others;        // group for all other tasks of the system, null means they are not moved
+    String m_path;
+};
+
+
+} /* namespace xmrig */
+
+
+#endif /* XMRIG_RESCTRLCONFIG_H */
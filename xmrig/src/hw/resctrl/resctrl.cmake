@@ -0,0 +1,15 @@
+if (WITH_RESCTRL AND WITH_RANDOMX AND XMRIG_OS_LINUX)
+    add_definitions(/DXMRIG_FEATURE_RESCTRL)
+
+    list(APPEND HEADERS
+        src/hw/resctrl/Resctrl.h
+        src/hw/resctrl/ResctrlConfig.h
+        )
+
+    list(APPEND SOURCES
+        src/hw/resctrl/Resctrl.cpp
+        src/hw/resctrl/ResctrlConfig.cpp
+        )
+else()
+    remove_definitions(/DXMRIG_FEATURE_RESCTRL)
+endif()
@@ -49,6 +49,7 @@ public:
         clientId(job.clientId()),
         jobId(job.id()),
         backend(job.backend()),
+        group(job.group()),
         nonce(nonce),
         diff(job.diff())
     {
@@ -74,6 +75,7 @@ public:
         clientId(job.clientId()),
         jobId(job.id()),
         backend(job.backend()),
+        group(job.group()),
         nonce(0),
         diff(0)
     {
@@ -92,6 +94,7 @@ public:
     const String clientId;
     const String jobId;
     const uint32_t backend;
+    const uint32_t group;
     const uint64_t nonce;
     const uint64_t diff;
 
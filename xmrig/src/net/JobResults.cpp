@@ -128,7 +128,7 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
             return;
         }
 
-        auto vm = RxVm::create(dataset, memory->scratchpad(), !hwAES, Assembly::NONE, 0);
+        auto vm = RxVm::create(dataset, memory->scratchpad(), !hwAES, Assembly::NONE, 0, algorithm);
 
         for (uint32_t nonce : bundle.nonces) {
             *bundle.job.nonce() = nonce;
@@ -188,6 +188,8 @@ static void getResults(JobBundle &bundle, std::vector<JobResult> &results, uint3
 
             checkHash(bundle, results, nonce, hash, errors);
         }
+
+        CnCtx::release(ctx, 1);
     }
 
     delete memory;
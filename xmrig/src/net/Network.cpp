@@ -34,6 +34,7 @@
 #include "core/config/Config.h"
 #include "core/Controller.h"
 #include "core/Miner.h"
+#include "crypto/common/Nonce.h"
 #include "net/JobResult.h"
 #include "net/JobResults.h"
 #include "net/strategies/DonateStrategy.h"
@@ -72,6 +73,8 @@ xmrig::Network::Network(Controller *controller) :
     const Pools &pools = controller->config()->pools();
     m_strategy = pools.createStrategy(m_state);
 
+    createGroups(pools);
+
     if (pools.donateLevel() > 0) {
         m_donate = new DonateStrategy(controller, this);
     }
@@ -88,12 +91,18 @@ xmrig::Network::~Network()
     delete m_donate;
     delete m_strategy;
     delete m_state;
+
+    stopGroups();
 }
 
 
 void xmrig::Network::connect()
 {
     m_strategy->connect();
+
+    for (auto &kv : m_groups) {
+        kv.second.strategy->connect();
+    }
 }
 
 
@@ -136,9 +145,19 @@ void xmrig::Network::onActive(IStrategy *strategy, IClient *client)
         snprintf(zmq_buf, sizeof(zmq_buf), " (ZMQ:%d)", client->pool().zmq_port());
     }
 
+    char tls_buf[48] = {};
+    if (client->isTLS() && client->tlsHandshakeTime()) {
+        snprintf(tls_buf, sizeof(tls_buf), " (%s, %" PRIu64 " ms)", client->isTLSResumed() ? "resumed" : "full handshake", client->tlsHandshakeTime());
+    }
+
+    char group_buf[24] = {};
+    if (group(strategy) > 0) {
+        snprintf(group_buf, sizeof(group_buf), "group %u ", group(strategy));
+    }
+
     const char *tlsVersion = client->tlsVersion();
-    LOG_INFO("%s " WHITE_BOLD("use %s ") CYAN_BOLD("%s:%d%s ") GREEN_BOLD("%s") " " BLACK_BOLD("%s"),
-             Tags::network(), client->mode(), pool.host().data(), pool.port(), zmq_buf, tlsVersion ? tlsVersion : "", client->ip().data());
+    LOG_INFO("%s " WHITE_BOLD("%suse %s ") CYAN_BOLD("%s:%d%s ") GREEN_BOLD("%s") " " BLACK_BOLD("%s%s"),
+             Tags::network(), group_buf, client->mode(), pool.host().data(), pool.port(), zmq_buf, tlsVersion ? tlsVersion : "", client->ip().data(), tls_buf);
 
     const char *fingerprint = client->tlsFingerprint();
     if (fingerprint != nullptr) {
@@ -154,17 +173,27 @@ void xmrig::Network::onConfigChanged(Config *config, Config *previousConfig)
     }
 
     m_strategy->stop();
+    stopGroups();
 
     config->pools().print();
 
     delete m_strategy;
     m_strategy = config->pools().createStrategy(m_state);
+    createGroups(config->pools());
     connect();
 }
 
 
 void xmrig::Network::onJob(IStrategy *strategy, IClient *client, const Job &job, const rapidjson::Value &)
 {
+    const uint32_t group = this->group(strategy);
+    if (group > 0) {
+        Job copy(job);
+        copy.setGroup(group);
+
+        return setJob(client, copy, false);
+    }
+
     if (m_donate && m_donate->isActive() && m_donate != strategy) {
         return;
     }
@@ -175,6 +204,15 @@ void xmrig::Network::onJob(IStrategy *strategy, IClient *client, const Job &job,
 
 void xmrig::Network::onJobResult(const JobResult &result)
 {
+    if (result.group > 0) {
+        const auto it = m_groups.find(result.group);
+        if (it != m_groups.end()) {
+            it->second.strategy->submit(result);
+        }
+
+        return;
+    }
+
     if (result.index == 1 && m_donate) {
         m_donate->submit(result);
         return;
@@ -210,6 +248,17 @@ void xmrig::Network::onLogin(IStrategy *, IClient *client, rapidjson::Document &
 
 void xmrig::Network::onPause(IStrategy *strategy)
 {
+    const uint32_t group = this->group(strategy);
+    if (group > 0) {
+        if (!strategy->isActive()) {
+            LOG_ERR("%s " RED("no active pools in group %u, stop mining of the group"), Tags::network(), group);
+
+            m_controller->miner()->pause(group);
+        }
+
+        return;
+    }
+
     if (m_donate && m_donate == strategy) {
         LOG_NOTICE("%s " WHITE_BOLD("dev donate finished"), Tags::network());
         m_strategy->resume();
@@ -223,29 +272,42 @@ void xmrig::Network::onPause(IStrategy *strategy)
 }
 
 
-void xmrig::Network::onResultAccepted(IStrategy *, IClient *, const SubmitResult &result, const char *error)
+void xmrig::Network::onResultAccepted(IStrategy *strategy, IClient *, const SubmitResult &result, const char *error)
 {
     uint64_t diff     = result.diff;
     const char *scale = NetworkState::scaleDiff(diff);
 
+    const uint32_t group      = this->group(strategy);
+    const NetworkState *state = group > 0 ? m_groups.at(group).state : m_state;
+
+    char group_buf[24] = {};
+    if (group > 0) {
+        snprintf(group_buf, sizeof(group_buf), " group %u", group);
+    }
+
     if (error) {
-        LOG_INFO("%s " RED_BOLD("rejected") " (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64 "%s") " " RED("\"%s\"") " " BLACK_BOLD("(%" PRIu64 " ms)"),
-                 backend_tag(result.backend), m_state->accepted(), m_state->rejected(), diff, scale, error, result.elapsed);
+        LOG_INFO("%s " RED_BOLD("rejected") "%s (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64 "%s") " " RED("\"%s\"") " " BLACK_BOLD("(%" PRIu64 " ms)"),
+                 backend_tag(result.backend), group_buf, state->accepted(), state->rejected(), diff, scale, error, result.elapsed);
     }
     else {
-        LOG_INFO("%s " GREEN_BOLD("accepted") " (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64 "%s") " " BLACK_BOLD("(%" PRIu64 " ms)"),
-                 backend_tag(result.backend), m_state->accepted(), m_state->rejected(), diff, scale, result.elapsed);
+        LOG_INFO("%s " GREEN_BOLD("accepted") "%s (%" PRId64 "/%" PRId64 ") diff " WHITE_BOLD("%" PRIu64 "%s") " " BLACK_BOLD("(%" PRIu64 " ms)"),
+                 backend_tag(result.backend), group_buf, state->accepted(), state->rejected(), diff, scale, result.elapsed);
     }
 }
 
 
-void xmrig::Network::onVerifyAlgorithm(IStrategy *, const IClient *, const Algorithm &algorithm, bool *ok)
+void xmrig::Network::onVerifyAlgorithm(IStrategy *strategy, const IClient *, const Algorithm &algorithm, bool *ok)
 {
     if (!m_controller->miner()->isEnabled(algorithm)) {
         *ok = false;
 
         return;
     }
+
+    // GPU backends are used only by the main group, each group has its own RandomX dataset.
+    if (group(strategy) > 0 && algorithm.family() == Algorithm::KAWPOW) {
+        *ok = false;
+    }
 }
 
 
@@ -262,6 +324,33 @@ void xmrig::Network::onRequest(IApiRequest &request)
 #endif
 
 
+uint32_t xmrig::Network::group(const IStrategy *strategy) const
+{
+    for (const auto &kv : m_groups) {
+        if (kv.second.strategy == strategy) {
+            return kv.first;
+        }
+    }
+
+    return 0;
+}
+
+
+void xmrig::Network::createGroups(const Pools &pools)
+{
+    for (const uint32_t group : pools.groups()) {
+        if (group >= Nonce::kMaxGroups) {
+            LOG_WARN("%s " YELLOW("pool group %u ignored, maximum is %u"), Tags::network(), group, Nonce::kMaxGroups - 1);
+
+            continue;
+        }
+
+        auto state = new NetworkState(this);
+        m_groups[group] = { pools.createStrategy(state, group), state };
+    }
+}
+
+
 void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
 {
 #   ifdef XMRIG_FEATURE_BENCHMARK
@@ -287,11 +376,16 @@ void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
             snprintf(height_buf, sizeof(height_buf), " height " WHITE_BOLD("%" PRIu64), job.height());
         }
 
-        LOG_INFO("%s " MAGENTA_BOLD("new job") " from " WHITE_BOLD("%s:%d%s") " diff " WHITE_BOLD("%" PRIu64 "%s") " algo " WHITE_BOLD("%s") "%s%s",
-                 Tags::network(), client->pool().host().data(), client->pool().port(), zmq_buf, diff, scale, job.algorithm().name(), height_buf, tx_buf);
+        char group_buf[24] = {};
+        if (job.group() > 0) {
+            snprintf(group_buf, sizeof(group_buf), " group %u", job.group());
+        }
+
+        LOG_INFO("%s " MAGENTA_BOLD("new job") "%s from " WHITE_BOLD("%s:%d%s") " diff " WHITE_BOLD("%" PRIu64 "%s") " algo " WHITE_BOLD("%s") "%s%s",
+                 Tags::network(), group_buf, client->pool().host().data(), client->pool().port(), zmq_buf, diff, scale, job.algorithm().name(), height_buf, tx_buf);
     }
 
-    if (!donate && m_donate) {
+    if (!donate && m_donate && job.group() == 0) {
         m_donate->setAlgo(job.algorithm());
         m_donate->setProxy(client->pool().proxy());
     }
@@ -300,12 +394,29 @@ void xmrig::Network::setJob(IClient *client, const Job &job, bool donate)
 }
 
 
+void xmrig::Network::stopGroups()
+{
+    for (auto &kv : m_groups) {
+        kv.second.strategy->stop();
+
+        delete kv.second.strategy;
+        delete kv.second.state;
+    }
+
+    m_groups.clear();
+}
+
+
 void xmrig::Network::tick()
 {
     const uint64_t now = Chrono::steadyMSecs();
 
     m_strategy->tick(now);
 
+    for (auto &kv : m_groups) {
+        kv.second.strategy->tick(now);
+    }
+
     if (m_donate) {
         m_donate->tick(now);
     }
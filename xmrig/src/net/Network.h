@@ -30,6 +30,7 @@
 #include "interfaces/IJobResultListener.h"
 
 
+#include <map>
 #include <vector>
 
 
@@ -39,6 +40,7 @@ namespace xmrig {
 class Controller;
 class IStrategy;
 class NetworkState;
+class Pools;
 
 
 class Network : public IJobResultListener, public IStrategyListener, public IBaseListener, public ITimerListener, public IApiListener
@@ -49,7 +51,8 @@ public:
     Network(Controller *controller);
     ~Network() override;
 
-    inline IStrategy *strategy() const { return m_strategy; }
+    inline const NetworkState *state() const    { return m_state; }
+    inline IStrategy *strategy() const          { return m_strategy; }
 
     void connect();
     void execCommand(char command);
@@ -73,7 +76,10 @@ protected:
 private:
     constexpr static int kTickInterval = 1 * 1000;
 
+    uint32_t group(const IStrategy *strategy) const;
+    void createGroups(const Pools &pools);
     void setJob(IClient *client, const Job &job, bool donate);
+    void stopGroups();
     void tick();
 
 #   ifdef XMRIG_FEATURE_API
@@ -81,10 +87,18 @@ private:
     void getResults(rapidjson::Value &reply, rapidjson::Document &doc, int version) const;
 #   endif
 
+    // Strategy and connection state of each pool group > 0, jobs of the group are mined only by the CPU threads of the group.
+    struct Group
+    {
+        IStrategy *strategy;
+        NetworkState *state;
+    };
+
     Controller *m_controller;
     IStrategy *m_donate     = nullptr;
     IStrategy *m_strategy   = nullptr;
     NetworkState *m_state   = nullptr;
+    std::map<uint32_t, Group> m_groups;
     Timer *m_timer          = nullptr;
 };
 